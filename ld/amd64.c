@@ -73,13 +73,13 @@ static enum ld_tls_relax _tls_check_relax(struct ld *ld,
 static uint64_t _got_offset(struct ld *ld, struct ld_symbol *lsb);
 static int _tls_verify_gd(uint8_t *buf, uint64_t off);
 static int _tls_verify_ld(uint8_t *buf, uint64_t off);
-static void _tls_relax_gd_to_ie(struct ld *ld, struct ld_state *ls,
+static void _tls_relax_gd_to_ie(struct ld *ld, struct ld_input_section *is,
     struct ld_output *lo,struct ld_reloc_entry *lre, uint64_t p, uint64_t g,
     uint8_t *buf);
-static void _tls_relax_gd_to_le(struct ld *ld, struct ld_state *ls,
+static void _tls_relax_gd_to_le(struct ld *ld, struct ld_input_section *is,
     struct ld_output *lo, struct ld_reloc_entry *lre, struct ld_symbol *lsb,
     uint8_t *buf);
-static void _tls_relax_ld_to_le(struct ld *ld, struct ld_state *ls,
+static void _tls_relax_ld_to_le(struct ld *ld, struct ld_input_section *is,
     struct ld_reloc_entry *lre, uint8_t *buf);
 static void _tls_relax_ie_to_le(struct ld *ld, struct ld_output *lo,
     struct ld_reloc_entry *lre, struct ld_symbol *lsb, uint8_t *buf);
@@ -864,7 +864,6 @@ static void
 _process_reloc(struct ld *ld, struct ld_input_section *is,
     struct ld_reloc_entry *lre, struct ld_symbol *lsb, uint8_t *buf)
 {
-	struct ld_state *ls;
 	struct ld_output *lo;
 	uint64_t u64, s, l, p, g;
 	int64_t s64;
@@ -872,8 +871,6 @@ _process_reloc(struct ld *ld, struct ld_input_section *is,
 	int32_t s32;
 	enum ld_tls_relax tr;
 
-	ls = &ld->ld_state;
-
 	lo = ld->ld_output;
 	assert(lo != NULL);
 
@@ -898,11 +895,11 @@ _process_reloc(struct ld *ld, struct ld_input_section *is,
 		break;
 
 	case R_X86_64_PLT32:
-		if (!ls->ls_ignore_next_plt) {
+		if (!is->is_ignore_next_plt) {
 			s32 = l + lre->lre_addend - p;
 			WRITE_32(buf + lre->lre_offset, s32);
 		} else
-			ls->ls_ignore_next_plt = 0;
+			is->is_ignore_next_plt = 0;
 		break;
 
 	case R_X86_64_GOTPCREL:
@@ -937,10 +934,10 @@ _process_reloc(struct ld *ld, struct ld_input_section *is,
 			break;
 		case TLS_RELAX_INIT_EXEC:
 			g = _got_offset(ld, lsb);
-			_tls_relax_gd_to_ie(ld, ls, lo, lre, p, g, buf);
+			_tls_relax_gd_to_ie(ld, is, lo, lre, p, g, buf);
 			break;
 		case TLS_RELAX_LOCAL_EXEC:
-			_tls_relax_gd_to_le(ld, ls, lo, lre, lsb, buf);
+			_tls_relax_gd_to_le(ld, is, lo, lre, lsb, buf);
 			break;
 		default:
 			ld_fatal(ld, "Internal: invalid TLS relaxation %d",
@@ -958,7 +955,7 @@ _process_reloc(struct ld *ld, struct ld_input_section *is,
 			WRITE_32(buf + lre->lre_offset, s32);
 			break;
 		case TLS_RELAX_LOCAL_EXEC:
-			_tls_relax_ld_to_le(ld, ls, lre, buf);
+			_tls_relax_ld_to_le(ld, is, lre, buf);
 			break;
 		default:
 			ld_fatal(ld, "Internal: invalid TLS relaxation %d",
@@ -1135,8 +1132,9 @@ _tls_verify_ld(uint8_t *buf, uint64_t off)
 }
 
 static void
-_tls_relax_gd_to_ie(struct ld *ld, struct ld_state *ls, struct ld_output *lo,
-    struct ld_reloc_entry *lre, uint64_t p, uint64_t g, uint8_t *buf)
+_tls_relax_gd_to_ie(struct ld *ld, struct ld_input_section *is,
+    struct ld_output *lo, struct ld_reloc_entry *lre, uint64_t p, uint64_t g,
+    uint8_t *buf)
 {
 	/*
 	 * Initial Exec model:
@@ -1168,12 +1166,13 @@ _tls_relax_gd_to_ie(struct ld *ld, struct ld_state *ls, struct ld_output *lo,
 	WRITE_32(buf + lre->lre_offset + 8, s32);
 
 	/* Ignore the next R_X86_64_PLT32 relocation for _tls_get_addr. */
-	ls->ls_ignore_next_plt = 1;
+	is->is_ignore_next_plt = 1;
 }
 
 static void
-_tls_relax_gd_to_le(struct ld *ld, struct ld_state *ls, struct ld_output *lo,
-    struct ld_reloc_entry *lre, struct ld_symbol *lsb, uint8_t *buf)
+_tls_relax_gd_to_le(struct ld *ld, struct ld_input_section *is,
+    struct ld_output *lo, struct ld_reloc_entry *lre, struct ld_symbol *lsb,
+    uint8_t *buf)
 {
 	/*
 	 * Local Exec model:
@@ -1200,11 +1199,11 @@ _tls_relax_gd_to_le(struct ld *ld, struct ld_state *ls, struct ld_output *lo,
 	WRITE_32(buf + lre->lre_offset + 8, s32);
 
 	/* Ignore the next R_X86_64_PLT32 relocation for _tls_get_addr. */
-	ls->ls_ignore_next_plt = 1;
+	is->is_ignore_next_plt = 1;
 }
 
 static void
-_tls_relax_ld_to_le(struct ld *ld, struct ld_state *ls,
+_tls_relax_ld_to_le(struct ld *ld, struct ld_input_section *is,
     struct ld_reloc_entry *lre, uint8_t *buf)
 {
 	/*
@@ -1225,7 +1224,7 @@ _tls_relax_ld_to_le(struct ld *ld, struct ld_state *ls,
 	memcpy(buf + lre->lre_offset - 3, le_p, sizeof(le_p) - 1);
 
 	/* Ignore the next R_X86_64_PLT32 relocation for _tls_get_addr. */
-	ls->ls_ignore_next_plt = 1;
+	is->is_ignore_next_plt = 1;
 }
 
 static void
@@ -536,13 +536,10 @@ static void
 _process_reloc(struct ld *ld, struct ld_input_section *is,
     struct ld_reloc_entry *lre, struct ld_symbol *lsb, uint8_t *buf)
 {
-	struct ld_state *ls;
 	struct ld_output *lo;
 	uint32_t p, s, l, g, got;
 	int32_t a, v;
 
-	ls = &ld->ld_state;
-
 	lo = ld->ld_output;
 	assert(lo != NULL);
 
@@ -570,11 +567,11 @@ _process_reloc(struct ld *ld, struct ld_input_section *is,
 		break;
 
 	case R_386_PLT32:
-		if (!ls->ls_ignore_next_plt) {
+		if (!is->is_ignore_next_plt) {
 			v = l + a - p;
 			WRITE_32(buf + lre->lre_offset, v);
 		} else
-			ls->ls_ignore_next_plt = 0;
+			is->is_ignore_next_plt = 0;
 		break;
 
 	case R_386_GOT32:
@@ -68,6 +68,15 @@ struct ld_section_group;
 
 #define	LD_MAX_NESTED_GROUP	16
 
+#define	LD_HASH_STYLE_SYSV	0x1
+#define	LD_HASH_STYLE_GNU	0x2
+
+#define	LD_BUILD_ID_NONE	0
+#define	LD_BUILD_ID_SHA1	1
+#define	LD_BUILD_ID_MD5		2
+#define	LD_BUILD_ID_UUID	3
+#define	LD_BUILD_ID_HEX		4
+
 struct ld_state {
 	Elftc_Bfd_Target *ls_itgt;	/* input bfd target set by -b */
 	struct ld_file *ls_file;	/* current open file */
@@ -88,7 +97,6 @@ struct ld_state {
 	unsigned ls_rerun;		/* ld(1) restarted */
 	unsigned ls_archive_mb_header;	/* extracted list header printed */
 	unsigned ls_first_output_sec;	/* flag indicates 1st output section */
-	unsigned ls_ignore_next_plt;	/* ignore next PLT relocation */
 	unsigned ls_version_local;	/* version entry is local */
 	uint64_t ls_relative_reloc;	/* number of *_RELATIVE relocations */
 	struct ld_input_section_head *ls_gc;
@@ -125,6 +133,7 @@ struct ld {
 	struct ld_symbol_table *ld_dynsym; /* .dynsym symbol table */
 	struct ld_strtab *ld_dynstr;	/* .dynstr string table */
 	struct ld_symbol_head *ld_dyn_symbols; /* dynamic symbol list */
+	struct ld_symbol_head *ld_undef_symbols; /* undefined symbol list */
 	struct ld_wildcard_match *ld_wm; /* wildcard hash table */
 	struct ld_input_section *ld_dynbss; /* .dynbss section */
 	struct ld_input_section *ld_got;    /* .got section */
@@ -147,6 +156,12 @@ struct ld {
 	unsigned char ld_gc;		/* perform garbage collection */
 	unsigned char ld_gc_print;	/* print removed sections */
 	unsigned char ld_ehframe_hdr;	/* create .eh_frame_hdr section */
+	unsigned char ld_gdb_index;	/* create .gdb_index section */
+	unsigned char ld_hash_style;	/* dynamic hash table style */
+	unsigned char ld_build_id;	/* build ID style */
+	uint8_t *ld_build_id_hex;	/* build ID given in hex */
+	size_t ld_build_id_hexsz;	/* size of hex build ID */
+	unsigned ld_threads;		/* number of worker threads */
 	STAILQ_HEAD(ld_input_head, ld_input) ld_lilist; /* input object list */
 	TAILQ_HEAD(ld_file_head, ld_file) ld_lflist; /* input file list */
 };
@@ -0,0 +1,517 @@
+/*-
+ * Copyright (c) 2026 The Elftoolchain Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ctype.h>
+#include <pthread.h>
+
+#include "ld.h"
+#include "ld_buildid.h"
+#include "ld_input.h"
+#include "ld_output.h"
+#include "ld_utils.h"
+
+ELFTC_VCSID("$Id$");
+
+/*
+ * Generate a .note.gnu.build-id section for the output object.
+ *
+ * For the sha1 and md5 styles the build ID is a tree hash of the final
+ * output image: the image (with the build ID descriptor zeroed) is split
+ * into fixed size chunks which are hashed in parallel, and the build ID
+ * is the hash of the concatenated chunk digests. The chunk size does not
+ * depend on the number of threads, so the result is reproducible.
+ */
+
+#define	_BUILD_ID_CHUNK_SIZE	(1024 * 1024)
+#define	_BUILD_ID_MAX_THREADS	64
+#define	_BUILD_ID_NOTE_HDR_SIZE	16
+#define	_BUILD_ID_MAX_SIZE	64
+
+struct _build_id_job {
+	const uint8_t *bj_buf;		/* output image */
+	size_t bj_size;			/* size of output image */
+	uint8_t *bj_md;			/* chunk digests */
+	size_t bj_nchunks;		/* number of chunks */
+	unsigned char bj_style;		/* hash style */
+	int bj_nthreads;		/* number of threads */
+	int bj_id;			/* index of this thread */
+};
+
+static void	_digest(unsigned char style, const uint8_t *buf, size_t size,
+    uint8_t *md);
+static size_t	_digest_size(unsigned char style);
+static void	*_hash_chunks(void *arg);
+static void	_md5_block(uint32_t *h, const uint8_t *p);
+static void	_sha1_block(uint32_t *h, const uint8_t *p);
+static void	_tree_hash(struct ld *ld, const uint8_t *buf, size_t size,
+    uint8_t *md);
+
+void
+ld_buildid_set_style(struct ld *ld, const char *arg)
+{
+	const char *p;
+	uint8_t *hex;
+	size_t len, i;
+	int c, v;
+
+	if (ld->ld_build_id_hex != NULL) {
+		free(ld->ld_build_id_hex);
+		ld->ld_build_id_hex = NULL;
+		ld->ld_build_id_hexsz = 0;
+	}
+
+	if (arg == NULL || !strcmp(arg, "sha1") || !strcmp(arg, "tree")) {
+		ld->ld_build_id = LD_BUILD_ID_SHA1;
+		return;
+	}
+
+	if (!strcmp(arg, "md5")) {
+		ld->ld_build_id = LD_BUILD_ID_MD5;
+		return;
+	}
+
+	if (!strcmp(arg, "uuid")) {
+		ld->ld_build_id = LD_BUILD_ID_UUID;
+		return;
+	}
+
+	if (!strcmp(arg, "none")) {
+		ld->ld_build_id = LD_BUILD_ID_NONE;
+		return;
+	}
+
+	if (strncmp(arg, "0x", 2) != 0 && strncmp(arg, "0X", 2) != 0)
+		ld_fatal(ld, "invalid build-id style `%s'", arg);
+
+	p = arg + 2;
+	len = strlen(p);
+	if (len == 0 || len % 2 != 0 || len / 2 > _BUILD_ID_MAX_SIZE)
+		ld_fatal(ld, "invalid build-id `%s'", arg);
+
+	if ((hex = malloc(len / 2)) == NULL)
+		ld_fatal_std(ld, "malloc");
+
+	for (i = 0; i < len; i++) {
+		c = (unsigned char) p[i];
+		if (!isxdigit(c))
+			ld_fatal(ld, "invalid build-id `%s'", arg);
+		v = isdigit(c) ? c - '0' : tolower(c) - 'a' + 10;
+		if (i % 2 == 0)
+			hex[i / 2] = v << 4;
+		else
+			hex[i / 2] |= v;
+	}
+
+	ld->ld_build_id = LD_BUILD_ID_HEX;
+	ld->ld_build_id_hex = hex;
+	ld->ld_build_id_hexsz = len / 2;
+}
+
+void
+ld_buildid_create(struct ld *ld)
+{
+	struct ld_input_section *is;
+	size_t descsz;
+
+	switch (ld->ld_build_id) {
+	case LD_BUILD_ID_HEX:
+		descsz = ld->ld_build_id_hexsz;
+		break;
+	case LD_BUILD_ID_UUID:
+		descsz = 16;
+		break;
+	default:
+		descsz = _digest_size(ld->ld_build_id);
+		break;
+	}
+
+	is = ld_input_add_internal_section(ld, ".note.gnu.build-id");
+	is->is_type = SHT_NOTE;
+	is->is_size = _BUILD_ID_NOTE_HDR_SIZE + roundup(descsz, 4);
+	is->is_align = 4;
+	is->is_entsize = 0;
+}
+
+void
+ld_buildid_finalize(struct ld *ld)
+{
+	struct ld_input_section *is;
+	struct ld_output *lo;
+	uint8_t *p;
+	size_t descsz;
+	int fd;
+
+	lo = ld->ld_output;
+	assert(lo != NULL);
+
+	is = ld_input_find_internal_section(ld, ".note.gnu.build-id");
+	assert(is != NULL);
+	if (is->is_discard || is->is_output == NULL)
+		return;
+
+	descsz = is->is_size - _BUILD_ID_NOTE_HDR_SIZE;
+	if (ld->ld_build_id == LD_BUILD_ID_HEX)
+		descsz = ld->ld_build_id_hexsz;
+
+	p = is->is_ibuf;
+	memset(p, 0, is->is_size);
+	WRITE_32(p, 4);			/* n_namesz */
+	p += 4;
+	WRITE_32(p, descsz);		/* n_descsz */
+	p += 4;
+	WRITE_32(p, NT_GNU_BUILD_ID);	/* n_type */
+	p += 4;
+	memcpy(p, "GNU", 4);
+	p += 4;
+
+	switch (ld->ld_build_id) {
+	case LD_BUILD_ID_HEX:
+		memcpy(p, ld->ld_build_id_hex, descsz);
+		break;
+	case LD_BUILD_ID_UUID:
+		/* Generate a random (version 4) UUID. */
+		if ((fd = open("/dev/urandom", O_RDONLY)) < 0)
+			ld_fatal_std(ld, "open /dev/urandom");
+		if (read(fd, p, descsz) != (ssize_t) descsz)
+			ld_fatal_std(ld, "read /dev/urandom");
+		(void) close(fd);
+		p[6] = (p[6] & 0x0f) | 0x40;
+		p[8] = (p[8] & 0x3f) | 0x80;
+		break;
+	default:
+		/* Filled in by ld_buildid_write() later. */
+		break;
+	}
+}
+
+void
+ld_buildid_write(struct ld *ld, off_t size)
+{
+	struct ld_input_section *is;
+	struct ld_output *lo;
+	struct ld_output_section *os;
+	uint8_t md[_BUILD_ID_MAX_SIZE];
+	uint8_t *buf;
+	off_t off;
+	size_t mdsz;
+
+	if (ld->ld_build_id != LD_BUILD_ID_SHA1 &&
+	    ld->ld_build_id != LD_BUILD_ID_MD5)
+		return;
+
+	lo = ld->ld_output;
+	assert(lo != NULL);
+
+	is = ld_input_find_internal_section(ld, ".note.gnu.build-id");
+	assert(is != NULL);
+	if (is->is_discard || (os = is->is_output) == NULL ||
+	    os->os_type == SHT_NOBITS)
+		return;
+
+	mdsz = _digest_size(ld->ld_build_id);
+	off = os->os_off + is->is_reloff + _BUILD_ID_NOTE_HDR_SIZE;
+	assert(off + (off_t) mdsz <= size);
+
+	buf = mmap(NULL, size, PROT_READ, MAP_SHARED, lo->lo_fd, 0);
+	if (buf == MAP_FAILED)
+		ld_fatal_std(ld, "mmap output file");
+
+	_tree_hash(ld, buf, size, md);
+
+	(void) munmap(buf, size);
+
+	if (pwrite(lo->lo_fd, md, mdsz, off) != (ssize_t) mdsz)
+		ld_fatal_std(ld, "pwrite output file");
+}
+
+static void
+_tree_hash(struct ld *ld, const uint8_t *buf, size_t size, uint8_t *md)
+{
+	struct _build_id_job *jobs;
+	pthread_t *tids;
+	uint8_t *chunk_md;
+	size_t mdsz, nchunks;
+	long ncpu;
+	int i, nthreads;
+
+	mdsz = _digest_size(ld->ld_build_id);
+	nchunks = (size + _BUILD_ID_CHUNK_SIZE - 1) / _BUILD_ID_CHUNK_SIZE;
+	if (nchunks == 0)
+		nchunks = 1;
+
+	if ((chunk_md = malloc(nchunks * mdsz)) == NULL)
+		ld_fatal_std(ld, "malloc");
+
+	if ((ncpu = sysconf(_SC_NPROCESSORS_ONLN)) < 1)
+		ncpu = 1;
+	nthreads = ncpu > _BUILD_ID_MAX_THREADS ? _BUILD_ID_MAX_THREADS :
+	    (int) ncpu;
+	if ((size_t) nthreads > nchunks)
+		nthreads = (int) nchunks;
+
+	if ((jobs = calloc(nthreads, sizeof(*jobs))) == NULL ||
+	    (tids = calloc(nthreads, sizeof(*tids))) == NULL)
+		ld_fatal_std(ld, "calloc");
+
+	for (i = 0; i < nthreads; i++) {
+		jobs[i].bj_buf = buf;
+		jobs[i].bj_size = size;
+		jobs[i].bj_md = chunk_md;
+		jobs[i].bj_nchunks = nchunks;
+		jobs[i].bj_style = ld->ld_build_id;
+		jobs[i].bj_nthreads = nthreads;
+		jobs[i].bj_id = i;
+	}
+
+	/*
+	 * The calling thread hashes its own share of the chunks. If a
+	 * worker thread can not be created, its share is hashed by the
+	 * calling thread as well.
+	 */
+	for (i = 1; i < nthreads; i++) {
+		if (pthread_create(&tids[i], NULL, _hash_chunks,
+		    &jobs[i]) != 0)
+			jobs[i].bj_id = -1;
+	}
+	(void) _hash_chunks(&jobs[0]);
+	for (i = 1; i < nthreads; i++) {
+		if (jobs[i].bj_id < 0) {
+			jobs[i].bj_id = i;
+			(void) _hash_chunks(&jobs[i]);
+		} else
+			(void) pthread_join(tids[i], NULL);
+	}
+
+	_digest(ld->ld_build_id, chunk_md, nchunks * mdsz, md);
+
+	free(tids);
+	free(jobs);
+	free(chunk_md);
+}
+
+static void *
+_hash_chunks(void *arg)
+{
+	struct _build_id_job *bj;
+	size_t c, off, len, mdsz;
+
+	bj = arg;
+	mdsz = _digest_size(bj->bj_style);
+
+	for (c = bj->bj_id; c < bj->bj_nchunks; c += bj->bj_nthreads) {
+		off = c * _BUILD_ID_CHUNK_SIZE;
+		len = bj->bj_size - off;
+		if (len > _BUILD_ID_CHUNK_SIZE)
+			len = _BUILD_ID_CHUNK_SIZE;
+		_digest(bj->bj_style, bj->bj_buf + off, len,
+		    bj->bj_md + c * mdsz);
+	}
+
+	return (NULL);
+}
+
+static size_t
+_digest_size(unsigned char style)
+{
+
+	return (style == LD_BUILD_ID_MD5 ? 16 : 20);
+}
+
+/*
+ * Compute the SHA-1 or MD5 digest of a buffer.
+ */
+static void
+_digest(unsigned char style, const uint8_t *buf, size_t size, uint8_t *md)
+{
+	uint8_t tail[128];
+	uint64_t bits;
+	uint32_t h[5];
+	size_t i, n, rem;
+
+	if (style == LD_BUILD_ID_MD5) {
+		h[0] = 0x67452301;
+		h[1] = 0xefcdab89;
+		h[2] = 0x98badcfe;
+		h[3] = 0x10325476;
+	} else {
+		h[0] = 0x67452301;
+		h[1] = 0xefcdab89;
+		h[2] = 0x98badcfe;
+		h[3] = 0x10325476;
+		h[4] = 0xc3d2e1f0;
+	}
+
+	n = size / 64;
+	for (i = 0; i < n; i++) {
+		if (style == LD_BUILD_ID_MD5)
+			_md5_block(h, buf + i * 64);
+		else
+			_sha1_block(h, buf + i * 64);
+	}
+
+	/* Pad the last block(s) and append the message length in bits. */
+	rem = size % 64;
+	memset(tail, 0, sizeof(tail));
+	memcpy(tail, buf + n * 64, rem);
+	tail[rem] = 0x80;
+	n = rem < 56 ? 1 : 2;
+	bits = (uint64_t) size * 8;
+	for (i = 0; i < 8; i++) {
+		if (style == LD_BUILD_ID_MD5)
+			tail[n * 64 - 8 + i] = (uint8_t) (bits >> (i * 8));
+		else
+			tail[n * 64 - 1 - i] = (uint8_t) (bits >> (i * 8));
+	}
+	for (i = 0; i < n; i++) {
+		if (style == LD_BUILD_ID_MD5)
+			_md5_block(h, tail + i * 64);
+		else
+			_sha1_block(h, tail + i * 64);
+	}
+
+	/* MD5 digest is little-endian, SHA-1 digest is big-endian. */
+	if (style == LD_BUILD_ID_MD5) {
+		for (i = 0; i < 16; i++)
+			md[i] = (uint8_t) (h[i / 4] >> ((i % 4) * 8));
+	} else {
+		for (i = 0; i < 20; i++)
+			md[i] = (uint8_t) (h[i / 4] >> ((3 - i % 4) * 8));
+	}
+}
+
+#define	_ROTL32(x, n)	(((x) << (n)) | ((x) >> (32 - (n))))
+
+#define	_SHA1_ROUND(f, k)						\
+	do {								\
+		t = _ROTL32(a, 5) + (f) + e + (k) + w[i];		\
+		e = d;							\
+		d = c;							\
+		c = _ROTL32(b, 30);					\
+		b = a;							\
+		a = t;							\
+	} while (0)
+
+static void
+_sha1_block(uint32_t *h, const uint8_t *p)
+{
+	uint32_t w[80], a, b, c, d, e, t;
+	int i;
+
+	for (i = 0; i < 16; i++)
+		w[i] = ((uint32_t) p[i * 4] << 24) |
+		    ((uint32_t) p[i * 4 + 1] << 16) |
+		    ((uint32_t) p[i * 4 + 2] << 8) | p[i * 4 + 3];
+	for (i = 16; i < 80; i++)
+		w[i] = _ROTL32(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+	a = h[0];
+	b = h[1];
+	c = h[2];
+	d = h[3];
+	e = h[4];
+
+	for (i = 0; i < 20; i++)
+		_SHA1_ROUND(d ^ (b & (c ^ d)), 0x5a827999);
+	for (; i < 40; i++)
+		_SHA1_ROUND(b ^ c ^ d, 0x6ed9eba1);
+	for (; i < 60; i++)
+		_SHA1_ROUND((b & c) | (d & (b | c)), 0x8f1bbcdc);
+	for (; i < 80; i++)
+		_SHA1_ROUND(b ^ c ^ d, 0xca62c1d6);
+
+	h[0] += a;
+	h[1] += b;
+	h[2] += c;
+	h[3] += d;
+	h[4] += e;
+}
+
+static void
+_md5_block(uint32_t *h, const uint8_t *p)
+{
+	static const uint32_t k[64] = {
+		0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee,
+		0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+		0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be,
+		0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+		0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa,
+		0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+		0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed,
+		0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+		0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c,
+		0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+		0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05,
+		0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+		0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039,
+		0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+		0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1,
+		0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
+	};
+	static const int s[64] = {
+		7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+		5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20,
+		4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+		6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21
+	};
+	uint32_t m[16], a, b, c, d, f, t;
+	int g, i;
+
+	for (i = 0; i < 16; i++)
+		m[i] = p[i * 4] | ((uint32_t) p[i * 4 + 1] << 8) |
+		    ((uint32_t) p[i * 4 + 2] << 16) |
+		    ((uint32_t) p[i * 4 + 3] << 24);
+
+	a = h[0];
+	b = h[1];
+	c = h[2];
+	d = h[3];
+
+	for (i = 0; i < 64; i++) {
+		if (i < 16) {
+			f = (b & c) | (~b & d);
+			g = i;
+		} else if (i < 32) {
+			f = (d & b) | (~d & c);
+			g = (5 * i + 1) % 16;
+		} else if (i < 48) {
+			f = b ^ c ^ d;
+			g = (3 * i + 5) % 16;
+		} else {
+			f = c ^ (b | ~d);
+			g = (7 * i) % 16;
+		}
+		t = d;
+		d = c;
+		c = b;
+		b = b + _ROTL32(a + f + k[i] + m[g], s[i]);
+		a = t;
+	}
+
+	h[0] += a;
+	h[1] += b;
+	h[2] += c;
+	h[3] += d;
+}
@@ -73,8 +73,16 @@ ld_dynamic_create(struct ld *ld)
 	/* Create .dynsym and .dynstr sections. */
 	_create_dynsym_and_dynstr_section(ld, lo);
 
+	/*
+	 * Create .gnu.hash section. This must be done first since it
+	 * reorders the dynamic symbols.
+	 */
+	if (ld->ld_hash_style & LD_HASH_STYLE_GNU)
+		ld_hash_create_gnu_hash_section(ld);
+
 	/* Create .hash section. */
-	ld_hash_create_svr4_hash_section(ld);
+	if (ld->ld_hash_style & LD_HASH_STYLE_SYSV)
+		ld_hash_create_svr4_hash_section(ld);
 
 	/*
 	 * Create .gnu.version_d section if the linker creats a shared
@@ -315,9 +323,16 @@ _create_dynamic(struct ld *ld, struct ld_output *lo)
 		entries++;
 	}
 
-	/* DT_HASH, DT_STRTAB, DT_SYMTAB, DT_STRSZ and DT_SYMENT */
-	if (ld->ld_dynsym)
-		entries += 5;
+	/* DT_STRTAB, DT_SYMTAB, DT_STRSZ and DT_SYMENT */
+	if (ld->ld_dynsym) {
+		entries += 4;
+
+		/* DT_HASH and DT_GNU_HASH. */
+		if (ld->ld_hash_style & LD_HASH_STYLE_SYSV)
+			entries++;
+		if (ld->ld_hash_style & LD_HASH_STYLE_GNU)
+			entries++;
+	}
 
 	/* DT_RPATH. */
 	if (!STAILQ_EMPTY(&ld->ld_state.ls_rplist)) {
@@ -455,7 +470,11 @@ _finalize_dynamic(struct ld *ld, struct ld_output *lo)
 	if (lo->lo_hash != NULL)
 		DT_ENTRY_PTR(DT_HASH, lo->lo_hash->os_addr);
 
-	/* DT_HASH, DT_STRTAB, DT_SYMTAB, DT_STRSZ and DT_SYMENT */
+	/* DT_GNU_HASH */
+	if (lo->lo_gnu_hash != NULL)
+		DT_ENTRY_PTR(DT_GNU_HASH, lo->lo_gnu_hash->os_addr);
+
+	/* DT_STRTAB, DT_SYMTAB, DT_STRSZ and DT_SYMENT */
 	if (lo->lo_dynsym != NULL && lo->lo_dynstr != NULL) {
 		DT_ENTRY_PTR(DT_STRTAB, lo->lo_dynstr->os_addr);
 		DT_ENTRY_PTR(DT_SYMTAB, lo->lo_dynsym->os_addr);
@@ -43,6 +43,7 @@ ld_file_cleanup(struct ld *ld)
 {
 	struct ld_file *lf, *_lf;
 	struct ld_archive_member *lam, *_lam;
+	struct ld_archive_symbol *las, *_las;
 
 	TAILQ_FOREACH_SAFE(lf, &ld->ld_lflist, lf_next, _lf) {
 		TAILQ_REMOVE(&ld->ld_lflist, lf, lf_next);
@@ -53,6 +54,11 @@ ld_file_cleanup(struct ld *ld)
 				free(lam->lam_name);
 				free(lam);
 			}
+			HASH_ITER(hh, lf->lf_ar->la_as, las, _las) {
+				HASH_DEL(lf->lf_ar->la_as, las);
+				free(las->las_name);
+				free(las);
+			}
 			free(lf->lf_ar);
 		}
 		free(lf);
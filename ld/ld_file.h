@@ -42,8 +42,17 @@ struct ld_archive_member {
 	UT_hash_handle hh;		/* hash handle */
 };
 
+struct ld_archive_symbol {
+	char *las_name;			/* symbol name */
+	off_t las_off;			/* archive member offset */
+	UT_hash_handle hh;		/* hash handle */
+};
+
 struct ld_archive {
 	struct ld_archive_member *la_m;	/* extracted member list. */
+	struct ld_archive_symbol *la_as; /* archive symbol table */
+	struct ld_symbol *la_undef;	/* last undefined symbol searched */
+	unsigned la_as_loaded;		/* archive symbol table loaded */
 };
 
 struct ld_file {
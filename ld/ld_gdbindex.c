@@ -0,0 +1,841 @@
+/*-
+ * Copyright (c) 2026 The Elftoolchain Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <libdwarf.h>
+
+#include "ld.h"
+#include "ld_gdbindex.h"
+#include "ld_output.h"
+#include "ld_strtab.h"
+#include "ld_utils.h"
+
+ELFTC_VCSID("$Id$");
+
+/*
+ * Create a .gdb_index section for the output object.  The index is
+ * built from the relocated content of the output .debug_* sections and
+ * lets the debugger find CUs by address and symbol name without reading
+ * every CU at startup.
+ *
+ * All fields of the index are little-endian regardless of the byte
+ * order of the output object.
+ */
+
+#define	GDB_INDEX_VERSION	7
+#define	GDB_INDEX_HDR_SIZE	24
+#define	GDB_INDEX_MAX_CU	0xffffff
+
+/* Symbol kinds recorded in the CU vector entries. */
+#define	GDB_INDEX_KIND_TYPE	1
+#define	GDB_INDEX_KIND_VARIABLE	2
+#define	GDB_INDEX_KIND_FUNCTION	3
+
+struct ld_gdbindex_section {
+	const char *gs_name;		/* section name */
+	uint8_t *gs_buf;		/* section content */
+	uint64_t gs_size;		/* section size */
+};
+
+struct ld_gdbindex_cu {
+	uint64_t gc_off;		/* CU offset in .debug_info */
+	uint64_t gc_len;		/* CU length */
+};
+
+struct ld_gdbindex_addr {
+	uint64_t ga_lo;			/* low address */
+	uint64_t ga_hi;			/* high address (exclusive) */
+	uint32_t ga_cu;			/* CU index */
+};
+
+struct ld_gdbindex_sym {
+	char *gy_name;			/* qualified name */
+	uint32_t *gy_vec;		/* CU vector */
+	uint32_t gy_veclen;		/* CU vector length */
+	uint32_t gy_veccap;		/* CU vector capacity */
+	uint32_t gy_nameoff;		/* name offset in constant pool */
+	uint32_t gy_vecoff;		/* CU vector offset in constant pool */
+	UT_hash_handle hh;		/* hash handle */
+};
+
+struct ld_gdbindex_decl {
+	uint64_t gd_off;		/* DIE offset of the declaration */
+	char *gd_name;			/* qualified name */
+	int gd_kind;			/* symbol kind */
+	int gd_static;			/* not externally visible */
+	UT_hash_handle hh;		/* hash handle */
+};
+
+struct ld_gdbindex {
+	struct ld *gi_ld;		/* linker context */
+	struct ld_output *gi_lo;	/* output object */
+	struct ld_gdbindex_section *gi_sec; /* output debug sections */
+	Dwarf_Unsigned gi_seccnt;	/* number of debug sections */
+	struct ld_gdbindex_cu *gi_cu;	/* CU list */
+	uint32_t gi_cucnt;		/* number of CUs */
+	uint32_t gi_cucap;		/* capacity of CU list */
+	struct ld_gdbindex_addr *gi_addr; /* address area */
+	uint32_t gi_addrcnt;		/* number of address ranges */
+	uint32_t gi_addrcap;		/* capacity of address area */
+	struct ld_gdbindex_sym *gi_symtab; /* symbol table */
+	struct ld_gdbindex_decl *gi_decltab; /* member declarations */
+};
+
+static void _add_addr(struct ld_gdbindex *gi, uint64_t lo, uint64_t hi,
+    uint32_t cu);
+static void _add_decl(struct ld_gdbindex *gi, Dwarf_Die die, char *name,
+    int kind, int is_static);
+static void _add_symbol(struct ld_gdbindex *gi, const char *name,
+    uint32_t cu, int kind, int is_static);
+static void _cleanup(struct ld_gdbindex *gi);
+static void _collect_debug_sections(struct ld_gdbindex *gi);
+static int _get_ref(Dwarf_Die die, Dwarf_Half attr, Dwarf_Off *ref);
+static uint32_t _hash_name(const char *name);
+static char *_qualify(struct ld *ld, const char *prefix, const char *name);
+static void _scan_cu_ranges(struct ld_gdbindex *gi, Dwarf_Debug dbg,
+    Dwarf_Die die, uint32_t cu);
+static void _scan_die(struct ld_gdbindex *gi, Dwarf_Debug dbg, Dwarf_Die die,
+    const char *prefix, uint32_t cu, int cplus);
+static void _scan_die_list(struct ld_gdbindex *gi, Dwarf_Debug dbg,
+    Dwarf_Die parent, const char *prefix, uint32_t cu, int cplus);
+static void _write_index(struct ld_gdbindex *gi);
+
+static int
+_get_section_info(void *obj, Dwarf_Half ndx, Dwarf_Obj_Access_Section *ret,
+    int *error)
+{
+	struct ld_gdbindex *gi;
+
+	gi = obj;
+
+	if (ndx >= gi->gi_seccnt) {
+		if (error != NULL)
+			*error = DW_DLE_NO_ENTRY;
+		return (DW_DLV_NO_ENTRY);
+	}
+
+	ret->addr = 0;
+	ret->size = gi->gi_sec[ndx].gs_size;
+	ret->name = gi->gi_sec[ndx].gs_name;
+
+	return (DW_DLV_OK);
+}
+
+static Dwarf_Endianness
+_get_byte_order(void *obj)
+{
+	struct ld_gdbindex *gi;
+
+	gi = obj;
+
+	return (gi->gi_lo->lo_endian == ELFDATA2MSB ? DW_OBJECT_MSB :
+	    DW_OBJECT_LSB);
+}
+
+static Dwarf_Small
+_get_length_size(void *obj)
+{
+
+	(void) obj;
+
+	return (4);
+}
+
+static Dwarf_Small
+_get_pointer_size(void *obj)
+{
+	struct ld_gdbindex *gi;
+
+	gi = obj;
+
+	return (gi->gi_lo->lo_ec == ELFCLASS32 ? 4 : 8);
+}
+
+static Dwarf_Unsigned
+_get_section_count(void *obj)
+{
+	struct ld_gdbindex *gi;
+
+	gi = obj;
+
+	return (gi->gi_seccnt);
+}
+
+static int
+_load_section(void *obj, Dwarf_Half ndx, Dwarf_Small **ret_data, int *error)
+{
+	struct ld_gdbindex *gi;
+
+	gi = obj;
+
+	if (ndx >= gi->gi_seccnt) {
+		if (error != NULL)
+			*error = DW_DLE_NO_ENTRY;
+		return (DW_DLV_NO_ENTRY);
+	}
+
+	*ret_data = gi->gi_sec[ndx].gs_buf;
+
+	return (DW_DLV_OK);
+}
+
+static const Dwarf_Obj_Access_Methods _gdbindex_methods = {
+	_get_section_info,
+	_get_byte_order,
+	_get_length_size,
+	_get_pointer_size,
+	_get_section_count,
+	_load_section
+};
+
+void
+ld_gdbindex_create(struct ld *ld)
+{
+	struct ld_gdbindex gi;
+	Dwarf_Obj_Access_Interface iface;
+	Dwarf_Debug dbg;
+	Dwarf_Die die;
+	Dwarf_Unsigned lang;
+	Dwarf_Off off, len;
+	Dwarf_Error de;
+	Dwarf_Unsigned i;
+	int cplus, ret;
+
+	memset(&gi, 0, sizeof(gi));
+	gi.gi_ld = ld;
+	gi.gi_lo = ld->ld_output;
+
+	_collect_debug_sections(&gi);
+
+	/* Nothing to index if the output has no debugging information. */
+	for (i = 0; i < gi.gi_seccnt; i++)
+		if (strcmp(gi.gi_sec[i].gs_name, ".debug_info") == 0)
+			break;
+	if (i == gi.gi_seccnt) {
+		_cleanup(&gi);
+		return;
+	}
+
+	iface.object = &gi;
+	iface.methods = &_gdbindex_methods;
+	if (dwarf_object_init(&iface, NULL, NULL, &dbg, &de) != DW_DLV_OK) {
+		ld_warn(ld, "can not create .gdb_index: %s", dwarf_errmsg(de));
+		_cleanup(&gi);
+		return;
+	}
+
+	while ((ret = dwarf_next_cu_header_c(dbg, 1, NULL, NULL, NULL, NULL,
+	    NULL, NULL, NULL, NULL, NULL, &de)) == DW_DLV_OK) {
+		if (dwarf_siblingof(dbg, NULL, &die, &de) != DW_DLV_OK ||
+		    dwarf_die_CU_offset_range(die, &off, &len, &de) !=
+		    DW_DLV_OK) {
+			ret = DW_DLV_ERROR;
+			break;
+		}
+
+		if (gi.gi_cucnt == GDB_INDEX_MAX_CU) {
+			dwarf_dealloc(dbg, die, DW_DLA_DIE);
+			ld_warn(ld, "can not create .gdb_index: too many CUs");
+			goto done;
+		}
+
+		if (gi.gi_cucnt == gi.gi_cucap) {
+			gi.gi_cucap = gi.gi_cucap == 0 ? 64 : gi.gi_cucap * 2;
+			gi.gi_cu = realloc(gi.gi_cu, gi.gi_cucap *
+			    sizeof(*gi.gi_cu));
+			if (gi.gi_cu == NULL)
+				ld_fatal_std(ld, "realloc");
+		}
+		gi.gi_cu[gi.gi_cucnt].gc_off = off;
+		gi.gi_cu[gi.gi_cucnt].gc_len = len;
+
+		if (dwarf_srclang(die, &lang, &de) != DW_DLV_OK)
+			lang = 0;
+		cplus = (lang == DW_LANG_C_plus_plus ||
+		    lang == DW_LANG_C_plus_plus_03 ||
+		    lang == DW_LANG_C_plus_plus_11 ||
+		    lang == DW_LANG_C_plus_plus_14);
+
+		_scan_cu_ranges(&gi, dbg, die, gi.gi_cucnt);
+		_scan_die_list(&gi, dbg, die, NULL, gi.gi_cucnt, cplus);
+		dwarf_dealloc(dbg, die, DW_DLA_DIE);
+
+		gi.gi_cucnt++;
+	}
+
+	if (ret == DW_DLV_ERROR)
+		ld_warn(ld, "can not create .gdb_index: %s", dwarf_errmsg(de));
+	else
+		_write_index(&gi);
+
+done:
+	(void) dwarf_object_finish(dbg, &de);
+	_cleanup(&gi);
+}
+
+static void
+_collect_debug_sections(struct ld_gdbindex *gi)
+{
+	struct ld *ld;
+	struct ld_output_section *os;
+	struct ld_gdbindex_section *gs;
+	Elf_Data *d;
+
+	ld = gi->gi_ld;
+
+	STAILQ_FOREACH(os, &gi->gi_lo->lo_oslist, os_next) {
+		if (os->os_scn == NULL || os->os_type == SHT_NOBITS ||
+		    os->os_size == 0 || strncmp(os->os_name, ".debug_", 7) != 0)
+			continue;
+
+		gi->gi_sec = realloc(gi->gi_sec, (gi->gi_seccnt + 1) *
+		    sizeof(*gi->gi_sec));
+		if (gi->gi_sec == NULL)
+			ld_fatal_std(ld, "realloc");
+		gs = &gi->gi_sec[gi->gi_seccnt++];
+		gs->gs_name = os->os_name;
+		gs->gs_size = os->os_size;
+		if ((gs->gs_buf = calloc(1, os->os_size)) == NULL)
+			ld_fatal_std(ld, "calloc");
+
+		/*
+		 * The output section consists of one data descriptor per
+		 * input section, each placed at its offset in the section.
+		 */
+		d = NULL;
+		while ((d = elf_getdata(os->os_scn, d)) != NULL) {
+			if (d->d_buf == NULL || d->d_size == 0)
+				continue;
+			assert(d->d_off + d->d_size <= os->os_size);
+			memcpy(gs->gs_buf + d->d_off, d->d_buf, d->d_size);
+		}
+	}
+}
+
+static void
+_scan_cu_ranges(struct ld_gdbindex *gi, Dwarf_Debug dbg, Dwarf_Die die,
+    uint32_t cu)
+{
+	Dwarf_Ranges *ranges;
+	Dwarf_Addr base, lo, hi;
+	Dwarf_Half form;
+	Dwarf_Signed cnt, i;
+	Dwarf_Off off;
+	Dwarf_Error de;
+	enum Dwarf_Form_Class class;
+
+	if (dwarf_lowpc(die, &lo, &de) != DW_DLV_OK)
+		lo = 0;
+
+	if (dwarf_highpc_b(die, &hi, &form, &class, &de) == DW_DLV_OK) {
+		if (class == DW_FORM_CLASS_CONSTANT)
+			hi += lo;
+		_add_addr(gi, lo, hi, cu);
+		return;
+	}
+
+	if (!_get_ref(die, DW_AT_ranges, &off) ||
+	    dwarf_get_ranges_a(dbg, off, die, &ranges, &cnt, NULL, &de) !=
+	    DW_DLV_OK)
+		return;
+
+	/* Range list entries are relative to the CU base address. */
+	base = lo;
+	for (i = 0; i < cnt; i++) {
+		switch (ranges[i].dwr_type) {
+		case DW_RANGES_ENTRY:
+			_add_addr(gi, base + ranges[i].dwr_addr1,
+			    base + ranges[i].dwr_addr2, cu);
+			break;
+		case DW_RANGES_ADDRESS_SELECTION:
+			base = ranges[i].dwr_addr2;
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+static void
+_scan_die_list(struct ld_gdbindex *gi, Dwarf_Debug dbg, Dwarf_Die parent,
+    const char *prefix, uint32_t cu, int cplus)
+{
+	Dwarf_Die die, sib;
+	Dwarf_Error de;
+	int ret;
+
+	if (dwarf_child(parent, &die, &de) != DW_DLV_OK)
+		return;
+
+	for (;;) {
+		_scan_die(gi, dbg, die, prefix, cu, cplus);
+		ret = dwarf_siblingof(dbg, die, &sib, &de);
+		dwarf_dealloc(dbg, die, DW_DLA_DIE);
+		if (ret != DW_DLV_OK)
+			break;
+		die = sib;
+	}
+}
+
+static void
+_scan_die(struct ld_gdbindex *gi, Dwarf_Debug dbg, Dwarf_Die die,
+    const char *prefix, uint32_t cu, int cplus)
+{
+	struct ld_gdbindex_decl *gd;
+	Dwarf_Half tag;
+	Dwarf_Bool flag;
+	Dwarf_Off ref;
+	Dwarf_Error de;
+	char *name, *qname;
+	int decl, external, kind;
+
+	if (dwarf_tag(die, &tag, &de) != DW_DLV_OK)
+		return;
+
+	if (dwarf_diename(die, &name, &de) != DW_DLV_OK)
+		name = NULL;
+	decl = (dwarf_attrval_flag(die, DW_AT_declaration, &flag, &de) ==
+	    DW_DLV_OK && flag);
+	external = (dwarf_attrval_flag(die, DW_AT_external, &flag, &de) ==
+	    DW_DLV_OK && flag);
+
+	/*
+	 * Types and enumerators are static unless they come from a C++
+	 * CU, where the one definition rule makes them global.
+	 */
+	switch (tag) {
+	case DW_TAG_namespace:
+		qname = _qualify(gi->gi_ld, prefix, name != NULL ? name :
+		    "(anonymous namespace)");
+		_add_symbol(gi, qname, cu, GDB_INDEX_KIND_TYPE, 0);
+		_scan_die_list(gi, dbg, die, qname, cu, cplus);
+		free(qname);
+		break;
+
+	case DW_TAG_class_type:
+	case DW_TAG_structure_type:
+	case DW_TAG_union_type:
+		if (name == NULL)
+			break;
+		qname = _qualify(gi->gi_ld, prefix, name);
+		if (!decl)
+			_add_symbol(gi, qname, cu, GDB_INDEX_KIND_TYPE, !cplus);
+		/* Nested types and member declarations are scoped. */
+		if (cplus)
+			_scan_die_list(gi, dbg, die, qname, cu, cplus);
+		free(qname);
+		break;
+
+	case DW_TAG_enumeration_type:
+		qname = NULL;
+		if (name != NULL) {
+			qname = _qualify(gi->gi_ld, prefix, name);
+			if (!decl)
+				_add_symbol(gi, qname, cu, GDB_INDEX_KIND_TYPE,
+				    !cplus);
+		}
+		/* Enumerators of an unscoped enum live in the outer scope. */
+		if (qname != NULL && dwarf_attrval_flag(die, DW_AT_enum_class,
+		    &flag, &de) == DW_DLV_OK && flag)
+			_scan_die_list(gi, dbg, die, qname, cu, cplus);
+		else
+			_scan_die_list(gi, dbg, die, prefix, cu, cplus);
+		free(qname);
+		break;
+
+	case DW_TAG_enumerator:
+		if (name == NULL)
+			break;
+		qname = _qualify(gi->gi_ld, prefix, name);
+		_add_symbol(gi, qname, cu, GDB_INDEX_KIND_VARIABLE, !cplus);
+		free(qname);
+		break;
+
+	case DW_TAG_base_type:
+	case DW_TAG_typedef:
+		if (name == NULL || decl)
+			break;
+		qname = _qualify(gi->gi_ld, prefix, name);
+		_add_symbol(gi, qname, cu, GDB_INDEX_KIND_TYPE, !cplus);
+		free(qname);
+		break;
+
+	case DW_TAG_member:
+	case DW_TAG_subprogram:
+	case DW_TAG_variable:
+		kind = tag == DW_TAG_subprogram ? GDB_INDEX_KIND_FUNCTION :
+		    GDB_INDEX_KIND_VARIABLE;
+
+		/*
+		 * Declarations inside a namespace or a class are
+		 * remembered so that out-of-line definitions, which
+		 * refer to them by DW_AT_specification, can be indexed
+		 * by their qualified name.
+		 */
+		if (decl) {
+			if (name != NULL && prefix != NULL)
+				_add_decl(gi, die, _qualify(gi->gi_ld, prefix,
+				    name), kind, !external);
+			break;
+		}
+
+		if (tag == DW_TAG_member)
+			break;
+
+		if (name != NULL) {
+			qname = _qualify(gi->gi_ld, prefix, name);
+			_add_symbol(gi, qname, cu, kind, !external);
+			free(qname);
+		} else if (_get_ref(die, DW_AT_specification, &ref)) {
+			HASH_FIND(hh, gi->gi_decltab, &ref, sizeof(ref), gd);
+			if (gd != NULL)
+				_add_symbol(gi, gd->gd_name, cu, gd->gd_kind,
+				    gd->gd_static);
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+static int
+_get_ref(Dwarf_Die die, Dwarf_Half attr, Dwarf_Off *ref)
+{
+	Dwarf_Attribute at;
+	Dwarf_Error de;
+
+	if (dwarf_attr(die, attr, &at, &de) != DW_DLV_OK)
+		return (0);
+
+	return (dwarf_global_formref(at, ref, &de) == DW_DLV_OK);
+}
+
+static char *
+_qualify(struct ld *ld, const char *prefix, const char *name)
+{
+	char *s;
+	size_t len;
+
+	if (prefix == NULL) {
+		if ((s = strdup(name)) == NULL)
+			ld_fatal_std(ld, "strdup");
+		return (s);
+	}
+
+	len = strlen(prefix) + strlen(name) + 3;
+	if ((s = malloc(len)) == NULL)
+		ld_fatal_std(ld, "malloc");
+	snprintf(s, len, "%s::%s", prefix, name);
+
+	return (s);
+}
+
+static void
+_add_addr(struct ld_gdbindex *gi, uint64_t lo, uint64_t hi, uint32_t cu)
+{
+	struct ld *ld;
+	struct ld_gdbindex_addr *ga;
+
+	ld = gi->gi_ld;
+
+	if (lo >= hi)
+		return;
+
+	if (gi->gi_addrcnt == gi->gi_addrcap) {
+		gi->gi_addrcap = gi->gi_addrcap == 0 ? 64 :
+		    gi->gi_addrcap * 2;
+		gi->gi_addr = realloc(gi->gi_addr, gi->gi_addrcap *
+		    sizeof(*gi->gi_addr));
+		if (gi->gi_addr == NULL)
+			ld_fatal_std(ld, "realloc");
+	}
+
+	ga = &gi->gi_addr[gi->gi_addrcnt++];
+	ga->ga_lo = lo;
+	ga->ga_hi = hi;
+	ga->ga_cu = cu;
+}
+
+static void
+_add_decl(struct ld_gdbindex *gi, Dwarf_Die die, char *name, int kind,
+    int is_static)
+{
+	struct ld *ld;
+	struct ld_gdbindex_decl *gd;
+	Dwarf_Off off;
+	Dwarf_Error de;
+
+	ld = gi->gi_ld;
+
+	if (dwarf_dieoffset(die, &off, &de) != DW_DLV_OK) {
+		free(name);
+		return;
+	}
+
+	HASH_FIND(hh, gi->gi_decltab, &off, sizeof(off), gd);
+	if (gd != NULL) {
+		free(name);
+		return;
+	}
+
+	if ((gd = calloc(1, sizeof(*gd))) == NULL)
+		ld_fatal_std(ld, "calloc");
+	gd->gd_off = off;
+	gd->gd_name = name;
+	gd->gd_kind = kind;
+	gd->gd_static = is_static;
+	HASH_ADD(hh, gi->gi_decltab, gd_off, sizeof(gd->gd_off), gd);
+}
+
+static void
+_add_symbol(struct ld_gdbindex *gi, const char *name, uint32_t cu, int kind,
+    int is_static)
+{
+	struct ld *ld;
+	struct ld_gdbindex_sym *gy;
+	uint32_t i, v;
+
+	ld = gi->gi_ld;
+
+	v = cu | ((uint32_t) kind << 28) | ((uint32_t) is_static << 31);
+
+	HASH_FIND(hh, gi->gi_symtab, (void *) (uintptr_t) name, strlen(name),
+	    gy);
+	if (gy == NULL) {
+		if ((gy = calloc(1, sizeof(*gy))) == NULL)
+			ld_fatal_std(ld, "calloc");
+		if ((gy->gy_name = strdup(name)) == NULL)
+			ld_fatal_std(ld, "strdup");
+		HASH_ADD_KEYPTR(hh, gi->gi_symtab, gy->gy_name,
+		    strlen(gy->gy_name), gy);
+	}
+
+	for (i = 0; i < gy->gy_veclen; i++)
+		if (gy->gy_vec[i] == v)
+			return;
+
+	if (gy->gy_veclen == gy->gy_veccap) {
+		gy->gy_veccap = gy->gy_veccap == 0 ? 4 : gy->gy_veccap * 2;
+		gy->gy_vec = realloc(gy->gy_vec, gy->gy_veccap *
+		    sizeof(*gy->gy_vec));
+		if (gy->gy_vec == NULL)
+			ld_fatal_std(ld, "realloc");
+	}
+	gy->gy_vec[gy->gy_veclen++] = v;
+}
+
+/*
+ * The symbol hash function used by the debugger for index version 5
+ * and later: names are hashed case-insensitively.
+ */
+static uint32_t
+_hash_name(const char *name)
+{
+	const unsigned char *s;
+	uint32_t c, h;
+
+	h = 0;
+	for (s = (const unsigned char *) name; *s != '\0'; s++) {
+		c = *s;
+		if (c >= 'A' && c <= 'Z')
+			c += 'a' - 'A';
+		h = h * 67 + c - 113;
+	}
+
+	return (h);
+}
+
+static void
+_write_index(struct ld_gdbindex *gi)
+{
+	struct ld *ld;
+	struct ld_state *ls;
+	struct ld_output *lo;
+	struct ld_gdbindex_sym *gy, *_gy;
+	struct ld_gdbindex_sym **slot;
+	Elf_Scn *scn;
+	Elf_Data *d;
+	GElf_Shdr sh;
+	uint64_t cu_off, tu_off, addr_off, sym_off, pool_off, pool_size, size;
+	uint32_t h, i, j, nsym, tabsize, step;
+	uint8_t *buf, *p;
+
+	ld = gi->gi_ld;
+	ls = &ld->ld_state;
+	lo = gi->gi_lo;
+
+	/*
+	 * The symbol table is an open-addressing hash table whose size
+	 * is a power of 2 and kept at most 3/4 full.
+	 */
+	nsym = HASH_COUNT(gi->gi_symtab);
+	tabsize = 1024;
+	while (nsym * 4 > tabsize * 3)
+		tabsize *= 2;
+
+	/*
+	 * Lay out the constant pool: all CU vectors, followed by the
+	 * symbol names.
+	 */
+	pool_size = 0;
+	HASH_ITER(hh, gi->gi_symtab, gy, _gy) {
+		gy->gy_vecoff = pool_size;
+		pool_size += 4 * (gy->gy_veclen + 1);
+	}
+	HASH_ITER(hh, gi->gi_symtab, gy, _gy) {
+		gy->gy_nameoff = pool_size;
+		pool_size += strlen(gy->gy_name) + 1;
+	}
+
+	cu_off = GDB_INDEX_HDR_SIZE;
+	tu_off = cu_off + 16 * (uint64_t) gi->gi_cucnt;
+	addr_off = tu_off;
+	sym_off = addr_off + 20 * (uint64_t) gi->gi_addrcnt;
+	pool_off = sym_off + 8 * (uint64_t) tabsize;
+	size = pool_off + pool_size;
+
+	if (size > UINT32_MAX) {
+		ld_warn(ld, "can not create .gdb_index: index too large");
+		return;
+	}
+
+	if ((buf = calloc(1, size)) == NULL)
+		ld_fatal_std(ld, "calloc");
+
+	/* Header. */
+	p = buf;
+	WRITE_32LE(p, GDB_INDEX_VERSION);
+	WRITE_32LE(p + 4, cu_off);
+	WRITE_32LE(p + 8, tu_off);
+	WRITE_32LE(p + 12, addr_off);
+	WRITE_32LE(p + 16, sym_off);
+	WRITE_32LE(p + 20, pool_off);
+
+	/* CU list. */
+	p = buf + cu_off;
+	for (i = 0; i < gi->gi_cucnt; i++, p += 16) {
+		WRITE_64LE(p, gi->gi_cu[i].gc_off);
+		WRITE_64LE(p + 8, gi->gi_cu[i].gc_len);
+	}
+
+	/* Address area. */
+	p = buf + addr_off;
+	for (i = 0; i < gi->gi_addrcnt; i++, p += 20) {
+		WRITE_64LE(p, gi->gi_addr[i].ga_lo);
+		WRITE_64LE(p + 8, gi->gi_addr[i].ga_hi);
+		WRITE_32LE(p + 16, gi->gi_addr[i].ga_cu);
+	}
+
+	/* Symbol table. */
+	if ((slot = calloc(tabsize, sizeof(*slot))) == NULL)
+		ld_fatal_std(ld, "calloc");
+	HASH_ITER(hh, gi->gi_symtab, gy, _gy) {
+		h = _hash_name(gy->gy_name);
+		j = h & (tabsize - 1);
+		step = ((h * 17) & (tabsize - 1)) | 1;
+		while (slot[j] != NULL)
+			j = (j + step) & (tabsize - 1);
+		slot[j] = gy;
+	}
+	p = buf + sym_off;
+	for (j = 0; j < tabsize; j++, p += 8) {
+		if (slot[j] == NULL)
+			continue;
+		WRITE_32LE(p, slot[j]->gy_nameoff);
+		WRITE_32LE(p + 4, slot[j]->gy_vecoff);
+	}
+	free(slot);
+
+	/* Constant pool. */
+	HASH_ITER(hh, gi->gi_symtab, gy, _gy) {
+		p = buf + pool_off + gy->gy_vecoff;
+		WRITE_32LE(p, gy->gy_veclen);
+		for (i = 0; i < gy->gy_veclen; i++)
+			WRITE_32LE(p + 4 * (i + 1), gy->gy_vec[i]);
+		memcpy(buf + pool_off + gy->gy_nameoff, gy->gy_name,
+		    strlen(gy->gy_name) + 1);
+	}
+
+	/*
+	 * Create the section at the end of the output object.  The slot
+	 * for its section header was reserved during layout.
+	 */
+	if ((scn = elf_newscn(lo->lo_elf)) == NULL)
+		ld_fatal(ld, "elf_newscn failed: %s", elf_errmsg(-1));
+
+	if (gelf_getshdr(scn, &sh) == NULL)
+		ld_fatal(ld, "gelf_getshdr failed: %s", elf_errmsg(-1));
+
+	sh.sh_name = ld_strtab_lookup(ld->ld_shstrtab, ".gdb_index");
+	sh.sh_flags = 0;
+	sh.sh_addr = 0;
+	sh.sh_addralign = 4;
+	sh.sh_offset = roundup(ls->ls_offset, sh.sh_addralign);
+	sh.sh_size = size;
+	sh.sh_type = SHT_PROGBITS;
+
+	if (!gelf_update_shdr(scn, &sh))
+		ld_fatal(ld, "gelf_update_shdr failed: %s", elf_errmsg(-1));
+
+	if ((d = elf_newdata(scn)) == NULL)
+		ld_fatal(ld, "elf_newdata failed: %s", elf_errmsg(-1));
+
+	d->d_align = sh.sh_addralign;
+	d->d_off = 0;
+	d->d_type = ELF_T_BYTE;
+	d->d_size = size;
+	d->d_version = EV_CURRENT;
+	d->d_buf = buf;
+
+	ls->ls_offset = sh.sh_offset + sh.sh_size;
+}
+
+static void
+_cleanup(struct ld_gdbindex *gi)
+{
+	struct ld_gdbindex_sym *gy, *_gy;
+	struct ld_gdbindex_decl *gd, *_gd;
+	Dwarf_Unsigned i;
+
+	for (i = 0; i < gi->gi_seccnt; i++)
+		free(gi->gi_sec[i].gs_buf);
+	free(gi->gi_sec);
+	free(gi->gi_cu);
+	free(gi->gi_addr);
+
+	HASH_ITER(hh, gi->gi_symtab, gy, _gy) {
+		HASH_DEL(gi->gi_symtab, gy);
+		free(gy->gy_name);
+		free(gy->gy_vec);
+		free(gy);
+	}
+
+	HASH_ITER(hh, gi->gi_decltab, gd, _gd) {
+		HASH_DEL(gi->gi_decltab, gd);
+		free(gd->gd_name);
+		free(gd);
+	}
+}
@@ -29,6 +29,7 @@
 #include "ld_layout.h"
 #include "ld_output.h"
 #include "ld_symbols.h"
+#include "ld_utils.h"
 
 ELFTC_VCSID("$Id$");
 
@@ -45,12 +46,197 @@ static unsigned hash_buckets[] = {
 	16411, 32771, 65537, 131101, 262147
 };
 
+/*
+ * Bloom filter shift count used by .gnu.hash section.
+ */
+#define	_GNU_HASH_SHIFT2	26
+
+struct _gnu_hash_entry {
+	struct ld_symbol *ghe_lsb;	/* dynamic symbol */
+	uint32_t ghe_hash;		/* GNU hash value */
+	uint32_t ghe_bucket;		/* bucket index */
+	uint64_t ghe_index;		/* original dynamic symbol index */
+};
+
+static void _add_data_buffer(struct ld *ld, struct ld_output_section *os,
+    void *buf, size_t size, uint64_t align, Elf_Type type);
+static int _cmp_gnu_hash_entry(const void *a, const void *b);
+static uint32_t _gnu_hash(const char *name);
+static uint32_t _hash_nbuckets(uint32_t nsyms);
+static int _is_gnu_hashed(struct ld_symbol *lsb);
+
+void
+ld_hash_create_gnu_hash_section(struct ld *ld)
+{
+	struct ld_output *lo;
+	struct ld_output_section *os;
+	struct ld_symbol *lsb;
+	struct _gnu_hash_entry *ghe, *hashed;
+	char hash_name[] = ".gnu.hash";
+	uint8_t *buf, *p;
+	uint32_t *buckets, *chains;
+	uint32_t nbuckets, nhashed, nsyms, symoffset, maskwords, h;
+	uint64_t *bloom;
+	unsigned wordbits;
+	uint64_t i, j, word;
+	size_t size;
+
+	lo = ld->ld_output;
+	assert(lo != NULL);
+
+	HASH_FIND_STR(lo->lo_ostbl, hash_name, os);
+	if (os == NULL)
+		os = ld_layout_insert_output_section(ld, hash_name, SHF_ALLOC);
+	os->os_type = SHT_GNU_HASH;
+	os->os_flags = SHF_ALLOC;
+	if (lo->lo_ec == ELFCLASS32) {
+		os->os_entsize = 4;
+		os->os_align = 4;
+		wordbits = 32;
+	} else {
+		os->os_entsize = 0;
+		os->os_align = 8;
+		wordbits = 64;
+	}
+
+	if ((os->os_link = strdup(".dynsym")) == NULL)
+		ld_fatal_std(ld, "strdup");
+
+	lo->lo_gnu_hash = os;
+
+	assert(ld->ld_dynsym != NULL && ld->ld_dynsym->sy_size > 0);
+	assert(ld->ld_dyn_symbols != NULL);
+
+	/*
+	 * The runtime linker only searches the dynamic symbols at or
+	 * after `symoffset', and it expects the symbols in the same
+	 * bucket to be contiguous. Move the undefined symbols to the
+	 * front of the dynamic symbol table, and sort the rest of the
+	 * symbols by bucket, keeping the original order otherwise.
+	 */
+	nsyms = ld->ld_dynsym->sy_size - 1;
+	if ((ghe = calloc(nsyms, sizeof(*ghe))) == NULL)
+		ld_fatal_std(ld, "calloc");
+
+	i = 0;
+	STAILQ_FOREACH(lsb, ld->ld_dyn_symbols, lsb_dyn) {
+		if (!_is_gnu_hashed(lsb))
+			ghe[i++].ghe_lsb = lsb;
+	}
+	symoffset = i + 1;
+	nhashed = nsyms - i;
+	hashed = &ghe[i];
+	nbuckets = _hash_nbuckets(nhashed);
+
+	STAILQ_FOREACH(lsb, ld->ld_dyn_symbols, lsb_dyn) {
+		if (!_is_gnu_hashed(lsb))
+			continue;
+		assert(i < nsyms);
+		ghe[i].ghe_lsb = lsb;
+		ghe[i].ghe_hash = _gnu_hash(lsb->lsb_name);
+		ghe[i].ghe_bucket = ghe[i].ghe_hash % nbuckets;
+		ghe[i].ghe_index = lsb->lsb_dyn_index;
+		i++;
+	}
+	assert(i == nsyms);
+
+	qsort(hashed, nhashed, sizeof(*hashed), _cmp_gnu_hash_entry);
+
+	STAILQ_INIT(ld->ld_dyn_symbols);
+	for (i = 0; i < nsyms; i++) {
+		lsb = ghe[i].ghe_lsb;
+		STAILQ_INSERT_TAIL(ld->ld_dyn_symbols, lsb, lsb_dyn);
+		lsb->lsb_dyn_index = i + 1;
+	}
+
+	/*
+	 * Size the Bloom filter to roughly 12 bits per hashed symbol,
+	 * rounded up to a power of 2 number of words.
+	 */
+	maskwords = 1;
+	while (maskwords * wordbits < nhashed * 12)
+		maskwords <<= 1;
+
+	if ((bloom = calloc(maskwords, sizeof(*bloom))) == NULL)
+		ld_fatal_std(ld, "calloc");
+	if ((buckets = calloc(nbuckets, sizeof(*buckets))) == NULL)
+		ld_fatal_std(ld, "calloc");
+	if ((chains = calloc(nhashed + 1, sizeof(*chains))) == NULL)
+		ld_fatal_std(ld, "calloc");
+
+	for (i = 0; i < nhashed; i++) {
+		h = hashed[i].ghe_hash;
+		word = (h / wordbits) & (maskwords - 1);
+		bloom[word] |= (1ULL << (h % wordbits)) |
+		    (1ULL << ((h >> _GNU_HASH_SHIFT2) % wordbits));
+
+		j = hashed[i].ghe_bucket;
+		if (buckets[j] == 0)
+			buckets[j] = symoffset + i;
+
+		/* The lowest bit marks the end of a bucket chain. */
+		chains[i] = h & ~1U;
+		if (i == nhashed - 1 || hashed[i + 1].ghe_bucket != j)
+			chains[i] |= 1;
+	}
+
+	free(ghe);
+
+	/*
+	 * The Bloom filter words are 32 or 64 bits wide depending on the
+	 * ELF class, so the section can not be described by a single
+	 * libelf data type. Build the whole section in the byte order of
+	 * the output object instead.
+	 */
+	size = 4 * sizeof(uint32_t) + maskwords * (wordbits / 8) +
+	    (nbuckets + nhashed) * sizeof(uint32_t);
+	if ((buf = malloc(size)) == NULL)
+		ld_fatal_std(ld, "malloc");
+
+	/* Header: nbuckets, symoffset, bloom_size and bloom_shift. */
+	p = buf;
+	WRITE_32(p, nbuckets);
+	p += 4;
+	WRITE_32(p, symoffset);
+	p += 4;
+	WRITE_32(p, maskwords);
+	p += 4;
+	WRITE_32(p, _GNU_HASH_SHIFT2);
+	p += 4;
+
+	for (i = 0; i < maskwords; i++) {
+		if (wordbits == 32) {
+			WRITE_32(p, bloom[i]);
+			p += 4;
+		} else {
+			WRITE_64(p, bloom[i]);
+			p += 8;
+		}
+	}
+
+	for (i = 0; i < nbuckets; i++) {
+		WRITE_32(p, buckets[i]);
+		p += 4;
+	}
+
+	for (i = 0; i < nhashed; i++) {
+		WRITE_32(p, chains[i]);
+		p += 4;
+	}
+	assert((size_t) (p - buf) == size);
+
+	free(bloom);
+	free(buckets);
+	free(chains);
+
+	_add_data_buffer(ld, os, buf, size, os->os_align, ELF_T_BYTE);
+}
+
 void
 ld_hash_create_svr4_hash_section(struct ld *ld)
 {
 	struct ld_output *lo;
 	struct ld_output_section *os;
-	struct ld_output_data_buffer *odb;
 	struct ld_symbol *lsb;
 	char hash_name[] = ".hash";
 	uint32_t *buf, *buckets, *chains, nbuckets, nchains;
@@ -78,17 +264,7 @@ ld_hash_create_svr4_hash_section(struct ld *ld)
 	assert(ld->ld_dynsym != NULL && ld->ld_dynsym->sy_size > 0);
 
 	nchains = ld->ld_dynsym->sy_size;
-	nbuckets = 0;
-	for (i = 1;
-	    (size_t) i < sizeof(hash_buckets) / sizeof(hash_buckets[0]);
-	    i++) {
-		if (nchains < hash_buckets[i]) {
-			nbuckets = hash_buckets[i - 1];
-			break;
-		}
-	}
-	if (nbuckets == 0)
-		nbuckets = hash_buckets[i - 1];
+	nbuckets = _hash_nbuckets(nchains);
 
 	if ((buf = calloc(nbuckets + nchains + 2, sizeof(uint32_t))) == NULL)
 		ld_fatal_std(ld, "calloc");
@@ -113,14 +289,82 @@ ld_hash_create_svr4_hash_section(struct ld *ld)
 		i++;
 	}
 
+	_add_data_buffer(ld, os, buf, (nbuckets + nchains + 2) *
+	    sizeof(uint32_t), os->os_align, ELF_T_WORD);
+}
+
+static void
+_add_data_buffer(struct ld *ld, struct ld_output_section *os, void *buf,
+    size_t size, uint64_t align, Elf_Type type)
+{
+	struct ld_output_data_buffer *odb;
+
 	if ((odb = calloc(1, sizeof(*odb))) == NULL)
 		ld_fatal_std(ld, "calloc");
 
-	odb->odb_buf = (void *) buf;
-	odb->odb_size = (nbuckets + nchains + 2) * sizeof(uint32_t);
-	odb->odb_align = os->os_align;
-	odb->odb_type = ELF_T_WORD; /* enable libelf translation */
+	odb->odb_buf = buf;
+	odb->odb_size = size;
+	odb->odb_align = align;
+	odb->odb_type = type; /* enable libelf translation */
 
 	(void) ld_output_create_section_element(ld, os, OET_DATA_BUFFER,
 	    odb, NULL);
 }
+
+static int
+_cmp_gnu_hash_entry(const void *a, const void *b)
+{
+	const struct _gnu_hash_entry *ga, *gb;
+
+	ga = a;
+	gb = b;
+
+	if (ga->ghe_bucket != gb->ghe_bucket)
+		return (ga->ghe_bucket < gb->ghe_bucket ? -1 : 1);
+
+	if (ga->ghe_index != gb->ghe_index)
+		return (ga->ghe_index < gb->ghe_index ? -1 : 1);
+
+	return (0);
+}
+
+static uint32_t
+_gnu_hash(const char *name)
+{
+	const unsigned char *p;
+	uint32_t h;
+
+	h = 5381;
+	for (p = (const unsigned char *) name; *p != '\0'; p++)
+		h = (h << 5) + h + *p;
+
+	return (h);
+}
+
+static uint32_t
+_hash_nbuckets(uint32_t nsyms)
+{
+	size_t i;
+
+	for (i = 1; i < sizeof(hash_buckets) / sizeof(hash_buckets[0]); i++) {
+		if (nsyms < hash_buckets[i])
+			return (hash_buckets[i - 1]);
+	}
+
+	return (hash_buckets[i - 1]);
+}
+
+/*
+ * Check if a dynamic symbol should be put in the .gnu.hash section.
+ * Undefined symbols (including the symbols imported from DSOs) are
+ * never looked up by the runtime linker.
+ */
+static int
+_is_gnu_hashed(struct ld_symbol *lsb)
+{
+
+	if (lsb->lsb_name == NULL || lsb->lsb_import)
+		return (0);
+
+	return (lsb->lsb_shndx != SHN_UNDEF && lsb->lsb_bind != STB_LOCAL);
+}
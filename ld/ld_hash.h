@@ -26,4 +26,5 @@
  * $Id$
  */
 
+void	ld_hash_create_gnu_hash_section(struct ld *);
 void	ld_hash_create_svr4_hash_section(struct ld *);
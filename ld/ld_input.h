@@ -55,6 +55,7 @@ struct ld_input_section {
 	unsigned char is_pltrel;	/* section holds PLT relocations */
 	unsigned char is_refed;		/* should not be gc'ed */
 	unsigned char is_need_reloc;	/* need apply relocation */
+	unsigned char is_ignore_next_plt; /* ignore next PLT relocation */
 	void *is_data;			/* output section data descriptor */
 	void *is_ibuf;			/* buffer for internal sections */
 	void *is_ehframe;		/* temp buffer for ehframe section. */
@@ -1054,6 +1054,10 @@ _calc_offset(struct ld *ld)
 	if (ld->ld_gen_gnustack && ld->ld_reloc)
 		ld_output_emit_gnu_stack_section(ld);
 
+	/* Reserve the name of the .gdb_index section. */
+	if (ld->ld_gdb_index && !ld->ld_reloc)
+		ld_strtab_insert(ld, ld->ld_shstrtab, ".gdb_index");
+
 	/* Lay out section header table after normal input sections. */
 	_calc_shdr_offset(ld);
 
@@ -1248,7 +1252,13 @@ _calc_shdr_offset(struct ld *ld)
 	}
 
 	/* TODO: n + 2 if ld(1) will not create symbol table. */
-	ls->ls_offset += gelf_fsize(lo->lo_elf, ELF_T_SHDR, n + 4, EV_CURRENT);
+	n += 4;
+
+	/* One more for the .gdb_index section. */
+	if (ld->ld_gdb_index && !ld->ld_reloc)
+		n++;
+
+	ls->ls_offset += gelf_fsize(lo->lo_elf, ELF_T_SHDR, n, EV_CURRENT);
 
 	lo->lo_shoff = shoff;
 }
@@ -26,6 +26,7 @@
 
 #include "ld.h"
 #include "ld_arch.h"
+#include "ld_buildid.h"
 #include "ld_ehframe.h"
 #include "ld_options.h"
 #include "ld_reloc.h"
@@ -91,6 +92,9 @@ restart:
 	/* The linker generate an executable by default */
 	ld->ld_exec = 1;
 
+	/* Only SysV style .hash section is generated by default. */
+	ld->ld_hash_style = LD_HASH_STYLE_SYSV;
+
 	ld_script_init(ld);
 
 	ld_options_parse(ld, argc, argv);
@@ -133,6 +137,10 @@ restart:
 	if (ld->ld_ehframe_hdr)
 		ld_ehframe_create_hdr(ld);
 
+	/* Create .note.gnu.build-id section. */
+	if (ld->ld_build_id != LD_BUILD_ID_NONE && !ld->ld_reloc)
+		ld_buildid_create(ld);
+
 	ld_output_init(ld);
 
 	ld_layout_sections(ld);
@@ -24,7 +24,10 @@
  * SUCH DAMAGE.
  */
 
+#include <limits.h>
+
 #include "ld.h"
+#include "ld_buildid.h"
 #include "ld_file.h"
 #include "ld_path.h"
 #include "ld_script.h"
@@ -78,6 +81,7 @@ static struct ld_option ld_opts[] = {
 	{"fini", KEY_FINI, ANY_DASH, NO_ARG},
 	{"format", 'b', ANY_DASH, REQ_ARG},
 	{"gc-sections", KEY_GC_SECTIONS, ANY_DASH, NO_ARG},
+	{"gdb-index", KEY_GDB_INDEX, ANY_DASH, NO_ARG},
 	{"hash-style", KEY_HASH_STYLE, ANY_DASH, REQ_ARG},
 	{"help", KEY_HELP, ANY_DASH, NO_ARG},
 	{"init", KEY_INIT, ANY_DASH, REQ_ARG},
@@ -128,6 +132,7 @@ static struct ld_option ld_opts[] = {
 	{"static", KEY_STATIC, ONE_DASH, NO_ARG},
 	{"strip-all", 's', ANY_DASH, NO_ARG},
 	{"strip-debug", 'S', ANY_DASH, NO_ARG},
+	{"threads", KEY_THREADS, ANY_DASH, REQ_ARG},
 	{"trace", 't', ANY_DASH, NO_ARG},
 	{"trace_symbol", 'y', ANY_DASH, NO_ARG},
 	{"traditional-format", KEY_TRADITIONAL_FORMAT, ANY_DASH, NO_ARG},
@@ -330,6 +335,8 @@ static void
 _process_options(struct ld *ld, int key, char *arg)
 {
 	struct ld_state *ls;
+	char *end;
+	unsigned long n;
 
 	assert(ld != NULL);
 	ls = &ld->ld_state;
@@ -391,6 +398,9 @@ _process_options(struct ld *ld, int key, char *arg)
 	case KEY_AS_NEEDED:
 		ls->ls_as_needed = 1;
 		break;
+	case KEY_BUILD_ID:
+		ld_buildid_set_style(ld, arg);
+		break;
 	case KEY_DYNAMIC:
 		ls->ls_static = 0;
 		break;
@@ -400,6 +410,20 @@ _process_options(struct ld *ld, int key, char *arg)
 	case KEY_GC_SECTIONS:
 		ld->ld_gc = 1;
 		break;
+	case KEY_GDB_INDEX:
+		ld->ld_gdb_index = 1;
+		break;
+	case KEY_HASH_STYLE:
+		if (!strcmp(arg, "sysv"))
+			ld->ld_hash_style = LD_HASH_STYLE_SYSV;
+		else if (!strcmp(arg, "gnu"))
+			ld->ld_hash_style = LD_HASH_STYLE_GNU;
+		else if (!strcmp(arg, "both"))
+			ld->ld_hash_style = LD_HASH_STYLE_SYSV |
+			    LD_HASH_STYLE_GNU;
+		else
+			ld_fatal(ld, "invalid hash style `%s'", arg);
+		break;
 	case KEY_NO_AS_NEEDED:
 		ls->ls_as_needed = 0;
 		break;
@@ -440,6 +464,14 @@ _process_options(struct ld *ld, int key, char *arg)
 	case KEY_STATIC:
 		ls->ls_static = 1;
 		break;
+	case KEY_THREADS:
+		errno = 0;
+		n = strtoul(arg, &end, 10);
+		if (*arg == '\0' || *end != '\0' || errno != 0 || n == 0 ||
+		    n > UINT_MAX)
+			ld_fatal(ld, "invalid thread count `%s'", arg);
+		ld->ld_threads = (unsigned) n;
+		break;
 	case KEY_WHOLE_ARCHIVE:
 		ls->ls_whole_archive = 1;
 		break;
@@ -58,6 +58,7 @@ enum ld_key {
 	KEY_FATAL_WARNINGS,
 	KEY_FINI,
 	KEY_GC_SECTIONS,
+	KEY_GDB_INDEX,
 	KEY_GROUP,
 	KEY_HASH_STYLE,
 	KEY_HELP,
@@ -98,6 +99,7 @@ enum ld_key {
 	KEY_SYMBOLIC_FUNC,
 	KEY_TBSS,
 	KEY_TDATA,
+	KEY_THREADS,
 	KEY_TTEXT,
 	KEY_TRADITIONAL_FORMAT,
 	KEY_UNRESOLVED_SYMBOLS,
@@ -26,8 +26,10 @@
 
 #include "ld.h"
 #include "ld_arch.h"
+#include "ld_buildid.h"
 #include "ld_dynamic.h"
 #include "ld_ehframe.h"
+#include "ld_gdbindex.h"
 #include "ld_input.h"
 #include "ld_output.h"
 #include "ld_layout.h"
@@ -35,6 +37,7 @@
 #include "ld_script.h"
 #include "ld_strtab.h"
 #include "ld_symbols.h"
+#include "ld_thread.h"
 
 ELFTC_VCSID("$Id$");
 
@@ -59,6 +62,7 @@ static void _produce_reloc_sections(struct ld *ld, struct ld_output *lo);
 static void _join_and_finalize_dynamic_reloc_sections(struct ld *ld,
     struct ld_output *lo);
 static void _join_normal_reloc_sections(struct ld *ld, struct ld_output *lo);
+static void _reloc_input_section(struct ld *ld, void *arg, size_t i);
 static void _update_section_header(struct ld *ld);
 
 void
@@ -96,7 +100,7 @@ ld_output_init(struct ld *ld)
 	else
 		fn = ld->ld_output_file;
 
-	lo->lo_fd = open(fn, O_WRONLY | O_CREAT, S_IRWXU | S_IRWXG | S_IRWXO);
+	lo->lo_fd = open(fn, O_RDWR | O_CREAT, S_IRWXU | S_IRWXG | S_IRWXO);
 	if (lo->lo_fd < 0)
 		ld_fatal_std(ld, "can not create output file: open %s", fn);
 
@@ -429,10 +433,22 @@ static void
 _copy_and_reloc_input_sections(struct ld *ld)
 {
 	struct ld_input *li;
-	struct ld_input_section *is;
+	struct ld_input_section *is, **work;
 	Elf_Data *d;
+	size_t nwork, cap;
 	int i;
 
+	work = NULL;
+	nwork = cap = 0;
+
+	/*
+	 * Input objects are loaded one at a time, so the section data is
+	 * copied serially. The relocations are applied afterwards by a
+	 * pool of worker threads: every input section is relocated into
+	 * its own data buffer, and the relocation records of different
+	 * sections are disjoint, so the sections can be processed in any
+	 * order and the output does not depend on the number of threads.
+	 */
 	STAILQ_FOREACH(li, &ld->ld_lilist, li_next) {
 		ld_input_load(ld, li);
 		for (i = 0; (uint64_t) i < li->li_shnum; i++) {
@@ -463,18 +479,47 @@ _copy_and_reloc_input_sections(struct ld *ld)
 			if (is->is_ibuf != NULL) {
 				d->d_buf = is->is_ibuf;
 				/* .eh_frame section needs relocation */
-				if (strcmp(is->is_name, ".eh_frame") == 0)
-					ld_reloc_process_input_section(ld, is,
-					    d->d_buf);
-			} else if (is->is_reloc == NULL) {
+				if (strcmp(is->is_name, ".eh_frame") != 0)
+					continue;
+			} else if (is->is_reloc == NULL)
 				d->d_buf = ld_input_get_section_rawdata(ld,
 				    is);
-				ld_reloc_process_input_section(ld, is,
-				    d->d_buf);
+			else
+				continue;
+
+			if (nwork == cap) {
+				cap = cap == 0 ? 256 : cap * 2;
+				work = realloc(work, cap * sizeof(*work));
+				if (work == NULL)
+					ld_fatal_std(ld, "realloc");
 			}
+			work[nwork++] = is;
 		}
 		ld_input_unload(ld, li);
 	}
+
+	/*
+	 * The GOT section is looked up lazily while relocating. Do it
+	 * here, before the workers start, so that they only read it.
+	 */
+	if (ld->ld_got == NULL)
+		ld->ld_got = ld_input_find_internal_section(ld, ".got");
+
+	ld_thread_run(ld, nwork, _reloc_input_section, work);
+
+	free(work);
+}
+
+static void
+_reloc_input_section(struct ld *ld, void *arg, size_t i)
+{
+	struct ld_input_section *is;
+	Elf_Data *d;
+
+	is = ((struct ld_input_section **) arg)[i];
+	d = is->is_data;
+
+	ld_reloc_process_input_section(ld, is, d->d_buf);
 }
 
 static void
@@ -891,6 +936,7 @@ ld_output_create(struct ld *ld)
 {
 	struct ld_output *lo;
 	GElf_Ehdr eh;
+	off_t size;
 
 	lo = ld->ld_output;
 
@@ -937,10 +983,18 @@ ld_output_create(struct ld *ld)
 	/* Copy and relocate input section data to output section. */
 	_copy_and_reloc_input_sections(ld);
 
+	/* Create .gdb_index section from the relocated debug sections. */
+	if (ld->ld_gdb_index && !ld->ld_reloc)
+		ld_gdbindex_create(ld);
+
 	/* Finalize .eh_frame_hdr section. */
 	if (ld->ld_ehframe_hdr)
 		ld_ehframe_finalize_hdr(ld);
 
+	/* Finalize .note.gnu.build-id section. */
+	if (ld->ld_build_id != LD_BUILD_ID_NONE && !ld->ld_reloc)
+		ld_buildid_finalize(ld);
+
 	/*
 	 * Join normal relocation sections if the linker is creating a
 	 * relocatable object or if option -emit-relocs is specified.
@@ -959,8 +1013,12 @@ ld_output_create(struct ld *ld)
 		_create_phdr(ld);
 
 	/* Finally write out the output ELF object. */
-	if (elf_update(lo->lo_elf, ELF_C_WRITE) < 0)
+	if ((size = elf_update(lo->lo_elf, ELF_C_WRITE)) < 0)
 		ld_fatal(ld, "elf_update failed: %s", elf_errmsg(-1));
+
+	/* Compute the build ID from the output image. */
+	if (ld->ld_build_id != LD_BUILD_ID_NONE && !ld->ld_reloc)
+		ld_buildid_write(ld, size);
 }
 
 static void
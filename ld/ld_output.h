@@ -131,6 +131,7 @@ struct ld_output {
 	struct ld_output_section *lo_dynsym; /* .dynsym section. */
 	struct ld_output_section *lo_dynstr; /* .dynstr section. */
 	struct ld_output_section *lo_hash; /* .hash section. */
+	struct ld_output_section *lo_gnu_hash; /* .gnu.hash section. */
 	struct ld_output_section *lo_verdef; /* .gnu.version.d section */
 	struct ld_output_section *lo_verneed; /* .gnu.version.r section */
 	struct ld_output_section *lo_versym; /* .gnu.version section */
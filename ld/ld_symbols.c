@@ -40,11 +40,14 @@ ELFTC_VCSID("$Id$");
 
 static void _load_symbols(struct ld *ld, struct ld_file *lf);
 static void _load_archive_symbols(struct ld *ld, struct ld_file *lf);
+static void _load_archive_symbol_table(struct ld *ld, struct ld_file *lf,
+    struct ld_archive *la);
 static void _load_elf_symbols(struct ld *ld, struct ld_input *li, Elf *e);
 static void _unload_symbols(struct ld_input *li);
 static void _add_elf_symbol(struct ld *ld, struct ld_input *li, Elf *e,
     GElf_Sym *sym, size_t strndx, int i);
 static void _add_to_dynsym_table(struct ld *ld, struct ld_symbol *lsb);
+static void _add_to_undef_list(struct ld *ld, struct ld_symbol *lsb);
 static void _write_to_dynsym_table(struct ld *ld, struct ld_symbol *lsb);
 static void _add_to_symbol_table(struct ld *ld, struct ld_symbol *lsb);
 static void _free_symbol_table(struct ld_symbol_table *symtab);
@@ -116,6 +119,11 @@ ld_symbols_cleanup(struct ld *ld)
 		ld->ld_dyn_symbols = NULL;
 	}
 
+	if (ld->ld_undef_symbols != NULL) {
+		free(ld->ld_undef_symbols);
+		ld->ld_undef_symbols = NULL;
+	}
+
 	if (ld->ld_symtab != NULL) {
 		_free_symbol_table(ld->ld_symtab);
 		ld->ld_symtab = NULL;
@@ -151,6 +159,7 @@ ld_symbols_add_extern(struct ld *ld, char *name)
 	STAILQ_INSERT_TAIL(ld->ld_ext_symbols, lsb, lsb_next);
 
 	_add_symbol(ld->ld_sym, lsb);
+	_add_to_undef_list(ld, lsb);
 }
 
 void
@@ -227,8 +236,9 @@ void
 ld_symbols_resolve(struct ld *ld)
 {
 	struct ld_state *ls;
-	struct ld_file *lf;
+	struct ld_file *lf, *_lf;
 	struct ld_symbol *lsb, *_lsb;
+	unsigned level;
 
 	if (TAILQ_EMPTY(&ld->ld_lflist)) {
 		if (ld->ld_print_version)
@@ -241,18 +251,34 @@ ld_symbols_resolve(struct ld *ld)
 	lf = TAILQ_FIRST(&ld->ld_lflist);
 	ls->ls_group_level = lf->lf_group_level;
 
-	while (lf != NULL) {
-		/* Process archive groups. */
-		if (lf->lf_group_level < ls->ls_group_level &&
+	for (;;) {
+		/*
+		 * Process archive groups: when leaving a group in which
+		 * members were extracted, search it again from its first
+		 * file. The end of the input also ends a group.
+		 */
+		level = lf != NULL ? lf->lf_group_level : 0;
+		if (level < ls->ls_group_level &&
 		    ls->ls_extracted[ls->ls_group_level]) {
-			do {
+			if (lf != NULL)
 				lf = TAILQ_PREV(lf, ld_file_head, lf_next);
-			} while (lf->lf_group_level >= ls->ls_group_level);
-			lf = TAILQ_NEXT(lf, lf_next);
+			else
+				lf = TAILQ_LAST(&ld->ld_lflist, ld_file_head);
+			while ((_lf = TAILQ_PREV(lf, ld_file_head, lf_next)) !=
+			    NULL && _lf->lf_group_level >= ls->ls_group_level)
+				lf = _lf;
 			ls->ls_extracted[ls->ls_group_level] = 0;
 		}
+		if (lf == NULL)
+			break;
 		ls->ls_group_level = lf->lf_group_level;
 
+		/* Only archives are searched again. */
+		if (lf->lf_type != LFT_ARCHIVE && lf->lf_input != NULL) {
+			lf = TAILQ_NEXT(lf, lf_next);
+			continue;
+		}
+
 		/* Load symbols. */
 		ld_file_load(ld, lf);
 		if (ls->ls_arch_conflict) {
@@ -682,6 +708,8 @@ _resolve_and_add_symbol(struct ld *ld, struct ld_symbol *lsb)
 	 * the same symbol. We will solve that when we see the definition.
 	 */
 	_add_symbol(ld->ld_sym, lsb);
+	if (lsb->lsb_shndx == SHN_UNDEF || lsb->lsb_shndx == SHN_COMMON)
+		_add_to_undef_list(ld, lsb);
 
 	return;
 
@@ -1073,43 +1101,86 @@ _print_extracted_member(struct ld *ld, struct ld_archive_member *lam,
 	printf("%s (%s)\n", c2, lsb->lsb_name);
 }
 
+static void
+_load_archive_symbol_table(struct ld *ld, struct ld_file *lf,
+    struct ld_archive *la)
+{
+	struct ld_archive_symbol *las;
+	Elf_Arsym *as;
+	size_t c, i;
+
+	if ((as = elf_getarsym(lf->lf_elf, &c)) == NULL)
+		ld_fatal(ld, "%s: elf_getarsym failed: %s", lf->lf_name,
+		    elf_errmsg(-1));
+
+	for (i = 0; i < c; i++) {
+		if (as[i].as_name == NULL)
+			break;
+
+		/* The first archive member defining a symbol wins. */
+		HASH_FIND_STR(la->la_as, as[i].as_name, las);
+		if (las != NULL)
+			continue;
+
+		if ((las = calloc(1, sizeof(*las))) == NULL)
+			ld_fatal_std(ld, "calloc");
+		if ((las->las_name = strdup(as[i].as_name)) == NULL)
+			ld_fatal_std(ld, "strdup");
+		las->las_off = as[i].as_off;
+		HASH_ADD_KEYPTR(hh, la->la_as, las->las_name,
+		    strlen(las->las_name), las);
+	}
+
+	la->la_as_loaded = 1;
+}
+
+/*
+ * Extract the archive members that define a currently undefined
+ * symbol. Each archive remembers how far it has searched the list of
+ * undefined symbols, so that when the archive is visited again (e.g.
+ * in an archive group) only the symbols that became undefined since
+ * the last visit are searched in the archive symbol table. Symbols
+ * added by extracted members are appended to the list and are
+ * searched in the same visit.
+ */
 static void
 _load_archive_symbols(struct ld *ld, struct ld_file *lf)
 {
 	struct ld_state *ls;
 	struct ld_archive *la;
 	struct ld_archive_member *lam;
-	struct ld_symbol *lsb;
-	Elf_Arsym *as;
-	size_t c;
-	int extracted, i;
+	struct ld_archive_symbol *las;
+	struct ld_symbol *lsb, *undef;
 
 	assert(lf != NULL && lf->lf_type == LFT_ARCHIVE);
 	assert(lf->lf_ar != NULL);
 
 	ls = &ld->ld_state;
 	la = lf->lf_ar;
-	if ((as = elf_getarsym(lf->lf_elf, &c)) == NULL)
-		ld_fatal(ld, "%s: elf_getarsym failed: %s", lf->lf_name,
-		    elf_errmsg(-1));
-	do {
-		extracted = 0;
-		for (i = 0; (size_t) i < c; i++) {
-			if (as[i].as_name == NULL)
-				break;
-			if (_archive_member_extracted(la, as[i].as_off))
-				continue;
-			if ((lsb = _find_symbol(ld->ld_sym, as[i].as_name)) !=
-			    NULL) {
-				lam = _extract_archive_member(ld, lf, la,
-				    as[i].as_off);
-				extracted = 1;
-				ls->ls_extracted[ls->ls_group_level] = 1;
-				if (ld->ld_print_linkmap)
-					_print_extracted_member(ld, lam, lsb);
-			}
-		}
-	} while (extracted);
+	if (!la->la_as_loaded)
+		_load_archive_symbol_table(ld, lf, la);
+
+	if (ld->ld_undef_symbols == NULL || la->la_as == NULL)
+		return;
+
+	if (la->la_undef == NULL)
+		undef = STAILQ_FIRST(ld->ld_undef_symbols);
+	else
+		undef = STAILQ_NEXT(la->la_undef, lsb_undef);
+
+	for (; undef != NULL; undef = STAILQ_NEXT(undef, lsb_undef)) {
+		la->la_undef = undef;
+		lsb = ld_symbols_ref(undef);
+		if (lsb->lsb_shndx != SHN_UNDEF && lsb->lsb_shndx != SHN_COMMON)
+			continue;
+		HASH_FIND_STR(la->la_as, undef->lsb_longname, las);
+		if (las == NULL || _archive_member_extracted(la, las->las_off))
+			continue;
+		lam = _extract_archive_member(ld, lf, la, las->las_off);
+		ls->ls_extracted[ls->ls_group_level] = 1;
+		if (ld->ld_print_linkmap)
+			_print_extracted_member(ld, lam, lsb);
+	}
 }
 
 static void
@@ -1261,6 +1332,19 @@ _alloc_symbol_table(struct ld *ld)
 	return (symtab);
 }
 
+static void
+_add_to_undef_list(struct ld *ld, struct ld_symbol *lsb)
+{
+
+	if (ld->ld_undef_symbols == NULL) {
+		ld->ld_undef_symbols = malloc(sizeof(*ld->ld_undef_symbols));
+		if (ld->ld_undef_symbols == NULL)
+			ld_fatal_std(ld, "malloc");
+		STAILQ_INIT(ld->ld_undef_symbols);
+	}
+	STAILQ_INSERT_TAIL(ld->ld_undef_symbols, lsb, lsb_undef);
+}
+
 static void
 _add_to_dynsym_table(struct ld *ld, struct ld_symbol *lsb)
 {
@@ -67,6 +67,7 @@ struct ld_symbol {
 	UT_hash_handle hh;		/* hash handle */
 	STAILQ_ENTRY(ld_symbol) lsb_next; /* next symbol */
 	STAILQ_ENTRY(ld_symbol) lsb_dyn;  /* next dynamic symbol */
+	STAILQ_ENTRY(ld_symbol) lsb_undef; /* next undefined symbol */
 };
 
 STAILQ_HEAD(ld_symbol_head, ld_symbol);
@@ -0,0 +1,131 @@
+/*-
+ * Copyright (c) 2026 The Elftoolchain Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <pthread.h>
+
+#include "ld.h"
+#include "ld_thread.h"
+
+ELFTC_VCSID("$Id$");
+
+/*
+ * A simple worker pool for running independent jobs in parallel.
+ *
+ * Work items are handed out one at a time from a shared counter, so
+ * that a few large items do not leave the other threads idle. Callers
+ * must make sure that each item only writes to memory owned by that
+ * item; the result is then independent of the number of threads and
+ * of the order in which the items are processed.
+ */
+
+struct _thread_pool {
+	struct ld *tp_ld;		/* ld(1) context */
+	void (*tp_func)(struct ld *, void *, size_t); /* job callback */
+	void *tp_arg;			/* job argument */
+	size_t tp_nitems;		/* number of work items */
+	size_t tp_next;			/* next work item to hand out */
+	pthread_mutex_t tp_lock;	/* protects tp_next */
+};
+
+static void	*_worker(void *arg);
+
+/*
+ * Jobs run serially unless a thread count was given with --threads.
+ */
+unsigned
+ld_thread_count(struct ld *ld)
+{
+
+	return (ld->ld_threads > 0 ? ld->ld_threads : 1);
+}
+
+void
+ld_thread_run(struct ld *ld, size_t nitems,
+    void (*func)(struct ld *, void *, size_t), void *arg)
+{
+	struct _thread_pool tp;
+	pthread_t *tids;
+	size_t i, nthreads, ncreated;
+
+	nthreads = ld_thread_count(ld);
+	if (nthreads > nitems)
+		nthreads = nitems;
+
+	if (nthreads <= 1) {
+		for (i = 0; i < nitems; i++)
+			func(ld, arg, i);
+		return;
+	}
+
+	tp.tp_ld = ld;
+	tp.tp_func = func;
+	tp.tp_arg = arg;
+	tp.tp_nitems = nitems;
+	tp.tp_next = 0;
+	if (pthread_mutex_init(&tp.tp_lock, NULL) != 0)
+		ld_fatal(ld, "pthread_mutex_init failed");
+
+	if ((tids = calloc(nthreads - 1, sizeof(*tids))) == NULL)
+		ld_fatal_std(ld, "calloc");
+
+	/*
+	 * The calling thread works on the queue as well. If a worker
+	 * thread can not be created, the remaining threads simply pick
+	 * up its share of the work.
+	 */
+	for (ncreated = 0; ncreated < nthreads - 1; ncreated++) {
+		if (pthread_create(&tids[ncreated], NULL, _worker, &tp) != 0)
+			break;
+	}
+	(void) _worker(&tp);
+	for (i = 0; i < ncreated; i++)
+		(void) pthread_join(tids[i], NULL);
+
+	(void) pthread_mutex_destroy(&tp.tp_lock);
+	free(tids);
+}
+
+static void *
+_worker(void *arg)
+{
+	struct _thread_pool *tp;
+	size_t i;
+
+	tp = arg;
+
+	for (;;) {
+		(void) pthread_mutex_lock(&tp->tp_lock);
+		i = tp->tp_next;
+		if (i < tp->tp_nitems)
+			tp->tp_next++;
+		(void) pthread_mutex_unlock(&tp->tp_lock);
+		if (i >= tp->tp_nitems)
+			break;
+		tp->tp_func(tp->tp_ld, tp->tp_arg, i);
+	}
+
+	return (NULL);
+}
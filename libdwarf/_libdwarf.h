@@ -34,6 +34,7 @@
 #include <sys/queue.h>
 #include <assert.h>
 #include <limits.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -46,6 +47,14 @@
 
 #define DWARF_DIE_HASH_SIZE		8191
 
+/* Compression types of debug sections, as in ELFCOMPRESS_*. */
+#define	DWARF_COMPRESS_NONE		0
+#define	DWARF_COMPRESS_ZLIB		1
+#define	DWARF_COMPRESS_ZSTD		2
+
+/* Size of the header of a GNU-style ".zdebug_*" section. */
+#define	DWARF_ZDEBUG_HDR_SIZE		12
+
 struct _libdwarf_globals {
 	Dwarf_Handler	errhand;
 	Dwarf_Ptr	errarg;
@@ -61,6 +70,25 @@ extern struct _libdwarf_globals _libdwarf;
 #define	DWARF_SET_ELF_ERROR(_d, _e)					\
 	_DWARF_SET_ERROR(_d, _e, DW_DLE_ELF, elf_errno())
 
+/*
+ * Serialize the lazy construction of tables shared by all users of a
+ * consumer that was switched to thread-safe mode.  A table is built
+ * and published under the lock, and a thread only reads it after it
+ * has taken the lock itself, which orders its reads after the build.
+ * Section data is not loaded under the lock: dwarf_set_thread_safe()
+ * loads it before the consumer is shared.
+ */
+#define	DWARF_LOCK(_d)							\
+	do {								\
+		if ((_d)->dbg_thread_safe)				\
+			(void) pthread_mutex_lock(&(_d)->dbg_lock);	\
+	} while (0)
+#define	DWARF_UNLOCK(_d)						\
+	do {								\
+		if ((_d)->dbg_thread_safe)				\
+			(void) pthread_mutex_unlock(&(_d)->dbg_lock);	\
+	} while (0)
+
 /*
  * Convenient macros for producer bytes stream generation.
  */
@@ -90,11 +118,13 @@ extern struct _libdwarf_globals _libdwarf;
 	} while(0)
 
 typedef struct _Dwarf_CU *Dwarf_CU;
+typedef struct _Dwarf_NameIdx *Dwarf_NameIdx;
 
 struct _Dwarf_AttrDef {
 	uint64_t	ad_attrib;		/* DW_AT_XXX */
 	uint64_t	ad_form;		/* DW_FORM_XXX */
 	uint64_t	ad_offset;		/* Offset in abbrev section. */
+	int64_t		ad_const;		/* DW_FORM_implicit_const value. */
 	STAILQ_ENTRY(_Dwarf_AttrDef) ad_next;	/* Next attribute define. */
 };
 
@@ -126,7 +156,10 @@ struct _Dwarf_Abbrev {
 	uint64_t	ab_offset;	/* Offset in abbrev section. */
 	uint64_t	ab_length;	/* Length of this abbrev entry. */
 	uint64_t	ab_atnum;	/* Number of attribute defines. */
+	uint64_t	ab_usecnt;	/* Number of DIEs using it. (producer) */
+	uint8_t		*ab_key;	/* Encoded body, hash key. (producer) */
 	UT_hash_handle	ab_hh;		/* Uthash handle. */
+	UT_hash_handle	ab_khh;		/* Body hash handle. (producer) */
 	STAILQ_HEAD(, _Dwarf_AttrDef) ab_attrdef; /* List of attribute defs. */
 };
 
@@ -223,10 +256,26 @@ struct _Dwarf_NameTbl {
 	STAILQ_ENTRY(_Dwarf_NameTbl) nt_next; /* Next name table in the list. */
 };
 
+struct _Dwarf_StrSlot {
+	uint64_t	ss_off;		/* String offset plus one, or 0. */
+	uint32_t	ss_hash;	/* Hash value of the string. */
+};
+
+struct _Dwarf_NameSlot {
+	const char	*nh_name;	/* Name, or NULL if unused. */
+	uint32_t	nh_hash;	/* Hash value of the name. */
+	Dwarf_Unsigned	nh_first;	/* First pair in ns_byname. */
+	Dwarf_Unsigned	nh_cnt;		/* Number of pairs with the name. */
+};
+
 struct _Dwarf_NameSec {
 	STAILQ_HEAD(, _Dwarf_NameTbl) ns_ntlist; /* List of name tables. */
+	struct _Dwarf_NamePair *ns_pairs; /* Storage of all name pairs. */
 	Dwarf_NamePair	*ns_array;	/* Array of pairs of all tables. */
 	Dwarf_Unsigned	ns_len;		/* Length of the pair array. */
+	struct _Dwarf_NameSlot *ns_hash; /* Open addressing name hash. */
+	Dwarf_Unsigned	ns_hashsize;	/* Number of slots, a power of 2. */
+	Dwarf_NamePair	*ns_byname;	/* Pairs grouped by name. */
 };
 
 struct _Dwarf_Fde {
@@ -266,16 +315,31 @@ struct _Dwarf_Cie {
 	uint8_t		cie_fde_encode; /* FDE PC start/range encode. */
 	Dwarf_Ptr	cie_initinst;	/* Initial instructions. */
 	Dwarf_Unsigned	cie_instlen;	/* Length of init instructions. */
+	UT_hash_handle	cie_hh;		/* Offset hash handle. */
 	STAILQ_ENTRY(_Dwarf_Cie) cie_next;  /* Next CIE in list. */
 };
 
+struct _Dwarf_FdeIndex {
+	Dwarf_Unsigned	fi_initloc;	/* Initial location. */
+	Dwarf_Unsigned	fi_adrange;	/* Address range. */
+	Dwarf_Unsigned	fi_maxend;	/* Highest end address so far. */
+	Dwarf_Unsigned	fi_offset;	/* Offset of the FDE. */
+	Dwarf_Fde	fi_fde;		/* FDE, once materialized. */
+};
+
 struct _Dwarf_FrameSec {
+	struct _Dwarf_Section *fs_ds;	/* Ptr to the frame section. */
+	int		fs_eh_frame;	/* Whether it is .eh_frame. */
 	STAILQ_HEAD(, _Dwarf_Cie) fs_cielist; /* List of CIE. */
+	Dwarf_Cie	fs_ciehash;	/* CIEs hashed by offset. */
 	STAILQ_HEAD(, _Dwarf_Fde) fs_fdelist; /* List of FDE. */
 	Dwarf_Cie	*fs_ciearray;	/* Array of CIE. */
 	Dwarf_Unsigned	fs_cielen;	/* Length of CIE array. */
 	Dwarf_Fde	*fs_fdearray;	/* Array of FDE.*/
 	Dwarf_Unsigned	fs_fdelen;	/* Length of FDE array. */
+	struct _Dwarf_FdeIndex *fs_fdeidx; /* FDEs sorted by address. */
+	Dwarf_Unsigned	fs_fdeidxlen;	/* Length of FDE index. */
+	Dwarf_Unsigned	fs_fdeidxcap;	/* Capacity of FDE index. */
 };
 
 struct _Dwarf_Arange {
@@ -285,6 +349,7 @@ struct _Dwarf_Arange {
 	Dwarf_Unsigned	ar_symndx;	/* First symbol index for reloc. */
 	Dwarf_Unsigned	ar_esymndx;	/* Second symbol index for reloc. */
 	Dwarf_Addr	ar_eoff;	/* Offset from second symbol. */
+	Dwarf_Unsigned	ar_maxend;	/* Max end PC in sorted index. */
 	STAILQ_ENTRY(_Dwarf_Arange) ar_next; /* Next arange in list. */
 };
 
@@ -305,14 +370,35 @@ struct _Dwarf_MacroSet {
 	STAILQ_ENTRY(_Dwarf_MacroSet) ms_next; /* Next set in list. */
 };
 
+/*
+ * Hash key of a parsed range or location list.  DWARF 5 lists are
+ * decoded against their CU's base address and .debug_addr table, so
+ * the CU is part of the key; it is NULL for earlier versions.
+ */
+struct _Dwarf_ListKey {
+	uint64_t	lk_offset;	/* Offset of the list. */
+	Dwarf_CU	lk_cu;		/* DWARF 5 CU or NULL. */
+};
+
 struct _Dwarf_Rangelist {
 	Dwarf_CU	rl_cu;		/* Ptr to associated CU. */
 	Dwarf_Unsigned	rl_offset;	/* Offset of the rangelist. */
 	Dwarf_Ranges	*rl_rgarray;	/* Array of ranges. */
 	Dwarf_Unsigned	rl_rglen;	/* Length of the ranges array. */
+	struct _Dwarf_ListKey rl_key;	/* Offset hash key. */
+	UT_hash_handle	rl_hh;		/* Offset hash handle. */
 	STAILQ_ENTRY(_Dwarf_Rangelist) rl_next; /* Next rangelist in list. */
 };
 
+struct _Dwarf_Loclist {
+	struct _Dwarf_ListKey ll_key;	/* Offset hash key. */
+	Dwarf_Locdesc	**ll_ldlist;	/* Decoded location descriptions. */
+	Dwarf_Signed	ll_ldlen;	/* Length of the list. */
+	Dwarf_CU	ll_cu;		/* CU that decoded the list. */
+	Dwarf_Unsigned	ll_length;	/* Size of the list in the section. */
+	UT_hash_handle	ll_hh;		/* Offset hash handle. */
+};
+
 struct _Dwarf_CU {
 	Dwarf_Debug	cu_dbg;		/* Ptr to containing dbg. */
 	Dwarf_Off	cu_offset;	/* Offset to the this CU. */
@@ -326,24 +412,97 @@ struct _Dwarf_CU {
 	uint64_t	cu_lineno_offset; /* Offset into .debug_lineno. */
 	uint8_t		cu_pointer_size;/* Number of bytes in pointer. */
 	uint8_t		cu_dwarf_size;	/* CU section dwarf size. */
+	uint8_t		cu_unit_type;	/* DWARF 5 unit type (DW_UT_XXX). */
+	uint64_t	cu_dwo_id;	/* Skeleton/split unit DWO id. */
+	int		cu_bases_init;	/* CU table bases looked up. */
+	uint64_t	cu_str_offsets_base; /* DW_AT_str_offsets_base. */
+	uint64_t	cu_addr_base;	/* DW_AT_addr_base. */
+	uint64_t	cu_rnglists_base; /* DW_AT_rnglists_base. */
+	uint64_t	cu_loclists_base; /* DW_AT_loclists_base. */
+	uint64_t	cu_lowpc;	/* DW_AT_low_pc of the CU DIE. */
+	int		cu_is_split;	/* Split compilation/type unit. */
+	Dwarf_CU	cu_skel;	/* Skeleton CU of a split unit. */
+	struct _Dwarf_UnitIndex *cu_dwp_index; /* .dwp unit index. */
+	uint64_t	cu_dwp_off[DW_SECT_RNGLISTS + 1]; /* .dwp contributions. */
+	uint64_t	cu_sig;		/* Signature hash key. */
+	UT_hash_handle	cu_hh;		/* Signature hash handle. */
 	Dwarf_Sig8	cu_type_sig;	/* Type unit's signature. */
 	uint64_t	cu_type_offset; /* Type unit's type offset. */
 	Dwarf_Off	cu_next_offset; /* Offset to the next CU. */
 	uint64_t	cu_1st_offset;	/* First DIE offset. */
 	int		cu_pass2;	/* Two pass DIE traverse. */
 	Dwarf_LineInfo	cu_lineinfo;	/* Ptr to Dwarf_LineInfo. */
+	uint64_t	cu_lastuse;	/* Trim epoch of the last use. */
 	Dwarf_Abbrev	cu_abbrev_hash; /* Abbrev hash table. */
 	Dwarf_Bool	cu_is_info;	/* Compilation/type unit flag. */
 	STAILQ_ENTRY(_Dwarf_CU) cu_next; /* Next compilation unit. */
 };
 
+struct _Dwarf_CU_Cursor {
+	Dwarf_Debug	cc_dbg;		/* Ptr to containing dbg. */
+	Dwarf_CU	cc_next;	/* Next unit to hand out. */
+};
+
 typedef struct _Dwarf_Section {
 	const char	*ds_name;	/* Section name. */
 	Dwarf_Small	*ds_data;	/* Section data. */
 	Dwarf_Unsigned	ds_addr;	/* Section virtual addr. */
 	Dwarf_Unsigned	ds_size;	/* Section size. */
+	int		ds_loaded;	/* Section data loaded. */
+	int		ds_loaderr;	/* Error of a failed load. */
+	int		ds_elferr;	/* ELF error of a failed load. */
+	char		*ds_zname;	/* Name of a .zdebug section. */
+	Dwarf_Small	*ds_zdata;	/* Decompressed section data. */
+	UT_hash_handle	ds_hh;		/* Name hash handle. */
 } Dwarf_Section;
 
+struct _Dwarf_NameIdxAbbrev {
+	uint64_t	na_code;	/* Abbreviation code. */
+	uint64_t	na_tag;		/* DW_TAG_XXX of the indexed DIEs. */
+	uint64_t	na_attr;	/* Offset of the DW_IDX_XXX specs. */
+};
+
+struct _Dwarf_NameIdx {
+	Dwarf_Section	*ni_ds;		/* Ptr to .debug_names section. */
+	uint64_t	ni_end;		/* End offset of the name index. */
+	uint8_t		ni_dwarf_size;	/* Name index dwarf size. */
+	uint32_t	ni_cu_cnt;	/* Number of CUs in the CU list. */
+	uint32_t	ni_ltu_cnt;	/* Number of local TUs. */
+	uint32_t	ni_ftu_cnt;	/* Number of foreign TUs. */
+	uint32_t	ni_bucket_cnt;	/* Number of hash buckets. */
+	uint32_t	ni_name_cnt;	/* Number of names. */
+	uint64_t	ni_cu_off;	/* Offset of the CU list. */
+	uint64_t	ni_ltu_off;	/* Offset of the local TU list. */
+	uint64_t	ni_bucket_off;	/* Offset of the bucket array. */
+	uint64_t	ni_hash_off;	/* Offset of the hash array. */
+	uint64_t	ni_stroff_off;	/* Offset of the string offsets. */
+	uint64_t	ni_entoff_off;	/* Offset of the entry offsets. */
+	uint64_t	ni_pool_off;	/* Offset of the entry pool. */
+	struct _Dwarf_NameIdxAbbrev *ni_abbrev; /* Array of abbreviations. */
+	uint64_t	ni_abbrev_cnt;	/* Length of the abbreviation array. */
+	STAILQ_ENTRY(_Dwarf_NameIdx) ni_next; /* Next name index in list. */
+};
+
+struct _Dwarf_UnitIndexEnt {
+	uint64_t	ue_off;		/* Offset of the unit. */
+	uint32_t	ue_row;		/* Row in the index. */
+};
+
+struct _Dwarf_UnitIndex {
+	Dwarf_Section	*ui_ds;		/* Ptr to the index section. */
+	uint32_t	ui_version;	/* Index version. */
+	uint32_t	ui_col_cnt;	/* Number of section columns. */
+	uint32_t	ui_unit_cnt;	/* Number of units (rows). */
+	uint32_t	ui_slot_cnt;	/* Number of hash slots. */
+	uint64_t	ui_hash_off;	/* Offset of the hash table. */
+	uint64_t	ui_row_off;	/* Offset of the parallel row table. */
+	uint64_t	ui_off_off;	/* Offset of the section offsets. */
+	int		*ui_sect;	/* DW_SECT_XXX of each column. */
+	uint32_t	ui_key_col;	/* Column locating the units. */
+	struct _Dwarf_UnitIndexEnt *ui_ent; /* Rows sorted by unit offset. */
+	Dwarf_CU	*ui_cu;		/* Unit of each row once loaded. */
+};
+
 typedef struct _Dwarf_P_Section {
 	char		*ds_name;	/* Section name. */
 	Dwarf_Small	*ds_data;	/* Section data. */
@@ -361,15 +520,16 @@ typedef struct _Dwarf_Rel_Entry {
 	Dwarf_Unsigned	dre_addend;	/* Reloc addend. */
 	Dwarf_Unsigned	dre_symndx;	/* Reloc symbol index. */
 	const char	*dre_secname;	/* Refer to some debug section. */
-	STAILQ_ENTRY(_Dwarf_Rel_Entry) dre_next; /* Next reloc entry. */
 } *Dwarf_Rel_Entry;
 
 typedef struct _Dwarf_Rel_Section {
 	struct _Dwarf_P_Section *drs_ds; /* Ptr to actual reloc ELF section. */
 	struct _Dwarf_P_Section *drs_ref; /* Which debug section it refers. */
 	struct Dwarf_Relocation_Data_s *drs_drd; /* Reloc data array. */
-	STAILQ_HEAD(, _Dwarf_Rel_Entry) drs_dre; /* Reloc entry list. */
+	struct _Dwarf_Rel_Entry *drs_dre; /* Reloc entry array. */
 	Dwarf_Unsigned	drs_drecnt;	/* Count of entries. */
+	Dwarf_Unsigned	drs_drecap;	/* Capacity of entry array. */
+	int		drs_sorted;	/* Entries in offset order. */
 	Dwarf_Unsigned	drs_size;	/* Size of ELF section in bytes. */
 	int		drs_addend;	/* Elf_Rel or Elf_Rela */
 	STAILQ_ENTRY(_Dwarf_Rel_Section) drs_next; /* Next reloc section. */
@@ -378,21 +538,33 @@ typedef struct _Dwarf_Rel_Section {
 typedef struct {
 	Elf_Data *ed_data;
 	void *ed_alloc;
+	const char *ed_name;
+	size_t ed_ndx;
+	int ed_loaded;
+	int ed_compress;
+	Dwarf_Unsigned ed_hdrsize;
+	Dwarf_Unsigned ed_size;
 } Dwarf_Elf_Data;
 
 typedef struct {
 	Elf		*eo_elf;
+	Dwarf_Debug	eo_dbg;
 	GElf_Ehdr	eo_ehdr;
 	GElf_Shdr	*eo_shdr;
 	Dwarf_Elf_Data	*eo_data;
 	Dwarf_Unsigned	eo_seccnt;
 	size_t		eo_strndx;
+	size_t		eo_symtab;
+	Elf_Data	*eo_symtab_data;
+	int		eo_applyrela;
+	int		eo_elferror;	/* libelf error of a failed load */
 	Dwarf_Obj_Access_Methods eo_methods;
 } Dwarf_Elf_Object;
 
 struct _Dwarf_Debug {
 	Dwarf_Obj_Access_Interface *dbg_iface;
 	Dwarf_Section	*dbg_section;	/* Dwarf section list. */
+	Dwarf_Section	*dbg_sechash;	/* Sections hashed by name. */
 	Dwarf_Section	*dbg_info_sec;	/* Pointer to info section. */
 	Dwarf_Off	dbg_info_off;	/* Current info section offset. */
 	Dwarf_Section	*dbg_types_sec; /* Pointer to type section. */
@@ -421,11 +593,33 @@ struct _Dwarf_Debug {
 	STAILQ_HEAD(, _Dwarf_ArangeSet) dbg_aslist; /* List of arange set. */
 	Dwarf_Arange	*dbg_arange_array; /* Array of arange. */
 	Dwarf_Unsigned	dbg_arange_cnt;	/* Length of the arange array. */
+	Dwarf_Arange	*dbg_arange_sorted; /* Arange array sorted by PC. */
+	int		dbg_arange_synth; /* Synthesize aranges from DIEs. */
+	int		dbg_arange_loaded; /* Arange table built. */
 	char		*dbg_strtab;	/* Dwarf string table. */
 	Dwarf_Unsigned	dbg_strtab_cap; /* Dwarf string table capacity. */
 	Dwarf_Unsigned	dbg_strtab_size; /* Dwarf string table size. */
+	struct _Dwarf_StrSlot *dbg_strhash; /* String table intern hash. */
+	Dwarf_Unsigned	dbg_strhash_size; /* Number of hash slots. */
+	Dwarf_Unsigned	dbg_strhash_cnt; /* Number of used hash slots. */
 	STAILQ_HEAD(, _Dwarf_MacroSet) dbg_mslist; /* List of macro set. */
 	STAILQ_HEAD(, _Dwarf_Rangelist) dbg_rllist; /* List of rangelist. */
+	struct _Dwarf_Rangelist *dbg_rlhash; /* Rangelists hashed by offset. */
+	struct _Dwarf_Loclist *dbg_llhash; /* Loclists hashed by offset. */
+	STAILQ_HEAD(, _Dwarf_NameIdx) dbg_nilist; /* List of name indexes. */
+	int		dbg_names_loaded; /* .debug_names headers parsed. */
+	Dwarf_Debug	dbg_tied;	/* Object holding the skeleton CUs. */
+	struct _Dwarf_UnitIndex *dbg_cu_index; /* .debug_cu_index of a .dwp. */
+	struct _Dwarf_UnitIndex *dbg_tu_index; /* .debug_tu_index of a .dwp. */
+	int		dbg_unit_index_loaded; /* Unit indexes parsed. */
+	Dwarf_CU	dbg_cu_sighash;	/* CUs hashed by DWO id. */
+	Dwarf_CU	dbg_tu_sighash;	/* TUs hashed by type signature. */
+	int		dbg_cu_sighash_init; /* CU signature hash built. */
+	int		dbg_tu_sighash_init; /* TU signature hash built. */
+	int		dbg_swap;	/* Object byte order is not native. */
+	int		dbg_thread_safe; /* Shared by several threads. */
+	pthread_mutex_t	dbg_lock;	/* Guards lazily built tables. */
+	uint64_t	dbg_epoch;	/* Current trim epoch. */
 	uint64_t	(*read)(uint8_t *, uint64_t *, int);
 	void		(*write)(uint8_t *, uint64_t *, uint64_t, int);
 	int		(*write_alloc)(uint8_t **, uint64_t *, uint64_t *,
@@ -483,6 +677,7 @@ void		_dwarf_abbrev_cleanup(Dwarf_CU);
 int		_dwarf_abbrev_find(Dwarf_CU, uint64_t, Dwarf_Abbrev *,
 		    Dwarf_Error *);
 int		_dwarf_abbrev_gen(Dwarf_P_Debug, Dwarf_Error *);
+void		_dwarf_abbrev_load(Dwarf_CU);
 int		_dwarf_abbrev_parse(Dwarf_Debug, Dwarf_CU, Dwarf_Unsigned *,
 		    Dwarf_Abbrev *, Dwarf_Error *);
 int		_dwarf_add_AT_dataref(Dwarf_P_Debug, Dwarf_P_Die, Dwarf_Half,
@@ -492,9 +687,12 @@ int		_dwarf_add_string_attr(Dwarf_P_Die, Dwarf_P_Attribute *,
 		    Dwarf_Half, char *, Dwarf_Error *);
 int		_dwarf_alloc(Dwarf_Debug *, int, Dwarf_Error *);
 void		_dwarf_arange_cleanup(Dwarf_Debug);
+Dwarf_Arange	_dwarf_arange_find(Dwarf_Debug, Dwarf_Addr);
 int		_dwarf_arange_gen(Dwarf_P_Debug, Dwarf_Error *);
 int		_dwarf_arange_init(Dwarf_Debug, Dwarf_Error *);
 void		_dwarf_arange_pro_cleanup(Dwarf_P_Debug);
+int		_dwarf_addrx_lookup(Dwarf_CU, uint64_t, uint64_t *,
+		    Dwarf_Error *);
 int		_dwarf_attr_alloc(Dwarf_Die, Dwarf_Attribute *, Dwarf_Error *);
 Dwarf_Attribute	_dwarf_attr_find(Dwarf_Die, Dwarf_Half);
 int		_dwarf_attr_gen(Dwarf_P_Debug, Dwarf_P_Section, Dwarf_Rel_Section,
@@ -502,8 +700,19 @@ int		_dwarf_attr_gen(Dwarf_P_Debug, Dwarf_P_Section, Dwarf_Rel_Section,
 int		_dwarf_attr_init(Dwarf_Debug, Dwarf_Section *, uint64_t *, int,
 		    Dwarf_CU, Dwarf_Die, Dwarf_AttrDef, uint64_t, int,
 		    Dwarf_Error *);
+uint64_t	_dwarf_attr_size(Dwarf_CU, Dwarf_P_Attribute);
+int		_dwarf_attr_resolve_index(Dwarf_Die, Dwarf_Error *);
 int		_dwarf_attrdef_add(Dwarf_Debug, Dwarf_Abbrev, uint64_t,
 		    uint64_t, uint64_t, Dwarf_AttrDef *, Dwarf_Error *);
+int		_dwarf_cu_bases_init(Dwarf_CU, Dwarf_Die, Dwarf_Error *);
+void		_dwarf_debugnames_cleanup(Dwarf_Debug);
+int		_dwarf_debugnames_gen(Dwarf_P_Debug, Dwarf_Error *);
+int		_dwarf_debugnames_lookup(Dwarf_Debug, const char *,
+		    Dwarf_Half, Dwarf_Off **, Dwarf_Unsigned *, Dwarf_Error *);
+int		_dwarf_decompress(int, const uint8_t *, Dwarf_Unsigned,
+		    uint8_t *, Dwarf_Unsigned);
+int		_dwarf_decompress_zdebug_header(const uint8_t *,
+		    Dwarf_Unsigned, Dwarf_Unsigned *);
 uint64_t	_dwarf_decode_lsb(uint8_t **, int);
 uint64_t	_dwarf_decode_msb(uint8_t **, int);
 int64_t		_dwarf_decode_sleb128(uint8_t **);
@@ -522,8 +731,12 @@ int		_dwarf_die_parse(Dwarf_Debug, Dwarf_Section *, Dwarf_CU, int,
 void		_dwarf_die_pro_cleanup(Dwarf_P_Debug);
 void		_dwarf_elf_deinit(Dwarf_Debug);
 int		_dwarf_elf_init(Dwarf_Debug, Elf *, Dwarf_Error *);
+int		_dwarf_elf_load_data(Dwarf_Elf_Object *, Dwarf_Elf_Data *,
+		    int *);
+int		_dwarf_elf_load_error(Dwarf_Debug);
 int		_dwarf_elf_load_section(void *, Dwarf_Half, Dwarf_Small **,
 		    int *);
+Dwarf_Unsigned	_dwarf_elf_memory_usage(Dwarf_Debug);
 Dwarf_Endianness _dwarf_elf_get_byte_order(void *);
 Dwarf_Small	_dwarf_elf_get_length_size(void *);
 Dwarf_Small	_dwarf_elf_get_pointer_size(void *);
@@ -533,10 +746,14 @@ int		_dwarf_elf_get_section_info(void *, Dwarf_Half,
 void		_dwarf_expr_cleanup(Dwarf_P_Debug);
 int		_dwarf_expr_into_block(Dwarf_P_Expr, Dwarf_Error *);
 Dwarf_Section	*_dwarf_find_next_types_section(Dwarf_Debug, Dwarf_Section *);
-Dwarf_Section	*_dwarf_find_section(Dwarf_Debug, const char *);
+int		_dwarf_find_section(Dwarf_Debug, const char *,
+		    Dwarf_Section **, Dwarf_Error *);
+Dwarf_Section	*_dwarf_locate_section(Dwarf_Debug, const char *);
 void		_dwarf_frame_cleanup(Dwarf_Debug);
 int		_dwarf_frame_fde_add_inst(Dwarf_P_Fde, Dwarf_Small,
 		    Dwarf_Unsigned, Dwarf_Unsigned, Dwarf_Error *);
+int		_dwarf_frame_fde_lookup(Dwarf_Debug, Dwarf_FrameSec,
+		    Dwarf_Addr, Dwarf_Fde *, Dwarf_Error *);
 int		_dwarf_frame_gen(Dwarf_P_Debug, Dwarf_Error *);
 int		_dwarf_frame_get_fop(Dwarf_Debug, uint8_t *, Dwarf_Unsigned,
 		    Dwarf_Frame_Op **, Dwarf_Signed *, Dwarf_Error *);
@@ -547,6 +764,8 @@ void		_dwarf_frame_params_init(Dwarf_Debug);
 void		_dwarf_frame_pro_cleanup(Dwarf_P_Debug);
 int		_dwarf_frame_regtable_copy(Dwarf_Debug, Dwarf_Regtable3 **,
 		    Dwarf_Regtable3 *, Dwarf_Error *);
+int		_dwarf_frame_section_fdes(Dwarf_Debug, Dwarf_FrameSec,
+		    Dwarf_Error *);
 int		_dwarf_frame_section_load(Dwarf_Debug, Dwarf_Error *);
 int		_dwarf_frame_section_load_eh(Dwarf_Debug, Dwarf_Error *);
 int		_dwarf_generate_sections(Dwarf_P_Debug, Dwarf_Error *);
@@ -560,6 +779,7 @@ int		_dwarf_info_load(Dwarf_Debug, Dwarf_Bool, Dwarf_Bool,
 		    Dwarf_Error *);
 int		_dwarf_info_next_cu(Dwarf_Debug, Dwarf_Error *);
 int		_dwarf_info_next_tu(Dwarf_Debug, Dwarf_Error *);
+int		_dwarf_info_preload(Dwarf_Debug, Dwarf_Error *);
 void		_dwarf_info_pro_cleanup(Dwarf_P_Debug);
 int		_dwarf_init(Dwarf_Debug, Dwarf_Unsigned, Dwarf_Handler,
 		    Dwarf_Ptr, Dwarf_Error *);
@@ -577,16 +797,26 @@ int		_dwarf_loc_add(Dwarf_Die, Dwarf_Attribute, Dwarf_Error *);
 int		_dwarf_loc_expr_add_atom(Dwarf_Debug, uint8_t *, uint8_t *,
 		    Dwarf_Small, Dwarf_Unsigned, Dwarf_Unsigned, int *,
 		    Dwarf_Error *);
+void		_dwarf_loclist_cleanup(Dwarf_Debug);
 int		_dwarf_loclist_find(Dwarf_Debug, Dwarf_CU, uint64_t,
 		    Dwarf_Locdesc ***, Dwarf_Signed *, Dwarf_Unsigned *,
 		    Dwarf_Error *);
+int		_dwarf_loclist_find_pc(Dwarf_Debug, Dwarf_CU, uint64_t,
+		    Dwarf_Addr, Dwarf_Locdesc **, Dwarf_Error *);
+void		_dwarf_loclist_trim(Dwarf_Debug, uint64_t);
 void		_dwarf_macinfo_cleanup(Dwarf_Debug);
 int		_dwarf_macinfo_gen(Dwarf_P_Debug, Dwarf_Error *);
 int		_dwarf_macinfo_init(Dwarf_Debug, Dwarf_Error *);
 void		_dwarf_macinfo_pro_cleanup(Dwarf_P_Debug);
+void		_dwarf_memory_trim(Dwarf_Debug, Dwarf_Unsigned);
+void		_dwarf_memory_usage(Dwarf_Debug, Dwarf_Memory_Usage *);
 int		_dwarf_nametbl_init(Dwarf_Debug, Dwarf_NameSec *,
 		    Dwarf_Section *, Dwarf_Error *);
 void		_dwarf_nametbl_cleanup(Dwarf_NameSec *);
+int		_dwarf_nametbl_hash_init(Dwarf_Debug, Dwarf_NameSec,
+		    Dwarf_Error *);
+int		_dwarf_nametbl_lookup(Dwarf_NameSec, const char *,
+		    Dwarf_NamePair **, Dwarf_Signed *);
 int		_dwarf_nametbl_gen(Dwarf_P_Debug, const char *, Dwarf_NameTbl,
 		    Dwarf_Error *);
 void		_dwarf_nametbl_pro_cleanup(Dwarf_NameTbl *);
@@ -597,11 +827,15 @@ Dwarf_P_Section	_dwarf_pro_find_section(Dwarf_P_Debug, const char *);
 int		_dwarf_ranges_add(Dwarf_Debug, Dwarf_CU, uint64_t,
 		    Dwarf_Rangelist *, Dwarf_Error *);
 void		_dwarf_ranges_cleanup(Dwarf_Debug);
-int		_dwarf_ranges_find(Dwarf_Debug, uint64_t, Dwarf_Rangelist *);
+int		_dwarf_ranges_find(Dwarf_Debug, Dwarf_CU, uint64_t,
+		    Dwarf_Rangelist *);
+void		_dwarf_ranges_trim(Dwarf_Debug, uint64_t);
 uint64_t	_dwarf_read_lsb(uint8_t *, uint64_t *, int);
 uint64_t	_dwarf_read_msb(uint8_t *, uint64_t *, int);
 int64_t		_dwarf_read_sleb128(uint8_t *, uint64_t *);
+int64_t		_dwarf_read_sleb128_bounded(uint8_t *, uint64_t *, uint64_t);
 uint64_t	_dwarf_read_uleb128(uint8_t *, uint64_t *);
+uint64_t	_dwarf_read_uleb128_bounded(uint8_t *, uint64_t *, uint64_t);
 char		*_dwarf_read_string(void *, Dwarf_Unsigned, uint64_t *);
 uint8_t		*_dwarf_read_block(void *, uint64_t *, uint64_t);
 int		_dwarf_reloc_section_finalize(Dwarf_P_Debug, Dwarf_Rel_Section,
@@ -616,8 +850,7 @@ int		_dwarf_reloc_entry_add_pair(Dwarf_P_Debug, Dwarf_Rel_Section,
 		    Dwarf_Unsigned, Dwarf_Error *);
 void		_dwarf_reloc_cleanup(Dwarf_P_Debug);
 int		_dwarf_reloc_gen(Dwarf_P_Debug, Dwarf_Error *);
-int		_dwarf_reloc_section_gen(Dwarf_P_Debug, Dwarf_Rel_Section,
-		    Dwarf_Error *);
+int		_dwarf_reloc_section_gen(Dwarf_P_Debug, Dwarf_Rel_Section);
 int		_dwarf_reloc_section_init(Dwarf_P_Debug, Dwarf_Rel_Section *,
 		    Dwarf_P_Section, Dwarf_Error *);
 void		_dwarf_reloc_section_free(Dwarf_P_Debug, Dwarf_Rel_Section *);
@@ -628,8 +861,16 @@ int		_dwarf_section_callback(Dwarf_P_Debug, Dwarf_P_Section,
 void		_dwarf_section_free(Dwarf_P_Debug, Dwarf_P_Section *);
 int		_dwarf_section_init(Dwarf_P_Debug, Dwarf_P_Section *,
 		    const char *, int, Dwarf_Error *);
+int		_dwarf_section_load(Dwarf_Debug, Dwarf_Section *,
+		    Dwarf_Error *);
+int		_dwarf_split_bases_init(Dwarf_CU, Dwarf_Error *);
+int		_dwarf_split_find_unit(Dwarf_Debug, uint64_t, int, Dwarf_CU *,
+		    Dwarf_Error *);
+void		_dwarf_split_sighash_cleanup(Dwarf_Debug, int);
 void		_dwarf_set_error(Dwarf_Debug, Dwarf_Error *, int, int,
 		    const char *, int);
+int		_dwarf_strx_lookup(Dwarf_CU, uint64_t, uint64_t *, char **,
+		    Dwarf_Error *);
 int		_dwarf_strtab_add(Dwarf_Debug, char *, uint64_t *,
 		    Dwarf_Error *);
 void		_dwarf_strtab_cleanup(Dwarf_Debug);
@@ -637,6 +878,9 @@ int		_dwarf_strtab_gen(Dwarf_P_Debug, Dwarf_Error *);
 char		*_dwarf_strtab_get_table(Dwarf_Debug);
 int		_dwarf_strtab_init(Dwarf_Debug, Dwarf_Error *);
 void		_dwarf_type_unit_cleanup(Dwarf_Debug);
+void		_dwarf_unit_index_apply(Dwarf_Debug, Dwarf_CU);
+void		_dwarf_unit_index_cleanup(Dwarf_Debug);
+int		_dwarf_unit_index_init(Dwarf_Debug, Dwarf_Error *);
 void		_dwarf_write_block(void *, uint64_t *, uint8_t *, uint64_t);
 int		_dwarf_write_block_alloc(uint8_t **, uint64_t *, uint64_t *,
 		    uint8_t *, uint64_t, Dwarf_Error *);
@@ -659,4 +903,98 @@ int		_dwarf_write_uleb128(uint8_t *, uint8_t *, uint64_t);
 int		_dwarf_write_uleb128_alloc(uint8_t **, uint64_t *, uint64_t *,
 		    uint64_t, Dwarf_Error *);
 
+/*
+ * Inline readers for the DIE decoding loop.  Fixed-size values are loaded
+ * directly and byte-swapped if the object's byte order is not the host's,
+ * instead of going through dbg->read.  Single-byte LEB128 values are
+ * decoded in place.
+ *
+ * Reads are bounded by the size of section 'ds'.  A read that would run
+ * past the end of the section returns 0 and sets '*offsetp' past the end,
+ * which the caller checks once after decoding a DIE's attributes.
+ */
+
+static __inline uint16_t
+_dwarf_bswap16(uint16_t v)
+{
+
+	return ((v >> 8) | (v << 8));
+}
+
+static __inline uint32_t
+_dwarf_bswap32(uint32_t v)
+{
+
+	return ((v >> 24) | ((v >> 8) & 0xff00) | ((v << 8) & 0xff0000) |
+	    (v << 24));
+}
+
+static __inline uint64_t
+_dwarf_bswap64(uint64_t v)
+{
+
+	return (((uint64_t) _dwarf_bswap32(v) << 32) |
+	    _dwarf_bswap32(v >> 32));
+}
+
+static __inline uint64_t
+_dwarf_section_read(Dwarf_Debug dbg, Dwarf_Section *ds, uint64_t *offsetp,
+    int bytes_to_read)
+{
+	uint64_t v64;
+	uint32_t v32;
+	uint16_t v16;
+	uint8_t *src;
+
+	if (*offsetp > ds->ds_size ||
+	    (uint64_t) bytes_to_read > ds->ds_size - *offsetp) {
+		*offsetp = ds->ds_size + 1;
+		return (0);
+	}
+
+	src = ds->ds_data + *offsetp;
+
+	switch (bytes_to_read) {
+	case 1:
+		*offsetp += 1;
+		return (src[0]);
+	case 2:
+		memcpy(&v16, src, sizeof(v16));
+		*offsetp += 2;
+		return (dbg->dbg_swap ? _dwarf_bswap16(v16) : v16);
+	case 4:
+		memcpy(&v32, src, sizeof(v32));
+		*offsetp += 4;
+		return (dbg->dbg_swap ? _dwarf_bswap32(v32) : v32);
+	case 8:
+		memcpy(&v64, src, sizeof(v64));
+		*offsetp += 8;
+		return (dbg->dbg_swap ? _dwarf_bswap64(v64) : v64);
+	default:
+		return (dbg->read(ds->ds_data, offsetp, bytes_to_read));
+	}
+}
+
+static __inline uint64_t
+_dwarf_section_read_uleb128(Dwarf_Section *ds, uint64_t *offsetp)
+{
+	uint8_t b;
+
+	if (*offsetp < ds->ds_size && ((b = ds->ds_data[*offsetp]) & 0x80) ==
+	    0) {
+		*offsetp += 1;
+		return (b);
+	}
+
+	return (_dwarf_read_uleb128_bounded(ds->ds_data, offsetp,
+	    ds->ds_size));
+}
+
+static __inline int64_t
+_dwarf_section_read_sleb128(Dwarf_Section *ds, uint64_t *offsetp)
+{
+
+	return (_dwarf_read_sleb128_bounded(ds->ds_data, offsetp, ds->ds_size));
+}
+
 #endif /* !__LIBDWARF_H_ */
@@ -32,19 +32,31 @@ int
 dwarf_get_aranges(Dwarf_Debug dbg, Dwarf_Arange **arlist,
     Dwarf_Signed *ret_arange_cnt, Dwarf_Error *error)
 {
+	int ret;
 
 	if (dbg == NULL || arlist == NULL || ret_arange_cnt == NULL) {
 		DWARF_SET_ERROR(dbg, error, DW_DLE_ARGUMENT);
 		return (DW_DLV_ERROR);
 	}
 
+	/*
+	 * The table is built once, even if it turns out to be empty, so
+	 * that an object without address ranges is not read again on
+	 * every call.
+	 */
+	DWARF_LOCK(dbg);
+	ret = DW_DLE_NONE;
+	if (!dbg->dbg_arange_loaded) {
+		ret = _dwarf_arange_init(dbg, error);
+		if (ret == DW_DLE_NONE)
+			dbg->dbg_arange_loaded = 1;
+	}
+	DWARF_UNLOCK(dbg);
+	if (ret != DW_DLE_NONE)
+		return (DW_DLV_ERROR);
 	if (dbg->dbg_arange_cnt == 0) {
-		if (_dwarf_arange_init(dbg, error) != DW_DLE_NONE)
-			return (DW_DLV_ERROR);
-		if (dbg->dbg_arange_cnt == 0) {
-			DWARF_SET_ERROR(dbg, error, DW_DLE_NO_ENTRY);
-			return (DW_DLV_NO_ENTRY);
-		}
+		DWARF_SET_ERROR(dbg, error, DW_DLE_NO_ENTRY);
+		return (DW_DLV_NO_ENTRY);
 	}
 
 	assert(dbg->dbg_arange_array != NULL);
@@ -75,6 +87,23 @@ dwarf_get_arange(Dwarf_Arange *arlist, Dwarf_Unsigned arange_cnt,
 		return (DW_DLV_ERROR);
 	}
 
+	/*
+	 * Use the sorted index when searching the array returned by
+	 * dwarf_get_aranges().  The array was built, under the lock,
+	 * before it could be handed to the caller and is not changed
+	 * afterwards.
+	 */
+	if (arlist == dbg->dbg_arange_array &&
+	    arange_cnt == dbg->dbg_arange_cnt) {
+		assert(dbg->dbg_arange_loaded);
+		if ((ar = _dwarf_arange_find(dbg, addr)) != NULL) {
+			*ret_arange = ar;
+			return (DW_DLV_OK);
+		}
+		DWARF_SET_ERROR(dbg, error, DW_DLE_NO_ENTRY);
+		return (DW_DLV_NO_ENTRY);
+	}
+
 	for (i = 0; (Dwarf_Unsigned)i < arange_cnt; i++) {
 		ar = arlist[i];
 		if (addr >= ar->ar_address && addr < ar->ar_address +
@@ -89,6 +118,17 @@ dwarf_get_arange(Dwarf_Arange *arlist, Dwarf_Unsigned arange_cnt,
 	return (DW_DLV_NO_ENTRY);
 }
 
+int
+dwarf_set_aranges_synthesis(Dwarf_Debug dbg, int synth)
+{
+	int oldsynth;
+
+	oldsynth = dbg->dbg_arange_synth;
+	dbg->dbg_arange_synth = synth;
+
+	return (oldsynth);
+}
+
 int
 dwarf_get_cu_die_offset(Dwarf_Arange ar, Dwarf_Off *ret_offset,
     Dwarf_Error *error)
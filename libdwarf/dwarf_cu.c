@@ -38,6 +38,8 @@ dwarf_next_cu_header_c(Dwarf_Debug dbg, Dwarf_Bool is_info,
     Dwarf_Unsigned *cu_next_offset, Dwarf_Error *error)
 {
 	Dwarf_CU cu;
+	Dwarf_Error de;
+	uint64_t offset;
 	int ret;
 
 	if (dbg == NULL) {
@@ -100,11 +102,24 @@ dwarf_next_cu_header_c(Dwarf_Debug dbg, Dwarf_Bool is_info,
 	if (cu_next_offset)
 		*cu_next_offset	= cu->cu_next_offset;
 
-	if (!is_info) {
+	if (cu->cu_unit_type == DW_UT_type ||
+	    cu->cu_unit_type == DW_UT_split_type) {
 		if (type_signature)
 			*type_signature = cu->cu_type_sig;
 		if (type_offset)
 			*type_offset = cu->cu_type_offset;
+	} else if (type_signature != NULL) {
+		/*
+		 * Skeleton and split compilation units report their DWO id
+		 * instead, which DWARF 4 units keep in the CU DIE.
+		 */
+		if (cu->cu_version < 5)
+			(void) _dwarf_cu_bases_init(cu, NULL, &de);
+		if (cu->cu_dwo_id != 0) {
+			offset = 0;
+			dbg->write((uint8_t *) type_signature->signature,
+			    &offset, cu->cu_dwo_id, 8);
+		}
 	}
 
 	return (DW_DLV_OK);
@@ -157,5 +172,93 @@ dwarf_next_types_section(Dwarf_Debug dbg, Dwarf_Error *error)
 		return (DW_DLV_NO_ENTRY);
 	}
 
+	/* Prepare the type units of the new section for shared use. */
+	if (dbg->dbg_thread_safe &&
+	    _dwarf_info_preload(dbg, error) != DW_DLE_NONE)
+		return (DW_DLV_ERROR);
+
+	return (DW_DLV_OK);
+}
+
+int
+dwarf_cu_cursor_init(Dwarf_Debug dbg, Dwarf_Bool is_info,
+    Dwarf_CU_Cursor *ret_cursor, Dwarf_Error *error)
+{
+	Dwarf_CU_Cursor cc;
+	int ret;
+
+	if (dbg == NULL || ret_cursor == NULL) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_ARGUMENT);
+		return (DW_DLV_ERROR);
+	}
+
+	DWARF_LOCK(dbg);
+	ret = _dwarf_info_load(dbg, 1, is_info, error);
+	DWARF_UNLOCK(dbg);
+	if (ret == DW_DLE_NO_ENTRY) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_NO_ENTRY);
+		return (DW_DLV_NO_ENTRY);
+	} else if (ret != DW_DLE_NONE)
+		return (DW_DLV_ERROR);
+
+	if ((cc = malloc(sizeof(struct _Dwarf_CU_Cursor))) == NULL) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
+		return (DW_DLV_ERROR);
+	}
+
+	cc->cc_dbg = dbg;
+	if (is_info)
+		cc->cc_next = STAILQ_FIRST(&dbg->dbg_cu);
+	else
+		cc->cc_next = STAILQ_FIRST(&dbg->dbg_tu);
+
+	*ret_cursor = cc;
+
+	return (DW_DLV_OK);
+}
+
+int
+dwarf_cu_cursor_next(Dwarf_CU_Cursor cc, Dwarf_Die *ret_die,
+    Dwarf_Error *error)
+{
+	Dwarf_Debug dbg;
+	Dwarf_Section *ds;
+	Dwarf_CU cu;
+	int ret;
+
+	dbg = cc != NULL ? cc->cc_dbg : NULL;
+
+	if (cc == NULL || ret_die == NULL) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_ARGUMENT);
+		return (DW_DLV_ERROR);
+	}
+
+	/* Threads sharing a cursor are each handed a different unit. */
+	DWARF_LOCK(dbg);
+	if ((cu = cc->cc_next) != NULL)
+		cc->cc_next = STAILQ_NEXT(cu, cu_next);
+	DWARF_UNLOCK(dbg);
+
+	if (cu == NULL) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_NO_ENTRY);
+		return (DW_DLV_NO_ENTRY);
+	}
+
+	ds = cu->cu_is_info ? dbg->dbg_info_sec : dbg->dbg_types_sec;
+	ret = _dwarf_die_parse(dbg, ds, cu, cu->cu_dwarf_size,
+	    cu->cu_1st_offset, cu->cu_next_offset, ret_die, 0, error);
+	if (ret == DW_DLE_NO_ENTRY) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_NO_ENTRY);
+		return (DW_DLV_NO_ENTRY);
+	} else if (ret != DW_DLE_NONE)
+		return (DW_DLV_ERROR);
+
 	return (DW_DLV_OK);
 }
+
+void
+dwarf_cu_cursor_dealloc(Dwarf_CU_Cursor cc)
+{
+
+	free(cc);
+}
@@ -78,17 +78,23 @@ dwarf_siblingof_b(Dwarf_Debug dbg, Dwarf_Die die, Dwarf_Die *ret_die,
 	}
 
 	ds = is_info ? dbg->dbg_info_sec : dbg->dbg_types_sec;
-	cu = is_info ? dbg->dbg_cu_current : dbg->dbg_tu_current;
-
-	if (cu == NULL) {
-		DWARF_SET_ERROR(dbg, error, DW_DLE_DIE_NO_CU_CONTEXT);
-		return (DW_DLV_ERROR);
-	}
 
 	/* Application requests the first DIE in this CU. */
-	if (die == NULL)
+	if (die == NULL) {
+		cu = is_info ? dbg->dbg_cu_current : dbg->dbg_tu_current;
+		if (cu == NULL) {
+			DWARF_SET_ERROR(dbg, error, DW_DLE_DIE_NO_CU_CONTEXT);
+			return (DW_DLV_ERROR);
+		}
 		return (dwarf_offdie_b(dbg, cu->cu_1st_offset, is_info,
 		    ret_die, error));
+	}
+
+	/*
+	 * The DIE need not belong to the current CU, e.g. when it was
+	 * looked up by signature.
+	 */
+	cu = die->die_cu;
 
 	/*
 	 * Check if the `is_info' flag matches the debug section the
@@ -231,6 +237,45 @@ dwarf_offdie(Dwarf_Debug dbg, Dwarf_Off offset, Dwarf_Die *ret_die,
 	return (dwarf_offdie_b(dbg, offset, 1, ret_die, error));
 }
 
+int
+dwarf_find_die_given_sig8(Dwarf_Debug dbg, Dwarf_Sig8 *sig,
+    Dwarf_Die *ret_die, Dwarf_Bool *is_info, Dwarf_Error *error)
+{
+	Dwarf_Section *ds;
+	Dwarf_CU cu;
+	uint64_t offset;
+	int ret;
+
+	if (dbg == NULL || sig == NULL || ret_die == NULL) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_ARGUMENT);
+		return (DW_DLV_ERROR);
+	}
+
+	offset = 0;
+	ret = _dwarf_split_find_unit(dbg, dbg->read((uint8_t *) sig->signature,
+	    &offset, 8), 1, &cu, error);
+	if (ret == DW_DLE_NO_ENTRY) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_NO_ENTRY);
+		return (DW_DLV_NO_ENTRY);
+	} else if (ret != DW_DLE_NONE)
+		return (DW_DLV_ERROR);
+
+	ds = cu->cu_is_info ? dbg->dbg_info_sec : dbg->dbg_types_sec;
+	ret = _dwarf_die_parse(dbg, ds, cu, cu->cu_dwarf_size,
+	    cu->cu_offset + cu->cu_type_offset, cu->cu_next_offset, ret_die, 0,
+	    error);
+	if (ret == DW_DLE_NO_ENTRY) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_NO_ENTRY);
+		return (DW_DLV_NO_ENTRY);
+	} else if (ret != DW_DLE_NONE)
+		return (DW_DLV_ERROR);
+
+	if (is_info != NULL)
+		*is_info = cu->cu_is_info;
+
+	return (DW_DLV_OK);
+}
+
 int
 dwarf_tag(Dwarf_Die die, Dwarf_Half *tag, Dwarf_Error *error)
 {
@@ -170,6 +170,64 @@ dwarf_get_AT_name(unsigned attr, const char **s)
 		*s = "DW_AT_language"; break;
 	case DW_AT_linkage_name:
 		*s = "DW_AT_linkage_name"; break;
+	case DW_AT_string_length_bit_size:
+		*s = "DW_AT_string_length_bit_size"; break;
+	case DW_AT_string_length_byte_size:
+		*s = "DW_AT_string_length_byte_size"; break;
+	case DW_AT_rank:
+		*s = "DW_AT_rank"; break;
+	case DW_AT_str_offsets_base:
+		*s = "DW_AT_str_offsets_base"; break;
+	case DW_AT_addr_base:
+		*s = "DW_AT_addr_base"; break;
+	case DW_AT_rnglists_base:
+		*s = "DW_AT_rnglists_base"; break;
+	case DW_AT_dwo_name:
+		*s = "DW_AT_dwo_name"; break;
+	case DW_AT_reference:
+		*s = "DW_AT_reference"; break;
+	case DW_AT_rvalue_reference:
+		*s = "DW_AT_rvalue_reference"; break;
+	case DW_AT_macros:
+		*s = "DW_AT_macros"; break;
+	case DW_AT_call_all_calls:
+		*s = "DW_AT_call_all_calls"; break;
+	case DW_AT_call_all_source_calls:
+		*s = "DW_AT_call_all_source_calls"; break;
+	case DW_AT_call_all_tail_calls:
+		*s = "DW_AT_call_all_tail_calls"; break;
+	case DW_AT_call_return_pc:
+		*s = "DW_AT_call_return_pc"; break;
+	case DW_AT_call_value:
+		*s = "DW_AT_call_value"; break;
+	case DW_AT_call_origin:
+		*s = "DW_AT_call_origin"; break;
+	case DW_AT_call_parameter:
+		*s = "DW_AT_call_parameter"; break;
+	case DW_AT_call_pc:
+		*s = "DW_AT_call_pc"; break;
+	case DW_AT_call_tail_call:
+		*s = "DW_AT_call_tail_call"; break;
+	case DW_AT_call_target:
+		*s = "DW_AT_call_target"; break;
+	case DW_AT_call_target_clobbered:
+		*s = "DW_AT_call_target_clobbered"; break;
+	case DW_AT_call_data_location:
+		*s = "DW_AT_call_data_location"; break;
+	case DW_AT_call_data_value:
+		*s = "DW_AT_call_data_value"; break;
+	case DW_AT_noreturn:
+		*s = "DW_AT_noreturn"; break;
+	case DW_AT_alignment:
+		*s = "DW_AT_alignment"; break;
+	case DW_AT_export_symbols:
+		*s = "DW_AT_export_symbols"; break;
+	case DW_AT_deleted:
+		*s = "DW_AT_deleted"; break;
+	case DW_AT_defaulted:
+		*s = "DW_AT_defaulted"; break;
+	case DW_AT_loclists_base:
+		*s = "DW_AT_loclists_base"; break;
 	case DW_AT_lo_user:
 		*s = "DW_AT_lo_user"; break;
 	case DW_AT_location:
@@ -298,6 +356,22 @@ dwarf_get_AT_name(unsigned attr, const char **s)
 		*s = "DW_AT_GNU_all_call_sites"; break;
 	case DW_AT_GNU_all_source_call_sites:
 		*s = "DW_AT_GNU_all_source_call_sites"; break;
+	case DW_AT_GNU_dwo_name:
+		*s = "DW_AT_GNU_dwo_name"; break;
+	case DW_AT_GNU_dwo_id:
+		*s = "DW_AT_GNU_dwo_id"; break;
+	case DW_AT_GNU_ranges_base:
+		*s = "DW_AT_GNU_ranges_base"; break;
+	case DW_AT_GNU_addr_base:
+		*s = "DW_AT_GNU_addr_base"; break;
+	case DW_AT_GNU_pubnames:
+		*s = "DW_AT_GNU_pubnames"; break;
+	case DW_AT_GNU_pubtypes:
+		*s = "DW_AT_GNU_pubtypes"; break;
+	case DW_AT_GNU_locviews:
+		*s = "DW_AT_GNU_locviews"; break;
+	case DW_AT_GNU_entry_view:
+		*s = "DW_AT_GNU_entry_view"; break;
 	default:
 		return (DW_DLV_NO_ENTRY);
 	}
@@ -342,6 +416,12 @@ dwarf_get_ATE_name(unsigned ate, const char **s)
 		*s = "DW_ATE_unsigned_fixed"; break;
 	case DW_ATE_decimal_float:
 		*s = "DW_ATE_decimal_float"; break;
+	case DW_ATE_UTF:
+		*s = "DW_ATE_UTF"; break;
+	case DW_ATE_UCS:
+		*s = "DW_ATE_UCS"; break;
+	case DW_ATE_ASCII:
+		*s = "DW_ATE_ASCII"; break;
 	case DW_ATE_lo_user:
 		*s = "DW_ATE_lo_user"; break;
 	case DW_ATE_hi_user:
@@ -522,6 +602,50 @@ dwarf_get_FORM_name(unsigned form, const char **s)
 		*s = "DW_FORM_strp"; break;
 	case DW_FORM_udata:
 		*s = "DW_FORM_udata"; break;
+	case DW_FORM_strx:
+		*s = "DW_FORM_strx"; break;
+	case DW_FORM_addrx:
+		*s = "DW_FORM_addrx"; break;
+	case DW_FORM_ref_sup4:
+		*s = "DW_FORM_ref_sup4"; break;
+	case DW_FORM_strp_sup:
+		*s = "DW_FORM_strp_sup"; break;
+	case DW_FORM_data16:
+		*s = "DW_FORM_data16"; break;
+	case DW_FORM_line_strp:
+		*s = "DW_FORM_line_strp"; break;
+	case DW_FORM_implicit_const:
+		*s = "DW_FORM_implicit_const"; break;
+	case DW_FORM_loclistx:
+		*s = "DW_FORM_loclistx"; break;
+	case DW_FORM_rnglistx:
+		*s = "DW_FORM_rnglistx"; break;
+	case DW_FORM_ref_sup8:
+		*s = "DW_FORM_ref_sup8"; break;
+	case DW_FORM_strx1:
+		*s = "DW_FORM_strx1"; break;
+	case DW_FORM_strx2:
+		*s = "DW_FORM_strx2"; break;
+	case DW_FORM_strx3:
+		*s = "DW_FORM_strx3"; break;
+	case DW_FORM_strx4:
+		*s = "DW_FORM_strx4"; break;
+	case DW_FORM_addrx1:
+		*s = "DW_FORM_addrx1"; break;
+	case DW_FORM_addrx2:
+		*s = "DW_FORM_addrx2"; break;
+	case DW_FORM_addrx3:
+		*s = "DW_FORM_addrx3"; break;
+	case DW_FORM_addrx4:
+		*s = "DW_FORM_addrx4"; break;
+	case DW_FORM_GNU_addr_index:
+		*s = "DW_FORM_GNU_addr_index"; break;
+	case DW_FORM_GNU_str_index:
+		*s = "DW_FORM_GNU_str_index"; break;
+	case DW_FORM_GNU_ref_alt:
+		*s = "DW_FORM_GNU_ref_alt"; break;
+	case DW_FORM_GNU_strp_alt:
+		*s = "DW_FORM_GNU_strp_alt"; break;
 	default:
 		return (DW_DLV_NO_ENTRY);
 	}
@@ -728,6 +852,42 @@ dwarf_get_LANG_name(unsigned lang, const char **s)
 		*s = "DW_LANG_UPC"; break;
 	case DW_LANG_D:
 		*s = "DW_LANG_D"; break;
+	case DW_LANG_Python:
+		*s = "DW_LANG_Python"; break;
+	case DW_LANG_OpenCL:
+		*s = "DW_LANG_OpenCL"; break;
+	case DW_LANG_Go:
+		*s = "DW_LANG_Go"; break;
+	case DW_LANG_Modula3:
+		*s = "DW_LANG_Modula3"; break;
+	case DW_LANG_Haskell:
+		*s = "DW_LANG_Haskell"; break;
+	case DW_LANG_C_plus_plus_03:
+		*s = "DW_LANG_C_plus_plus_03"; break;
+	case DW_LANG_C_plus_plus_11:
+		*s = "DW_LANG_C_plus_plus_11"; break;
+	case DW_LANG_OCaml:
+		*s = "DW_LANG_OCaml"; break;
+	case DW_LANG_Rust:
+		*s = "DW_LANG_Rust"; break;
+	case DW_LANG_C11:
+		*s = "DW_LANG_C11"; break;
+	case DW_LANG_Swift:
+		*s = "DW_LANG_Swift"; break;
+	case DW_LANG_Julia:
+		*s = "DW_LANG_Julia"; break;
+	case DW_LANG_Dylan:
+		*s = "DW_LANG_Dylan"; break;
+	case DW_LANG_C_plus_plus_14:
+		*s = "DW_LANG_C_plus_plus_14"; break;
+	case DW_LANG_Fortran03:
+		*s = "DW_LANG_Fortran03"; break;
+	case DW_LANG_Fortran08:
+		*s = "DW_LANG_Fortran08"; break;
+	case DW_LANG_RenderScript:
+		*s = "DW_LANG_RenderScript"; break;
+	case DW_LANG_BLISS:
+		*s = "DW_LANG_BLISS"; break;
 	case DW_LANG_lo_user:
 		*s = "DW_LANG_lo_user"; break;
 	case DW_LANG_hi_user:
@@ -752,6 +912,8 @@ dwarf_get_LNE_name(unsigned lne, const char **s)
 		*s = "DW_LNE_set_address"; break;
 	case DW_LNE_define_file:
 		*s = "DW_LNE_define_file"; break;
+	case DW_LNE_set_discriminator:
+		*s = "DW_LNE_set_discriminator"; break;
 	case DW_LNE_lo_user:
 		*s = "DW_LNE_lo_user"; break;
 	case DW_LNE_hi_user:
@@ -1140,6 +1302,26 @@ dwarf_get_OP_name(unsigned op, const char **s)
 		*s = "DW_OP_implicit_value"; break;
 	case DW_OP_stack_value:
 		*s = "DW_OP_stack_value"; break;
+	case DW_OP_implicit_pointer:
+		*s = "DW_OP_implicit_pointer"; break;
+	case DW_OP_addrx:
+		*s = "DW_OP_addrx"; break;
+	case DW_OP_constx:
+		*s = "DW_OP_constx"; break;
+	case DW_OP_entry_value:
+		*s = "DW_OP_entry_value"; break;
+	case DW_OP_const_type:
+		*s = "DW_OP_const_type"; break;
+	case DW_OP_regval_type:
+		*s = "DW_OP_regval_type"; break;
+	case DW_OP_deref_type:
+		*s = "DW_OP_deref_type"; break;
+	case DW_OP_xderef_type:
+		*s = "DW_OP_xderef_type"; break;
+	case DW_OP_convert:
+		*s = "DW_OP_convert"; break;
+	case DW_OP_reinterpret:
+		*s = "DW_OP_reinterpret"; break;
 	case DW_OP_GNU_push_tls_address:
 		*s = "DW_OP_GNU_push_tls_address"; break;
 	case DW_OP_GNU_uninit:
@@ -1288,6 +1470,22 @@ dwarf_get_TAG_name(unsigned tag, const char **s)
 		*s = "DW_TAG_subroutine_type"; break;
 	case DW_TAG_template_alias:
 		*s = "DW_TAG_template_alias"; break;
+	case DW_TAG_coarray_type:
+		*s = "DW_TAG_coarray_type"; break;
+	case DW_TAG_generic_subrange:
+		*s = "DW_TAG_generic_subrange"; break;
+	case DW_TAG_dynamic_type:
+		*s = "DW_TAG_dynamic_type"; break;
+	case DW_TAG_atomic_type:
+		*s = "DW_TAG_atomic_type"; break;
+	case DW_TAG_call_site:
+		*s = "DW_TAG_call_site"; break;
+	case DW_TAG_call_site_parameter:
+		*s = "DW_TAG_call_site_parameter"; break;
+	case DW_TAG_skeleton_unit:
+		*s = "DW_TAG_skeleton_unit"; break;
+	case DW_TAG_immutable_type:
+		*s = "DW_TAG_immutable_type"; break;
 	case DW_TAG_template_type_parameter:
 		*s = "DW_TAG_template_type_parameter"; break;
 	case DW_TAG_template_value_parameter:
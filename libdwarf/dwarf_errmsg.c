@@ -59,6 +59,10 @@ static const char *_libdwarf_errors[] = {
 	DEFINE_ERROR(ARANGE_OFFSET_BAD, "Invalid address range offset"),
 	DEFINE_ERROR(DEBUG_MACRO_INCONSISTENT, "Invalid macinfo data"),
 	DEFINE_ERROR(ELF_SECT_ERR, "Application callback failed"),
+	DEFINE_ERROR(COMPRESSION, "Invalid or unsupported compressed section"),
+	DEFINE_ERROR(INDEX_BAD, "Invalid string or address index"),
+	DEFINE_ERROR(DEBUG_NAMES_BAD, "Invalid .debug_names section"),
+	DEFINE_ERROR(UNIT_INDEX_BAD, "Invalid split unit index section"),
 	DEFINE_ERROR(NUM, "Unknown DWARF error")
 #undef	DEFINE_ERROR
 };
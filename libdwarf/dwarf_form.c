@@ -149,6 +149,8 @@ dwarf_global_formref(Dwarf_Attribute at, Dwarf_Off *return_offset,
 	switch (at->at_form) {
 	case DW_FORM_ref_addr:
 	case DW_FORM_sec_offset:
+	case DW_FORM_loclistx:
+	case DW_FORM_rnglistx:
 		*return_offset = (Dwarf_Off) at->u[0].u64;
 		ret = DW_DLV_OK;
 		break;
@@ -182,10 +184,18 @@ dwarf_formaddr(Dwarf_Attribute at, Dwarf_Addr *return_addr, Dwarf_Error *error)
 		return (DW_DLV_ERROR);
 	}
 
-	if (at->at_form == DW_FORM_addr) {
+	switch (at->at_form) {
+	case DW_FORM_addr:
+	case DW_FORM_addrx:
+	case DW_FORM_addrx1:
+	case DW_FORM_addrx2:
+	case DW_FORM_addrx3:
+	case DW_FORM_addrx4:
+	case DW_FORM_GNU_addr_index:
 		*return_addr = at->u[0].u64;
 		ret = DW_DLV_OK;
-	} else {
+		break;
+	default:
 		DWARF_SET_ERROR(dbg, error, DW_DLE_ATTR_FORM_BAD);
 		ret = DW_DLV_ERROR;
 	}
@@ -238,6 +248,7 @@ dwarf_formudata(Dwarf_Attribute at, Dwarf_Unsigned *return_uvalue,
 	case DW_FORM_data4:
 	case DW_FORM_data8:
 	case DW_FORM_udata:
+	case DW_FORM_implicit_const:
 		*return_uvalue = at->u[0].u64;
 		ret = DW_DLV_OK;
 		break;
@@ -278,6 +289,7 @@ dwarf_formsdata(Dwarf_Attribute at, Dwarf_Signed *return_svalue,
 		break;
 	case DW_FORM_data8:
 	case DW_FORM_sdata:
+	case DW_FORM_implicit_const:
 		*return_svalue = at->u[0].s64;
 		ret = DW_DLV_OK;
 		break;
@@ -308,6 +320,7 @@ dwarf_formblock(Dwarf_Attribute at, Dwarf_Block **return_block,
 	case DW_FORM_block1:
 	case DW_FORM_block2:
 	case DW_FORM_block4:
+	case DW_FORM_data16:
 		*return_block = &at->at_block;
 		ret = DW_DLV_OK;
 		break;
@@ -387,6 +400,13 @@ dwarf_formstring(Dwarf_Attribute at, char **return_string,
 		ret = DW_DLV_OK;
 		break;
 	case DW_FORM_strp:
+	case DW_FORM_line_strp:
+	case DW_FORM_strx:
+	case DW_FORM_strx1:
+	case DW_FORM_strx2:
+	case DW_FORM_strx3:
+	case DW_FORM_strx4:
+	case DW_FORM_GNU_str_index:
 		*return_string = (char *) at->u[1].s;
 		ret = DW_DLV_OK;
 		break;
@@ -405,6 +425,12 @@ dwarf_get_form_class(Dwarf_Half dwversion, Dwarf_Half attr,
 
 	switch (form) {
 	case DW_FORM_addr:
+	case DW_FORM_addrx:
+	case DW_FORM_addrx1:
+	case DW_FORM_addrx2:
+	case DW_FORM_addrx3:
+	case DW_FORM_addrx4:
+	case DW_FORM_GNU_addr_index:
 		return (DW_FORM_CLASS_ADDRESS);
 	case DW_FORM_block:
 	case DW_FORM_block1:
@@ -413,7 +439,19 @@ dwarf_get_form_class(Dwarf_Half dwversion, Dwarf_Half attr,
 		return (DW_FORM_CLASS_BLOCK);
 	case DW_FORM_string:
 	case DW_FORM_strp:
+	case DW_FORM_line_strp:
+	case DW_FORM_strp_sup:
+	case DW_FORM_strx:
+	case DW_FORM_strx1:
+	case DW_FORM_strx2:
+	case DW_FORM_strx3:
+	case DW_FORM_strx4:
+	case DW_FORM_GNU_str_index:
 		return (DW_FORM_CLASS_STRING);
+	case DW_FORM_loclistx:
+		return (DW_FORM_CLASS_LOCLIST);
+	case DW_FORM_rnglistx:
+		return (DW_FORM_CLASS_RNGLIST);
 	case DW_FORM_flag:
 	case DW_FORM_flag_present:
 		return (DW_FORM_CLASS_FLAG);
@@ -424,6 +462,8 @@ dwarf_get_form_class(Dwarf_Half dwversion, Dwarf_Half attr,
 	case DW_FORM_ref2:
 	case DW_FORM_ref4:
 	case DW_FORM_ref8:
+	case DW_FORM_ref_sup4:
+	case DW_FORM_ref_sup8:
 		return (DW_FORM_CLASS_REFERENCE);
 	case DW_FORM_exprloc:
 		return (DW_FORM_CLASS_EXPRLOC);
@@ -431,6 +471,8 @@ dwarf_get_form_class(Dwarf_Half dwversion, Dwarf_Half attr,
 	case DW_FORM_data2:
 	case DW_FORM_sdata:
 	case DW_FORM_udata:
+	case DW_FORM_data16:
+	case DW_FORM_implicit_const:
 		return (DW_FORM_CLASS_CONSTANT);
 	case DW_FORM_data4:
 	case DW_FORM_data8:
@@ -467,7 +509,17 @@ dwarf_get_form_class(Dwarf_Half dwversion, Dwarf_Half attr,
 		case DW_AT_ranges:
 			return (DW_FORM_CLASS_RANGELISTPTR);
 		case DW_AT_macro_info:
+		case DW_AT_macros:
 			return (DW_FORM_CLASS_MACPTR);
+		case DW_AT_addr_base:
+		case DW_AT_GNU_addr_base:
+			return (DW_FORM_CLASS_ADDRPTR);
+		case DW_AT_loclists_base:
+			return (DW_FORM_CLASS_LOCLISTSPTR);
+		case DW_AT_rnglists_base:
+			return (DW_FORM_CLASS_RNGLISTSPTR);
+		case DW_AT_str_offsets_base:
+			return (DW_FORM_CLASS_STROFFSETSPTR);
 		default:
 			if (form == DW_FORM_data4 || form == DW_FORM_data8)
 				return (DW_FORM_CLASS_CONSTANT);
@@ -28,11 +28,37 @@
 
 ELFTC_VCSID("$Id$");
 
+static int
+_dwarf_frame_fde_list(Dwarf_Debug dbg, Dwarf_FrameSec *fsp,
+    int (*load)(Dwarf_Debug, Dwarf_Error *), Dwarf_Error *error)
+{
+
+	if (*fsp == NULL) {
+		if (load(dbg, error) != DW_DLE_NONE)
+			return (DW_DLV_ERROR);
+		if (*fsp == NULL) {
+			DWARF_SET_ERROR(dbg, error, DW_DLE_NO_ENTRY);
+			return (DW_DLV_NO_ENTRY);
+		}
+	}
+
+	if (_dwarf_frame_section_fdes(dbg, *fsp, error) != DW_DLE_NONE)
+		return (DW_DLV_ERROR);
+
+	if ((*fsp)->fs_ciearray == NULL || (*fsp)->fs_fdearray == NULL) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_NO_ENTRY);
+		return (DW_DLV_NO_ENTRY);
+	}
+
+	return (DW_DLV_OK);
+}
+
 int
 dwarf_get_fde_list(Dwarf_Debug dbg, Dwarf_Cie **cie_list,
     Dwarf_Signed *cie_count, Dwarf_Fde **fde_list, Dwarf_Signed *fde_count,
     Dwarf_Error *error)
 {
+	int ret;
 
 	if (dbg == NULL || cie_list == NULL || cie_count == NULL ||
 	    fde_list == NULL || fde_count == NULL) {
@@ -40,32 +66,18 @@ dwarf_get_fde_list(Dwarf_Debug dbg, Dwarf_Cie **cie_list,
 		return (DW_DLV_ERROR);
 	}
 
-	if (dbg->dbg_internal_reg_table == NULL) {
-		if (_dwarf_frame_interal_table_init(dbg, error) != DW_DLE_NONE)
-			return (DW_DLV_ERROR);
+	DWARF_LOCK(dbg);
+	ret = _dwarf_frame_fde_list(dbg, &dbg->dbg_frame,
+	    _dwarf_frame_section_load, error);
+	if (ret == DW_DLV_OK) {
+		*cie_list = dbg->dbg_frame->fs_ciearray;
+		*cie_count = dbg->dbg_frame->fs_cielen;
+		*fde_list = dbg->dbg_frame->fs_fdearray;
+		*fde_count = dbg->dbg_frame->fs_fdelen;
 	}
+	DWARF_UNLOCK(dbg);
 
-	if (dbg->dbg_frame == NULL) {
-		if (_dwarf_frame_section_load(dbg, error) != DW_DLE_NONE)
-			return (DW_DLV_ERROR);
-		if (dbg->dbg_frame == NULL) {
-			DWARF_SET_ERROR(dbg, error, DW_DLE_NO_ENTRY);
-			return (DW_DLV_NO_ENTRY);
-		}
-	}
-
-	if (dbg->dbg_frame->fs_ciearray == NULL ||
-	    dbg->dbg_frame->fs_fdearray == NULL) {
-		DWARF_SET_ERROR(dbg, error, DW_DLE_NO_ENTRY);
-		return (DW_DLV_NO_ENTRY);
-	}
-
-	*cie_list = dbg->dbg_frame->fs_ciearray;
-	*cie_count = dbg->dbg_frame->fs_cielen;
-	*fde_list = dbg->dbg_frame->fs_fdearray;
-	*fde_count = dbg->dbg_frame->fs_fdelen;
-
-	return (DW_DLV_OK);
+	return (ret);
 }
 
 int
@@ -73,6 +85,7 @@ dwarf_get_fde_list_eh(Dwarf_Debug dbg, Dwarf_Cie **cie_list,
     Dwarf_Signed *cie_count, Dwarf_Fde **fde_list, Dwarf_Signed *fde_count,
     Dwarf_Error *error)
 {
+	int ret;
 
 	if (dbg == NULL || cie_list == NULL || cie_count == NULL ||
 	    fde_list == NULL || fde_count == NULL) {
@@ -80,34 +93,89 @@ dwarf_get_fde_list_eh(Dwarf_Debug dbg, Dwarf_Cie **cie_list,
 		return (DW_DLV_ERROR);
 	}
 
-	if (dbg->dbg_internal_reg_table == NULL) {
-		if (_dwarf_frame_interal_table_init(dbg, error) != DW_DLE_NONE)
-			return (DW_DLV_ERROR);
+	DWARF_LOCK(dbg);
+	ret = _dwarf_frame_fde_list(dbg, &dbg->dbg_eh_frame,
+	    _dwarf_frame_section_load_eh, error);
+	if (ret == DW_DLV_OK) {
+		*cie_list = dbg->dbg_eh_frame->fs_ciearray;
+		*cie_count = dbg->dbg_eh_frame->fs_cielen;
+		*fde_list = dbg->dbg_eh_frame->fs_fdearray;
+		*fde_count = dbg->dbg_eh_frame->fs_fdelen;
 	}
+	DWARF_UNLOCK(dbg);
 
-	if (dbg->dbg_eh_frame == NULL) {
-		if (_dwarf_frame_section_load_eh(dbg, error) != DW_DLE_NONE)
+	return (ret);
+}
+
+static int
+_dwarf_frame_fde_for_pc(Dwarf_Debug dbg, Dwarf_FrameSec *fsp,
+    int (*load)(Dwarf_Debug, Dwarf_Error *), Dwarf_Addr pc,
+    Dwarf_Fde *ret_fde, Dwarf_Addr *lopc, Dwarf_Addr *hipc,
+    Dwarf_Error *error)
+{
+	Dwarf_Fde fde;
+	int ret;
+
+	if (*fsp == NULL) {
+		if (load(dbg, error) != DW_DLE_NONE)
 			return (DW_DLV_ERROR);
-		if (dbg->dbg_eh_frame == NULL) {
+		if (*fsp == NULL) {
 			DWARF_SET_ERROR(dbg, error, DW_DLE_NO_ENTRY);
 			return (DW_DLV_NO_ENTRY);
 		}
 	}
 
-	if (dbg->dbg_eh_frame->fs_ciearray == NULL ||
-	    dbg->dbg_eh_frame->fs_fdearray == NULL) {
-		DWARF_SET_ERROR(dbg, error, DW_DLE_NO_ENTRY);
+	ret = _dwarf_frame_fde_lookup(dbg, *fsp, pc, &fde, error);
+	if (ret == DW_DLE_NO_ENTRY)
 		return (DW_DLV_NO_ENTRY);
-	}
+	else if (ret != DW_DLE_NONE)
+		return (DW_DLV_ERROR);
 
-	*cie_list = dbg->dbg_eh_frame->fs_ciearray;
-	*cie_count = dbg->dbg_eh_frame->fs_cielen;
-	*fde_list = dbg->dbg_eh_frame->fs_fdearray;
-	*fde_count = dbg->dbg_eh_frame->fs_fdelen;
+	*ret_fde = fde;
+	*lopc = fde->fde_initloc;
+	*hipc = fde->fde_initloc + fde->fde_adrange - 1;
 
 	return (DW_DLV_OK);
 }
 
+int
+dwarf_get_fde_for_pc(Dwarf_Debug dbg, Dwarf_Addr pc, Dwarf_Fde *ret_fde,
+    Dwarf_Addr *lopc, Dwarf_Addr *hipc, Dwarf_Error *error)
+{
+	int ret;
+
+	if (dbg == NULL || ret_fde == NULL || lopc == NULL || hipc == NULL) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_ARGUMENT);
+		return (DW_DLV_ERROR);
+	}
+
+	DWARF_LOCK(dbg);
+	ret = _dwarf_frame_fde_for_pc(dbg, &dbg->dbg_frame,
+	    _dwarf_frame_section_load, pc, ret_fde, lopc, hipc, error);
+	DWARF_UNLOCK(dbg);
+
+	return (ret);
+}
+
+int
+dwarf_get_fde_for_pc_eh(Dwarf_Debug dbg, Dwarf_Addr pc, Dwarf_Fde *ret_fde,
+    Dwarf_Addr *lopc, Dwarf_Addr *hipc, Dwarf_Error *error)
+{
+	int ret;
+
+	if (dbg == NULL || ret_fde == NULL || lopc == NULL || hipc == NULL) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_ARGUMENT);
+		return (DW_DLV_ERROR);
+	}
+
+	DWARF_LOCK(dbg);
+	ret = _dwarf_frame_fde_for_pc(dbg, &dbg->dbg_eh_frame,
+	    _dwarf_frame_section_load_eh, pc, ret_fde, lopc, hipc, error);
+	DWARF_UNLOCK(dbg);
+
+	return (ret);
+}
+
 int
 dwarf_get_fde_n(Dwarf_Fde *fdelist, Dwarf_Unsigned fde_index,
     Dwarf_Fde *ret_fde, Dwarf_Error *error)
@@ -301,10 +369,21 @@ dwarf_get_fde_info_for_reg(Dwarf_Fde fde, Dwarf_Half table_column,
 		return (DW_DLV_ERROR);
 	}
 
+	if (table_column != dbg->dbg_frame_cfa_value &&
+	    (table_column >= dbg->dbg_frame_rule_table_size ||
+	    table_column >= DW_REG_TABLE_SIZE)) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_FRAME_TABLE_COL_BAD);
+		return (DW_DLV_ERROR);
+	}
+
+	/* The internal register table is shared by all threads. */
+	DWARF_LOCK(dbg);
 	ret = _dwarf_frame_get_internal_table(fde, pc_requested, &rt, &pc,
 	    error);
-	if (ret != DW_DLE_NONE)
+	if (ret != DW_DLE_NONE) {
+		DWARF_UNLOCK(dbg);
 		return (DW_DLV_ERROR);
+	}
 
 	if (table_column == dbg->dbg_frame_cfa_value) {
 		/* Application ask for CFA. */
@@ -313,16 +392,11 @@ dwarf_get_fde_info_for_reg(Dwarf_Fde fde, Dwarf_Half table_column,
 		*offset = CFA.dw_offset_or_block_len;
 	} else {
 		/* Application ask for normal registers. */
-		if (table_column >= dbg->dbg_frame_rule_table_size ||
-		    table_column >= DW_REG_TABLE_SIZE) {
-			DWARF_SET_ERROR(dbg, error, DW_DLE_FRAME_TABLE_COL_BAD);
-			return (DW_DLV_ERROR);
-		}
-
 		*offset_relevant = RL.dw_offset_relevant;
 		*register_num = RL.dw_regnum;
 		*offset = RL.dw_offset_or_block_len;
 	}
+	DWARF_UNLOCK(dbg);
 
 	*row_pc = pc;
 
@@ -354,10 +428,13 @@ dwarf_get_fde_info_for_all_regs(Dwarf_Fde fde, Dwarf_Addr pc_requested,
 		return (DW_DLV_ERROR);
 	}
 
+	DWARF_LOCK(dbg);
 	ret = _dwarf_frame_get_internal_table(fde, pc_requested, &rt, &pc,
 	    error);
-	if (ret != DW_DLE_NONE)
+	if (ret != DW_DLE_NONE) {
+		DWARF_UNLOCK(dbg);
 		return (DW_DLV_ERROR);
+	}
 
 	/*
 	 * Copy the CFA rule to the column intended for holding the CFA,
@@ -387,6 +464,7 @@ dwarf_get_fde_info_for_all_regs(Dwarf_Fde fde, Dwarf_Addr pc_requested,
 		reg_table->rules[i].dw_offset =
 		    rt->rt3_rules[i].dw_offset_or_block_len;
 	}
+	DWARF_UNLOCK(dbg);
 
 	*row_pc = pc;
 
@@ -420,21 +498,25 @@ dwarf_get_fde_info_for_reg3(Dwarf_Fde fde, Dwarf_Half table_column,
 		return (DW_DLV_ERROR);
 	}
 
-	ret = _dwarf_frame_get_internal_table(fde, pc_requested, &rt, &pc,
-	    error);
-	if (ret != DW_DLE_NONE)
-		return (DW_DLV_ERROR);
-
 	if (table_column >= dbg->dbg_frame_rule_table_size) {
 		DWARF_SET_ERROR(dbg, error, DW_DLE_FRAME_TABLE_COL_BAD);
 		return (DW_DLV_ERROR);
 	}
 
+	DWARF_LOCK(dbg);
+	ret = _dwarf_frame_get_internal_table(fde, pc_requested, &rt, &pc,
+	    error);
+	if (ret != DW_DLE_NONE) {
+		DWARF_UNLOCK(dbg);
+		return (DW_DLV_ERROR);
+	}
+
 	*value_type = RL.dw_value_type;
 	*offset_relevant = RL.dw_offset_relevant;
 	*register_num = RL.dw_regnum;
 	*offset_or_block_len = RL.dw_offset_or_block_len;
 	*block_ptr = RL.dw_block_ptr;
+	DWARF_UNLOCK(dbg);
 	*row_pc = pc;
 
 	return (DW_DLV_OK);
@@ -466,16 +548,20 @@ dwarf_get_fde_info_for_cfa_reg3(Dwarf_Fde fde, Dwarf_Addr pc_requested,
 		return (DW_DLV_ERROR);
 	}
 
+	DWARF_LOCK(dbg);
 	ret = _dwarf_frame_get_internal_table(fde, pc_requested, &rt, &pc,
 	    error);
-	if (ret != DW_DLE_NONE)
+	if (ret != DW_DLE_NONE) {
+		DWARF_UNLOCK(dbg);
 		return (DW_DLV_ERROR);
+	}
 
 	*value_type = CFA.dw_value_type;
 	*offset_relevant = CFA.dw_offset_relevant;
 	*register_num = CFA.dw_regnum;
 	*offset_or_block_len = CFA.dw_offset_or_block_len;
 	*block_ptr = CFA.dw_block_ptr;
+	DWARF_UNLOCK(dbg);
 	*row_pc = pc;
 
 	return (DW_DLV_OK);
@@ -509,12 +595,12 @@ dwarf_get_fde_info_for_all_regs3(Dwarf_Fde fde, Dwarf_Addr pc_requested,
 		return (DW_DLV_ERROR);
 	}
 
+	DWARF_LOCK(dbg);
 	ret = _dwarf_frame_get_internal_table(fde, pc_requested, &rt, &pc,
 	    error);
-	if (ret != DW_DLE_NONE)
-		return (DW_DLV_ERROR);
-
-	ret = _dwarf_frame_regtable_copy(dbg, &reg_table, rt, error);
+	if (ret == DW_DLE_NONE)
+		ret = _dwarf_frame_regtable_copy(dbg, &reg_table, rt, error);
+	DWARF_UNLOCK(dbg);
 	if (ret != DW_DLE_NONE)
 		return (DW_DLV_ERROR);
 
@@ -161,3 +161,38 @@ dwarf_object_init(Dwarf_Obj_Access_Interface *iface, Dwarf_Handler errhand,
 
 	return (DW_DLV_OK);
 }
+
+int
+dwarf_set_thread_safe(Dwarf_Debug dbg, Dwarf_Error *error)
+{
+	pthread_mutexattr_t attr;
+	int ret;
+
+	if (dbg == NULL || dbg->dbg_mode != DW_DLC_READ) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_ARGUMENT);
+		return (DW_DLV_ERROR);
+	}
+
+	if (dbg->dbg_thread_safe)
+		return (DW_DLV_OK);
+
+	if (_dwarf_info_preload(dbg, error) != DW_DLE_NONE)
+		return (DW_DLV_ERROR);
+
+	/* Building one lazy table may require building another. */
+	if (pthread_mutexattr_init(&attr) != 0) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
+		return (DW_DLV_ERROR);
+	}
+	(void) pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	ret = pthread_mutex_init(&dbg->dbg_lock, &attr);
+	(void) pthread_mutexattr_destroy(&attr);
+	if (ret != 0) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
+		return (DW_DLV_ERROR);
+	}
+
+	dbg->dbg_thread_safe = 1;
+
+	return (DW_DLV_OK);
+}
@@ -28,8 +28,8 @@
 
 ELFTC_VCSID("$Id$");
 
-int
-dwarf_srclines(Dwarf_Die die, Dwarf_Line **linebuf, Dwarf_Signed *linecount,
+static int
+_dwarf_srclines(Dwarf_Die die, Dwarf_Line **linebuf, Dwarf_Signed *linecount,
     Dwarf_Error *error)
 {
 	Dwarf_LineInfo li;
@@ -52,6 +52,7 @@ dwarf_srclines(Dwarf_Die die, Dwarf_Line **linebuf, Dwarf_Signed *linecount,
 	}
 
 	cu = die->die_cu;
+	cu->cu_lastuse = dbg->dbg_epoch;
 	if (cu->cu_lineinfo == NULL) {
 		if (_dwarf_lineno_init(die, at->u[0].u64, error) !=
 		    DW_DLE_NONE)
@@ -90,8 +91,8 @@ dwarf_srclines(Dwarf_Die die, Dwarf_Line **linebuf, Dwarf_Signed *linecount,
 	return (DW_DLV_OK);
 }
 
-int
-dwarf_srcfiles(Dwarf_Die die, char ***srcfiles, Dwarf_Signed *srccount,
+static int
+_dwarf_srcfiles(Dwarf_Die die, char ***srcfiles, Dwarf_Signed *srccount,
     Dwarf_Error *error)
 {
 	Dwarf_LineInfo li;
@@ -114,6 +115,7 @@ dwarf_srcfiles(Dwarf_Die die, char ***srcfiles, Dwarf_Signed *srccount,
 	}
 
 	cu = die->die_cu;
+	cu->cu_lastuse = dbg->dbg_epoch;
 	if (cu->cu_lineinfo == NULL) {
 		if (_dwarf_lineno_init(die, at->u[0].u64, error) !=
 		    DW_DLE_NONE)
@@ -155,6 +157,46 @@ dwarf_srcfiles(Dwarf_Die die, char ***srcfiles, Dwarf_Signed *srccount,
 	return (DW_DLV_OK);
 }
 
+/*
+ * The line information of a CU is decoded on first use, under the lock
+ * of a thread-safe consumer.
+ */
+int
+dwarf_srclines(Dwarf_Die die, Dwarf_Line **linebuf, Dwarf_Signed *linecount,
+    Dwarf_Error *error)
+{
+	int ret;
+
+	if (die == NULL) {
+		DWARF_SET_ERROR(NULL, error, DW_DLE_ARGUMENT);
+		return (DW_DLV_ERROR);
+	}
+
+	DWARF_LOCK(die->die_dbg);
+	ret = _dwarf_srclines(die, linebuf, linecount, error);
+	DWARF_UNLOCK(die->die_dbg);
+
+	return (ret);
+}
+
+int
+dwarf_srcfiles(Dwarf_Die die, char ***srcfiles, Dwarf_Signed *srccount,
+    Dwarf_Error *error)
+{
+	int ret;
+
+	if (die == NULL) {
+		DWARF_SET_ERROR(NULL, error, DW_DLE_ARGUMENT);
+		return (DW_DLV_ERROR);
+	}
+
+	DWARF_LOCK(die->die_dbg);
+	ret = _dwarf_srcfiles(die, srcfiles, srccount, error);
+	DWARF_UNLOCK(die->die_dbg);
+
+	return (ret);
+}
+
 int
 dwarf_linebeginstatement(Dwarf_Line ln, Dwarf_Bool *ret_bool,
     Dwarf_Error *error)
@@ -53,6 +53,26 @@ copy_locdesc(Dwarf_Debug dbg, Dwarf_Locdesc *dst, Dwarf_Locdesc *src,
 	return (DW_DLE_NONE);
 }
 
+static int
+loclist_attr(Dwarf_Half attr)
+{
+
+	switch (attr) {
+	case DW_AT_location:
+	case DW_AT_string_length:
+	case DW_AT_return_addr:
+	case DW_AT_data_member_location:
+	case DW_AT_frame_base:
+	case DW_AT_segment:
+	case DW_AT_static_link:
+	case DW_AT_use_location:
+	case DW_AT_vtable_elem_location:
+		return (1);
+	default:
+		return (0);
+	}
+}
+
 int
 dwarf_loclist_n(Dwarf_Attribute at, Dwarf_Locdesc ***llbuf,
     Dwarf_Signed *listlen, Dwarf_Error *error)
@@ -67,16 +87,7 @@ dwarf_loclist_n(Dwarf_Attribute at, Dwarf_Locdesc ***llbuf,
 		return (DW_DLV_ERROR);
 	}
 
-	switch (at->at_attrib) {
-	case DW_AT_location:
-	case DW_AT_string_length:
-	case DW_AT_return_addr:
-	case DW_AT_data_member_location:
-	case DW_AT_frame_base:
-	case DW_AT_segment:
-	case DW_AT_static_link:
-	case DW_AT_use_location:
-	case DW_AT_vtable_elem_location:
+	if (loclist_attr(at->at_attrib)) {
 		switch (at->at_form) {
 		case DW_FORM_data4:
 		case DW_FORM_data8:
@@ -92,6 +103,7 @@ dwarf_loclist_n(Dwarf_Attribute at, Dwarf_Locdesc ***llbuf,
 			}
 			/* FALLTHROUGH */
 		case DW_FORM_sec_offset:
+		case DW_FORM_loclistx:
 			ret = _dwarf_loclist_find(dbg, at->at_die->die_cu,
 			    at->u[0].u64, llbuf, listlen, NULL, error);
 			if (ret == DW_DLE_NO_ENTRY) {
@@ -135,7 +147,7 @@ dwarf_loclist_n(Dwarf_Attribute at, Dwarf_Locdesc ***llbuf,
 			DWARF_SET_ERROR(dbg, error, DW_DLE_ATTR_FORM_BAD);
 			return (DW_DLV_NO_ENTRY);
 		}
-	default:
+	} else {
 		/* Wrong attr supplied. */
 		DWARF_SET_ERROR(dbg, error, DW_DLE_ARGUMENT);
 		return (DW_DLV_ERROR);
@@ -147,17 +159,26 @@ dwarf_loclist(Dwarf_Attribute at, Dwarf_Locdesc **llbuf,
     Dwarf_Signed *listlen, Dwarf_Error *error)
 {
 	Dwarf_Locdesc **_llbuf;
-	int i, ret;
+	int i, first, ret;
 
 	ret = dwarf_loclist_n(at, &_llbuf, listlen, error);
 	if (ret != DW_DLV_OK)
 		return (ret);
 
-	/* Only return the first location description of the list. */
-	*llbuf = _llbuf[0];
+	/*
+	 * Only return the first location description of the list.
+	 * DWARF 5 location lists start with a synthesized base address
+	 * selection entry, which is skipped.
+	 */
+	first = 0;
+	if (at->at_die->die_cu->cu_version >= 5 && *listlen > 1)
+		first = 1;
+	*llbuf = _llbuf[first];
 
 	/* Free the rest of the list. */
-	for (i = 1; i < *listlen; i++) {
+	for (i = 0; i < *listlen; i++) {
+		if (i == first)
+			continue;
 		if (_llbuf[i]->ld_s)
 			free(_llbuf[i]->ld_s);
 		free(_llbuf[i]);
@@ -169,6 +190,57 @@ dwarf_loclist(Dwarf_Attribute at, Dwarf_Locdesc **llbuf,
 	return (DW_DLV_OK);
 }
 
+int
+dwarf_loclist_at_pc(Dwarf_Attribute at, Dwarf_Addr pc, Dwarf_Locdesc **ret_ld,
+    Dwarf_Error *error)
+{
+	Dwarf_Debug dbg;
+	int ret;
+
+	dbg = at != NULL ? at->at_die->die_dbg : NULL;
+
+	if (at == NULL || ret_ld == NULL || !loclist_attr(at->at_attrib)) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_ARGUMENT);
+		return (DW_DLV_ERROR);
+	}
+
+	switch (at->at_form) {
+	case DW_FORM_data4:
+	case DW_FORM_data8:
+		/* See dwarf_loclist_n(). */
+		if (at->at_die->die_cu->cu_version >= 4) {
+			DWARF_SET_ERROR(dbg, error, DW_DLE_NO_ENTRY);
+			return (DW_DLV_NO_ENTRY);
+		}
+		/* FALLTHROUGH */
+	case DW_FORM_sec_offset:
+	case DW_FORM_loclistx:
+		ret = _dwarf_loclist_find_pc(dbg, at->at_die->die_cu,
+		    at->u[0].u64, pc, ret_ld, error);
+		if (ret == DW_DLE_NO_ENTRY)
+			return (DW_DLV_NO_ENTRY);
+		if (ret != DW_DLE_NONE)
+			return (DW_DLV_ERROR);
+		return (DW_DLV_OK);
+	case DW_FORM_block:
+	case DW_FORM_block1:
+	case DW_FORM_block2:
+	case DW_FORM_block4:
+	case DW_FORM_exprloc:
+		/* A single location expression is valid at every address. */
+		if (at->at_ld == NULL) {
+			ret = _dwarf_loc_add(at->at_die, at, error);
+			if (ret != DW_DLE_NONE)
+				return (DW_DLV_ERROR);
+		}
+		*ret_ld = at->at_ld;
+		return (DW_DLV_OK);
+	default:
+		DWARF_SET_ERROR(dbg, error, DW_DLE_ATTR_FORM_BAD);
+		return (DW_DLV_NO_ENTRY);
+	}
+}
+
 int
 dwarf_get_loclist_entry(Dwarf_Debug dbg, Dwarf_Unsigned offset,
     Dwarf_Addr *hipc, Dwarf_Addr *lopc, Dwarf_Ptr *data,
@@ -214,8 +286,10 @@ dwarf_get_loclist_entry(Dwarf_Debug dbg, Dwarf_Unsigned offset,
 		}
 	}
 
-	ds = _dwarf_find_section(dbg, ".debug_loc");
-	assert(ds != NULL);
+	ds = _dwarf_locate_section(dbg,
+	    STAILQ_FIRST(&dbg->dbg_cu)->cu_version >= 5 ? ".debug_loclists" :
+	    ".debug_loc");
+	assert(ds != NULL && ds->ds_loaded);
 	*data = (uint8_t *) ds->ds_data + offset;
 	*next_entry = offset + *entry_len;
 
@@ -52,20 +52,23 @@ dwarf_get_macro_details(Dwarf_Debug dbg, Dwarf_Off offset,
 {
 	Dwarf_MacroSet ms;
 	Dwarf_Unsigned cnt;
-	int i;
+	int i, ret;
 
 	if (dbg == NULL || entry_cnt == NULL || details == NULL) {
 		DWARF_SET_ERROR(dbg, error, DW_DLE_ARGUMENT);
 		return (DW_DLV_ERROR);
 	}
 
+	DWARF_LOCK(dbg);
+	ret = DW_DLE_NONE;
+	if (STAILQ_EMPTY(&dbg->dbg_mslist))
+		ret = _dwarf_macinfo_init(dbg, error);
+	DWARF_UNLOCK(dbg);
+	if (ret != DW_DLE_NONE)
+		return (DW_DLV_ERROR);
 	if (STAILQ_EMPTY(&dbg->dbg_mslist)) {
-		if (_dwarf_macinfo_init(dbg, error) != DW_DLE_NONE)
-			return (DW_DLV_ERROR);
-		if (STAILQ_EMPTY(&dbg->dbg_mslist)) {
-			DWARF_SET_ERROR(dbg, error, DW_DLE_NO_ENTRY);
-			return (DW_DLV_NO_ENTRY);
-		}
+		DWARF_SET_ERROR(dbg, error, DW_DLE_NO_ENTRY);
+		return (DW_DLV_NO_ENTRY);
 	}
 
 	STAILQ_FOREACH(ms, &dbg->dbg_mslist, ms_next) {
@@ -0,0 +1,70 @@
+/*-
+ * Copyright (c) 2026 The Elftoolchain Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "_libdwarf.h"
+
+ELFTC_VCSID("$Id$");
+
+int
+dwarf_get_memory_usage(Dwarf_Debug dbg, Dwarf_Memory_Usage *mu,
+    Dwarf_Error *error)
+{
+
+	if (dbg == NULL || mu == NULL || dbg->dbg_mode != DW_DLC_READ) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_ARGUMENT);
+		return (DW_DLV_ERROR);
+	}
+
+	DWARF_LOCK(dbg);
+	_dwarf_memory_usage(dbg, mu);
+	DWARF_UNLOCK(dbg);
+
+	return (DW_DLV_OK);
+}
+
+int
+dwarf_trim(Dwarf_Debug dbg, Dwarf_Unsigned idle, Dwarf_Unsigned *freed,
+    Dwarf_Error *error)
+{
+	Dwarf_Memory_Usage before, after;
+
+	if (dbg == NULL || dbg->dbg_mode != DW_DLC_READ) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_ARGUMENT);
+		return (DW_DLV_ERROR);
+	}
+
+	DWARF_LOCK(dbg);
+	if (freed != NULL)
+		_dwarf_memory_usage(dbg, &before);
+	_dwarf_memory_trim(dbg, idle);
+	if (freed != NULL) {
+		_dwarf_memory_usage(dbg, &after);
+		*freed = before.dmu_total - after.dmu_total;
+	}
+	DWARF_UNLOCK(dbg);
+
+	return (DW_DLV_OK);
+}
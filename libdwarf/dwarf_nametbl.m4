@@ -39,17 +39,20 @@ dwarf_get_$1s(Dwarf_Debug dbg, Dwarf_$2 **$1s,
 		return (DW_DLV_ERROR);
 	}
 
+	DWARF_LOCK(dbg);
+	ret = DW_DLE_NONE;
 	if (dbg->dbg_$1s == NULL) {
-		if ((ds = _dwarf_find_section(dbg, ".debug_$4")) != NULL) {
+		ret = _dwarf_find_section(dbg, ".debug_$4", &ds, error);
+		if (ret == DW_DLE_NONE && ds != NULL)
 			ret = _dwarf_nametbl_init(dbg, &dbg->dbg_$1s, ds,
 			    error);
-			if (ret != DW_DLE_NONE)
-				return (DW_DLV_ERROR);
-		}
-		if (dbg->dbg_$1s == NULL) {
-			DWARF_SET_ERROR(dbg, error, DW_DLE_NO_ENTRY);
-			return (DW_DLV_NO_ENTRY);
-		}
+	}
+	DWARF_UNLOCK(dbg);
+	if (ret != DW_DLE_NONE)
+		return (DW_DLV_ERROR);
+	if (dbg->dbg_$1s == NULL) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_NO_ENTRY);
+		return (DW_DLV_NO_ENTRY);
 	}
 
 	*$1s = dbg->dbg_$1s->ns_array;
@@ -58,6 +61,41 @@ dwarf_get_$1s(Dwarf_Debug dbg, Dwarf_$2 **$1s,
 	return (DW_DLV_OK);
 }
 
+int
+dwarf_$1s_lookup(Dwarf_Debug dbg, const char *name, Dwarf_$2 **$1s,
+    Dwarf_Signed *ret_count, Dwarf_Error *error)
+{
+	Dwarf_Section *ds;
+	int ret;
+
+	if (dbg == NULL || name == NULL || $1s == NULL || ret_count == NULL) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_ARGUMENT);
+		return (DW_DLV_ERROR);
+	}
+
+	DWARF_LOCK(dbg);
+	ret = DW_DLE_NONE;
+	if (dbg->dbg_$1s == NULL) {
+		ret = _dwarf_find_section(dbg, ".debug_$4", &ds, error);
+		if (ret == DW_DLE_NONE && ds != NULL)
+			ret = _dwarf_nametbl_init(dbg, &dbg->dbg_$1s, ds,
+			    error);
+	}
+	if (ret == DW_DLE_NONE && dbg->dbg_$1s != NULL &&
+	    dbg->dbg_$1s->ns_hash == NULL)
+		ret = _dwarf_nametbl_hash_init(dbg, dbg->dbg_$1s, error);
+	DWARF_UNLOCK(dbg);
+	if (ret != DW_DLE_NONE)
+		return (DW_DLV_ERROR);
+	if (dbg->dbg_$1s == NULL || _dwarf_nametbl_lookup(dbg->dbg_$1s,
+	    name, $1s, ret_count) != DW_DLE_NONE) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_NO_ENTRY);
+		return (DW_DLV_NO_ENTRY);
+	}
+
+	return (DW_DLV_OK);
+}
+
 int
 dwarf_$3name(Dwarf_$2 $1, char **ret_name, Dwarf_Error *error)
 {
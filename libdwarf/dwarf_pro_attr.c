@@ -374,8 +374,6 @@ dwarf_add_AT_string(Dwarf_P_Debug dbg, Dwarf_P_Die die, Dwarf_Half attr,
 		return (DW_DLV_BADADDR);
 	}
 
-	/* XXX Add DW_FORM_string style string instead? */
-
 	if (_dwarf_add_string_attr(die, &at, attr, string, error) !=
 	    DW_DLE_NONE)
 		return (DW_DLV_BADADDR);
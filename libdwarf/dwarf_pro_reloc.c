@@ -95,15 +95,13 @@ dwarf_get_relocation_info(Dwarf_P_Debug dbg, Dwarf_Signed *elf_section_index,
 			DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
 			return (DW_DLV_ERROR);
 		}
-		for (i = 0, dre = STAILQ_FIRST(&drs->drs_dre);
-		    (Dwarf_Unsigned) i < *reloc_entry_count && dre != NULL;
-		    i++, dre = STAILQ_NEXT(dre, dre_next)) {
+		for (i = 0; (Dwarf_Unsigned) i < *reloc_entry_count; i++) {
+			dre = &drs->drs_dre[i];
 			drs->drs_drd[i].drd_type = dre->dre_type;
 			drs->drs_drd[i].drd_length = dre->dre_length;
 			drs->drs_drd[i].drd_offset = dre->dre_offset;
 			drs->drs_drd[i].drd_symbol_index = dre->dre_symndx;
 		}
-		assert((Dwarf_Unsigned) i == *reloc_entry_count && dre == NULL);
 	}
 
 	*reloc_buffer = drs->drs_drd;
@@ -64,6 +64,10 @@ dwarf_get_section_max_offsets_b(Dwarf_Debug dbg, Dwarf_Unsigned *debug_info,
 	SET(debug_types, 0);
 
 	for (i = 0; (Dwarf_Unsigned) i < dbg->dbg_seccnt; i++) {
+		/* The size of a ".zdebug_*" section is known once loaded. */
+		if (dbg->dbg_section[i].ds_zname != NULL)
+			(void) _dwarf_section_load(dbg, &dbg->dbg_section[i],
+			    NULL);
 		n = dbg->dbg_section[i].ds_name;
 		sz = dbg->dbg_section[i].ds_size;
 		if (!strcmp(n, ".debug_info"))
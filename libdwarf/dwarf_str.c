@@ -39,7 +39,8 @@ dwarf_get_str(Dwarf_Debug dbg, Dwarf_Off offset, char **string,
 		return (DW_DLV_ERROR);
 	}
 
-	ds = _dwarf_find_section(dbg, ".debug_str");
+	if (_dwarf_find_section(dbg, ".debug_str", &ds, error) != DW_DLE_NONE)
+		return (DW_DLV_ERROR);
 	if (ds == NULL) {
 		DWARF_SET_ERROR(dbg, error, DW_DLE_NO_ENTRY);
 		return (DW_DLV_NO_ENTRY);
@@ -49,6 +49,7 @@ typedef struct _Dwarf_Attribute *Dwarf_P_Attribute;
 typedef struct _Dwarf_AttrDef	*Dwarf_AttrDef;
 typedef struct _Dwarf_Cie	*Dwarf_Cie;
 typedef struct _Dwarf_Cie	*Dwarf_P_Cie;
+typedef struct _Dwarf_CU_Cursor	*Dwarf_CU_Cursor;
 typedef struct _Dwarf_Debug	*Dwarf_Debug;
 typedef struct _Dwarf_Debug	*Dwarf_P_Debug;
 typedef struct _Dwarf_Die	*Dwarf_Die;
@@ -155,7 +156,13 @@ enum Dwarf_Form_Class {
 	DW_FORM_CLASS_MACPTR,
 	DW_FORM_CLASS_RANGELISTPTR,
 	DW_FORM_CLASS_REFERENCE,
-	DW_FORM_CLASS_STRING
+	DW_FORM_CLASS_STRING,
+	DW_FORM_CLASS_ADDRPTR,
+	DW_FORM_CLASS_LOCLIST,
+	DW_FORM_CLASS_LOCLISTSPTR,
+	DW_FORM_CLASS_RNGLIST,
+	DW_FORM_CLASS_RNGLISTSPTR,
+	DW_FORM_CLASS_STROFFSETSPTR
 };
 
 #ifndef	DW_FRAME_HIGHEST_NORMAL_REGISTER
@@ -243,6 +250,25 @@ typedef struct {
 	char		*dmd_macro;
 } Dwarf_Macro_Details;
 
+/*
+ * Memory held by a consumer instance, in bytes, as reported by
+ * dwarf_get_memory_usage(3).
+ */
+
+typedef struct {
+	Dwarf_Unsigned	dmu_units;	/* Unit descriptors. */
+	Dwarf_Unsigned	dmu_abbrevs;	/* Abbreviation tables. */
+	Dwarf_Unsigned	dmu_lines;	/* Line number tables. */
+	Dwarf_Unsigned	dmu_ranges;	/* Decoded range lists. */
+	Dwarf_Unsigned	dmu_loclists;	/* Decoded location lists. */
+	Dwarf_Unsigned	dmu_aranges;	/* Address range tables. */
+	Dwarf_Unsigned	dmu_frames;	/* CIEs, FDEs and FDE indexes. */
+	Dwarf_Unsigned	dmu_names;	/* Name lookup tables. */
+	Dwarf_Unsigned	dmu_macros;	/* Macro information. */
+	Dwarf_Unsigned	dmu_sections;	/* Private copies of section data. */
+	Dwarf_Unsigned	dmu_total;	/* Sum of the above. */
+} Dwarf_Memory_Usage;
+
 /*
  * Symbols denoting allocation types, for use with dwarf_dealloc(3).
  */
@@ -335,6 +361,10 @@ enum {
 	DW_DLE_ARANGE_OFFSET_BAD,	/* Invalid arange offset. */
 	DW_DLE_DEBUG_MACRO_INCONSISTENT,/* Invalid macinfo data. */
 	DW_DLE_ELF_SECT_ERR,		/* Application callback failed. */
+	DW_DLE_COMPRESSION,		/* Invalid compressed section. */
+	DW_DLE_INDEX_BAD,		/* Invalid string/address index. */
+	DW_DLE_DEBUG_NAMES_BAD,		/* Invalid .debug_names section. */
+	DW_DLE_UNIT_INDEX_BAD,		/* Invalid split unit index. */
 	DW_DLE_NUM			/* Max error number. */
 };
 
@@ -427,6 +457,9 @@ typedef void (*Dwarf_Handler)(Dwarf_Error, Dwarf_Ptr);
 #define DW_DLC_SYMBOLIC_RELOCATIONS	0x04000000
 #define DW_DLC_TARGET_BIGENDIAN		0x08000000
 #define DW_DLC_TARGET_LITTLEENDIAN	0x00100000
+#define DW_DLC_DEBUG_NAMES		0x00200000
+#define DW_DLC_STRING_TAIL_MERGE	0x00400000
+#define DW_DLC_NO_SECTION_RELOCATIONS	0x00800000
 
 /*
  * Instruction set architectures supported by this implementation.
@@ -530,13 +563,22 @@ int		dwarf_bitoffset(Dwarf_Die, Dwarf_Unsigned *, Dwarf_Error *);
 int		dwarf_bitsize(Dwarf_Die, Dwarf_Unsigned *, Dwarf_Error *);
 int		dwarf_bytesize(Dwarf_Die, Dwarf_Unsigned *, Dwarf_Error *);
 int		dwarf_child(Dwarf_Die, Dwarf_Die *, Dwarf_Error *);
+void		dwarf_cu_cursor_dealloc(Dwarf_CU_Cursor);
+int		dwarf_cu_cursor_init(Dwarf_Debug, Dwarf_Bool, Dwarf_CU_Cursor *,
+		    Dwarf_Error *);
+int		dwarf_cu_cursor_next(Dwarf_CU_Cursor, Dwarf_Die *,
+		    Dwarf_Error *);
 void		dwarf_dealloc(Dwarf_Debug, Dwarf_Ptr, Dwarf_Unsigned);
+int		dwarf_debugnames_lookup(Dwarf_Debug, const char *, Dwarf_Half,
+		    Dwarf_Off **, Dwarf_Signed *, Dwarf_Error *);
 int		dwarf_def_macro(Dwarf_P_Debug, Dwarf_Unsigned, char *, char *,
 		    Dwarf_Error *);
 int		dwarf_die_CU_offset(Dwarf_Die, Dwarf_Off *, Dwarf_Error *);
 int		dwarf_die_CU_offset_range(Dwarf_Die, Dwarf_Off *, Dwarf_Off *,
 		    Dwarf_Error *);
 int		dwarf_die_abbrev_code(Dwarf_Die);
+int		dwarf_die_from_hash_signature(Dwarf_Debug, Dwarf_Sig8 *,
+		    const char *, Dwarf_Die *, Dwarf_Error *);
 Dwarf_P_Die	dwarf_die_link(Dwarf_P_Die, Dwarf_P_Die, Dwarf_P_Die,
 		    Dwarf_P_Die, Dwarf_P_Die, Dwarf_Error *);
 int		dwarf_diename(Dwarf_Die, char **, Dwarf_Error *);
@@ -555,6 +597,8 @@ Dwarf_P_Fde	dwarf_fde_cfa_offset(Dwarf_P_Fde, Dwarf_Unsigned, Dwarf_Signed,
 		    Dwarf_Error *);
 void		dwarf_fde_cie_list_dealloc(Dwarf_Debug, Dwarf_Cie *,
 		    Dwarf_Signed, Dwarf_Fde *, Dwarf_Signed);
+int		dwarf_find_die_given_sig8(Dwarf_Debug, Dwarf_Sig8 *,
+		    Dwarf_Die *, Dwarf_Bool *, Dwarf_Error *);
 char		*dwarf_find_macro_value_start(char *);
 int		dwarf_finish(Dwarf_Debug, Dwarf_Error *);
 int		dwarf_formaddr(Dwarf_Attribute, Dwarf_Addr *, Dwarf_Error *);
@@ -575,6 +619,8 @@ int		dwarf_func_name_offsets(Dwarf_Func, char **,
 		    Dwarf_Off *, Dwarf_Off *, Dwarf_Error *);
 int		dwarf_funcname(Dwarf_Func, char **, Dwarf_Error *);
 void		dwarf_funcs_dealloc(Dwarf_Debug, Dwarf_Func *, Dwarf_Signed);
+int		dwarf_funcs_lookup(Dwarf_Debug, const char *, Dwarf_Func **,
+		    Dwarf_Signed *, Dwarf_Error *);
 int		dwarf_get_ACCESS_name(unsigned, const char **);
 int		dwarf_get_ATE_name(unsigned, const char **);
 int		dwarf_get_AT_name(unsigned, const char **);
@@ -631,6 +677,10 @@ Dwarf_Bool	dwarf_get_die_infotypes_flag(Dwarf_Die);
 int		dwarf_get_elf(Dwarf_Debug, Elf **, Dwarf_Error *);
 int		dwarf_get_fde_at_pc(Dwarf_Fde *, Dwarf_Addr, Dwarf_Fde *,
 		    Dwarf_Addr *, Dwarf_Addr *, Dwarf_Error *);
+int		dwarf_get_fde_for_pc(Dwarf_Debug, Dwarf_Addr, Dwarf_Fde *,
+		    Dwarf_Addr *, Dwarf_Addr *, Dwarf_Error *);
+int		dwarf_get_fde_for_pc_eh(Dwarf_Debug, Dwarf_Addr, Dwarf_Fde *,
+		    Dwarf_Addr *, Dwarf_Addr *, Dwarf_Error *);
 int		dwarf_get_fde_info_for_all_regs(Dwarf_Fde, Dwarf_Addr,
 		    Dwarf_Regtable *, Dwarf_Addr *, Dwarf_Error *);
 int		dwarf_get_fde_info_for_all_regs3(Dwarf_Fde, Dwarf_Addr,
@@ -666,6 +716,8 @@ int		dwarf_get_loclist_entry(Dwarf_Debug, Dwarf_Unsigned,
 		    Dwarf_Unsigned *, Dwarf_Error *);
 int		dwarf_get_macro_details(Dwarf_Debug, Dwarf_Off, Dwarf_Unsigned,
 		    Dwarf_Signed *, Dwarf_Macro_Details **, Dwarf_Error *);
+int		dwarf_get_memory_usage(Dwarf_Debug, Dwarf_Memory_Usage *,
+		    Dwarf_Error *);
 int		dwarf_get_pubtypes(Dwarf_Debug, Dwarf_Type **, Dwarf_Signed *,
 		    Dwarf_Error *);
 int		dwarf_get_ranges(Dwarf_Debug, Dwarf_Off, Dwarf_Ranges **,
@@ -692,6 +744,7 @@ int		dwarf_get_section_max_offsets_b(Dwarf_Debug, Dwarf_Unsigned *,
 		    Dwarf_Unsigned *, Dwarf_Unsigned *);
 int		dwarf_get_str(Dwarf_Debug, Dwarf_Off, char **, Dwarf_Signed *,
 		    Dwarf_Error *);
+int		dwarf_get_tied_dbg(Dwarf_Debug, Dwarf_Debug *, Dwarf_Error *);
 int		dwarf_get_types(Dwarf_Debug, Dwarf_Type **, Dwarf_Signed *,
 		    Dwarf_Error *);
 int		dwarf_get_vars(Dwarf_Debug, Dwarf_Var **, Dwarf_Signed *,
@@ -706,6 +759,8 @@ int		dwarf_global_formref(Dwarf_Attribute, Dwarf_Off *,
 int		dwarf_global_name_offsets(Dwarf_Global, char **,
 		    Dwarf_Off *, Dwarf_Off *, Dwarf_Error *);
 void		dwarf_globals_dealloc(Dwarf_Debug, Dwarf_Global *, Dwarf_Signed);
+int		dwarf_globals_lookup(Dwarf_Debug, const char *, Dwarf_Global **,
+		    Dwarf_Signed *, Dwarf_Error *);
 int		dwarf_globname(Dwarf_Global, char **, Dwarf_Error *);
 int		dwarf_hasattr(Dwarf_Die, Dwarf_Half, Dwarf_Bool *,
 		    Dwarf_Error *);
@@ -731,6 +786,8 @@ Dwarf_Unsigned	dwarf_lne_set_address(Dwarf_P_Debug, Dwarf_Addr, Dwarf_Unsigned,
 		    Dwarf_Error *);
 int		dwarf_loclist(Dwarf_Attribute, Dwarf_Locdesc **, Dwarf_Signed *,
 		    Dwarf_Error *);
+int		dwarf_loclist_at_pc(Dwarf_Attribute, Dwarf_Addr,
+		    Dwarf_Locdesc **, Dwarf_Error *);
 int		dwarf_loclist_from_expr(Dwarf_Debug, Dwarf_Ptr, Dwarf_Unsigned,
 		    Dwarf_Locdesc **, Dwarf_Signed *, Dwarf_Error *);
 int		dwarf_loclist_from_expr_a(Dwarf_Debug, Dwarf_Ptr,
@@ -779,14 +836,19 @@ int		dwarf_pubtype_name_offsets(Dwarf_Type, char **,
 		    Dwarf_Off *, Dwarf_Off *, Dwarf_Error *);
 int		dwarf_pubtypename(Dwarf_Type, char **, Dwarf_Error *);
 void		dwarf_pubtypes_dealloc(Dwarf_Debug, Dwarf_Type *, Dwarf_Signed);
+int		dwarf_pubtypes_lookup(Dwarf_Debug, const char *, Dwarf_Type **,
+		    Dwarf_Signed *, Dwarf_Error *);
 void		dwarf_ranges_dealloc(Dwarf_Debug, Dwarf_Ranges *, Dwarf_Signed);
 void		dwarf_reset_section_bytes(Dwarf_P_Debug);
+int		dwarf_set_aranges_synthesis(Dwarf_Debug, int);
 Dwarf_Half	dwarf_set_frame_cfa_value(Dwarf_Debug, Dwarf_Half);
 Dwarf_Half	dwarf_set_frame_rule_initial_value(Dwarf_Debug, Dwarf_Half);
 Dwarf_Half	dwarf_set_frame_rule_table_size(Dwarf_Debug, Dwarf_Half);
 Dwarf_Half	dwarf_set_frame_same_value(Dwarf_Debug, Dwarf_Half);
 Dwarf_Half	dwarf_set_frame_undefined_value(Dwarf_Debug, Dwarf_Half);
 int		dwarf_set_reloc_application(int);
+int		dwarf_set_thread_safe(Dwarf_Debug, Dwarf_Error *);
+int		dwarf_set_tied_dbg(Dwarf_Debug, Dwarf_Debug, Dwarf_Error *);
 Dwarf_Ptr	dwarf_seterrarg(Dwarf_Debug, Dwarf_Ptr);
 Dwarf_Handler	dwarf_seterrhand(Dwarf_Debug, Dwarf_Handler);
 int		dwarf_siblingof(Dwarf_Debug, Dwarf_Die, Dwarf_Die *, Dwarf_Error *);
@@ -802,12 +864,16 @@ int		dwarf_start_macro_file(Dwarf_P_Debug, Dwarf_Unsigned,
 		    Dwarf_Unsigned, Dwarf_Error *);
 int		dwarf_tag(Dwarf_Die, Dwarf_Half *, Dwarf_Error *);
 Dwarf_Signed	dwarf_transform_to_disk_form(Dwarf_P_Debug, Dwarf_Error *);
+int		dwarf_trim(Dwarf_Debug, Dwarf_Unsigned, Dwarf_Unsigned *,
+		    Dwarf_Error *);
 int		dwarf_type_cu_offset(Dwarf_Type, Dwarf_Off *, Dwarf_Error *);
 int		dwarf_type_die_offset(Dwarf_Type, Dwarf_Off *, Dwarf_Error *);
 int		dwarf_type_name_offsets(Dwarf_Type, char **,
 		    Dwarf_Off *, Dwarf_Off *, Dwarf_Error *);
 int		dwarf_typename(Dwarf_Type, char **, Dwarf_Error *);
 void		dwarf_types_dealloc(Dwarf_Debug, Dwarf_Type *, Dwarf_Signed);
+int		dwarf_types_lookup(Dwarf_Debug, const char *, Dwarf_Type **,
+		    Dwarf_Signed *, Dwarf_Error *);
 int		dwarf_undef_macro(Dwarf_P_Debug, Dwarf_Unsigned, char *,
 		    Dwarf_Error *);
 int		dwarf_var_cu_offset(Dwarf_Var, Dwarf_Off *, Dwarf_Error *);
@@ -817,6 +883,8 @@ int		dwarf_var_name_offsets(Dwarf_Var, char **,
 		    Dwarf_Off *, Dwarf_Off *, Dwarf_Error *);
 int		dwarf_varname(Dwarf_Var, char **, Dwarf_Error *);
 void		dwarf_vars_dealloc(Dwarf_Debug, Dwarf_Var *, Dwarf_Signed);
+int		dwarf_vars_lookup(Dwarf_Debug, const char *, Dwarf_Var **,
+		    Dwarf_Signed *, Dwarf_Error *);
 int		dwarf_vendor_ext(Dwarf_P_Debug, Dwarf_Unsigned, char *,
 		    Dwarf_Error *);
 int		dwarf_weak_cu_offset(Dwarf_Weak, Dwarf_Off *, Dwarf_Error *);
@@ -826,6 +894,8 @@ int		dwarf_weak_name_offsets(Dwarf_Weak, char **,
 		    Dwarf_Off *, Dwarf_Off *, Dwarf_Error *);
 int		dwarf_weakname(Dwarf_Weak, char **, Dwarf_Error *);
 void		dwarf_weaks_dealloc(Dwarf_Debug, Dwarf_Weak *, Dwarf_Signed);
+int		dwarf_weaks_lookup(Dwarf_Debug, const char *, Dwarf_Weak **,
+		    Dwarf_Signed *, Dwarf_Error *);
 int		dwarf_whatattr(Dwarf_Attribute, Dwarf_Half *, Dwarf_Error *);
 int		dwarf_whatform(Dwarf_Attribute, Dwarf_Half *, Dwarf_Error *);
 int		dwarf_whatform_direct(Dwarf_Attribute, Dwarf_Half *,
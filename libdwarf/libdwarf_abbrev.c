@@ -50,6 +50,8 @@ _dwarf_abbrev_add(Dwarf_CU cu, uint64_t entry, uint64_t tag, uint8_t children,
 	ab->ab_offset	= aboff;
 	ab->ab_length	= 0;	/* fill in later. */
 	ab->ab_atnum	= 0;	/* fill in later. */
+	ab->ab_usecnt	= 0;
+	ab->ab_key	= NULL;
 
 	/* Initialise the list of attribute definitions. */
 	STAILQ_INIT(&ab->ab_attrdef);
@@ -85,6 +87,7 @@ _dwarf_attrdef_add(Dwarf_Debug dbg, Dwarf_Abbrev ab, uint64_t attr,
 	ad->ad_attrib	= attr;
 	ad->ad_form	= form;
 	ad->ad_offset	= adoff;
+	ad->ad_const	= 0;
 
 	/* Add the attribute definition to the list in the abbrev. */
 	STAILQ_INSERT_TAIL(&ab->ab_attrdef, ad, ad_next);
@@ -102,6 +105,7 @@ int
 _dwarf_abbrev_parse(Dwarf_Debug dbg, Dwarf_CU cu, Dwarf_Unsigned *offset,
     Dwarf_Abbrev *abp, Dwarf_Error *error)
 {
+	Dwarf_AttrDef ad;
 	Dwarf_Section *ds;
 	uint64_t attr;
 	uint64_t entry;
@@ -109,12 +113,15 @@ _dwarf_abbrev_parse(Dwarf_Debug dbg, Dwarf_CU cu, Dwarf_Unsigned *offset,
 	uint64_t aboff;
 	uint64_t adoff;
 	uint64_t tag;
+	int64_t cval;
 	uint8_t children;
 	int ret;
 
 	assert(abp != NULL);
 
-	ds = _dwarf_find_section(dbg, ".debug_abbrev");
+	ret = _dwarf_find_section(dbg, ".debug_abbrev", &ds, error);
+	if (ret != DW_DLE_NONE)
+		return (ret);
 	assert(ds != NULL);
 
 	if (*offset >= ds->ds_size)
@@ -144,10 +151,16 @@ _dwarf_abbrev_parse(Dwarf_Debug dbg, Dwarf_CU cu, Dwarf_Unsigned *offset,
 		adoff = *offset;
 		attr = _dwarf_read_uleb128(ds->ds_data, offset);
 		form = _dwarf_read_uleb128(ds->ds_data, offset);
-		if (attr != 0)
+		/* DW_FORM_implicit_const stores its value in the abbrev. */
+		cval = 0;
+		if (form == DW_FORM_implicit_const)
+			cval = _dwarf_read_sleb128(ds->ds_data, offset);
+		if (attr != 0) {
 			if ((ret = _dwarf_attrdef_add(dbg, *abp, attr,
-			    form, adoff, NULL, error)) != DW_DLE_NONE)
+			    form, adoff, &ad, error)) != DW_DLE_NONE)
 				return (ret);
+			ad->ad_const = cval;
+		}
 	} while (attr != 0);
 
 	(*abp)->ab_length = *offset - aboff;
@@ -179,7 +192,9 @@ _dwarf_abbrev_find(Dwarf_CU cu, uint64_t entry, Dwarf_Abbrev *abp,
 	}
 
 	/* Load and search the abbrev table. */
-	ds = _dwarf_find_section(cu->cu_dbg, ".debug_abbrev");
+	ret = _dwarf_find_section(cu->cu_dbg, ".debug_abbrev", &ds, error);
+	if (ret != DW_DLE_NONE)
+		return (ret);
 	assert(ds != NULL);
 	offset = cu->cu_abbrev_offset_cur;
 	while (offset < ds->ds_size) {
@@ -201,6 +216,21 @@ _dwarf_abbrev_find(Dwarf_CU cu, uint64_t entry, Dwarf_Abbrev *abp,
 	return (DW_DLE_NO_ENTRY);
 }
 
+/*
+ * Parse the rest of the abbrev table of a CU, so that later lookups
+ * only read the hash table.  A table that fails to parse keeps the
+ * entries read so far.
+ */
+void
+_dwarf_abbrev_load(Dwarf_CU cu)
+{
+	Dwarf_Abbrev ab;
+	Dwarf_Error de;
+
+	(void) _dwarf_abbrev_find(cu, UINT64_MAX, &ab, &de);
+	cu->cu_abbrev_loaded = 1;
+}
+
 void
 _dwarf_abbrev_cleanup(Dwarf_CU cu)
 {
@@ -46,9 +46,235 @@ _dwarf_arange_cleanup(Dwarf_Debug dbg)
 
 	if (dbg->dbg_arange_array)
 		free(dbg->dbg_arange_array);
+	if (dbg->dbg_arange_sorted)
+		free(dbg->dbg_arange_sorted);
 
 	dbg->dbg_arange_array = NULL;
+	dbg->dbg_arange_sorted = NULL;
 	dbg->dbg_arange_cnt = 0;
+	dbg->dbg_arange_loaded = 0;
+}
+
+static int
+_dwarf_arange_cmp(const void *a, const void *b)
+{
+	Dwarf_Arange ar1, ar2;
+
+	ar1 = *(Dwarf_Arange const *) a;
+	ar2 = *(Dwarf_Arange const *) b;
+
+	if (ar1->ar_address < ar2->ar_address)
+		return (-1);
+	else if (ar1->ar_address > ar2->ar_address)
+		return (1);
+	else if (ar1->ar_range < ar2->ar_range)
+		return (-1);
+	else if (ar1->ar_range > ar2->ar_range)
+		return (1);
+
+	return (0);
+}
+
+/*
+ * Build the arange array (in section order) and a second array of the
+ * same descriptors sorted by start address.  Each descriptor in the
+ * sorted array records the largest end address seen so far, so that
+ * lookups remain correct when address ranges overlap.
+ */
+static int
+_dwarf_arange_index(Dwarf_Debug dbg, Dwarf_Error *error)
+{
+	Dwarf_ArangeSet as;
+	Dwarf_Arange ar;
+	Dwarf_Unsigned i, maxend;
+
+	if (dbg->dbg_arange_cnt == 0)
+		return (DW_DLE_NONE);
+
+	if ((dbg->dbg_arange_array = malloc(dbg->dbg_arange_cnt *
+	    sizeof(Dwarf_Arange))) == NULL ||
+	    (dbg->dbg_arange_sorted = malloc(dbg->dbg_arange_cnt *
+	    sizeof(Dwarf_Arange))) == NULL) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
+		return (DW_DLE_MEMORY);
+	}
+
+	i = 0;
+	STAILQ_FOREACH(as, &dbg->dbg_aslist, as_next) {
+		STAILQ_FOREACH(ar, &as->as_arlist, ar_next)
+			dbg->dbg_arange_array[i++] = ar;
+	}
+	assert(i == dbg->dbg_arange_cnt);
+
+	memcpy(dbg->dbg_arange_sorted, dbg->dbg_arange_array,
+	    dbg->dbg_arange_cnt * sizeof(Dwarf_Arange));
+	qsort(dbg->dbg_arange_sorted, dbg->dbg_arange_cnt,
+	    sizeof(Dwarf_Arange), _dwarf_arange_cmp);
+
+	maxend = 0;
+	for (i = 0; i < dbg->dbg_arange_cnt; i++) {
+		ar = dbg->dbg_arange_sorted[i];
+		if (ar->ar_address + ar->ar_range > maxend)
+			maxend = ar->ar_address + ar->ar_range;
+		ar->ar_maxend = maxend;
+	}
+
+	return (DW_DLE_NONE);
+}
+
+Dwarf_Arange
+_dwarf_arange_find(Dwarf_Debug dbg, Dwarf_Addr addr)
+{
+	Dwarf_Arange ar;
+	Dwarf_Unsigned lo, hi, mid;
+
+	assert(dbg != NULL && dbg->dbg_arange_sorted != NULL);
+
+	/* Find the first descriptor starting above `addr'. */
+	lo = 0;
+	hi = dbg->dbg_arange_cnt;
+	while (lo < hi) {
+		mid = lo + (hi - lo) / 2;
+		if (dbg->dbg_arange_sorted[mid]->ar_address <= addr)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	/*
+	 * Walk backwards over the descriptors that start at or below
+	 * `addr', stopping as soon as none of them can reach it.
+	 */
+	while (lo > 0) {
+		ar = dbg->dbg_arange_sorted[--lo];
+		if (ar->ar_maxend <= addr)
+			break;
+		if (addr < ar->ar_address + ar->ar_range)
+			return (ar);
+	}
+
+	return (NULL);
+}
+
+static int
+_dwarf_arange_add(Dwarf_Debug dbg, Dwarf_CU cu, Dwarf_ArangeSet *asp,
+    Dwarf_Unsigned addr, Dwarf_Unsigned range, Dwarf_Error *error)
+{
+	Dwarf_ArangeSet as;
+	Dwarf_Arange ar;
+
+	if ((as = *asp) == NULL) {
+		if ((as = calloc(1, sizeof(struct _Dwarf_ArangeSet))) ==
+		    NULL) {
+			DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
+			return (DW_DLE_MEMORY);
+		}
+		STAILQ_INIT(&as->as_arlist);
+		as->as_version = 2;
+		as->as_cu_offset = cu->cu_offset;
+		as->as_cu = cu;
+		as->as_addrsz = cu->cu_pointer_size;
+		STAILQ_INSERT_TAIL(&dbg->dbg_aslist, as, as_next);
+		*asp = as;
+	}
+
+	if ((ar = calloc(1, sizeof(struct _Dwarf_Arange))) == NULL) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
+		return (DW_DLE_MEMORY);
+	}
+	ar->ar_as = as;
+	ar->ar_address = addr;
+	ar->ar_range = range;
+	STAILQ_INSERT_TAIL(&as->as_arlist, ar, ar_next);
+	dbg->dbg_arange_cnt++;
+
+	return (DW_DLE_NONE);
+}
+
+/*
+ * Synthesize address range descriptors from the DW_AT_low_pc,
+ * DW_AT_high_pc and DW_AT_ranges attributes of each CU DIE, for
+ * objects that do not have a .debug_aranges section.
+ */
+static int
+_dwarf_arange_synthesize(Dwarf_Debug dbg, Dwarf_Error *error)
+{
+	Dwarf_CU cu;
+	Dwarf_ArangeSet as;
+	Dwarf_Attribute at;
+	Dwarf_Die die;
+	Dwarf_Rangelist rl;
+	Dwarf_Ranges *rg;
+	Dwarf_Unsigned base, lopc, hipc, i;
+	int ret;
+
+	STAILQ_FOREACH(cu, &dbg->dbg_cu, cu_next) {
+		ret = _dwarf_die_parse(dbg, dbg->dbg_info_sec, cu,
+		    cu->cu_dwarf_size, cu->cu_1st_offset, cu->cu_next_offset,
+		    &die, 0, error);
+		if (ret == DW_DLE_NO_ENTRY)
+			continue;
+		else if (ret != DW_DLE_NONE)
+			return (ret);
+
+		as = NULL;
+		lopc = 0;
+		if ((at = _dwarf_attr_find(die, DW_AT_low_pc)) != NULL)
+			lopc = at->u[0].u64;
+
+		if ((at = _dwarf_attr_find(die, DW_AT_ranges)) != NULL) {
+			if (_dwarf_ranges_find(dbg, cu, at->u[0].u64, &rl) ==
+			    DW_DLE_NO_ENTRY) {
+				ret = _dwarf_ranges_add(dbg, cu, at->u[0].u64,
+				    &rl, error);
+				if (ret != DW_DLE_NONE)
+					goto fail;
+			}
+			base = lopc;
+			for (i = 0; i < rl->rl_rglen; i++) {
+				rg = &rl->rl_rgarray[i];
+				if (rg->dwr_type == DW_RANGES_END)
+					break;
+				if (rg->dwr_type == DW_RANGES_ADDRESS_SELECTION) {
+					base = rg->dwr_addr2;
+					continue;
+				}
+				if (rg->dwr_addr2 <= rg->dwr_addr1)
+					continue;
+				ret = _dwarf_arange_add(dbg, cu, &as,
+				    base + rg->dwr_addr1,
+				    rg->dwr_addr2 - rg->dwr_addr1, error);
+				if (ret != DW_DLE_NONE)
+					goto fail;
+			}
+		} else if ((at = _dwarf_attr_find(die, DW_AT_high_pc)) !=
+		    NULL && _dwarf_attr_find(die, DW_AT_low_pc) != NULL) {
+			/*
+			 * Starting from DWARF4, DW_AT_high_pc can be encoded
+			 * as an offset from DW_AT_low_pc.
+			 */
+			hipc = at->u[0].u64;
+			if (dwarf_get_form_class(cu->cu_version, DW_AT_high_pc,
+			    cu->cu_dwarf_size, at->at_form) ==
+			    DW_FORM_CLASS_CONSTANT)
+				hipc += lopc;
+			if (hipc > lopc) {
+				ret = _dwarf_arange_add(dbg, cu, &as, lopc,
+				    hipc - lopc, error);
+				if (ret != DW_DLE_NONE)
+					goto fail;
+			}
+		}
+
+		dwarf_dealloc(dbg, die, DW_DLA_DIE);
+	}
+
+	return (DW_DLE_NONE);
+
+fail:
+	dwarf_dealloc(dbg, die, DW_DLA_DIE);
+
+	return (ret);
 }
 
 int
@@ -59,11 +285,14 @@ _dwarf_arange_init(Dwarf_Debug dbg, Dwarf_Error *error)
 	Dwarf_Arange ar;
 	Dwarf_Section *ds;
 	uint64_t offset, dwarf_size, length, addr, range;
-	int i, ret;
+	int ret;
 
 	ret = DW_DLE_NONE;
 
-	if ((ds = _dwarf_find_section(dbg, ".debug_aranges")) == NULL)
+	ret = _dwarf_find_section(dbg, ".debug_aranges", &ds, error);
+	if (ret != DW_DLE_NONE)
+		return (ret);
+	if (ds == NULL && !dbg->dbg_arange_synth)
 		return (DW_DLE_NONE);
 
 	if (!dbg->dbg_info_loaded) {
@@ -72,6 +301,13 @@ _dwarf_arange_init(Dwarf_Debug dbg, Dwarf_Error *error)
 			return (ret);
 	}
 
+	if (ds == NULL) {
+		ret = _dwarf_arange_synthesize(dbg, error);
+		if (ret != DW_DLE_NONE)
+			goto fail_cleanup;
+		goto build_index;
+	}
+
 	offset = 0;
 	while (offset < ds->ds_size) {
 
@@ -125,6 +361,7 @@ _dwarf_arange_init(Dwarf_Debug dbg, Dwarf_Error *error)
 			if ((ar = calloc(1, sizeof(struct _Dwarf_Arange))) ==
 			    NULL) {
 				DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
+				ret = DW_DLE_MEMORY;
 				goto fail_cleanup;
 			}
 			ar->ar_as = as;
@@ -135,22 +372,11 @@ _dwarf_arange_init(Dwarf_Debug dbg, Dwarf_Error *error)
 		}
 	}
 
-	/* Build arange array. */
-	if (dbg->dbg_arange_cnt > 0) {
-		if ((dbg->dbg_arange_array = malloc(dbg->dbg_arange_cnt *
-		    sizeof(Dwarf_Arange))) == NULL) {
-			DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
-			ret = DW_DLE_MEMORY;
-			goto fail_cleanup;
-		}
+build_index:
 
-		i = 0;
-		STAILQ_FOREACH(as, &dbg->dbg_aslist, as_next) {
-			STAILQ_FOREACH(ar, &as->as_arlist, ar_next)
-				dbg->dbg_arange_array[i++] = ar;
-		}
-		assert((Dwarf_Unsigned)i == dbg->dbg_arange_cnt);
-	}
+	/* Build arange array and the sorted lookup index. */
+	if ((ret = _dwarf_arange_index(dbg, error)) != DW_DLE_NONE)
+		goto fail_cleanup;
 
 	return (DW_DLE_NONE);
 
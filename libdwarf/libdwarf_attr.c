@@ -65,6 +65,7 @@ _dwarf_attr_add(Dwarf_Die die, Dwarf_Attribute atref, Dwarf_Attribute *atp,
 	if (at->at_attrib == DW_AT_name) {
 		switch (at->at_form) {
 		case DW_FORM_strp:
+		case DW_FORM_line_strp:
 			die->die_name = at->u[1].s;
 			break;
 		case DW_FORM_string:
@@ -94,6 +95,258 @@ _dwarf_attr_find(Dwarf_Die die, Dwarf_Half attr)
 	return (at);
 }
 
+/*
+ * Look up the bases of the DWARF 5 offset tables (DW_AT_str_offsets_base
+ * and friends) of a CU.  These are attributes of the CU DIE, which is
+ * parsed here unless the caller passes it in.
+ */
+int
+_dwarf_cu_bases_init(Dwarf_CU cu, Dwarf_Die die, Dwarf_Error *error)
+{
+	Dwarf_Attribute at;
+	Dwarf_Debug dbg;
+	Dwarf_Section *ds;
+	Dwarf_Die cudie;
+	int has_dwo_name, ret;
+
+	if (cu->cu_bases_init)
+		return (DW_DLE_NONE);
+
+	dbg = cu->cu_dbg;
+
+	if (die == NULL || die->die_offset != cu->cu_1st_offset) {
+		ds = cu->cu_is_info ? dbg->dbg_info_sec : dbg->dbg_types_sec;
+		ret = _dwarf_die_parse(dbg, ds, cu, cu->cu_dwarf_size,
+		    cu->cu_1st_offset, cu->cu_next_offset, &cudie, 0, error);
+		if (ret != DW_DLE_NONE)
+			return (ret);
+		dwarf_dealloc(dbg, cudie, DW_DLA_DIE);
+		return (DW_DLE_NONE);
+	}
+
+	/*
+	 * Split units have no base attributes; their tables start right
+	 * after the table header.
+	 */
+	if (cu->cu_version >= 5 && (cu->cu_unit_type == DW_UT_split_compile ||
+	    cu->cu_unit_type == DW_UT_split_type)) {
+		cu->cu_str_offsets_base = cu->cu_dwarf_size == 4 ? 8 : 16;
+		cu->cu_rnglists_base = cu->cu_dwarf_size == 4 ? 12 : 20;
+		cu->cu_loclists_base = cu->cu_rnglists_base;
+	}
+
+	has_dwo_name = 0;
+	STAILQ_FOREACH(at, &die->die_attr, at_next) {
+		switch (at->at_attrib) {
+		case DW_AT_GNU_dwo_id:
+			cu->cu_dwo_id = at->u[0].u64;
+			break;
+		case DW_AT_dwo_name:
+		case DW_AT_GNU_dwo_name:
+			has_dwo_name = 1;
+			break;
+		case DW_AT_str_offsets_base:
+			cu->cu_str_offsets_base = at->u[0].u64;
+			break;
+		case DW_AT_addr_base:
+		case DW_AT_GNU_addr_base:
+			cu->cu_addr_base = at->u[0].u64;
+			break;
+		case DW_AT_rnglists_base:
+			cu->cu_rnglists_base = at->u[0].u64;
+			break;
+		case DW_AT_loclists_base:
+			cu->cu_loclists_base = at->u[0].u64;
+			break;
+		default:
+			break;
+		}
+	}
+
+	/*
+	 * A GNU split unit is told from its skeleton by the absence of
+	 * the DW_AT_GNU_dwo_name attribute.
+	 */
+	if (cu->cu_unit_type == DW_UT_split_compile ||
+	    cu->cu_unit_type == DW_UT_split_type ||
+	    (cu->cu_version < 5 && cu->cu_dwo_id != 0 && !has_dwo_name))
+		cu->cu_is_split = 1;
+
+	if ((ret = _dwarf_split_bases_init(cu, error)) != DW_DLE_NONE)
+		return (ret);
+
+	cu->cu_bases_init = 1;
+
+	return (DW_DLE_NONE);
+}
+
+/*
+ * Read entry 'ndx' of size 'entsize' from the offset table starting at
+ * 'base' in section 'name'.
+ */
+static int
+_dwarf_attr_read_index(Dwarf_Debug dbg, const char *name, uint64_t base,
+    uint64_t ndx, int entsize, uint64_t *ret_value, Dwarf_Error *error)
+{
+	Dwarf_Section *ds;
+	uint64_t offset;
+	int ret;
+
+	if ((ret = _dwarf_find_section(dbg, name, &ds, error)) != DW_DLE_NONE)
+		return (ret);
+	if (ds == NULL || base > ds->ds_size ||
+	    ndx >= (ds->ds_size - base) / entsize) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_INDEX_BAD);
+		return (DW_DLE_INDEX_BAD);
+	}
+
+	offset = base + ndx * entsize;
+	*ret_value = dbg->read(ds->ds_data, &offset, entsize);
+
+	return (DW_DLE_NONE);
+}
+
+/*
+ * Translate an index into .debug_str_offsets to a string.
+ */
+int
+_dwarf_strx_lookup(Dwarf_CU cu, uint64_t ndx, uint64_t *ret_offset,
+    char **ret_string, Dwarf_Error *error)
+{
+	Dwarf_Debug dbg;
+	Dwarf_Section *str;
+	uint64_t offset;
+	int ret;
+
+	dbg = cu->cu_dbg;
+
+	if ((ret = _dwarf_cu_bases_init(cu, NULL, error)) != DW_DLE_NONE)
+		return (ret);
+
+	ret = _dwarf_attr_read_index(dbg, ".debug_str_offsets",
+	    cu->cu_str_offsets_base, ndx, cu->cu_dwarf_size, &offset, error);
+	if (ret != DW_DLE_NONE)
+		return (ret);
+
+	if ((ret = _dwarf_find_section(dbg, ".debug_str", &str, error)) !=
+	    DW_DLE_NONE)
+		return (ret);
+	if (str == NULL || offset >= str->ds_size) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_INDEX_BAD);
+		return (DW_DLE_INDEX_BAD);
+	}
+
+	if (ret_offset != NULL)
+		*ret_offset = offset;
+	*ret_string = (char *) str->ds_data + offset;
+
+	return (DW_DLE_NONE);
+}
+
+/*
+ * Translate an index into .debug_addr to an address.
+ */
+int
+_dwarf_addrx_lookup(Dwarf_CU cu, uint64_t ndx, uint64_t *ret_addr,
+    Dwarf_Error *error)
+{
+	Dwarf_Debug dbg;
+	int ret;
+
+	if ((ret = _dwarf_cu_bases_init(cu, NULL, error)) != DW_DLE_NONE)
+		return (ret);
+
+	/* The address table of a split unit is in the tied object. */
+	dbg = cu->cu_skel != NULL ? cu->cu_skel->cu_dbg : cu->cu_dbg;
+
+	return (_dwarf_attr_read_index(dbg, ".debug_addr",
+	    cu->cu_addr_base, ndx, cu->cu_pointer_size, ret_addr, error));
+}
+
+/*
+ * Replace the table indices carried by the DWARF 5 (and GNU split DWARF)
+ * index forms with the values they refer to, so that the rest of the
+ * library sees the same representation as for DW_FORM_strp, DW_FORM_addr
+ * and DW_FORM_sec_offset.
+ */
+int
+_dwarf_attr_resolve_index(Dwarf_Die die, Dwarf_Error *error)
+{
+	Dwarf_Attribute at;
+	Dwarf_Debug dbg;
+	Dwarf_CU cu;
+	uint64_t value;
+	int cu_init, ret;
+
+	cu = die->die_cu;
+	dbg = die->die_dbg;
+
+	/* Only the first parse of a CU DIE records its attributes. */
+	cu_init = die->die_offset == cu->cu_1st_offset && !cu->cu_bases_init;
+	if (cu_init &&
+	    (ret = _dwarf_cu_bases_init(cu, die, error)) != DW_DLE_NONE)
+		return (ret);
+
+	STAILQ_FOREACH(at, &die->die_attr, at_next) {
+		switch (at->at_form) {
+		case DW_FORM_strx:
+		case DW_FORM_strx1:
+		case DW_FORM_strx2:
+		case DW_FORM_strx3:
+		case DW_FORM_strx4:
+		case DW_FORM_GNU_str_index:
+			ret = _dwarf_strx_lookup(cu, at->u[0].u64,
+			    &at->u[0].u64, &at->u[1].s, error);
+			if (ret != DW_DLE_NONE)
+				return (ret);
+			if (at->at_attrib == DW_AT_name)
+				die->die_name = at->u[1].s;
+			break;
+		case DW_FORM_addrx:
+		case DW_FORM_addrx1:
+		case DW_FORM_addrx2:
+		case DW_FORM_addrx3:
+		case DW_FORM_addrx4:
+		case DW_FORM_GNU_addr_index:
+			ret = _dwarf_addrx_lookup(cu, at->u[0].u64,
+			    &at->u[0].u64, error);
+			if (ret != DW_DLE_NONE)
+				return (ret);
+			break;
+		case DW_FORM_rnglistx:
+		case DW_FORM_loclistx:
+			if ((ret = _dwarf_cu_bases_init(cu, NULL, error)) !=
+			    DW_DLE_NONE)
+				return (ret);
+			if (at->at_form == DW_FORM_rnglistx)
+				ret = _dwarf_attr_read_index(dbg,
+				    ".debug_rnglists", cu->cu_rnglists_base,
+				    at->u[0].u64, cu->cu_dwarf_size, &value,
+				    error);
+			else
+				ret = _dwarf_attr_read_index(dbg,
+				    ".debug_loclists", cu->cu_loclists_base,
+				    at->u[0].u64, cu->cu_dwarf_size, &value,
+				    error);
+			if (ret != DW_DLE_NONE)
+				return (ret);
+			/* Offsets in the table are relative to the base. */
+			at->u[0].u64 = value + (at->at_form ==
+			    DW_FORM_rnglistx ? cu->cu_rnglists_base :
+			    cu->cu_loclists_base);
+			break;
+		default:
+			break;
+		}
+	}
+
+	/* Remember the CU base address for DWARF 5 range/location lists. */
+	if (cu_init && (at = _dwarf_attr_find(die, DW_AT_low_pc)) != NULL)
+		cu->cu_lowpc = at->u[0].u64;
+
+	return (DW_DLE_NONE);
+}
+
 int
 _dwarf_attr_init(Dwarf_Debug dbg, Dwarf_Section *ds, uint64_t *offsetp,
     int dwarf_size, Dwarf_CU cu, Dwarf_Die die, Dwarf_AttrDef ad,
@@ -101,7 +354,7 @@ _dwarf_attr_init(Dwarf_Debug dbg, Dwarf_Section *ds, uint64_t *offsetp,
 {
 	struct _Dwarf_Attribute atref;
 	Dwarf_Section *str;
-	int ret;
+	int is_block, ret;
 
 	ret = DW_DLE_NONE;
 	memset(&atref, 0, sizeof(atref));
@@ -114,79 +367,138 @@ _dwarf_attr_init(Dwarf_Debug dbg, Dwarf_Section *ds, uint64_t *offsetp,
 
 	switch (form) {
 	case DW_FORM_addr:
-		atref.u[0].u64 = dbg->read(ds->ds_data, offsetp,
+		atref.u[0].u64 = _dwarf_section_read(dbg, ds, offsetp,
 		    cu->cu_pointer_size);
 		break;
 	case DW_FORM_block:
 	case DW_FORM_exprloc:
-		atref.u[0].u64 = _dwarf_read_uleb128(ds->ds_data, offsetp);
+		atref.u[0].u64 = _dwarf_section_read_uleb128(ds, offsetp);
 		atref.u[1].u8p = _dwarf_read_block(ds->ds_data, offsetp,
 		    atref.u[0].u64);
 		break;
 	case DW_FORM_block1:
-		atref.u[0].u64 = dbg->read(ds->ds_data, offsetp, 1);
+		atref.u[0].u64 = _dwarf_section_read(dbg, ds, offsetp, 1);
 		atref.u[1].u8p = _dwarf_read_block(ds->ds_data, offsetp,
 		    atref.u[0].u64);
 		break;
 	case DW_FORM_block2:
-		atref.u[0].u64 = dbg->read(ds->ds_data, offsetp, 2);
+		atref.u[0].u64 = _dwarf_section_read(dbg, ds, offsetp, 2);
 		atref.u[1].u8p = _dwarf_read_block(ds->ds_data, offsetp,
 		    atref.u[0].u64);
 		break;
 	case DW_FORM_block4:
-		atref.u[0].u64 = dbg->read(ds->ds_data, offsetp, 4);
+		atref.u[0].u64 = _dwarf_section_read(dbg, ds, offsetp, 4);
 		atref.u[1].u8p = _dwarf_read_block(ds->ds_data, offsetp,
 		    atref.u[0].u64);
 		break;
 	case DW_FORM_data1:
 	case DW_FORM_flag:
 	case DW_FORM_ref1:
-		atref.u[0].u64 = dbg->read(ds->ds_data, offsetp, 1);
+		atref.u[0].u64 = _dwarf_section_read(dbg, ds, offsetp, 1);
 		break;
 	case DW_FORM_data2:
 	case DW_FORM_ref2:
-		atref.u[0].u64 = dbg->read(ds->ds_data, offsetp, 2);
+		atref.u[0].u64 = _dwarf_section_read(dbg, ds, offsetp, 2);
 		break;
 	case DW_FORM_data4:
 	case DW_FORM_ref4:
-		atref.u[0].u64 = dbg->read(ds->ds_data, offsetp, 4);
+		atref.u[0].u64 = _dwarf_section_read(dbg, ds, offsetp, 4);
 		break;
 	case DW_FORM_data8:
 	case DW_FORM_ref8:
-		atref.u[0].u64 = dbg->read(ds->ds_data, offsetp, 8);
+		atref.u[0].u64 = _dwarf_section_read(dbg, ds, offsetp, 8);
 		break;
 	case DW_FORM_indirect:
-		form = _dwarf_read_uleb128(ds->ds_data, offsetp);
+		form = _dwarf_section_read_uleb128(ds, offsetp);
 		return (_dwarf_attr_init(dbg, ds, offsetp, dwarf_size, cu, die,
 		    ad, form, 1, error));
 	case DW_FORM_ref_addr:
 		if (cu->cu_version == 2)
-			atref.u[0].u64 = dbg->read(ds->ds_data, offsetp,
+			atref.u[0].u64 = _dwarf_section_read(dbg, ds, offsetp,
 			    cu->cu_pointer_size);
 		else
-			atref.u[0].u64 = dbg->read(ds->ds_data, offsetp,
+			atref.u[0].u64 = _dwarf_section_read(dbg, ds, offsetp,
 			    dwarf_size);
 		break;
 	case DW_FORM_ref_udata:
 	case DW_FORM_udata:
-		atref.u[0].u64 = _dwarf_read_uleb128(ds->ds_data, offsetp);
+		atref.u[0].u64 = _dwarf_section_read_uleb128(ds, offsetp);
 		break;
 	case DW_FORM_sdata:
-		atref.u[0].s64 = _dwarf_read_sleb128(ds->ds_data, offsetp);
+		atref.u[0].s64 = _dwarf_section_read_sleb128(ds, offsetp);
 		break;
 	case DW_FORM_sec_offset:
-		atref.u[0].u64 = dbg->read(ds->ds_data, offsetp, dwarf_size);
+	case DW_FORM_strp_sup:
+	case DW_FORM_GNU_strp_alt:
+	case DW_FORM_GNU_ref_alt:
+		atref.u[0].u64 = _dwarf_section_read(dbg, ds, offsetp,
+		    dwarf_size);
+		break;
+	case DW_FORM_ref_sup4:
+		atref.u[0].u64 = _dwarf_section_read(dbg, ds, offsetp, 4);
+		break;
+	case DW_FORM_ref_sup8:
+		atref.u[0].u64 = _dwarf_section_read(dbg, ds, offsetp, 8);
+		break;
+	case DW_FORM_strx:
+	case DW_FORM_addrx:
+	case DW_FORM_loclistx:
+	case DW_FORM_rnglistx:
+	case DW_FORM_GNU_str_index:
+	case DW_FORM_GNU_addr_index:
+		/* Indices are resolved by _dwarf_attr_resolve_index(). */
+		atref.u[0].u64 = _dwarf_section_read_uleb128(ds, offsetp);
+		break;
+	case DW_FORM_strx1:
+	case DW_FORM_addrx1:
+		atref.u[0].u64 = _dwarf_section_read(dbg, ds, offsetp, 1);
+		break;
+	case DW_FORM_strx2:
+	case DW_FORM_addrx2:
+		atref.u[0].u64 = _dwarf_section_read(dbg, ds, offsetp, 2);
+		break;
+	case DW_FORM_strx3:
+	case DW_FORM_addrx3:
+		atref.u[0].u64 = _dwarf_section_read(dbg, ds, offsetp, 3);
+		break;
+	case DW_FORM_strx4:
+	case DW_FORM_addrx4:
+		atref.u[0].u64 = _dwarf_section_read(dbg, ds, offsetp, 4);
+		break;
+	case DW_FORM_implicit_const:
+		/* The value lives in the abbrev, not in the DIE. */
+		atref.u[0].s64 = ad->ad_const;
+		break;
+	case DW_FORM_data16:
+		atref.u[0].u64 = 16;
+		atref.u[1].u8p = _dwarf_read_block(ds->ds_data, offsetp,
+		    atref.u[0].u64);
 		break;
 	case DW_FORM_string:
 		atref.u[0].s = _dwarf_read_string(ds->ds_data, ds->ds_size,
 		    offsetp);
 		break;
 	case DW_FORM_strp:
-		atref.u[0].u64 = dbg->read(ds->ds_data, offsetp, dwarf_size);
-		str = _dwarf_find_section(dbg, ".debug_str");
+		atref.u[0].u64 = _dwarf_section_read(dbg, ds, offsetp,
+		    dwarf_size);
+		ret = _dwarf_find_section(dbg, ".debug_str", &str, error);
+		if (ret != DW_DLE_NONE)
+			return (ret);
 		assert(str != NULL);
 		atref.u[1].s = (char *) str->ds_data + atref.u[0].u64;
 		break;
+	case DW_FORM_line_strp:
+		atref.u[0].u64 = _dwarf_section_read(dbg, ds, offsetp,
+		    dwarf_size);
+		ret = _dwarf_find_section(dbg, ".debug_line_str", &str, error);
+		if (ret != DW_DLE_NONE)
+			return (ret);
+		if (str == NULL || atref.u[0].u64 >= str->ds_size) {
+			DWARF_SET_ERROR(dbg, error, DW_DLE_ATTR_FORM_BAD);
+			return (DW_DLE_ATTR_FORM_BAD);
+		}
+		atref.u[1].s = (char *) str->ds_data + atref.u[0].u64;
+		break;
 	case DW_FORM_ref_sig8:
 		atref.u[0].u64 = 8;
 		atref.u[1].u8p = _dwarf_read_block(ds->ds_data, offsetp,
@@ -203,8 +515,23 @@ _dwarf_attr_init(Dwarf_Debug dbg, Dwarf_Section *ds, uint64_t *offsetp,
 	}
 
 	if (ret == DW_DLE_NONE) {
+		/*
+		 * Catch values and blocks running past the section end.  A
+		 * block length larger than the section may have wrapped the
+		 * offset around.
+		 */
+		is_block = form == DW_FORM_block || form == DW_FORM_exprloc ||
+		    form == DW_FORM_block1 || form == DW_FORM_block2 ||
+		    form == DW_FORM_block4;
+		if (*offsetp > ds->ds_size ||
+		    (is_block && atref.u[0].u64 > ds->ds_size)) {
+			DWARF_SET_ERROR(dbg, error, DW_DLE_ATTR_FORM_BAD);
+			return (DW_DLE_ATTR_FORM_BAD);
+		}
+
 		if (form == DW_FORM_block || form == DW_FORM_block1 ||
-		    form == DW_FORM_block2 || form == DW_FORM_block4) {
+		    form == DW_FORM_block2 || form == DW_FORM_block4 ||
+		    form == DW_FORM_data16) {
 			atref.at_block.bl_len = atref.u[0].u64;
 			atref.at_block.bl_data = atref.u[1].u8p;
 		}
@@ -226,13 +553,16 @@ _dwarf_attr_write(Dwarf_P_Debug dbg, Dwarf_P_Section ds, Dwarf_Rel_Section drs,
 
 	/* Fill in reference to other DIE in the second pass. */
 	if (pass2) {
-		if (at->at_form != DW_FORM_ref4 && at->at_form != DW_FORM_ref8)
+		if (at->at_form != DW_FORM_ref1 &&
+		    at->at_form != DW_FORM_ref2 &&
+		    at->at_form != DW_FORM_ref4 &&
+		    at->at_form != DW_FORM_ref8)
 			return (DW_DLE_NONE);
 		if (at->at_refdie == NULL || at->at_offset == 0)
 			return (DW_DLE_NONE);
 		offset = at->at_offset;
 		dbg->write(ds->ds_data, &offset, at->at_refdie->die_offset,
-		    at->at_form == DW_FORM_ref4 ? 4 : 8);
+		    _dwarf_attr_size(cu, at));
 		return (DW_DLE_NONE);
 	}
 
@@ -292,11 +622,9 @@ _dwarf_attr_write(Dwarf_P_Debug dbg, Dwarf_P_Section ds, Dwarf_Rel_Section drs,
 		break;
 	case DW_FORM_data1:
 	case DW_FORM_flag:
-	case DW_FORM_ref1:
 		ret = WRITE_VALUE(at->u[0].u64, 1);
 		break;
 	case DW_FORM_data2:
-	case DW_FORM_ref2:
 		ret = WRITE_VALUE(at->u[0].u64, 2);
 		break;
 	case DW_FORM_data4:
@@ -315,10 +643,12 @@ _dwarf_attr_write(Dwarf_P_Debug dbg, Dwarf_P_Section ds, Dwarf_Rel_Section drs,
 		else
 			ret = WRITE_VALUE(at->u[0].u64, 8);
 		break;
+	case DW_FORM_ref1:
+	case DW_FORM_ref2:
 	case DW_FORM_ref4:
 	case DW_FORM_ref8:
 		/*
-		 * The value of ref4 and ref8 could be a reference to another
+		 * The value of refN could be a reference to another
 		 * DIE within the CU. And if we don't know the ref DIE's
 		 * offset at the moement, then we remember at_offset and fill
 		 * it in the second pass.
@@ -331,7 +661,7 @@ _dwarf_attr_write(Dwarf_P_Debug dbg, Dwarf_P_Section ds, Dwarf_Rel_Section drs,
 			}
 		} else
 			value = at->u[0].u64;
-		ret = WRITE_VALUE(value, at->at_form == DW_FORM_ref4 ? 4 : 8);
+		ret = WRITE_VALUE(value, _dwarf_attr_size(cu, at));
 		break;
 	case DW_FORM_indirect:
 		/* TODO. */
@@ -372,6 +702,56 @@ _dwarf_attr_write(Dwarf_P_Debug dbg, Dwarf_P_Section ds, Dwarf_Rel_Section drs,
 	return (ret);
 }
 
+/*
+ * Return the number of bytes _dwarf_attr_write() emits for a producer
+ * attribute.
+ */
+uint64_t
+_dwarf_attr_size(Dwarf_CU cu, Dwarf_P_Attribute at)
+{
+	uint8_t buf[16];
+
+	switch (at->at_form) {
+	case DW_FORM_addr:
+	case DW_FORM_ref_addr:
+		return (cu->cu_pointer_size);
+	case DW_FORM_block:
+		return (_dwarf_write_uleb128(buf, buf + sizeof(buf),
+		    at->u[0].u64) + at->u[0].u64);
+	case DW_FORM_block1:
+		return (1 + at->u[0].u64);
+	case DW_FORM_block2:
+		return (2 + at->u[0].u64);
+	case DW_FORM_block4:
+		return (4 + at->u[0].u64);
+	case DW_FORM_data1:
+	case DW_FORM_flag:
+	case DW_FORM_ref1:
+		return (1);
+	case DW_FORM_data2:
+	case DW_FORM_ref2:
+		return (2);
+	case DW_FORM_data4:
+	case DW_FORM_ref4:
+	case DW_FORM_strp:
+		return (4);
+	case DW_FORM_data8:
+	case DW_FORM_ref8:
+		return (8);
+	case DW_FORM_ref_udata:
+	case DW_FORM_udata:
+		return (_dwarf_write_uleb128(buf, buf + sizeof(buf),
+		    at->u[0].u64));
+	case DW_FORM_sdata:
+		return (_dwarf_write_sleb128(buf, buf + sizeof(buf),
+		    at->u[0].s64));
+	case DW_FORM_string:
+		return (strlen(at->u[0].s) + 1);
+	default:
+		return (0);
+	}
+}
+
 int
 _dwarf_add_AT_dataref(Dwarf_P_Debug dbg, Dwarf_P_Die die, Dwarf_Half attr,
     Dwarf_Unsigned pc_value, Dwarf_Unsigned sym_index, const char *secname,
@@ -409,6 +789,7 @@ _dwarf_add_string_attr(Dwarf_P_Die die, Dwarf_P_Attribute *atp, Dwarf_Half attr,
 {
 	Dwarf_Attribute at;
 	Dwarf_Debug dbg;
+	size_t len;
 	int ret;
 
 	dbg = die != NULL ? die->die_dbg : NULL;
@@ -425,13 +806,26 @@ _dwarf_add_string_attr(Dwarf_P_Die die, Dwarf_P_Attribute *atp, Dwarf_Half attr,
 
 	at->at_die = die;
 	at->at_attrib = attr;
-	at->at_form = DW_FORM_strp;
-	if ((ret = _dwarf_strtab_add(dbg, string, &at->u[0].u64,
-	    error)) != DW_DLE_NONE) {
-		free(at);
-		return (ret);
+
+	/*
+	 * A string no longer than a .debug_str offset is cheaper to store
+	 * inline: it is then kept in the attribute itself.  Longer strings
+	 * are shared through the string table.
+	 */
+	len = strlen(string) + 1;
+	if (len <= (size_t) dbg->dbg_offset_size && len <= sizeof(at->u[1])) {
+		at->at_form = DW_FORM_string;
+		memcpy(&at->u[1], string, len);
+		at->u[0].s = (char *) &at->u[1];
+	} else {
+		at->at_form = DW_FORM_strp;
+		if ((ret = _dwarf_strtab_add(dbg, string, &at->u[0].u64,
+		    error)) != DW_DLE_NONE) {
+			free(at);
+			return (ret);
+		}
+		at->u[1].s = _dwarf_strtab_get_table(dbg) + at->u[0].u64;
 	}
-	at->u[1].s = _dwarf_strtab_get_table(dbg) + at->u[0].u64;
 
 	*atp = at;
 
@@ -0,0 +1,95 @@
+/*-
+ * Copyright (c) 2026 The Elftoolchain Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <zlib.h>
+#ifdef	LIBDWARF_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include "_libdwarf.h"
+
+ELFTC_VCSID("$Id$");
+
+/*
+ * Decompress the contents of a compressed debug section.  The size of
+ * the uncompressed data is recorded in the section's compression
+ * header, and the caller supplies a destination buffer of that size.
+ */
+int
+_dwarf_decompress(int type, const uint8_t *src, Dwarf_Unsigned srclen,
+    uint8_t *dst, Dwarf_Unsigned dstlen)
+{
+	uLongf len;
+
+	switch (type) {
+	case DWARF_COMPRESS_ZLIB:
+		len = (uLongf) dstlen;
+		if ((Dwarf_Unsigned) len != dstlen ||
+		    (Dwarf_Unsigned) (uLong) srclen != srclen)
+			return (DW_DLE_COMPRESSION);
+		if (uncompress(dst, &len, src, (uLong) srclen) != Z_OK ||
+		    len != dstlen)
+			return (DW_DLE_COMPRESSION);
+		break;
+#ifdef	LIBDWARF_HAVE_ZSTD
+	case DWARF_COMPRESS_ZSTD:
+	{
+		size_t r;
+
+		r = ZSTD_decompress(dst, (size_t) dstlen, src, (size_t) srclen);
+		if (ZSTD_isError(r) || r != dstlen)
+			return (DW_DLE_COMPRESSION);
+		break;
+	}
+#endif
+	default:
+		return (DW_DLE_COMPRESSION);
+	}
+
+	return (DW_DLE_NONE);
+}
+
+/*
+ * Decode the header of a GNU-style ".zdebug_*" section: the string
+ * "ZLIB" followed by the uncompressed size as a 64-bit big-endian
+ * integer.  Returns the size of the header, or 0 if the section data
+ * does not start with a valid header.
+ */
+int
+_dwarf_decompress_zdebug_header(const uint8_t *buf, Dwarf_Unsigned size,
+    Dwarf_Unsigned *uncompressed)
+{
+	uint8_t *p;
+
+	if (buf == NULL || size < DWARF_ZDEBUG_HDR_SIZE ||
+	    memcmp(buf, "ZLIB", 4) != 0)
+		return (0);
+
+	p = (uint8_t *) (uintptr_t) buf + 4;
+	*uncompressed = _dwarf_decode_msb(&p, 8);
+
+	return (DWARF_ZDEBUG_HDR_SIZE);
+}
@@ -0,0 +1,805 @@
+/*-
+ * Copyright (c) 2026 The Elftoolchain Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "_libdwarf.h"
+
+ELFTC_VCSID("$Id$");
+
+void
+_dwarf_debugnames_cleanup(Dwarf_Debug dbg)
+{
+	Dwarf_NameIdx ni, tni;
+
+	assert(dbg != NULL && dbg->dbg_mode == DW_DLC_READ);
+
+	STAILQ_FOREACH_SAFE(ni, &dbg->dbg_nilist, ni_next, tni) {
+		STAILQ_REMOVE(&dbg->dbg_nilist, ni, _Dwarf_NameIdx, ni_next);
+		if (ni->ni_abbrev)
+			free(ni->ni_abbrev);
+		free(ni);
+	}
+	dbg->dbg_names_loaded = 0;
+}
+
+static int
+_dwarf_debugnames_abbrev_init(Dwarf_Debug dbg, Dwarf_NameIdx ni,
+    uint64_t offset, uint64_t end, Dwarf_Error *error)
+{
+	struct _Dwarf_NameIdxAbbrev *na;
+	Dwarf_Section *ds;
+	uint64_t code, idx, form, start, cnt;
+	int i;
+
+	ds = ni->ni_ds;
+	start = offset;
+
+	/*
+	 * The abbreviation table is scanned twice: the first pass counts
+	 * the abbreviations and validates their attribute specifications,
+	 * the second pass records them.
+	 */
+	for (i = 0; i < 2; i++) {
+		offset = start;
+		cnt = 0;
+		while (offset < end) {
+			code = _dwarf_read_uleb128(ds->ds_data, &offset);
+			if (code == 0)
+				break;
+			if (i == 1) {
+				na = &ni->ni_abbrev[cnt];
+				na->na_code = code;
+				na->na_tag = _dwarf_read_uleb128(ds->ds_data,
+				    &offset);
+				na->na_attr = offset;
+			} else
+				(void) _dwarf_read_uleb128(ds->ds_data,
+				    &offset);
+			do {
+				if (offset >= end)
+					goto bad;
+				idx = _dwarf_read_uleb128(ds->ds_data, &offset);
+				form = _dwarf_read_uleb128(ds->ds_data,
+				    &offset);
+			} while (idx != 0 || form != 0);
+			cnt++;
+		}
+		if (offset > end)
+			goto bad;
+
+		if (i == 0) {
+			if (cnt == 0)
+				break;
+			if ((ni->ni_abbrev = calloc(cnt,
+			    sizeof(struct _Dwarf_NameIdxAbbrev))) == NULL) {
+				DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
+				return (DW_DLE_MEMORY);
+			}
+		}
+	}
+	ni->ni_abbrev_cnt = cnt;
+
+	return (DW_DLE_NONE);
+
+bad:
+	DWARF_SET_ERROR(dbg, error, DW_DLE_DEBUG_NAMES_BAD);
+	return (DW_DLE_DEBUG_NAMES_BAD);
+}
+
+static int
+_dwarf_debugnames_init(Dwarf_Debug dbg, Dwarf_Error *error)
+{
+	Dwarf_NameIdx ni;
+	Dwarf_Section *ds;
+	uint64_t offset, length, abbrev_size, aug_size;
+	uint16_t version;
+	int dwarf_size, ret;
+
+	assert(!dbg->dbg_names_loaded);
+
+	if ((ret = _dwarf_find_section(dbg, ".debug_names", &ds, error)) !=
+	    DW_DLE_NONE)
+		return (ret);
+	if (ds == NULL) {
+		dbg->dbg_names_loaded = 1;
+		return (DW_DLE_NONE);
+	}
+
+	/*
+	 * Only the header and the abbreviation table of each name index
+	 * are parsed here.  The buckets, hashes and entries are read in
+	 * place by _dwarf_debugnames_lookup().
+	 */
+	offset = 0;
+	while (offset < ds->ds_size) {
+		if (ds->ds_size - offset < 4)
+			goto bad;
+		length = dbg->read(ds->ds_data, &offset, 4);
+		if (length == 0xffffffff) {
+			if (ds->ds_size - offset < 8)
+				goto bad;
+			dwarf_size = 8;
+			length = dbg->read(ds->ds_data, &offset, 8);
+		} else
+			dwarf_size = 4;
+
+		if (length > ds->ds_size - offset || length < 32)
+			goto bad;
+
+		version = dbg->read(ds->ds_data, &offset, 2);
+		if (version != 5) {
+			/* Skip name indexes of an unknown version. */
+			offset += length - 2;
+			continue;
+		}
+
+		if ((ni = calloc(1, sizeof(struct _Dwarf_NameIdx))) == NULL) {
+			ret = DW_DLE_MEMORY;
+			DWARF_SET_ERROR(dbg, error, ret);
+			goto fail_cleanup;
+		}
+		STAILQ_INSERT_TAIL(&dbg->dbg_nilist, ni, ni_next);
+
+		ni->ni_ds = ds;
+		ni->ni_end = offset - 2 + length;
+		ni->ni_dwarf_size = dwarf_size;
+		(void) dbg->read(ds->ds_data, &offset, 2); /* Padding. */
+		ni->ni_cu_cnt = dbg->read(ds->ds_data, &offset, 4);
+		ni->ni_ltu_cnt = dbg->read(ds->ds_data, &offset, 4);
+		ni->ni_ftu_cnt = dbg->read(ds->ds_data, &offset, 4);
+		ni->ni_bucket_cnt = dbg->read(ds->ds_data, &offset, 4);
+		ni->ni_name_cnt = dbg->read(ds->ds_data, &offset, 4);
+		abbrev_size = dbg->read(ds->ds_data, &offset, 4);
+		aug_size = dbg->read(ds->ds_data, &offset, 4);
+
+		/*
+		 * Compute the location of each table of the name index.
+		 * The table sizes are products of 32-bit counts, so they
+		 * cannot overflow the 64-bit offset before being checked.
+		 */
+		offset += aug_size;
+		ni->ni_cu_off = offset;
+		offset += (uint64_t) ni->ni_cu_cnt * dwarf_size;
+		ni->ni_ltu_off = offset;
+		offset += (uint64_t) ni->ni_ltu_cnt * dwarf_size;
+		offset += (uint64_t) ni->ni_ftu_cnt * 8;
+		ni->ni_bucket_off = offset;
+		offset += (uint64_t) ni->ni_bucket_cnt * 4;
+		ni->ni_hash_off = offset;
+		if (ni->ni_bucket_cnt > 0)
+			offset += (uint64_t) ni->ni_name_cnt * 4;
+		ni->ni_stroff_off = offset;
+		offset += (uint64_t) ni->ni_name_cnt * dwarf_size;
+		ni->ni_entoff_off = offset;
+		offset += (uint64_t) ni->ni_name_cnt * dwarf_size;
+		if (offset > ni->ni_end || abbrev_size > ni->ni_end - offset)
+			goto bad;
+		ni->ni_pool_off = offset + abbrev_size;
+
+		ret = _dwarf_debugnames_abbrev_init(dbg, ni, offset,
+		    ni->ni_pool_off, error);
+		if (ret != DW_DLE_NONE)
+			goto fail_cleanup;
+
+		offset = ni->ni_end;
+	}
+
+	dbg->dbg_names_loaded = 1;
+
+	return (DW_DLE_NONE);
+
+bad:
+	ret = DW_DLE_DEBUG_NAMES_BAD;
+	DWARF_SET_ERROR(dbg, error, ret);
+
+fail_cleanup:
+
+	_dwarf_debugnames_cleanup(dbg);
+
+	return (ret);
+}
+
+/*
+ * The hash function of the name index: the DJB hash of the name after
+ * case folding.  Only ASCII letters are folded.
+ */
+static uint32_t
+_dwarf_debugnames_hash(const char *name)
+{
+	const unsigned char *p;
+	uint32_t h;
+	unsigned char c;
+
+	h = 5381;
+	for (p = (const unsigned char *) name; (c = *p) != '\0'; p++) {
+		if (c >= 'A' && c <= 'Z')
+			c += 'a' - 'A';
+		h = h * 33 + c;
+	}
+
+	return (h);
+}
+
+static int
+_dwarf_debugnames_read_form(Dwarf_Debug dbg, Dwarf_NameIdx ni,
+    uint64_t *offsetp, uint64_t form, uint64_t *val)
+{
+	Dwarf_Section *ds;
+	uint64_t len;
+
+	ds = ni->ni_ds;
+	len = 0;
+	switch (form) {
+	case DW_FORM_flag_present:
+		*val = 1;
+		return (DW_DLE_NONE);
+	case DW_FORM_data1:
+	case DW_FORM_flag:
+	case DW_FORM_ref1:
+		len = 1;
+		break;
+	case DW_FORM_data2:
+	case DW_FORM_ref2:
+		len = 2;
+		break;
+	case DW_FORM_data4:
+	case DW_FORM_ref4:
+		len = 4;
+		break;
+	case DW_FORM_data8:
+	case DW_FORM_ref8:
+	case DW_FORM_ref_sig8:
+		len = 8;
+		break;
+	case DW_FORM_strp:
+	case DW_FORM_sec_offset:
+		len = ni->ni_dwarf_size;
+		break;
+	case DW_FORM_udata:
+	case DW_FORM_ref_udata:
+		*val = _dwarf_read_uleb128(ds->ds_data, offsetp);
+		return (DW_DLE_NONE);
+	case DW_FORM_sdata:
+		*val = _dwarf_read_sleb128(ds->ds_data, offsetp);
+		return (DW_DLE_NONE);
+	case DW_FORM_data16:
+		*offsetp += 16;
+		*val = 0;
+		return (DW_DLE_NONE);
+	case DW_FORM_block1:
+		len = dbg->read(ds->ds_data, offsetp, 1);
+		break;
+	case DW_FORM_block2:
+		len = dbg->read(ds->ds_data, offsetp, 2);
+		break;
+	case DW_FORM_block4:
+		len = dbg->read(ds->ds_data, offsetp, 4);
+		break;
+	case DW_FORM_block:
+		len = _dwarf_read_uleb128(ds->ds_data, offsetp);
+		break;
+	default:
+		return (DW_DLE_DEBUG_NAMES_BAD);
+	}
+
+	if (len > ni->ni_end - *offsetp)
+		return (DW_DLE_DEBUG_NAMES_BAD);
+
+	switch (form) {
+	case DW_FORM_block1:
+	case DW_FORM_block2:
+	case DW_FORM_block4:
+	case DW_FORM_block:
+		*offsetp += len;
+		*val = 0;
+		break;
+	default:
+		*val = dbg->read(ds->ds_data, offsetp, len);
+		break;
+	}
+
+	return (DW_DLE_NONE);
+}
+
+/*
+ * Decode the series of index entries of the name at the given 1-based
+ * index of the name table, appending the .debug_info offsets of the
+ * DIEs they describe to the result array.
+ */
+static int
+_dwarf_debugnames_add_entries(Dwarf_Debug dbg, Dwarf_NameIdx ni,
+    uint32_t i, Dwarf_Half tag, Dwarf_Off **offsets, Dwarf_Unsigned *cnt,
+    Dwarf_Unsigned *cap)
+{
+	struct _Dwarf_NameIdxAbbrev *na;
+	Dwarf_Section *ds;
+	Dwarf_Off *p;
+	uint64_t offset, aoff, code, idx, form, val, unit, dieoff;
+	uint64_t cu_idx, tu_idx;
+	int has_cu, has_tu, has_die, ret;
+
+	ds = ni->ni_ds;
+	offset = ni->ni_entoff_off + (uint64_t) (i - 1) * ni->ni_dwarf_size;
+	offset = ni->ni_pool_off + dbg->read(ds->ds_data, &offset,
+	    ni->ni_dwarf_size);
+
+	for (;;) {
+		if (offset >= ni->ni_end)
+			return (DW_DLE_DEBUG_NAMES_BAD);
+		code = _dwarf_read_uleb128(ds->ds_data, &offset);
+		if (code == 0)
+			break;
+
+		/* Abbreviation codes are usually assigned sequentially. */
+		na = NULL;
+		if (code <= ni->ni_abbrev_cnt &&
+		    ni->ni_abbrev[code - 1].na_code == code)
+			na = &ni->ni_abbrev[code - 1];
+		else {
+			for (idx = 0; idx < ni->ni_abbrev_cnt; idx++) {
+				if (ni->ni_abbrev[idx].na_code == code) {
+					na = &ni->ni_abbrev[idx];
+					break;
+				}
+			}
+		}
+		if (na == NULL)
+			return (DW_DLE_DEBUG_NAMES_BAD);
+
+		has_cu = has_tu = has_die = 0;
+		cu_idx = tu_idx = dieoff = 0;
+		aoff = na->na_attr;
+		for (;;) {
+			idx = _dwarf_read_uleb128(ds->ds_data, &aoff);
+			form = _dwarf_read_uleb128(ds->ds_data, &aoff);
+			if (idx == 0 && form == 0)
+				break;
+			ret = _dwarf_debugnames_read_form(dbg, ni, &offset,
+			    form, &val);
+			if (ret != DW_DLE_NONE)
+				return (ret);
+			switch (idx) {
+			case DW_IDX_compile_unit:
+				has_cu = 1;
+				cu_idx = val;
+				break;
+			case DW_IDX_type_unit:
+				has_tu = 1;
+				tu_idx = val;
+				break;
+			case DW_IDX_die_offset:
+				has_die = 1;
+				dieoff = val;
+				break;
+			default:
+				break;
+			}
+		}
+
+		if (!has_die || (tag != 0 && na->na_tag != tag))
+			continue;
+
+		/*
+		 * Find the unit holding the DIE.  Entries of foreign type
+		 * units refer to DIEs in other objects and are skipped.
+		 * The unit index may be omitted when the name index covers
+		 * a single unit.
+		 */
+		if (has_tu) {
+			if (tu_idx >= ni->ni_ltu_cnt)
+				continue;
+			unit = ni->ni_ltu_off + tu_idx * ni->ni_dwarf_size;
+		} else if (has_cu) {
+			if (cu_idx >= ni->ni_cu_cnt)
+				return (DW_DLE_DEBUG_NAMES_BAD);
+			unit = ni->ni_cu_off + cu_idx * ni->ni_dwarf_size;
+		} else if (ni->ni_cu_cnt == 1)
+			unit = ni->ni_cu_off;
+		else if (ni->ni_cu_cnt == 0 && ni->ni_ltu_cnt == 1)
+			unit = ni->ni_ltu_off;
+		else
+			return (DW_DLE_DEBUG_NAMES_BAD);
+		unit = dbg->read(ds->ds_data, &unit, ni->ni_dwarf_size);
+
+		if (*cnt == *cap) {
+			*cap = *cap == 0 ? 8 : *cap * 2;
+			if ((p = realloc(*offsets, *cap * sizeof(Dwarf_Off))) ==
+			    NULL)
+				return (DW_DLE_MEMORY);
+			*offsets = p;
+		}
+		(*offsets)[(*cnt)++] = unit + dieoff;
+	}
+
+	return (DW_DLE_NONE);
+}
+
+int
+_dwarf_debugnames_lookup(Dwarf_Debug dbg, const char *name, Dwarf_Half tag,
+    Dwarf_Off **ret_offsets, Dwarf_Unsigned *ret_count, Dwarf_Error *error)
+{
+	Dwarf_NameIdx ni;
+	Dwarf_Section *ds, *str;
+	Dwarf_Off *offsets;
+	Dwarf_Unsigned cnt, cap;
+	uint64_t offset, stroff;
+	uint32_t hash, h, b, i;
+	int ret;
+
+	assert(dbg != NULL && name != NULL);
+
+	DWARF_LOCK(dbg);
+	ret = DW_DLE_NONE;
+	if (!dbg->dbg_names_loaded)
+		ret = _dwarf_debugnames_init(dbg, error);
+	DWARF_UNLOCK(dbg);
+	if (ret != DW_DLE_NONE)
+		return (ret);
+
+	if (STAILQ_EMPTY(&dbg->dbg_nilist))
+		return (DW_DLE_NO_ENTRY);
+
+	if ((ret = _dwarf_find_section(dbg, ".debug_str", &str, error)) !=
+	    DW_DLE_NONE)
+		return (ret);
+	if (str == NULL) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_DEBUG_NAMES_BAD);
+		return (DW_DLE_DEBUG_NAMES_BAD);
+	}
+
+	offsets = NULL;
+	cnt = cap = 0;
+	b = 0;
+	hash = _dwarf_debugnames_hash(name);
+
+	STAILQ_FOREACH(ni, &dbg->dbg_nilist, ni_next) {
+		ds = ni->ni_ds;
+
+		/*
+		 * Without a hash table the names can only be searched
+		 * linearly.  Otherwise walk the names of the bucket the
+		 * hash value maps to: they are stored contiguously and
+		 * end where a hash value maps to another bucket.
+		 */
+		if (ni->ni_bucket_cnt == 0)
+			i = 1;
+		else {
+			b = hash % ni->ni_bucket_cnt;
+			offset = ni->ni_bucket_off + (uint64_t) b * 4;
+			i = dbg->read(ds->ds_data, &offset, 4);
+			if (i == 0)
+				continue;
+		}
+
+		for (; i > 0 && i <= ni->ni_name_cnt; i++) {
+			if (ni->ni_bucket_cnt > 0) {
+				offset = ni->ni_hash_off + (uint64_t) (i - 1) *
+				    4;
+				h = dbg->read(ds->ds_data, &offset, 4);
+				if (h % ni->ni_bucket_cnt != b)
+					break;
+				if (h != hash)
+					continue;
+			}
+			offset = ni->ni_stroff_off + (uint64_t) (i - 1) *
+			    ni->ni_dwarf_size;
+			stroff = dbg->read(ds->ds_data, &offset,
+			    ni->ni_dwarf_size);
+			if (stroff >= str->ds_size) {
+				ret = DW_DLE_DEBUG_NAMES_BAD;
+				goto fail_cleanup;
+			}
+			if (strcmp((char *) str->ds_data + stroff, name) != 0)
+				continue;
+
+			ret = _dwarf_debugnames_add_entries(dbg, ni, i, tag,
+			    &offsets, &cnt, &cap);
+			if (ret != DW_DLE_NONE)
+				goto fail_cleanup;
+
+			/* A name appears only once in each name index. */
+			break;
+		}
+	}
+
+	if (cnt == 0) {
+		free(offsets);
+		return (DW_DLE_NO_ENTRY);
+	}
+
+	*ret_offsets = offsets;
+	*ret_count = cnt;
+
+	return (DW_DLE_NONE);
+
+fail_cleanup:
+
+	free(offsets);
+	DWARF_SET_ERROR(dbg, error, ret);
+
+	return (ret);
+}
+
+/*
+ * A name collected from the producer's name lookup tables.
+ */
+struct _Dwarf_NameIdxName {
+	char		*nn_name;	/* Name. */
+	uint32_t	nn_hash;	/* Hash value of the name. */
+	uint32_t	nn_bucket;	/* Hash bucket of the name. */
+	uint64_t	nn_stroff;	/* Offset of the name in .debug_str. */
+	Dwarf_P_Die	*nn_die;	/* Array of DIEs with the name. */
+	Dwarf_Unsigned	nn_diecnt;	/* Length of the DIE array. */
+	Dwarf_Unsigned	nn_diecap;	/* Capacity of the DIE array. */
+	UT_hash_handle	nn_hh;		/* Hash handle. */
+};
+
+static int
+_dwarf_debugnames_name_add(struct _Dwarf_NameIdxName **nnhash,
+    Dwarf_NamePair np)
+{
+	struct _Dwarf_NameIdxName *nn;
+	Dwarf_P_Die *p;
+	Dwarf_Unsigned i;
+
+	HASH_FIND(nn_hh, *nnhash, np->np_name, strlen(np->np_name), nn);
+	if (nn == NULL) {
+		if ((nn = calloc(1, sizeof(*nn))) == NULL)
+			return (DW_DLE_MEMORY);
+		nn->nn_name = np->np_name;
+		nn->nn_hash = _dwarf_debugnames_hash(nn->nn_name);
+		HASH_ADD_KEYPTR(nn_hh, *nnhash, nn->nn_name,
+		    strlen(nn->nn_name), nn);
+	}
+
+	/* The same DIE may be registered in several tables. */
+	for (i = 0; i < nn->nn_diecnt; i++)
+		if (nn->nn_die[i] == np->np_die)
+			return (DW_DLE_NONE);
+
+	if (nn->nn_diecnt == nn->nn_diecap) {
+		nn->nn_diecap = nn->nn_diecap == 0 ? 4 : nn->nn_diecap * 2;
+		if ((p = realloc(nn->nn_die, nn->nn_diecap *
+		    sizeof(Dwarf_P_Die))) == NULL)
+			return (DW_DLE_MEMORY);
+		nn->nn_die = p;
+	}
+	nn->nn_die[nn->nn_diecnt++] = np->np_die;
+
+	return (DW_DLE_NONE);
+}
+
+static int
+_dwarf_debugnames_name_cmp(const void *a, const void *b)
+{
+	struct _Dwarf_NameIdxName *na, *nb;
+
+	na = *(struct _Dwarf_NameIdxName * const *) a;
+	nb = *(struct _Dwarf_NameIdxName * const *) b;
+
+	if (na->nn_bucket != nb->nn_bucket)
+		return (na->nn_bucket < nb->nn_bucket ? -1 : 1);
+	if (na->nn_hash != nb->nn_hash)
+		return (na->nn_hash < nb->nn_hash ? -1 : 1);
+
+	return (strcmp(na->nn_name, nb->nn_name));
+}
+
+/*
+ * Generate a .debug_names section indexing every name registered with
+ * the producer's name lookup tables.
+ */
+int
+_dwarf_debugnames_gen(Dwarf_P_Debug dbg, Dwarf_Error *error)
+{
+	struct _Dwarf_NameIdxName *nnhash, *nn, *tnn, **nnarray;
+	Dwarf_NameTbl ntlist[5];
+	Dwarf_P_Section ds;
+	Dwarf_Rel_Section drs;
+	Dwarf_NamePair np;
+	Dwarf_CU cu;
+	Dwarf_Tag *tags, *t;
+	Dwarf_Unsigned ntag, cnt, i, j, k;
+	uint64_t offset, abbrev_size_off, abbrev_off, entoff_off, pool_off;
+	uint32_t bucket_cnt;
+	int ret;
+
+	assert(dbg != NULL);
+
+	if ((dbg->dbgp_flags & DW_DLC_DEBUG_NAMES) == 0)
+		return (DW_DLE_NONE);
+
+	nnhash = NULL;
+	nnarray = NULL;
+	tags = NULL;
+	ds = NULL;
+	drs = NULL;
+
+	/* Collect the names and the DIEs they refer to. */
+	ntlist[0] = dbg->dbgp_pubs;
+	ntlist[1] = dbg->dbgp_weaks;
+	ntlist[2] = dbg->dbgp_funcs;
+	ntlist[3] = dbg->dbgp_types;
+	ntlist[4] = dbg->dbgp_vars;
+	ntag = 0;
+	for (i = 0; i < 5; i++) {
+		if (ntlist[i] == NULL)
+			continue;
+		STAILQ_FOREACH(np, &ntlist[i]->nt_nplist, np_next) {
+			assert(np->np_die != NULL);
+			ret = _dwarf_debugnames_name_add(&nnhash, np);
+			if (ret != DW_DLE_NONE) {
+				DWARF_SET_ERROR(dbg, error, ret);
+				goto gen_cleanup;
+			}
+			ntag++;
+		}
+	}
+
+	cnt = HASH_CNT(nn_hh, nnhash);
+	if (cnt == 0)
+		return (DW_DLE_NONE);
+
+	cu = STAILQ_FIRST(&dbg->dbg_cu);
+	assert(cu != NULL);
+
+	/*
+	 * Use one hash bucket per name and sort the names by bucket, so
+	 * that the names of each bucket are contiguous in the name table.
+	 * One abbreviation is used per DIE tag; the abbreviation code is
+	 * the index of the tag plus one.
+	 */
+	bucket_cnt = cnt;
+	if ((nnarray = calloc(cnt, sizeof(*nnarray))) == NULL ||
+	    (tags = calloc(ntag, sizeof(Dwarf_Tag))) == NULL) {
+		ret = DW_DLE_MEMORY;
+		DWARF_SET_ERROR(dbg, error, ret);
+		goto gen_cleanup;
+	}
+	i = 0;
+	ntag = 0;
+	HASH_ITER(nn_hh, nnhash, nn, tnn) {
+		nn->nn_bucket = nn->nn_hash % bucket_cnt;
+		nnarray[i++] = nn;
+		for (j = 0; j < nn->nn_diecnt; j++) {
+			for (k = 0; k < ntag; k++)
+				if (tags[k] == nn->nn_die[j]->die_tag)
+					break;
+			if (k == ntag)
+				tags[ntag++] = nn->nn_die[j]->die_tag;
+		}
+		ret = _dwarf_strtab_add(dbg, nn->nn_name, &nn->nn_stroff,
+		    error);
+		if (ret != DW_DLE_NONE)
+			goto gen_cleanup;
+	}
+	qsort(nnarray, cnt, sizeof(*nnarray), _dwarf_debugnames_name_cmp);
+
+	/* Create .debug_names section. */
+	if ((ret = _dwarf_section_init(dbg, &ds, ".debug_names", 0, error)) !=
+	    DW_DLE_NONE)
+		goto gen_cleanup;
+
+	/* Create relocation section for .debug_names section. */
+	RCHECK(_dwarf_reloc_section_init(dbg, &drs, ds, error));
+
+	/* Write the name index header. */
+	RCHECK(WRITE_VALUE(0, 4));	/* Length, filled in later. */
+	RCHECK(WRITE_VALUE(5, 2));	/* Version. */
+	RCHECK(WRITE_VALUE(0, 2));	/* Padding. */
+	RCHECK(WRITE_VALUE(1, 4));	/* CU count. */
+	RCHECK(WRITE_VALUE(0, 4));	/* Local TU count. */
+	RCHECK(WRITE_VALUE(0, 4));	/* Foreign TU count. */
+	RCHECK(WRITE_VALUE(bucket_cnt, 4));
+	RCHECK(WRITE_VALUE(cnt, 4));
+	abbrev_size_off = ds->ds_size;
+	RCHECK(WRITE_VALUE(0, 4));	/* Abbrev table size. */
+	RCHECK(WRITE_VALUE(0, 4));	/* Augmentation string size. */
+
+	/* Write the CU list. */
+	RCHECK(_dwarf_reloc_entry_add(dbg, drs, ds, dwarf_drt_data_reloc, 4,
+	    ds->ds_size, 0, cu->cu_offset, ".debug_info", error));
+
+	/* Write the buckets: the 1-based index of the first name. */
+	for (i = 0, j = 0; i < bucket_cnt; i++) {
+		while (j < cnt && nnarray[j]->nn_bucket < i)
+			j++;
+		RCHECK(WRITE_VALUE(j < cnt && nnarray[j]->nn_bucket == i ?
+		    j + 1 : 0, 4));
+	}
+
+	/* Write the hashes and the string offsets. */
+	for (i = 0; i < cnt; i++)
+		RCHECK(WRITE_VALUE(nnarray[i]->nn_hash, 4));
+	for (i = 0; i < cnt; i++)
+		RCHECK(_dwarf_reloc_entry_add(dbg, drs, ds,
+		    dwarf_drt_data_reloc, 4, ds->ds_size, 0,
+		    nnarray[i]->nn_stroff, ".debug_str", error));
+
+	/* Reserve the entry offsets. */
+	entoff_off = ds->ds_size;
+	for (i = 0; i < cnt; i++)
+		RCHECK(WRITE_VALUE(0, 4));
+
+	/* Write the abbreviation table. */
+	abbrev_off = ds->ds_size;
+	for (i = 0; i < ntag; i++) {
+		RCHECK(WRITE_ULEB128(i + 1));
+		RCHECK(WRITE_ULEB128(tags[i]));
+		RCHECK(WRITE_ULEB128(DW_IDX_die_offset));
+		RCHECK(WRITE_ULEB128(DW_FORM_ref4));
+		RCHECK(WRITE_ULEB128(0));
+		RCHECK(WRITE_ULEB128(0));
+	}
+	RCHECK(WRITE_ULEB128(0));
+	offset = abbrev_size_off;
+	dbg->write(ds->ds_data, &offset, ds->ds_size - abbrev_off, 4);
+
+	/*
+	 * Write the entry pool.  The DIE offsets are relative to the CU,
+	 * and the CU index is omitted since there is only one CU.
+	 */
+	pool_off = ds->ds_size;
+	for (i = 0; i < cnt; i++) {
+		nn = nnarray[i];
+		offset = entoff_off + i * 4;
+		dbg->write(ds->ds_data, &offset, ds->ds_size - pool_off, 4);
+		for (j = 0; j < nn->nn_diecnt; j++) {
+			for (t = tags; *t != nn->nn_die[j]->die_tag; t++)
+				;
+			RCHECK(WRITE_ULEB128(t - tags + 1));
+			RCHECK(WRITE_VALUE(nn->nn_die[j]->die_offset, 4));
+		}
+		RCHECK(WRITE_ULEB128(0));
+	}
+
+	/* Fill in the length field. */
+	offset = 0;
+	dbg->write(ds->ds_data, &offset, ds->ds_size - 4, 4);
+
+	/* Inform application the creation of .debug_names ELF section. */
+	RCHECK(_dwarf_section_callback(dbg, ds, SHT_PROGBITS, 0, 0, 0, error));
+
+	/* Finalize relocation section for .debug_names section. */
+	RCHECK(_dwarf_reloc_section_finalize(dbg, drs, error));
+
+	ret = DW_DLE_NONE;
+	goto gen_cleanup;
+
+gen_fail:
+	_dwarf_reloc_section_free(dbg, &drs);
+	_dwarf_section_free(dbg, &ds);
+
+gen_cleanup:
+	HASH_ITER(nn_hh, nnhash, nn, tnn) {
+		HASH_DELETE(nn_hh, nnhash, nn);
+		free(nn->nn_die);
+		free(nn);
+	}
+	free(nnarray);
+	free(tags);
+
+	return (ret);
+}
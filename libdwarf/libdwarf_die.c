@@ -114,6 +114,7 @@ _dwarf_die_parse(Dwarf_Debug dbg, Dwarf_Section *ds, Dwarf_CU cu,
 
 	assert(cu != NULL);
 
+	cu->cu_lastuse = dbg->dbg_epoch;
 	level = 1;
 	die = NULL;
 
@@ -121,7 +122,7 @@ _dwarf_die_parse(Dwarf_Debug dbg, Dwarf_Section *ds, Dwarf_CU cu,
 
 		die_offset = offset;
 
-		abnum = _dwarf_read_uleb128(ds->ds_data, &offset);
+		abnum = _dwarf_section_read_uleb128(ds, &offset);
 
 		if (abnum == 0) {
 			if (level == 0 || !search_sibling)
@@ -157,6 +158,11 @@ _dwarf_die_parse(Dwarf_Debug dbg, Dwarf_Section *ds, Dwarf_CU cu,
 				level++;
 			}
 		} else {
+			if ((ret = _dwarf_attr_resolve_index(die, error)) !=
+			    DW_DLE_NONE) {
+				dwarf_dealloc(dbg, die, DW_DLA_DIE);
+				return (ret);
+			}
 			*ret_die = die;
 			return (DW_DLE_NONE);
 		}
@@ -273,72 +279,125 @@ _dwarf_die_count_links(Dwarf_P_Die parent, Dwarf_P_Die child,
 	return (count);
 }
 
+/*
+ * Producer DIE trees are walked with an explicit stack of ancestors,
+ * so neither deep nor wide trees consume the C stack.  Sibling links
+ * do not record the parent, hence the stack.
+ */
+struct _Dwarf_DieStack {
+	Dwarf_P_Die	*st_die;	/* Ancestors of the current DIE. */
+	int		st_depth;	/* Number of ancestors. */
+	int		st_cap;		/* Size of the array. */
+};
+
+/*
+ * Advance *diep to the next DIE in generation order: its first child,
+ * else its right sibling, else the right sibling of the nearest
+ * ancestor that has one.  *diep is set to NULL at the end of the tree.
+ * Every level finished on the way is ended by a null DIE; their number
+ * is returned in *nullp.
+ */
 static int
-_dwarf_die_gen_recursive(Dwarf_P_Debug dbg, Dwarf_CU cu, Dwarf_Rel_Section drs,
-    Dwarf_P_Die die, int pass2, Dwarf_Error *error)
+_dwarf_die_next(Dwarf_P_Debug dbg, struct _Dwarf_DieStack *st,
+    Dwarf_P_Die *diep, uint64_t *nullp, Dwarf_Error *error)
 {
-	Dwarf_P_Section ds;
-	Dwarf_Abbrev ab;
-	Dwarf_Attribute at;
-	Dwarf_AttrDef ad;
-	int match, ret;
+	Dwarf_P_Die die, *nd;
 
-	ds = dbg->dbgp_info;
-	assert(ds != NULL);
+	die = *diep;
+	*nullp = 0;
 
-	if (pass2)
-		goto attr_gen;
-
-	/*
-	 * Add DW_AT_sibling attribute for DIEs with children, so consumers
-	 * can quickly scan chains of siblings, while ignoring the children
-	 * of individual siblings.
-	 */
-	if (die->die_child && die->die_right) {
-		if (_dwarf_attr_find(die, DW_AT_sibling) == NULL)
-			(void) dwarf_add_AT_reference(dbg, die, DW_AT_sibling,
-			    die->die_right, error);
-	}
-
-	/*
-	 * Search abbrev list to find a matching entry.
-	 */
-	die->die_ab = NULL;
-	for (ab = cu->cu_abbrev_hash; ab != NULL; ab = ab->ab_hh.next) {
-		if (die->die_tag != ab->ab_tag)
-			continue;
-		if (ab->ab_children == DW_CHILDREN_no && die->die_child != NULL)
-			continue;
-		if (ab->ab_children == DW_CHILDREN_yes &&
-		    die->die_child == NULL)
-			continue;
-		at = STAILQ_FIRST(&die->die_attr);
-		ad = STAILQ_FIRST(&ab->ab_attrdef);
-		match = 1;
-		while (at != NULL && ad != NULL) {
-			if (at->at_attrib != ad->ad_attrib ||
-			    at->at_form != ad->ad_form) {
-				match = 0;
-				break;
+	if (die->die_child != NULL) {
+		if (st->st_depth == st->st_cap) {
+			nd = realloc(st->st_die, st->st_cap * 2 *
+			    sizeof(*st->st_die));
+			if (nd == NULL) {
+				DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
+				return (DW_DLE_MEMORY);
 			}
-			at = STAILQ_NEXT(at, at_next);
-			ad = STAILQ_NEXT(ad, ad_next);
+			st->st_die = nd;
+			st->st_cap *= 2;
 		}
-		if ((at == NULL && ad != NULL) || (at != NULL && ad == NULL))
-			match = 0;
-		if (match) {
-			die->die_ab = ab;
-			break;
+		st->st_die[st->st_depth++] = die;
+		*diep = die->die_child;
+		return (DW_DLE_NONE);
+	}
+
+	while (die->die_right == NULL) {
+		(*nullp)++;
+		if (st->st_depth == 0) {
+			*diep = NULL;
+			return (DW_DLE_NONE);
 		}
+		die = st->st_die[--st->st_depth];
 	}
+	*diep = die->die_right;
 
-	/*
-	 * Create a new abbrev entry if we can not reuse any existing one.
-	 */
-	if (die->die_ab == NULL) {
+	return (DW_DLE_NONE);
+}
+
+static int
+_dwarf_die_stack_init(Dwarf_P_Debug dbg, struct _Dwarf_DieStack *st,
+    Dwarf_Error *error)
+{
+
+	st->st_depth = 0;
+	st->st_cap = 16;
+	if ((st->st_die = malloc(st->st_cap * sizeof(*st->st_die))) == NULL) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
+		return (DW_DLE_MEMORY);
+	}
+
+	return (DW_DLE_NONE);
+}
+
+/*
+ * Producer abbrevs are shared by every DIE with the same tag, children
+ * flag and attribute/form list.  The encoded abbrev body is used as
+ * the hash key, so finding the abbrev of a DIE costs one lookup.
+ */
+struct _Dwarf_AbbrevKeys {
+	Dwarf_Abbrev	ak_hash;	/* Abbrevs hashed by body. */
+	uint8_t		*ak_buf;	/* Key encoding buffer. */
+	uint64_t	ak_cap;		/* Size of key buffer. */
+};
+
+static int
+_dwarf_die_abbrev_find(Dwarf_P_Debug dbg, Dwarf_CU cu,
+    struct _Dwarf_AbbrevKeys *ak, Dwarf_P_Die die, Dwarf_Error *error)
+{
+	Dwarf_Abbrev ab;
+	Dwarf_Attribute at;
+	uint64_t len;
+	uint8_t children;
+	int ret;
+
+	children = die->die_child != NULL ? DW_CHILDREN_yes : DW_CHILDREN_no;
+
+	len = 0;
+	ret = _dwarf_write_uleb128_alloc(&ak->ak_buf, &ak->ak_cap, &len,
+	    die->die_tag, error);
+	if (ret != DW_DLE_NONE)
+		return (ret);
+	ret = _dwarf_write_lsb_alloc(&ak->ak_buf, &ak->ak_cap, &len, children,
+	    1, error);
+	if (ret != DW_DLE_NONE)
+		return (ret);
+	STAILQ_FOREACH(at, &die->die_attr, at_next) {
+		ret = _dwarf_write_uleb128_alloc(&ak->ak_buf, &ak->ak_cap,
+		    &len, at->at_attrib, error);
+		if (ret != DW_DLE_NONE)
+			return (ret);
+		ret = _dwarf_write_uleb128_alloc(&ak->ak_buf, &ak->ak_cap,
+		    &len, at->at_form, error);
+		if (ret != DW_DLE_NONE)
+			return (ret);
+	}
+
+	HASH_FIND(ab_khh, ak->ak_hash, ak->ak_buf, len, ab);
+	if (ab == NULL) {
+		/* Create a new abbrev entry. */
 		ret = _dwarf_abbrev_add(cu, ++cu->cu_abbrev_cnt, die->die_tag,
-		    die->die_child != NULL ? DW_CHILDREN_yes : DW_CHILDREN_no,
-		    0, &ab, error);
+		    children, 0, &ab, error);
 		if (ret != DW_DLE_NONE)
 			return (ret);
 		STAILQ_FOREACH(at, &die->die_attr, at_next) {
@@ -347,84 +406,265 @@ _dwarf_die_gen_recursive(Dwarf_P_Debug dbg, Dwarf_CU cu, Dwarf_Rel_Section drs,
 			if (ret != DW_DLE_NONE)
 				return (ret);
 		}
-		die->die_ab = ab;
+		if ((ab->ab_key = malloc(len)) == NULL) {
+			DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
+			return (DW_DLE_MEMORY);
+		}
+		memcpy(ab->ab_key, ak->ak_buf, len);
+		HASH_ADD_KEYPTR(ab_khh, ak->ak_hash, ab->ab_key, len, ab);
 	}
 
-	die->die_offset = ds->ds_size;
+	ab->ab_usecnt++;
+	die->die_ab = ab;
 
-	/*
-	 * Transform the DIE to bytes stream.
-	 */
-	ret = _dwarf_write_uleb128_alloc(&ds->ds_data, &ds->ds_cap,
-	    &ds->ds_size, die->die_ab->ab_entry, error);
-	if (ret != DW_DLE_NONE)
-		return (ret);
+	return (DW_DLE_NONE);
+}
 
-attr_gen:
+static int
+_dwarf_abbrev_usecmp(Dwarf_Abbrev a, Dwarf_Abbrev b)
+{
 
-	/* Transform the attributes of this DIE. */
-	ret = _dwarf_attr_gen(dbg, ds, drs, cu, die, pass2, error);
-	if (ret != DW_DLE_NONE)
-		return (ret);
+	if (a->ab_usecnt == b->ab_usecnt)
+		return (0);
 
-	/* Proceed to child DIE. */
-	if (die->die_child != NULL) {
-		ret = _dwarf_die_gen_recursive(dbg, cu, drs, die->die_child,
-		    pass2, error);
-		if (ret != DW_DLE_NONE)
-			return (ret);
+	return (a->ab_usecnt > b->ab_usecnt ? -1 : 1);
+}
+
+/*
+ * Assign an abbrev to every DIE of the CU, then number the abbrevs by
+ * decreasing use count so the most common ones get one byte codes.
+ */
+static int
+_dwarf_die_abbrev_gen(Dwarf_P_Debug dbg, Dwarf_CU cu,
+    struct _Dwarf_DieStack *st, Dwarf_P_Die die, Dwarf_Error *error)
+{
+	struct _Dwarf_AbbrevKeys ak;
+	Dwarf_Abbrev ab, tab;
+	uint64_t entry, nulls;
+	int ret;
+
+	ak.ak_hash = NULL;
+	ak.ak_cap = 64;
+	if ((ak.ak_buf = malloc(ak.ak_cap)) == NULL) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
+		return (DW_DLE_MEMORY);
 	}
 
-	/* Proceed to sibling DIE. */
-	if (die->die_right != NULL) {
-		ret = _dwarf_die_gen_recursive(dbg, cu, drs, die->die_right,
-		    pass2, error);
+	ret = DW_DLE_NONE;
+	while (die != NULL) {
+		/*
+		 * Add DW_AT_sibling attribute for DIEs with children, so
+		 * consumers can quickly scan chains of siblings, while
+		 * ignoring the children of individual siblings.
+		 */
+		if (die->die_child && die->die_right) {
+			if (_dwarf_attr_find(die, DW_AT_sibling) == NULL)
+				(void) dwarf_add_AT_reference(dbg, die,
+				    DW_AT_sibling, die->die_right, error);
+		}
+
+		ret = _dwarf_die_abbrev_find(dbg, cu, &ak, die, error);
 		if (ret != DW_DLE_NONE)
-			return (ret);
+			break;
+		ret = _dwarf_die_next(dbg, st, &die, &nulls, error);
+		if (ret != DW_DLE_NONE)
+			break;
+	}
+
+	HASH_ITER(ab_khh, ak.ak_hash, ab, tab) {
+		HASH_DELETE(ab_khh, ak.ak_hash, ab);
+		free(ab->ab_key);
+		ab->ab_key = NULL;
 	}
+	free(ak.ak_buf);
 
-	/* Write a null DIE indicating the end of current level. */
-	if (die->die_right == NULL) {
-		ret = _dwarf_write_uleb128_alloc(&ds->ds_data, &ds->ds_cap,
-		    &ds->ds_size, 0, error);
+	if (ret != DW_DLE_NONE)
+		return (ret);
+
+	HASH_SRT(ab_hh, cu->cu_abbrev_hash, _dwarf_abbrev_usecmp);
+	ab = cu->cu_abbrev_hash;
+	HASH_CLEAR(ab_hh, cu->cu_abbrev_hash);
+	for (entry = 1; ab != NULL; ab = tab, entry++) {
+		tab = ab->ab_hh.next;
+		ab->ab_entry = entry;
+		HASH_ADD(ab_hh, cu->cu_abbrev_hash, ab_entry,
+		    sizeof(ab->ab_entry), ab);
+	}
+
+	return (DW_DLE_NONE);
+}
+
+/*
+ * Compute the offset of every DIE of the CU, starting at offset
+ * 'start', and return the offset past the last DIE in *endp.
+ */
+static int
+_dwarf_die_layout(Dwarf_P_Debug dbg, Dwarf_CU cu, struct _Dwarf_DieStack *st,
+    Dwarf_P_Die die, uint64_t start, uint64_t *endp, Dwarf_Error *error)
+{
+	Dwarf_Attribute at;
+	uint8_t buf[16];
+	uint64_t nulls, offset;
+	int ret;
+
+	offset = start;
+	while (die != NULL) {
+		die->die_offset = offset;
+		offset += _dwarf_write_uleb128(buf, buf + sizeof(buf),
+		    die->die_ab->ab_entry);
+		STAILQ_FOREACH(at, &die->die_attr, at_next)
+			offset += _dwarf_attr_size(cu, at);
+		ret = _dwarf_die_next(dbg, st, &die, &nulls, error);
 		if (ret != DW_DLE_NONE)
 			return (ret);
+		offset += nulls;
 	}
 
+	*endp = offset;
+
 	return (DW_DLE_NONE);
 }
 
+/*
+ * DIE references are CU relative, so every reference fits in a form
+ * that can hold the size of the CU.  Pick the smallest such form and
+ * use it for all references, which keeps the abbrevs shared.
+ */
+static void
+_dwarf_die_ref_shrink(Dwarf_P_Debug dbg, Dwarf_CU cu, uint64_t size)
+{
+	Dwarf_Abbrev ab;
+	Dwarf_AttrDef ad;
+	Dwarf_Attribute at;
+	Dwarf_P_Die die;
+	uint64_t form;
+
+	/* References given as plain values must fit as well. */
+	STAILQ_FOREACH(die, &dbg->dbgp_dielist, die_pro_next) {
+		if (die->die_ab == NULL)
+			continue;
+		STAILQ_FOREACH(at, &die->die_attr, at_next) {
+			if ((at->at_form == DW_FORM_ref4 ||
+			    at->at_form == DW_FORM_ref8) &&
+			    at->at_refdie == NULL && at->u[0].u64 > size)
+				size = at->u[0].u64;
+		}
+	}
+
+	if (size <= UCHAR_MAX)
+		form = DW_FORM_ref1;
+	else if (size <= USHRT_MAX)
+		form = DW_FORM_ref2;
+	else
+		return;
+
+	STAILQ_FOREACH(die, &dbg->dbgp_dielist, die_pro_next) {
+		if (die->die_ab == NULL)
+			continue;
+		STAILQ_FOREACH(at, &die->die_attr, at_next) {
+			if (at->at_form == DW_FORM_ref4 ||
+			    at->at_form == DW_FORM_ref8)
+				at->at_form = form;
+		}
+	}
+	for (ab = cu->cu_abbrev_hash; ab != NULL; ab = ab->ab_hh.next) {
+		STAILQ_FOREACH(ad, &ab->ab_attrdef, ad_next) {
+			if (ad->ad_form == DW_FORM_ref4 ||
+			    ad->ad_form == DW_FORM_ref8)
+				ad->ad_form = form;
+		}
+	}
+}
+
 int
 _dwarf_die_gen(Dwarf_P_Debug dbg, Dwarf_CU cu, Dwarf_Rel_Section drs,
     Dwarf_Error *error)
 {
+	struct _Dwarf_DieStack st;
+	Dwarf_P_Section ds;
 	Dwarf_Abbrev ab, tab;
 	Dwarf_AttrDef ad, tad;
-	Dwarf_Die die;
+	Dwarf_Die die, root;
+	uint64_t end, nulls;
+	uint8_t *data;
 	int ret;
 
 	assert(dbg != NULL && cu != NULL);
 	assert(dbg->dbgp_root_die != NULL);
 
-	die = dbg->dbgp_root_die;
+	ds = dbg->dbgp_info;
+	assert(ds != NULL);
+
+	root = dbg->dbgp_root_die;
+	st.st_die = NULL;
 
 	/*
 	 * Insert a DW_AT_stmt_list attribute into root DIE, if there are
 	 * line number information.
 	 */
 	if (!STAILQ_EMPTY(&dbg->dbgp_lineinfo->li_lnlist))
-		RCHECK(_dwarf_add_AT_dataref(dbg, die, DW_AT_stmt_list, 0, 0,
+		RCHECK(_dwarf_add_AT_dataref(dbg, root, DW_AT_stmt_list, 0, 0,
 		    ".debug_line", NULL, error));
 
-	RCHECK(_dwarf_die_gen_recursive(dbg, cu, drs, die, 0, error));
+	RCHECK(_dwarf_die_stack_init(dbg, &st, error));
 
-	if (cu->cu_pass2)
-		RCHECK(_dwarf_die_gen_recursive(dbg, cu, drs, die, 1, error));
+	RCHECK(_dwarf_die_abbrev_gen(dbg, cu, &st, root, error));
+
+	/*
+	 * Lay out the DIEs to size the references, then again with the
+	 * final forms.  The second layout gives the offset of every DIE,
+	 * so forward references are written directly, and the exact
+	 * size of the section, which is allocated once.
+	 */
+	RCHECK(_dwarf_die_layout(dbg, cu, &st, root, ds->ds_size, &end,
+	    error));
+	_dwarf_die_ref_shrink(dbg, cu, end);
+	RCHECK(_dwarf_die_layout(dbg, cu, &st, root, ds->ds_size, &end,
+	    error));
+	if (end > ds->ds_cap) {
+		if ((data = realloc(ds->ds_data, end)) == NULL) {
+			DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
+			ret = DW_DLE_MEMORY;
+			goto gen_fail;
+		}
+		ds->ds_data = data;
+		ds->ds_cap = end;
+	}
+
+	/* Transform the DIEs to bytes stream. */
+	die = root;
+	while (die != NULL) {
+		assert(die->die_offset == ds->ds_size);
+		RCHECK(WRITE_ULEB128(die->die_ab->ab_entry));
+		RCHECK(_dwarf_attr_gen(dbg, ds, drs, cu, die, 0, error));
+		RCHECK(_dwarf_die_next(dbg, &st, &die, &nulls, error));
+		/* Write null DIEs indicating the end of levels. */
+		while (nulls-- > 0)
+			RCHECK(WRITE_ULEB128(0));
+	}
+	assert(ds->ds_size == end);
+
+	/*
+	 * References to DIEs outside of the tree are filled in when the
+	 * whole CU is written.
+	 */
+	if (cu->cu_pass2) {
+		STAILQ_FOREACH(die, &dbg->dbgp_dielist, die_pro_next) {
+			if (die->die_ab == NULL)
+				continue;
+			RCHECK(_dwarf_attr_gen(dbg, ds, drs, cu, die, 1,
+			    error));
+		}
+	}
+
+	free(st.st_die);
 
 	return (DW_DLE_NONE);
 
 gen_fail:
 
+	free(st.st_die);
+
 	HASH_ITER(ab_hh, cu->cu_abbrev_hash, ab, tab) {
 		HASH_DELETE(ab_hh, cu->cu_abbrev_hash, ab);
 		STAILQ_FOREACH_SAFE(ad, &ab->ab_attrdef, ad_next, tad) {
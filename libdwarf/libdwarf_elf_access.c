@@ -33,6 +33,7 @@ _dwarf_elf_get_section_info(void *obj, Dwarf_Half ndx,
     Dwarf_Obj_Access_Section *ret_section, int *error)
 {
 	Dwarf_Elf_Object *e;
+	Dwarf_Elf_Data *ed;
 	GElf_Shdr *sh;
 
 	e = obj;
@@ -51,16 +52,16 @@ _dwarf_elf_get_section_info(void *obj, Dwarf_Half ndx,
 	}
 
 	sh = &e->eo_shdr[ndx];
+	ed = &e->eo_data[ndx];
 
 	ret_section->addr = sh->sh_addr;
-	ret_section->size = sh->sh_size;
+	if (ed->ed_compress != DWARF_COMPRESS_NONE)
+		ret_section->size = ed->ed_size;
+	else
+		ret_section->size = sh->sh_size;
 
-	ret_section->name = elf_strptr(e->eo_elf, e->eo_strndx, sh->sh_name);
-	if (ret_section->name == NULL) {
-		if (error)
-			*error = DW_DLE_ELF;
-		return (DW_DLV_ERROR);
-	}
+	/* Compressed ".zdebug_*" sections are known by their plain name. */
+	ret_section->name = ed->ed_name;
 
 	return (DW_DLV_OK);
 }
@@ -131,6 +132,7 @@ _dwarf_elf_load_section(void *obj, Dwarf_Half ndx, Dwarf_Small** ret_data,
 {
 	Dwarf_Elf_Object *e;
 	Dwarf_Elf_Data *ed;
+	int ret;
 
 	e = obj;
 	assert(e != NULL);
@@ -149,6 +151,12 @@ _dwarf_elf_load_section(void *obj, Dwarf_Half ndx, Dwarf_Small** ret_data,
 
 	ed = &e->eo_data[ndx];
 
+	if (_dwarf_elf_load_data(e, ed, &ret) != DW_DLE_NONE) {
+		if (error)
+			*error = ret;
+		return (DW_DLV_ERROR);
+	}
+
 	if (ed->ed_alloc != NULL)
 		*ret_data = ed->ed_alloc;
 	else {
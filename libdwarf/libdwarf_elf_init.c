@@ -46,12 +46,149 @@ static const char *debug_name[] = {
 	".debug_static_vars",
 	".debug_typenames",
 	".debug_weaknames",
+	".debug_str_offsets",
+	".debug_addr",
+	".debug_line_str",
+	".debug_rnglists",
+	".debug_loclists",
+	".debug_names",
+	".debug_cu_index",
+	".debug_tu_index",
 	NULL
 };
 
+/*
+ * Map the name of a section to the name of the debug section it holds,
+ * recognizing the ".zdebug_*" names of GNU-style compressed sections
+ * and the ".dwo" suffix of the sections in split DWARF objects.
+ */
+static const char *
+_dwarf_elf_debug_name(const char *name)
+{
+	size_t len;
+	int i;
+
+	if (name[0] != '.')
+		return (NULL);
+	name += strncmp(name, ".zdebug", 7) ? 1 : 2;
+
+	len = strlen(name);
+	if (len > 4 && !strcmp(name + len - 4, ".dwo"))
+		len -= 4;
+
+	for (i = 0; debug_name[i] != NULL; i++) {
+		if (!strncmp(name, debug_name[i] + 1, len) &&
+		    debug_name[i][len + 1] == '\0')
+			return (debug_name[i]);
+	}
+
+	return (NULL);
+}
+
+/*
+ * Read the compression header of a compressed debug section, which is
+ * either a section with the SHF_COMPRESSED flag set or a GNU-style
+ * ".zdebug_*" section.
+ */
+static int
+_dwarf_elf_compress_header(Dwarf_Elf_Object *e, Elf_Scn *scn, GElf_Shdr *sh,
+    const char *name, Dwarf_Elf_Data *ed)
+{
+	uint64_t (*dec)(uint8_t **, int);
+	Elf_Data *d;
+	uint8_t *p;
+
+	if ((sh->sh_flags & SHF_COMPRESSED) == 0 &&
+	    strncmp(name, ".zdebug", 7) != 0)
+		return (DW_DLE_NONE);
+
+	(void) elf_errno();
+	if ((d = elf_rawdata(scn, NULL)) == NULL)
+		return (elf_errno() != 0 ? DW_DLE_ELF : DW_DLE_COMPRESSION);
+
+	if ((sh->sh_flags & SHF_COMPRESSED) == 0) {
+		ed->ed_hdrsize = _dwarf_decompress_zdebug_header(d->d_buf,
+		    d->d_size, &ed->ed_size);
+		if (ed->ed_hdrsize == 0)
+			return (DW_DLE_COMPRESSION);
+		ed->ed_compress = DWARF_COMPRESS_ZLIB;
+		return (DW_DLE_NONE);
+	}
+
+	if (e->eo_ehdr.e_ident[EI_DATA] == ELFDATA2MSB)
+		dec = _dwarf_decode_msb;
+	else
+		dec = _dwarf_decode_lsb;
+
+	/* Elf32_Chdr and Elf64_Chdr. */
+	p = d->d_buf;
+	if (e->eo_ehdr.e_ident[EI_CLASS] == ELFCLASS32) {
+		if (d->d_size < 12)
+			return (DW_DLE_COMPRESSION);
+		ed->ed_compress = (int) dec(&p, 4);
+		ed->ed_size = dec(&p, 4);
+		ed->ed_hdrsize = 12;
+	} else {
+		if (d->d_size < 24)
+			return (DW_DLE_COMPRESSION);
+		ed->ed_compress = (int) dec(&p, 4);
+		p += 4;
+		ed->ed_size = dec(&p, 8);
+		ed->ed_hdrsize = 24;
+	}
+
+	if (ed->ed_compress == DWARF_COMPRESS_NONE)
+		return (DW_DLE_COMPRESSION);
+
+	return (DW_DLE_NONE);
+}
+
+/*
+ * Decompress the data of a compressed debug section into a buffer
+ * owned by the ELF access object.
+ */
+static int
+_dwarf_elf_decompress(Dwarf_Elf_Object *e, Dwarf_Elf_Data *ed, Elf_Scn *scn,
+    int *error)
+{
+	uint8_t *buf;
+	int ret;
+
+	(void) elf_errno();
+	if ((ed->ed_data = elf_rawdata(scn, NULL)) == NULL) {
+		e->eo_elferror = elf_errno();
+		ret = e->eo_elferror != 0 ? DW_DLE_ELF : DW_DLE_COMPRESSION;
+		*error = ret;
+		return (ret);
+	}
+
+	if (ed->ed_data->d_size < ed->ed_hdrsize) {
+		*error = DW_DLE_COMPRESSION;
+		return (DW_DLE_COMPRESSION);
+	}
+
+	if ((ed->ed_alloc = malloc(ed->ed_size > 0 ? ed->ed_size : 1)) ==
+	    NULL) {
+		*error = DW_DLE_MEMORY;
+		return (DW_DLE_MEMORY);
+	}
+
+	buf = ed->ed_data->d_buf;
+	ret = _dwarf_decompress(ed->ed_compress, buf + ed->ed_hdrsize,
+	    ed->ed_data->d_size - ed->ed_hdrsize, ed->ed_alloc, ed->ed_size);
+	if (ret != DW_DLE_NONE) {
+		free(ed->ed_alloc);
+		ed->ed_alloc = NULL;
+		*error = ret;
+		return (ret);
+	}
+
+	return (DW_DLE_NONE);
+}
+
 static void
-_dwarf_elf_apply_reloc(Dwarf_Debug dbg, void *buf, Elf_Data *rel_data,
-    Elf_Data *symtab_data, int endian)
+_dwarf_elf_apply_reloc(Dwarf_Debug dbg, void *buf, Dwarf_Unsigned bufsize,
+    Elf_Data *rel_data, Elf_Data *symtab_data, int endian)
 {
 	Dwarf_Unsigned type;
 	GElf_Rela rela;
@@ -70,6 +207,8 @@ _dwarf_elf_apply_reloc(Dwarf_Debug dbg, void *buf, Elf_Data *rel_data,
 
 		offset = rela.r_offset;
 		size = _dwarf_get_reloc_size(dbg, type);
+		if (size == 0 || offset + size > bufsize)
+			continue;
 
 		if (endian == ELFDATA2MSB)
 			_dwarf_write_msb(buf, &offset, rela.r_addend, size);
@@ -79,65 +218,176 @@ _dwarf_elf_apply_reloc(Dwarf_Debug dbg, void *buf, Elf_Data *rel_data,
 }
 
 static int
-_dwarf_elf_relocate(Dwarf_Debug dbg, Elf *elf, Dwarf_Elf_Data *ed, size_t shndx,
-    size_t symtab, Elf_Data *symtab_data, Dwarf_Error *error)
+_dwarf_elf_relocate(Dwarf_Elf_Object *e, Dwarf_Elf_Data *ed, int *error)
 {
 	GElf_Ehdr eh;
 	GElf_Shdr sh;
 	Elf_Scn *scn;
 	Elf_Data *rel;
+	Dwarf_Unsigned size;
 	int elferr;
 
-	if (symtab == 0 || symtab_data == NULL)
+	if (e->eo_symtab == 0 || e->eo_symtab_data == NULL)
 		return (DW_DLE_NONE);
 
-	if (gelf_getehdr(elf, &eh) == NULL) {
-		DWARF_SET_ELF_ERROR(dbg, error);
-		return (DW_DLE_ELF);
-	}
+	(void) elf_errno();
+	if (gelf_getehdr(e->eo_elf, &eh) == NULL)
+		goto elf_error;
 
 	scn = NULL;
-	(void) elf_errno();
-	while ((scn = elf_nextscn(elf, scn)) != NULL) {
-		if (gelf_getshdr(scn, &sh) == NULL) {
-			DWARF_SET_ELF_ERROR(dbg, error);
-			return (DW_DLE_ELF);
-		}
+	while ((scn = elf_nextscn(e->eo_elf, scn)) != NULL) {
+		if (gelf_getshdr(scn, &sh) == NULL)
+			goto elf_error;
 
 		if (sh.sh_type != SHT_RELA || sh.sh_size == 0)
 			continue;
 
-		if (sh.sh_info == shndx && sh.sh_link == symtab) {
+		if (sh.sh_info == ed->ed_ndx && sh.sh_link == e->eo_symtab) {
 			if ((rel = elf_getdata(scn, NULL)) == NULL) {
-				elferr = elf_errno();
-				if (elferr != 0) {
-					_DWARF_SET_ERROR(NULL, error,
-					    DW_DLE_ELF, elferr);
-					return (DW_DLE_ELF);
-				} else
-					return (DW_DLE_NONE);
+				if ((elferr = elf_errno()) != 0)
+					goto elf_error_set;
+				return (DW_DLE_NONE);
 			}
 
-			ed->ed_alloc = malloc(ed->ed_data->d_size);
+			/*
+			 * A decompressed section is already held in a
+			 * private buffer and can be relocated in place.
+			 */
 			if (ed->ed_alloc == NULL) {
-				DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
-				return (DW_DLE_MEMORY);
-			}
-			memcpy(ed->ed_alloc, ed->ed_data->d_buf,
-			    ed->ed_data->d_size);
-			_dwarf_elf_apply_reloc(dbg, ed->ed_alloc, rel,
-			    symtab_data, eh.e_ident[EI_DATA]);
+				ed->ed_alloc = malloc(ed->ed_data->d_size);
+				if (ed->ed_alloc == NULL) {
+					*error = DW_DLE_MEMORY;
+					return (DW_DLE_MEMORY);
+				}
+				memcpy(ed->ed_alloc, ed->ed_data->d_buf,
+				    ed->ed_data->d_size);
+				size = ed->ed_data->d_size;
+			} else
+				size = ed->ed_size;
+			_dwarf_elf_apply_reloc(e->eo_dbg, ed->ed_alloc, size,
+			    rel, e->eo_symtab_data, eh.e_ident[EI_DATA]);
 
 			return (DW_DLE_NONE);
 		}
 	}
+	if ((elferr = elf_errno()) != 0)
+		goto elf_error_set;
+
+	return (DW_DLE_NONE);
+
+elf_error:
 	elferr = elf_errno();
-	if (elferr != 0) {
-		DWARF_SET_ELF_ERROR(dbg, error);
-		return (DW_DLE_ELF);
+elf_error_set:
+	e->eo_elferror = elferr;
+	*error = DW_DLE_ELF;
+	return (DW_DLE_ELF);
+}
+
+/*
+ * Retrieve the data of a debug section, decompress it if needed, and
+ * apply relocations to it if requested.  This is done the first time
+ * the section is accessed.  If libelf fails, the libelf error number
+ * is kept for _dwarf_elf_load_error().
+ */
+int
+_dwarf_elf_load_data(Dwarf_Elf_Object *e, Dwarf_Elf_Data *ed, int *error)
+{
+	Elf_Scn *scn;
+	int elferr, ret;
+
+	if (ed->ed_loaded)
+		return (DW_DLE_NONE);
+
+	(void) elf_errno();
+	if ((scn = elf_getscn(e->eo_elf, ed->ed_ndx)) == NULL)
+		goto elf_error;
+
+	if (ed->ed_compress != DWARF_COMPRESS_NONE) {
+		if ((ret = _dwarf_elf_decompress(e, ed, scn, error)) !=
+		    DW_DLE_NONE)
+			return (ret);
+	} else if ((ed->ed_data = elf_getdata(scn, NULL)) == NULL) {
+		if ((elferr = elf_errno()) != 0)
+			goto elf_error_set;
+		ed->ed_loaded = 1;
+		return (DW_DLE_NONE);
 	}
 
+	if (e->eo_applyrela && e->eo_symtab != 0) {
+		if (e->eo_symtab_data == NULL) {
+			if ((scn = elf_getscn(e->eo_elf, e->eo_symtab)) ==
+			    NULL ||
+			    (e->eo_symtab_data = elf_getdata(scn, NULL)) ==
+			    NULL) {
+				if ((elferr = elf_errno()) != 0)
+					goto elf_error_set;
+			}
+		}
+		if ((ret = _dwarf_elf_relocate(e, ed, error)) != DW_DLE_NONE)
+			return (ret);
+	}
+
+	ed->ed_loaded = 1;
+
 	return (DW_DLE_NONE);
+
+elf_error:
+	elferr = elf_errno();
+elf_error_set:
+	e->eo_elferror = elferr;
+	*error = DW_DLE_ELF;
+	return (DW_DLE_ELF);
+}
+
+/*
+ * Return the libelf error number of the last section load that failed
+ * with DW_DLE_ELF, or 0 if the consumer was not opened through the ELF
+ * object access layer.
+ */
+int
+_dwarf_elf_load_error(Dwarf_Debug dbg)
+{
+	Dwarf_Elf_Object *e;
+
+	if (dbg->dbg_iface == NULL ||
+	    dbg->dbg_iface->methods->load_section != _dwarf_elf_load_section)
+		return (0);
+
+	e = dbg->dbg_iface->object;
+
+	return (e->eo_elferror);
+}
+
+/*
+ * Return the number of bytes held by the ELF object access layer for
+ * decompressed and relocated copies of section data, or 0 if the
+ * consumer was not opened through it.
+ */
+Dwarf_Unsigned
+_dwarf_elf_memory_usage(Dwarf_Debug dbg)
+{
+	Dwarf_Elf_Object *e;
+	Dwarf_Elf_Data *ed;
+	Dwarf_Unsigned i, size;
+
+	if (dbg->dbg_iface == NULL ||
+	    dbg->dbg_iface->methods->load_section != _dwarf_elf_load_section)
+		return (0);
+
+	e = dbg->dbg_iface->object;
+	size = sizeof(*e) + e->eo_seccnt * (sizeof(Dwarf_Elf_Data) +
+	    sizeof(GElf_Shdr));
+	for (i = 0; i < e->eo_seccnt; i++) {
+		ed = &e->eo_data[i];
+		if (ed->ed_alloc == NULL)
+			continue;
+		if (ed->ed_compress != DWARF_COMPRESS_NONE)
+			size += ed->ed_size;
+		else
+			size += ed->ed_data->d_size;
+	}
+
+	return (size);
 }
 
 int
@@ -148,9 +398,7 @@ _dwarf_elf_init(Dwarf_Debug dbg, Elf *elf, Dwarf_Error *error)
 	const char *name;
 	GElf_Shdr sh;
 	Elf_Scn *scn;
-	Elf_Data *symtab_data;
-	size_t symtab_ndx;
-	int elferr, i, j, n, ret;
+	int elferr, j, n, ret;
 
 	ret = DW_DLE_NONE;
 
@@ -166,6 +414,8 @@ _dwarf_elf_init(Dwarf_Debug dbg, Elf *elf, Dwarf_Error *error)
 	}
 
 	e->eo_elf = elf;
+	e->eo_dbg = dbg;
+	e->eo_applyrela = _libdwarf.applyrela;
 	e->eo_methods.get_section_info = _dwarf_elf_get_section_info;
 	e->eo_methods.get_byte_order = _dwarf_elf_get_byte_order;
 	e->eo_methods.get_length_size = _dwarf_elf_get_length_size;
@@ -192,9 +442,12 @@ _dwarf_elf_init(Dwarf_Debug dbg, Elf *elf, Dwarf_Error *error)
 		goto fail_cleanup;
 	}
 
+	/*
+	 * Only the section headers are examined here.  The section data
+	 * is retrieved, and relocated, by _dwarf_elf_load_data() when a
+	 * section is first used.
+	 */
 	n = 0;
-	symtab_ndx = 0;
-	symtab_data = NULL;
 	scn = NULL;
 	(void) elf_errno();
 	while ((scn = elf_nextscn(elf, scn)) != NULL) {
@@ -212,23 +465,12 @@ _dwarf_elf_init(Dwarf_Debug dbg, Elf *elf, Dwarf_Error *error)
 		}
 
 		if (!strcmp(name, ".symtab")) {
-			symtab_ndx = elf_ndxscn(scn);
-			if ((symtab_data = elf_getdata(scn, NULL)) == NULL) {
-				elferr = elf_errno();
-				if (elferr != 0) {
-					_DWARF_SET_ERROR(NULL, error,
-					    DW_DLE_ELF, elferr);
-					ret = DW_DLE_ELF;
-					goto fail_cleanup;
-				}
-			}
+			e->eo_symtab = elf_ndxscn(scn);
 			continue;
 		}
 
-		for (i = 0; debug_name[i] != NULL; i++) {
-			if (!strcmp(name, debug_name[i]))
-				n++;
-		}
+		if (_dwarf_elf_debug_name(name) != NULL)
+			n++;
 	}
 	elferr = elf_errno();
 	if (elferr != 0) {
@@ -266,31 +508,21 @@ _dwarf_elf_init(Dwarf_Debug dbg, Elf *elf, Dwarf_Error *error)
 			goto fail_cleanup;
 		}
 
-		for (i = 0; debug_name[i] != NULL; i++) {
-			if (strcmp(name, debug_name[i]))
-				continue;
-
-			(void) elf_errno();
-			if ((e->eo_data[j].ed_data = elf_getdata(scn, NULL)) ==
-			    NULL) {
-				elferr = elf_errno();
-				if (elferr != 0) {
-					_DWARF_SET_ERROR(dbg, error,
-					    DW_DLE_ELF, elferr);
-					ret = DW_DLE_ELF;
-					goto fail_cleanup;
-				}
-			}
-
-			if (_libdwarf.applyrela) {
-				if (_dwarf_elf_relocate(dbg, elf,
-				    &e->eo_data[j], elf_ndxscn(scn), symtab_ndx,
-				    symtab_data, error) != DW_DLE_NONE)
-					goto fail_cleanup;
-			}
+		if ((e->eo_data[j].ed_name = _dwarf_elf_debug_name(name)) ==
+		    NULL)
+			continue;
 
-			j++;
+		e->eo_data[j].ed_ndx = elf_ndxscn(scn);
+		ret = _dwarf_elf_compress_header(e, scn, &sh, name,
+		    &e->eo_data[j]);
+		if (ret != DW_DLE_NONE) {
+			if (ret == DW_DLE_ELF)
+				DWARF_SET_ELF_ERROR(dbg, error);
+			else
+				DWARF_SET_ERROR(dbg, error, ret);
+			goto fail_cleanup;
 		}
+		j++;
 	}
 
 	assert(j == n);
@@ -34,11 +34,7 @@ _dwarf_frame_find_cie(Dwarf_FrameSec fs, Dwarf_Unsigned offset,
 {
 	Dwarf_Cie cie;
 
-	STAILQ_FOREACH(cie, &fs->fs_cielist, cie_next) {
-		if (cie->cie_offset == offset)
-			break;
-	}
-
+	HASH_FIND(cie_hh, fs->fs_ciehash, &offset, sizeof(offset), cie);
 	if (cie == NULL)
 		return (DW_DLE_NO_ENTRY);
 
@@ -193,6 +189,8 @@ _dwarf_frame_add_cie(Dwarf_Debug dbg, Dwarf_FrameSec fs, Dwarf_Section *ds,
 	cie->cie_dbg = dbg;
 	cie->cie_index = fs->fs_cielen;
 	cie->cie_offset = *off;
+	HASH_ADD(cie_hh, fs->fs_ciehash, cie_offset, sizeof(cie->cie_offset),
+	    cie);
 
 	length = dbg->read(ds->ds_data, off, 4);
 	if (length == 0xffffffff) {
@@ -285,21 +283,14 @@ _dwarf_frame_add_cie(Dwarf_Debug dbg, Dwarf_FrameSec fs, Dwarf_Section *ds,
 }
 
 static int
-_dwarf_frame_add_fde(Dwarf_Debug dbg, Dwarf_FrameSec fs, Dwarf_Section *ds,
-    Dwarf_Unsigned *off, int eh_frame, Dwarf_Error *error)
+_dwarf_frame_parse_fde(Dwarf_Debug dbg, Dwarf_FrameSec fs, Dwarf_Section *ds,
+    Dwarf_Unsigned *off, int eh_frame, Dwarf_Fde fde, Dwarf_Error *error)
 {
 	Dwarf_Cie cie;
-	Dwarf_Fde fde;
 	Dwarf_Unsigned cieoff;
 	uint64_t length, val;
 	int dwarf_size, ret;
 
-	if ((fde = calloc(1, sizeof(struct _Dwarf_Fde))) == NULL) {
-		DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
-		return (DW_DLE_MEMORY);
-	}
-	STAILQ_INSERT_TAIL(&fs->fs_fdelist, fde, fde_next);
-
 	fde->fde_dbg = dbg;
 	fde->fde_fs = fs;
 	fde->fde_addr = ds->ds_data + *off;
@@ -391,17 +382,117 @@ _dwarf_frame_add_fde(Dwarf_Debug dbg, Dwarf_FrameSec fs, Dwarf_Section *ds,
 	    fde->fde_cieoff, fde->fde_instlen, *off);
 #endif
 
-	fs->fs_fdelen++;
+	return (DW_DLE_NONE);
+}
+
+static int
+_dwarf_frame_add_fde(Dwarf_Debug dbg, Dwarf_FrameSec fs,
+    struct _Dwarf_FdeIndex *fi, Dwarf_Error *error)
+{
+	Dwarf_Fde fde;
+	Dwarf_Unsigned offset;
+	int ret;
+
+	if (fi->fi_fde != NULL)
+		return (DW_DLE_NONE);
+
+	if ((fde = calloc(1, sizeof(struct _Dwarf_Fde))) == NULL) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
+		return (DW_DLE_MEMORY);
+	}
+	STAILQ_INSERT_TAIL(&fs->fs_fdelist, fde, fde_next);
+
+	offset = fi->fi_offset;
+	ret = _dwarf_frame_parse_fde(dbg, fs, fs->fs_ds, &offset,
+	    fs->fs_eh_frame, fde, error);
+	if (ret != DW_DLE_NONE)
+		return (ret);
+
+	fi->fi_fde = fde;
+
+	return (DW_DLE_NONE);
+}
+
+static int
+_dwarf_frame_index_fde(Dwarf_Debug dbg, Dwarf_FrameSec fs, Dwarf_Section *ds,
+    Dwarf_Unsigned *off, int eh_frame, Dwarf_Error *error)
+{
+	struct _Dwarf_Fde fde;
+	struct _Dwarf_FdeIndex *fi;
+	Dwarf_Unsigned cap;
+	int ret;
+
+	/*
+	 * Only the address range and the offset of an FDE are kept at this
+	 * point; the FDE descriptor itself is created when it is asked for.
+	 */
+	memset(&fde, 0, sizeof(fde));
+	ret = _dwarf_frame_parse_fde(dbg, fs, ds, off, eh_frame, &fde, error);
+	if (ret != DW_DLE_NONE)
+		return (ret);
+
+	if (fs->fs_fdeidxlen == fs->fs_fdeidxcap) {
+		cap = fs->fs_fdeidxcap > 0 ? fs->fs_fdeidxcap * 2 : 64;
+		fi = realloc(fs->fs_fdeidx, cap * sizeof(*fi));
+		if (fi == NULL) {
+			DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
+			return (DW_DLE_MEMORY);
+		}
+		fs->fs_fdeidx = fi;
+		fs->fs_fdeidxcap = cap;
+	}
+
+	fi = &fs->fs_fdeidx[fs->fs_fdeidxlen++];
+	fi->fi_initloc = fde.fde_initloc;
+	fi->fi_adrange = fde.fde_adrange;
+	fi->fi_offset = fde.fde_offset;
+	fi->fi_fde = NULL;
 
 	return (DW_DLE_NONE);
 }
 
+static int
+_dwarf_frame_index_cmp(const void *a, const void *b)
+{
+	const struct _Dwarf_FdeIndex *fa, *fb;
+
+	fa = a;
+	fb = b;
+
+	if (fa->fi_initloc != fb->fi_initloc)
+		return (fa->fi_initloc < fb->fi_initloc ? -1 : 1);
+
+	/*
+	 * FDEs starting at the same address are kept in reverse section
+	 * order, so that a backward search finds the first one.
+	 */
+	if (fa->fi_offset != fb->fi_offset)
+		return (fa->fi_offset > fb->fi_offset ? -1 : 1);
+
+	return (0);
+}
+
+static int
+_dwarf_frame_offset_cmp(const void *a, const void *b)
+{
+	Dwarf_Fde fa, fb;
+
+	fa = *(Dwarf_Fde const *) a;
+	fb = *(Dwarf_Fde const *) b;
+
+	if (fa->fde_offset != fb->fde_offset)
+		return (fa->fde_offset < fb->fde_offset ? -1 : 1);
+
+	return (0);
+}
+
 static void
 _dwarf_frame_section_cleanup(Dwarf_FrameSec fs)
 {
 	Dwarf_Cie cie, tcie;
 	Dwarf_Fde fde, tfde;
 
+	HASH_CLEAR(cie_hh, fs->fs_ciehash);
 	STAILQ_FOREACH_SAFE(cie, &fs->fs_cielist, cie_next, tcie) {
 		STAILQ_REMOVE(&fs->fs_cielist, cie, _Dwarf_Cie, cie_next);
 		free(cie);
@@ -416,6 +507,8 @@ _dwarf_frame_section_cleanup(Dwarf_FrameSec fs)
 		free(fs->fs_ciearray);
 	if (fs->fs_fdearray != NULL)
 		free(fs->fs_fdearray);
+	if (fs->fs_fdeidx != NULL)
+		free(fs->fs_fdeidx);
 
 	free(fs);
 }
@@ -426,7 +519,7 @@ _dwarf_frame_section_init(Dwarf_Debug dbg, Dwarf_FrameSec *frame_sec,
 {
 	Dwarf_FrameSec fs;
 	Dwarf_Cie cie;
-	Dwarf_Fde fde;
+	Dwarf_Unsigned maxend, end;
 	uint64_t length, offset, cie_id, entry_off;
 	int dwarf_size, i, ret;
 
@@ -437,6 +530,8 @@ _dwarf_frame_section_init(Dwarf_Debug dbg, Dwarf_FrameSec *frame_sec,
 		DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
 		return (DW_DLE_MEMORY);
 	}
+	fs->fs_ds = ds;
+	fs->fs_eh_frame = eh_frame;
 	STAILQ_INIT(&fs->fs_cielist);
 	STAILQ_INIT(&fs->fs_fdelist);
 
@@ -469,7 +564,7 @@ _dwarf_frame_section_init(Dwarf_Debug dbg, Dwarf_FrameSec *frame_sec,
 				ret = _dwarf_frame_add_cie(dbg, fs, ds,
 				    &entry_off, NULL, error);
 			else
-				ret = _dwarf_frame_add_fde(dbg, fs, ds,
+				ret = _dwarf_frame_index_fde(dbg, fs, ds,
 				    &entry_off, 1, error);
 		} else {
 			/* .dwarf_frame use CIE id ~0 */
@@ -478,7 +573,7 @@ _dwarf_frame_section_init(Dwarf_Debug dbg, Dwarf_FrameSec *frame_sec,
 				ret = _dwarf_frame_add_cie(dbg, fs, ds,
 				    &entry_off, NULL, error);
 			else
-				ret = _dwarf_frame_add_fde(dbg, fs, ds,
+				ret = _dwarf_frame_index_fde(dbg, fs, ds,
 				    &entry_off, 0, error);
 		}
 
@@ -503,19 +598,30 @@ _dwarf_frame_section_init(Dwarf_Debug dbg, Dwarf_FrameSec *frame_sec,
 		assert((Dwarf_Unsigned)i == fs->fs_cielen);
 	}
 
-	/* Create FDE array. */
-	if (fs->fs_fdelen > 0) {
-		if ((fs->fs_fdearray = malloc(sizeof(Dwarf_Fde) *
-		    fs->fs_fdelen)) == NULL) {
-			ret = DW_DLE_MEMORY;
-			DWARF_SET_ERROR(dbg, error, ret);
-			goto fail_cleanup;
+	/*
+	 * Sort the FDE index by address and record, for each entry, the
+	 * highest end address of it and all the entries before it. This
+	 * bounds the backward search done by _dwarf_frame_fde_lookup.
+	 */
+	if (fs->fs_fdeidxlen > 0) {
+		/* Linked objects normally have their FDEs sorted already. */
+		for (i = 1; (Dwarf_Unsigned)i < fs->fs_fdeidxlen; i++) {
+			if (fs->fs_fdeidx[i].fi_initloc <=
+			    fs->fs_fdeidx[i - 1].fi_initloc)
+				break;
 		}
-		i = 0;
-		STAILQ_FOREACH(fde, &fs->fs_fdelist, fde_next) {
-			fs->fs_fdearray[i++] = fde;
+		if ((Dwarf_Unsigned)i < fs->fs_fdeidxlen)
+			qsort(fs->fs_fdeidx, fs->fs_fdeidxlen,
+			    sizeof(struct _Dwarf_FdeIndex),
+			    _dwarf_frame_index_cmp);
+		maxend = 0;
+		for (i = 0; (Dwarf_Unsigned)i < fs->fs_fdeidxlen; i++) {
+			end = fs->fs_fdeidx[i].fi_initloc +
+			    fs->fs_fdeidx[i].fi_adrange;
+			if (end > maxend)
+				maxend = end;
+			fs->fs_fdeidx[i].fi_maxend = maxend;
 		}
-		assert((Dwarf_Unsigned)i == fs->fs_fdelen);
 	}
 
 	*frame_sec = fs;
@@ -529,6 +635,82 @@ fail_cleanup:
 	return (ret);
 }
 
+int
+_dwarf_frame_section_fdes(Dwarf_Debug dbg, Dwarf_FrameSec fs,
+    Dwarf_Error *error)
+{
+	Dwarf_Fde *fdearray;
+	Dwarf_Unsigned i;
+	int ret, sorted;
+
+	if (fs->fs_fdearray != NULL || fs->fs_fdeidxlen == 0)
+		return (DW_DLE_NONE);
+
+	/* Create FDE array, in section order. */
+	if ((fdearray = malloc(sizeof(Dwarf_Fde) * fs->fs_fdeidxlen)) ==
+	    NULL) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
+		return (DW_DLE_MEMORY);
+	}
+	sorted = 1;
+	for (i = 0; i < fs->fs_fdeidxlen; i++) {
+		ret = _dwarf_frame_add_fde(dbg, fs, &fs->fs_fdeidx[i], error);
+		if (ret != DW_DLE_NONE) {
+			free(fdearray);
+			return (ret);
+		}
+		fdearray[i] = fs->fs_fdeidx[i].fi_fde;
+		if (i > 0 && fdearray[i]->fde_offset <
+		    fdearray[i - 1]->fde_offset)
+			sorted = 0;
+	}
+	if (!sorted)
+		qsort(fdearray, fs->fs_fdeidxlen, sizeof(Dwarf_Fde),
+		    _dwarf_frame_offset_cmp);
+
+	fs->fs_fdearray = fdearray;
+	fs->fs_fdelen = fs->fs_fdeidxlen;
+
+	return (DW_DLE_NONE);
+}
+
+int
+_dwarf_frame_fde_lookup(Dwarf_Debug dbg, Dwarf_FrameSec fs, Dwarf_Addr pc,
+    Dwarf_Fde *ret_fde, Dwarf_Error *error)
+{
+	struct _Dwarf_FdeIndex *fi;
+	Dwarf_Unsigned lo, hi, mid;
+	int ret;
+
+	/* Find the first FDE starting above the address. */
+	lo = 0;
+	hi = fs->fs_fdeidxlen;
+	while (lo < hi) {
+		mid = lo + (hi - lo) / 2;
+		if (fs->fs_fdeidx[mid].fi_initloc <= pc)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	/* Search backward for the nearest FDE covering the address. */
+	while (lo > 0) {
+		fi = &fs->fs_fdeidx[--lo];
+		if (fi->fi_maxend <= pc)
+			break;
+		if (pc < fi->fi_initloc + fi->fi_adrange) {
+			ret = _dwarf_frame_add_fde(dbg, fs, fi, error);
+			if (ret != DW_DLE_NONE)
+				return (ret);
+			*ret_fde = fi->fi_fde;
+			return (DW_DLE_NONE);
+		}
+	}
+
+	DWARF_SET_ERROR(dbg, error, DW_DLE_NO_ENTRY);
+	return (DW_DLE_NO_ENTRY);
+}
+
 static int
 _dwarf_frame_run_inst(Dwarf_Debug dbg, Dwarf_Regtable3 *rt, uint8_t *insts,
     Dwarf_Unsigned len, Dwarf_Unsigned caf, Dwarf_Signed daf, Dwarf_Addr pc,
@@ -1185,6 +1367,10 @@ _dwarf_frame_get_internal_table(Dwarf_Fde fde, Dwarf_Addr pc_req,
 	dbg = fde->fde_dbg;
 	assert(dbg != NULL);
 
+	/* The register table is only allocated once it is needed. */
+	ret = _dwarf_frame_interal_table_init(dbg, error);
+	if (ret != DW_DLE_NONE)
+		return (ret);
 	rt = dbg->dbg_internal_reg_table;
 
 	/* Clear the content of regtable from previous run. */
@@ -1249,8 +1435,12 @@ int
 _dwarf_frame_section_load(Dwarf_Debug dbg, Dwarf_Error *error)
 {
 	Dwarf_Section *ds;
+	int ret;
 
-	if ((ds = _dwarf_find_section(dbg, ".debug_frame")) != NULL) {
+	if ((ret = _dwarf_find_section(dbg, ".debug_frame", &ds, error)) !=
+	    DW_DLE_NONE)
+		return (ret);
+	if (ds != NULL) {
 		return (_dwarf_frame_section_init(dbg, &dbg->dbg_frame,
 		    ds, 0, error));
 	}
@@ -1262,8 +1452,12 @@ int
 _dwarf_frame_section_load_eh(Dwarf_Debug dbg, Dwarf_Error *error)
 {
 	Dwarf_Section *ds;
+	int ret;
 
-	if ((ds = _dwarf_find_section(dbg, ".eh_frame")) != NULL) {
+	if ((ret = _dwarf_find_section(dbg, ".eh_frame", &ds, error)) !=
+	    DW_DLE_NONE)
+		return (ret);
+	if (ds != NULL) {
 		return (_dwarf_frame_section_init(dbg, &dbg->dbg_eh_frame,
 		    ds, 1, error));
 	}
@@ -163,6 +163,14 @@ _dwarf_info_load(Dwarf_Debug dbg, Dwarf_Bool load_all, Dwarf_Bool is_info,
 			return (DW_DLE_NO_ENTRY);
 	}
 
+	if ((ret = _dwarf_section_load(dbg, ds, error)) != DW_DLE_NONE)
+		return (ret);
+
+	/* The units of a .dwp package are located through its indexes. */
+	if (!dbg->dbg_unit_index_loaded &&
+	    (ret = _dwarf_unit_index_init(dbg, error)) != DW_DLE_NONE)
+		return (ret);
+
 	while (offset < ds->ds_size) {
 		if ((cu = calloc(1, sizeof(struct _Dwarf_CU))) == NULL) {
 			DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
@@ -203,28 +211,57 @@ _dwarf_info_load(Dwarf_Debug dbg, Dwarf_Bool load_all, Dwarf_Bool is_info,
 		cu->cu_length		 = length;
 		cu->cu_length_size	 = (dwarf_size == 4 ? 4 : 12);
 		cu->cu_version		 = dbg->read(ds->ds_data, &offset, 2);
-		cu->cu_abbrev_offset	 = dbg->read(ds->ds_data, &offset,
-		    dwarf_size);
+		if (cu->cu_version >= 5) {
+			/*
+			 * DWARF 5 unit headers carry a unit type and place
+			 * the address size before the abbrev offset.
+			 */
+			cu->cu_unit_type = dbg->read(ds->ds_data, &offset, 1);
+			cu->cu_pointer_size = dbg->read(ds->ds_data, &offset,
+			    1);
+			cu->cu_abbrev_offset = dbg->read(ds->ds_data, &offset,
+			    dwarf_size);
+		} else {
+			cu->cu_unit_type = is_info ? DW_UT_compile :
+			    DW_UT_type;
+			cu->cu_abbrev_offset = dbg->read(ds->ds_data, &offset,
+			    dwarf_size);
+			cu->cu_pointer_size = dbg->read(ds->ds_data, &offset,
+			    1);
+		}
 		cu->cu_abbrev_offset_cur = cu->cu_abbrev_offset;
-		cu->cu_pointer_size	 = dbg->read(ds->ds_data, &offset, 1);
 		cu->cu_next_offset	 = next_offset;
 
-		/* .debug_types extra fields. */
-		if (!is_info) {
+		/* Unit type specific header fields. */
+		switch (cu->cu_unit_type) {
+		case DW_UT_type:
+		case DW_UT_split_type:
 			memcpy(cu->cu_type_sig.signature,
 			    (char *) ds->ds_data + offset, 8);
 			offset += 8;
 			cu->cu_type_offset = dbg->read(ds->ds_data, &offset,
 			    dwarf_size);
+			break;
+		case DW_UT_skeleton:
+		case DW_UT_split_compile:
+			cu->cu_dwo_id = dbg->read(ds->ds_data, &offset, 8);
+			break;
+		default:
+			break;
 		}
 
+		/* Locate the unit's contributions in a .dwp package. */
+		if (dbg->dbg_cu_index != NULL || dbg->dbg_tu_index != NULL)
+			_dwarf_unit_index_apply(dbg, cu);
+
 		/* Add the compilation unit to the list. */
 		if (is_info)
 			STAILQ_INSERT_TAIL(&dbg->dbg_cu, cu, cu_next);
 		else
 			STAILQ_INSERT_TAIL(&dbg->dbg_tu, cu, cu_next);
 
-		if (cu->cu_version < 2 || cu->cu_version > 4) {
+		if (cu->cu_version < 2 || cu->cu_version > 5 ||
+		    offset > next_offset) {
 			DWARF_SET_ERROR(dbg, error, DW_DLE_VERSION_STAMP_ERROR);
 			ret = DW_DLE_VERSION_STAMP_ERROR;
 			break;
@@ -249,6 +286,51 @@ _dwarf_info_load(Dwarf_Debug dbg, Dwarf_Bool load_all, Dwarf_Bool is_info,
 	return (ret);
 }
 
+/*
+ * Prepare a consumer for use by several threads: load the debug
+ * sections and all units, and complete the per-unit state which DIE
+ * parsing would otherwise fill in on first use, so that later calls
+ * only read it.  A section that fails to load here is not loaded
+ * again; later uses report the error recorded for it.
+ */
+int
+_dwarf_info_preload(Dwarf_Debug dbg, Dwarf_Error *error)
+{
+	Dwarf_CU cu;
+	Dwarf_Error de;
+	Dwarf_Unsigned i;
+	int ret, is_info;
+
+	for (i = 0; i < dbg->dbg_seccnt; i++)
+		(void) _dwarf_section_load(dbg, &dbg->dbg_section[i], &de);
+
+	if ((ret = _dwarf_info_load(dbg, 1, 1, error)) != DW_DLE_NONE)
+		return (ret);
+	if (dbg->dbg_types_sec != NULL &&
+	    (ret = _dwarf_info_load(dbg, 1, 0, error)) != DW_DLE_NONE)
+		return (ret);
+
+	/*
+	 * DIEs may refer to other units, so the abbrev tables and the
+	 * table bases of every unit are completed here rather than by
+	 * the thread that first parses one of its DIEs.  A unit whose
+	 * bases cannot be read keeps the default ones.
+	 */
+	for (is_info = 1; is_info >= 0; is_info--) {
+		if (is_info)
+			cu = STAILQ_FIRST(&dbg->dbg_cu);
+		else
+			cu = STAILQ_FIRST(&dbg->dbg_tu);
+		for (; cu != NULL; cu = STAILQ_NEXT(cu, cu_next)) {
+			_dwarf_abbrev_load(cu);
+			(void) _dwarf_cu_bases_init(cu, NULL, &de);
+			cu->cu_bases_init = 1;
+		}
+	}
+
+	return (DW_DLE_NONE);
+}
+
 void
 _dwarf_info_cleanup(Dwarf_Debug dbg)
 {
@@ -256,6 +338,9 @@ _dwarf_info_cleanup(Dwarf_Debug dbg)
 
 	assert(dbg != NULL && dbg->dbg_mode == DW_DLC_READ);
 
+	_dwarf_split_sighash_cleanup(dbg, 0);
+	_dwarf_split_sighash_cleanup(dbg, 1);
+
 	STAILQ_FOREACH_SAFE(cu, &dbg->dbg_cu, cu_next, tcu) {
 		STAILQ_REMOVE(&dbg->dbg_cu, cu, _Dwarf_CU, cu_next);
 		_dwarf_abbrev_cleanup(cu);
@@ -272,10 +357,17 @@ _dwarf_info_cleanup(Dwarf_Debug dbg)
 void
 _dwarf_type_unit_cleanup(Dwarf_Debug dbg)
 {
+	struct _Dwarf_UnitIndex *ui;
 	Dwarf_CU cu, tcu;
 
 	assert(dbg != NULL && dbg->dbg_mode == DW_DLC_READ);
 
+	/* The signature hash and a GNU .dwp index refer to type units. */
+	_dwarf_split_sighash_cleanup(dbg, 1);
+	ui = dbg->dbg_tu_index;
+	if (ui != NULL && ui->ui_version == 2 && ui->ui_unit_cnt > 0)
+		memset(ui->ui_cu, 0, ui->ui_unit_cnt * sizeof(Dwarf_CU));
+
 	STAILQ_FOREACH_SAFE(cu, &dbg->dbg_tu, cu_next, tcu) {
 		STAILQ_REMOVE(&dbg->dbg_tu, cu, _Dwarf_CU, cu_next);
 		_dwarf_abbrev_cleanup(cu);
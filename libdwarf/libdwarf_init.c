@@ -33,7 +33,8 @@ _dwarf_consumer_init(Dwarf_Debug dbg, Dwarf_Error *error)
 {
 	const Dwarf_Obj_Access_Methods *m;
 	Dwarf_Obj_Access_Section sec;
-	void *obj;
+	Dwarf_Section *ds, *tds;
+	void *key, *obj;
 	Dwarf_Unsigned cnt;
 	Dwarf_Half i;
 	int ret;
@@ -51,10 +52,16 @@ _dwarf_consumer_init(Dwarf_Debug dbg, Dwarf_Error *error)
 		dbg->read = _dwarf_read_msb;
 		dbg->write = _dwarf_write_msb;
 		dbg->decode = _dwarf_decode_msb;
+#if ELFTC_BYTE_ORDER != ELFTC_BYTE_ORDER_BIG_ENDIAN
+		dbg->dbg_swap = 1;
+#endif
 	} else {
 		dbg->read = _dwarf_read_lsb;
 		dbg->write = _dwarf_write_lsb;
 		dbg->decode = _dwarf_decode_lsb;
+#if ELFTC_BYTE_ORDER != ELFTC_BYTE_ORDER_LITTLE_ENDIAN
+		dbg->dbg_swap = 1;
+#endif
 	}
 
 	dbg->dbg_pointer_size = m->get_pointer_size(obj);
@@ -85,16 +92,46 @@ _dwarf_consumer_init(Dwarf_Debug dbg, Dwarf_Error *error)
 		dbg->dbg_section[i].ds_size = sec.size;
 		dbg->dbg_section[i].ds_name = sec.name;
 
-		if (m->load_section(obj, i, &dbg->dbg_section[i].ds_data, &ret)
-		    != DW_DLV_OK) {
-			DWARF_SET_ERROR(dbg, error, ret);
-			return (ret);
+		/*
+		 * GNU-style compressed ".zdebug_*" sections are known by
+		 * their plain ".debug_*" name, and are decompressed when
+		 * loaded.
+		 */
+		if (sec.name != NULL && !strncmp(sec.name, ".zdebug", 7)) {
+			ds = &dbg->dbg_section[i];
+			if ((ds->ds_zname = malloc(strlen(sec.name))) == NULL) {
+				DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
+				return (DW_DLE_MEMORY);
+			}
+			ds->ds_zname[0] = '.';
+			strcpy(ds->ds_zname + 1, sec.name + 2);
+			ds->ds_name = ds->ds_zname;
 		}
 	}
 	dbg->dbg_section[cnt].ds_name = NULL;
 
-	if (_dwarf_find_section(dbg, ".debug_abbrev") == NULL ||
-	    ((dbg->dbg_info_sec = _dwarf_find_section(dbg, ".debug_info")) ==
+	/*
+	 * Index the sections by name.  When several sections share a
+	 * name, the first one is found, as with a linear scan.
+	 */
+	for (i = 0; i < cnt; i++) {
+		ds = &dbg->dbg_section[i];
+		if (ds->ds_name == NULL)
+			continue;
+		key = (void *) (uintptr_t) ds->ds_name;
+		HASH_FIND(ds_hh, dbg->dbg_sechash, key, strlen(ds->ds_name),
+		    tds);
+		if (tds == NULL)
+			HASH_ADD_KEYPTR(ds_hh, dbg->dbg_sechash, key,
+			    strlen(ds->ds_name), ds);
+	}
+
+	/*
+	 * Section data is not loaded here: _dwarf_find_section() and
+	 * _dwarf_info_load() load each section when it is first used.
+	 */
+	if (_dwarf_locate_section(dbg, ".debug_abbrev") == NULL ||
+	    ((dbg->dbg_info_sec = _dwarf_locate_section(dbg, ".debug_info")) ==
 	     NULL)) {
 		DWARF_SET_ERROR(dbg, error, DW_DLE_DEBUG_INFO_NULL);
 		return (DW_DLE_DEBUG_INFO_NULL);
@@ -217,6 +254,7 @@ _dwarf_init(Dwarf_Debug dbg, Dwarf_Unsigned pro_flags, Dwarf_Handler errhand,
 	STAILQ_INIT(&dbg->dbg_cu);
 	STAILQ_INIT(&dbg->dbg_tu);
 	STAILQ_INIT(&dbg->dbg_rllist);
+	STAILQ_INIT(&dbg->dbg_nilist);
 	STAILQ_INIT(&dbg->dbg_aslist);
 	STAILQ_INIT(&dbg->dbg_mslist);
 
@@ -271,11 +309,13 @@ _dwarf_producer_deinit(Dwarf_P_Debug dbg)
 static void
 _dwarf_consumer_deinit(Dwarf_Debug dbg)
 {
+	Dwarf_Unsigned i;
 
 	assert(dbg != NULL && dbg->dbg_mode == DW_DLC_READ);
 
 	_dwarf_info_cleanup(dbg);
 	_dwarf_ranges_cleanup(dbg);
+	_dwarf_loclist_cleanup(dbg);
 	_dwarf_frame_cleanup(dbg);
 	_dwarf_arange_cleanup(dbg);
 	_dwarf_macinfo_cleanup(dbg);
@@ -286,8 +326,20 @@ _dwarf_consumer_deinit(Dwarf_Debug dbg)
 	_dwarf_nametbl_cleanup(&dbg->dbg_funcs);
 	_dwarf_nametbl_cleanup(&dbg->dbg_vars);
 	_dwarf_nametbl_cleanup(&dbg->dbg_types);
-
+	_dwarf_debugnames_cleanup(dbg);
+	_dwarf_unit_index_cleanup(dbg);
+
+	HASH_CLEAR(ds_hh, dbg->dbg_sechash);
+	if (dbg->dbg_section != NULL) {
+		for (i = 0; i < dbg->dbg_seccnt; i++) {
+			free(dbg->dbg_section[i].ds_zname);
+			free(dbg->dbg_section[i].ds_zdata);
+		}
+	}
 	free(dbg->dbg_section);
+
+	if (dbg->dbg_thread_safe)
+		(void) pthread_mutex_destroy(&dbg->dbg_lock);
 }
 
 void
@@ -28,16 +28,28 @@
 
 ELFTC_VCSID("$Id$");
 
+/* Name used for a DWARF 5 file or directory entry without a path. */
+static char _empty_path[] = "";
+
 static int
-_dwarf_lineno_add_file(Dwarf_LineInfo li, uint8_t **p, const char *compdir,
+_dwarf_lineno_add_file_entry(Dwarf_LineInfo li, char *fname,
+    uint64_t dirndx, uint64_t mtime, uint64_t size, const char *compdir,
     Dwarf_Error *error, Dwarf_Debug dbg)
 {
 	Dwarf_LineFile lf;
 	const char *dirname;
-	uint8_t *src;
 	int slen;
 
-	src = *p;
+	/*
+	 * Before DWARF 5 directory 0 is the compilation directory and
+	 * is not part of the include directory list; from DWARF 5 on
+	 * it is entry 0 of the list.
+	 */
+	if (li->li_version >= 5 ? (dirndx >= li->li_inclen && dirndx > 0) :
+	    dirndx > li->li_inclen) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_DIR_INDEX_BAD);
+		return (DW_DLE_DIR_INDEX_BAD);
+	}
 
 	if ((lf = malloc(sizeof(struct _Dwarf_LineFile))) == NULL) {
 		DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
@@ -45,19 +57,16 @@ _dwarf_lineno_add_file(Dwarf_LineInfo li, uint8_t **p, const char *compdir,
 	}
 
 	lf->lf_fullpath = NULL;
-	lf->lf_fname = (char *) src;
-	src += strlen(lf->lf_fname) + 1;
-	lf->lf_dirndx = _dwarf_decode_uleb128(&src);
-	if (lf->lf_dirndx > li->li_inclen) {
-		free(lf);
-		DWARF_SET_ERROR(dbg, error, DW_DLE_DIR_INDEX_BAD);
-		return (DW_DLE_DIR_INDEX_BAD);
-	}
+	lf->lf_fname = fname;
+	lf->lf_dirndx = dirndx;
 
 	/* Make full pathname if need. */
 	if (*lf->lf_fname != '/') {
 		dirname = compdir;
-		if (lf->lf_dirndx > 0)
+		if (li->li_version >= 5) {
+			if (dirndx < li->li_inclen)
+				dirname = li->li_incdirs[dirndx];
+		} else if (lf->lf_dirndx > 0)
 			dirname = li->li_incdirs[lf->lf_dirndx - 1];
 		if (dirname != NULL) {
 			slen = strlen(dirname) + strlen(lf->lf_fname) + 2;
@@ -71,23 +80,216 @@ _dwarf_lineno_add_file(Dwarf_LineInfo li, uint8_t **p, const char *compdir,
 		}
 	}
 
-	lf->lf_mtime = _dwarf_decode_uleb128(&src);
-	lf->lf_size = _dwarf_decode_uleb128(&src);
+	lf->lf_mtime = mtime;
+	lf->lf_size = size;
 	STAILQ_INSERT_TAIL(&li->li_lflist, lf, lf_next);
 	li->li_lflen++;
 
+	return (DW_DLE_NONE);
+}
+
+static int
+_dwarf_lineno_add_file(Dwarf_LineInfo li, uint8_t **p, const char *compdir,
+    Dwarf_Error *error, Dwarf_Debug dbg)
+{
+	char *fname;
+	uint64_t dirndx, mtime, size;
+	uint8_t *src;
+	int ret;
+
+	src = *p;
+
+	fname = (char *) src;
+	src += strlen(fname) + 1;
+	dirndx = _dwarf_decode_uleb128(&src);
+	mtime = _dwarf_decode_uleb128(&src);
+	size = _dwarf_decode_uleb128(&src);
+
+	ret = _dwarf_lineno_add_file_entry(li, fname, dirndx, mtime, size,
+	    compdir, error, dbg);
+	if (ret != DW_DLE_NONE)
+		return (ret);
+
 	*p = src;
 
 	return (DW_DLE_NONE);
 }
 
+/*
+ * Read one field of a DWARF 5 directory or file name entry.  String
+ * forms are returned through 'strp', everything else through 'valp'.
+ */
+static int
+_dwarf_lineno_read_field(Dwarf_CU cu, Dwarf_Section *ds, uint64_t *offsetp,
+    uint64_t form, int dwarf_size, uint64_t *valp, char **strp,
+    Dwarf_Error *error)
+{
+	Dwarf_Debug dbg;
+	Dwarf_Section *str;
+	const char *name;
+	uint64_t len;
+	int ret;
+
+	dbg = cu->cu_dbg;
+	*valp = 0;
+	*strp = NULL;
+	name = NULL;
+
+	switch (form) {
+	case DW_FORM_string:
+		*strp = _dwarf_read_string(ds->ds_data, ds->ds_size, offsetp);
+		break;
+	case DW_FORM_line_strp:
+		name = ".debug_line_str";
+		/* FALLTHROUGH */
+	case DW_FORM_strp:
+		if (name == NULL)
+			name = ".debug_str";
+		*valp = dbg->read(ds->ds_data, offsetp, dwarf_size);
+		ret = _dwarf_find_section(dbg, name, &str, error);
+		if (ret != DW_DLE_NONE)
+			return (ret);
+		if (str == NULL || *valp >= str->ds_size) {
+			DWARF_SET_ERROR(dbg, error,
+			    DW_DLE_DEBUG_LINE_LENGTH_BAD);
+			return (DW_DLE_DEBUG_LINE_LENGTH_BAD);
+		}
+		*strp = (char *) str->ds_data + *valp;
+		break;
+	case DW_FORM_strx:
+	case DW_FORM_strx1:
+	case DW_FORM_strx2:
+	case DW_FORM_strx3:
+	case DW_FORM_strx4:
+		if (form == DW_FORM_strx)
+			*valp = _dwarf_read_uleb128(ds->ds_data, offsetp);
+		else
+			*valp = dbg->read(ds->ds_data, offsetp,
+			    form - DW_FORM_strx1 + 1);
+		if ((ret = _dwarf_strx_lookup(cu, *valp, NULL, strp,
+		    error)) != DW_DLE_NONE)
+			return (ret);
+		break;
+	case DW_FORM_udata:
+		*valp = _dwarf_read_uleb128(ds->ds_data, offsetp);
+		break;
+	case DW_FORM_data1:
+		*valp = dbg->read(ds->ds_data, offsetp, 1);
+		break;
+	case DW_FORM_data2:
+		*valp = dbg->read(ds->ds_data, offsetp, 2);
+		break;
+	case DW_FORM_data4:
+		*valp = dbg->read(ds->ds_data, offsetp, 4);
+		break;
+	case DW_FORM_data8:
+		*valp = dbg->read(ds->ds_data, offsetp, 8);
+		break;
+	case DW_FORM_data16:
+		*offsetp += 16;
+		break;
+	case DW_FORM_block:
+		len = _dwarf_read_uleb128(ds->ds_data, offsetp);
+		*offsetp += len;
+		break;
+	default:
+		DWARF_SET_ERROR(dbg, error, DW_DLE_ATTR_FORM_BAD);
+		return (DW_DLE_ATTR_FORM_BAD);
+	}
+
+	if (*offsetp > ds->ds_size) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_DEBUG_LINE_LENGTH_BAD);
+		return (DW_DLE_DEBUG_LINE_LENGTH_BAD);
+	}
+
+	return (DW_DLE_NONE);
+}
+
+/*
+ * Read a DWARF 5 entry format description followed by the entries it
+ * describes.  Directory entries fill the include directory array, file
+ * name entries are added to the file list.
+ */
+static int
+_dwarf_lineno_read_entries(Dwarf_CU cu, Dwarf_LineInfo li, Dwarf_Section *ds,
+    uint64_t *offsetp, int dwarf_size, int is_dir, const char *compdir,
+    Dwarf_Error *error)
+{
+	Dwarf_Debug dbg;
+	uint64_t fmt[2 * 256];
+	uint64_t cnt, i, val, dirndx, mtime, size;
+	char *path, *str;
+	int fmtcnt, j, ret;
+
+	dbg = cu->cu_dbg;
+
+	fmtcnt = dbg->read(ds->ds_data, offsetp, 1);
+	for (j = 0; j < fmtcnt; j++) {
+		fmt[2 * j] = _dwarf_read_uleb128(ds->ds_data, offsetp);
+		fmt[2 * j + 1] = _dwarf_read_uleb128(ds->ds_data, offsetp);
+	}
+
+	cnt = _dwarf_read_uleb128(ds->ds_data, offsetp);
+	if (*offsetp > ds->ds_size || cnt > ds->ds_size - *offsetp) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_DEBUG_LINE_LENGTH_BAD);
+		return (DW_DLE_DEBUG_LINE_LENGTH_BAD);
+	}
+
+	if (is_dir && cnt > 0) {
+		if ((li->li_incdirs = calloc(cnt, sizeof(char *))) == NULL) {
+			DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
+			return (DW_DLE_MEMORY);
+		}
+		li->li_inclen = cnt;
+	}
+
+	for (i = 0; i < cnt; i++) {
+		path = NULL;
+		dirndx = mtime = size = 0;
+		for (j = 0; j < fmtcnt; j++) {
+			ret = _dwarf_lineno_read_field(cu, ds, offsetp,
+			    fmt[2 * j + 1], dwarf_size, &val, &str, error);
+			if (ret != DW_DLE_NONE)
+				return (ret);
+			switch (fmt[2 * j]) {
+			case DW_LNCT_path:
+				path = str;
+				break;
+			case DW_LNCT_directory_index:
+				dirndx = val;
+				break;
+			case DW_LNCT_timestamp:
+				mtime = val;
+				break;
+			case DW_LNCT_size:
+				size = val;
+				break;
+			default:
+				break;
+			}
+		}
+		if (path == NULL)
+			path = _empty_path;
+		if (is_dir)
+			li->li_incdirs[i] = path;
+		else {
+			ret = _dwarf_lineno_add_file_entry(li, path, dirndx,
+			    mtime, size, compdir, error, dbg);
+			if (ret != DW_DLE_NONE)
+				return (ret);
+		}
+	}
+
+	return (DW_DLE_NONE);
+}
+
 static int
 _dwarf_lineno_run_program(Dwarf_CU cu, Dwarf_LineInfo li, uint8_t *p,
     uint8_t *pe, const char *compdir, Dwarf_Error *error)
 {
 	Dwarf_Debug dbg;
 	Dwarf_Line ln, tln;
-	uint64_t address, file, line, column, opsize;
+	uint64_t address, file, line, column, opsize, fbias;
 	int is_stmt, basic_block, end_sequence;
 	int ret;
 
@@ -113,7 +315,7 @@ _dwarf_lineno_run_program(Dwarf_CU cu, Dwarf_LineInfo li, uint8_t *p,
 		ln->ln_li     = li;				\
 		ln->ln_addr   = address;			\
 		ln->ln_symndx = 0;				\
-		ln->ln_fileno = file;				\
+		ln->ln_fileno = file + fbias;			\
 		ln->ln_lineno = line;				\
 		ln->ln_column = column;				\
 		ln->ln_bblock = basic_block;			\
@@ -128,6 +330,12 @@ _dwarf_lineno_run_program(Dwarf_CU cu, Dwarf_LineInfo li, uint8_t *p,
 
 	dbg = cu->cu_dbg;
 
+	/*
+	 * DWARF 5 numbers files from 0.  Shift the numbers by one so
+	 * that they index the (1-based) file list as in earlier versions.
+	 */
+	fbias = li->li_version >= 5 ? 1 : 0;
+
 	/*
 	 * Set registers to their default values.
 	 */
@@ -267,9 +475,15 @@ _dwarf_lineno_init(Dwarf_Die die, uint64_t offset, Dwarf_Error *error)
 	dbg = cu->cu_dbg;
 	assert(dbg != NULL);
 
-	if ((ds = _dwarf_find_section(dbg, ".debug_line")) == NULL)
+	if ((ret = _dwarf_find_section(dbg, ".debug_line", &ds, error)) !=
+	    DW_DLE_NONE)
+		return (ret);
+	if (ds == NULL)
 		return (DW_DLE_NONE);
 
+	/* Units of a .dwp package refer to their own line table. */
+	offset += cu->cu_dwp_off[DW_SECT_LINE];
+
 	/*
 	 * Try to find out the dir where the CU was compiled. Later we
 	 * will use the dir to create full pathnames, if need.
@@ -279,6 +493,13 @@ _dwarf_lineno_init(Dwarf_Die die, uint64_t offset, Dwarf_Error *error)
 	if (at != NULL) {
 		switch (at->at_form) {
 		case DW_FORM_strp:
+		case DW_FORM_line_strp:
+		case DW_FORM_strx:
+		case DW_FORM_strx1:
+		case DW_FORM_strx2:
+		case DW_FORM_strx3:
+		case DW_FORM_strx4:
+		case DW_FORM_GNU_str_index:
 			compdir = at->u[1].s;
 			break;
 		case DW_FORM_string:
@@ -312,9 +533,18 @@ _dwarf_lineno_init(Dwarf_Die die, uint64_t offset, Dwarf_Error *error)
 	li->li_length = length;
 	endoff = offset + length;
 	li->li_version = dbg->read(ds->ds_data, &offset, 2); /* FIXME: verify version */
+	if (li->li_version >= 5) {
+		/* Address size and segment selector size. */
+		(void) dbg->read(ds->ds_data, &offset, 1);
+		(void) dbg->read(ds->ds_data, &offset, 1);
+	}
 	li->li_hdrlen = dbg->read(ds->ds_data, &offset, dwarf_size);
 	hdroff = offset;
 	li->li_minlen = dbg->read(ds->ds_data, &offset, 1);
+	if (li->li_version >= 4) {
+		/* Maximum operations per instruction (VLIW only). */
+		(void) dbg->read(ds->ds_data, &offset, 1);
+	}
 	li->li_defstmt = dbg->read(ds->ds_data, &offset, 1);
 	li->li_lbase = dbg->read(ds->ds_data, &offset, 1);
 	li->li_lrange = dbg->read(ds->ds_data, &offset, 1);
@@ -341,6 +571,23 @@ _dwarf_lineno_init(Dwarf_Die die, uint64_t offset, Dwarf_Error *error)
 	for (i = 1; i < li->li_opbase; i++)
 		li->li_oplen[i] = dbg->read(ds->ds_data, &offset, 1);
 
+	/*
+	 * DWARF 5 describes the directory and file name tables with
+	 * self-describing entry formats.
+	 */
+	if (li->li_version >= 5) {
+		ret = _dwarf_lineno_read_entries(cu, li, ds, &offset,
+		    dwarf_size, 1, compdir, error);
+		if (ret != DW_DLE_NONE)
+			goto fail_cleanup;
+		ret = _dwarf_lineno_read_entries(cu, li, ds, &offset,
+		    dwarf_size, 0, compdir, error);
+		if (ret != DW_DLE_NONE)
+			goto fail_cleanup;
+		p = ds->ds_data + offset;
+		goto header_done;
+	}
+
 	/*
 	 * Check how many strings in the include dir string array.
 	 */
@@ -396,6 +643,7 @@ _dwarf_lineno_init(Dwarf_Die die, uint64_t offset, Dwarf_Error *error)
 
 	p++;
 
+header_done:
 	/* Sanity check. */
 	if (p - ds->ds_data - hdroff != li->li_hdrlen) {
 		ret = DW_DLE_DEBUG_LINE_LENGTH_BAD;
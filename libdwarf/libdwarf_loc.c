@@ -220,7 +220,12 @@ _dwarf_loc_fill_loc(Dwarf_Debug dbg, Dwarf_Locdesc *lbuf, uint8_t pointer_size,
 		case DW_OP_plus_uconst:
 		case DW_OP_regx:
 		case DW_OP_piece:
-		case DW_OP_GNU_deref_type:
+		case DW_OP_addrx:
+		case DW_OP_constx:
+		case DW_OP_convert:
+		case DW_OP_reinterpret:
+		case DW_OP_GNU_addr_index:
+		case DW_OP_GNU_const_index:
 		case DW_OP_GNU_convert:
 		case DW_OP_GNU_reinterpret:
 			operand1 = _dwarf_decode_uleb128(&p);
@@ -268,6 +273,7 @@ _dwarf_loc_fill_loc(Dwarf_Debug dbg, Dwarf_Locdesc *lbuf, uint8_t pointer_size,
 		 * Oeration with two unsigned LEB128 operands.
 		 */
 		case DW_OP_bit_piece:
+		case DW_OP_regval_type:
 		case DW_OP_GNU_regval_type:
 			operand1 = _dwarf_decode_uleb128(&p);
 			operand2 = _dwarf_decode_uleb128(&p);
@@ -291,6 +297,7 @@ _dwarf_loc_fill_loc(Dwarf_Debug dbg, Dwarf_Locdesc *lbuf, uint8_t pointer_size,
 		 * and a pointer to the block in the operand2.
 		 */
 		case DW_OP_implicit_value:
+		case DW_OP_entry_value:
 		case DW_OP_GNU_entry_value:
 			operand1 = _dwarf_decode_uleb128(&p);
 			operand2 = (Dwarf_Unsigned) (uintptr_t) p;
@@ -299,11 +306,20 @@ _dwarf_loc_fill_loc(Dwarf_Debug dbg, Dwarf_Locdesc *lbuf, uint8_t pointer_size,
 
 		/* Target address size operand. */
 		case DW_OP_addr:
-		case DW_OP_GNU_addr_index:
-		case DW_OP_GNU_const_index:
 			operand1 = dbg->decode(&p, pointer_size);
 			break;
 
+		/*
+		 * A 1-byte operand holding the size of the value,
+		 * followed by an unsigned LEB128 type DIE offset.
+		 */
+		case DW_OP_deref_type:
+		case DW_OP_xderef_type:
+		case DW_OP_GNU_deref_type:
+			operand1 = *p++;
+			operand2 = _dwarf_decode_uleb128(&p);
+			break;
+
 		/* Offset size operand. */
 		case DW_OP_call_ref:
 			operand1 = dbg->decode(&p, offset_size);
@@ -328,6 +344,7 @@ _dwarf_loc_fill_loc(Dwarf_Debug dbg, Dwarf_Locdesc *lbuf, uint8_t pointer_size,
 		 *
 		 * Operand2: SLEB128
 		 */
+		case DW_OP_implicit_pointer:
 		case DW_OP_GNU_implicit_pointer:
 			if (version == 2)
 				operand1 = dbg->decode(&p, pointer_size);
@@ -341,6 +358,7 @@ _dwarf_loc_fill_loc(Dwarf_Debug dbg, Dwarf_Locdesc *lbuf, uint8_t pointer_size,
 		 * Operand2: pointer to a block. The block's first byte
 		 * is its size.
 		 */
+		case DW_OP_const_type:
 		case DW_OP_GNU_const_type:
 			operand1 = _dwarf_decode_uleb128(&p);
 			operand2 = (Dwarf_Unsigned) (uintptr_t) p;
@@ -90,18 +90,151 @@ _dwarf_loclist_add_locdesc(Dwarf_Debug dbg, Dwarf_CU cu, Dwarf_Section *ds,
 	return (DW_DLE_NONE);
 }
 
-int
-_dwarf_loclist_find(Dwarf_Debug dbg, Dwarf_CU cu, uint64_t lloff,
-    Dwarf_Locdesc ***ret_llbuf, Dwarf_Signed *listlen,
-    Dwarf_Unsigned *entry_len, Dwarf_Error *error)
+/*
+ * Parse a DWARF 5 location list in .debug_loclists.  As for range lists,
+ * the entries are translated to the .debug_loc representation: a base
+ * address selection entry with base 0 comes first and all following
+ * entries carry absolute addresses.
+ */
+static int
+_dwarf_loclists_add_locdesc(Dwarf_Debug dbg, Dwarf_CU cu, Dwarf_Section *ds,
+    Dwarf_Unsigned *off, Dwarf_Locdesc **ld, Dwarf_Signed *ldlen,
+    Dwarf_Unsigned *total_len, Dwarf_Error *error)
 {
+	uint64_t base, start, end, len, lloff;
+	uint8_t kind;
+	int i, ret;
+
+	if ((ret = _dwarf_cu_bases_init(cu, NULL, error)) != DW_DLE_NONE)
+		return (ret);
+
+	base = cu->cu_lowpc;
+	lloff = *off;
+
+	if (ld != NULL) {
+		ld[0]->ld_lopc = cu->cu_pointer_size == 4 ? ~0U : ~0ULL;
+		ld[0]->ld_hipc = 0;
+	}
+	i = 1;
+
+	for (;;) {
+		if (*off >= ds->ds_size)
+			goto short_section;
+		kind = dbg->read(ds->ds_data, off, 1);
+		if (kind == DW_LLE_end_of_list)
+			break;
+
+		switch (kind) {
+		case DW_LLE_base_addressx:
+			ret = _dwarf_addrx_lookup(cu,
+			    _dwarf_read_uleb128(ds->ds_data, off), &base,
+			    error);
+			if (ret != DW_DLE_NONE)
+				return (ret);
+			continue;
+		case DW_LLE_base_address:
+			if (*off + cu->cu_pointer_size > ds->ds_size)
+				goto short_section;
+			base = dbg->read(ds->ds_data, off,
+			    cu->cu_pointer_size);
+			continue;
+		case DW_LLE_startx_endx:
+		case DW_LLE_startx_length:
+			ret = _dwarf_addrx_lookup(cu,
+			    _dwarf_read_uleb128(ds->ds_data, off), &start,
+			    error);
+			if (ret != DW_DLE_NONE)
+				return (ret);
+			if (kind == DW_LLE_startx_length)
+				end = start + _dwarf_read_uleb128(ds->ds_data,
+				    off);
+			else if ((ret = _dwarf_addrx_lookup(cu,
+			    _dwarf_read_uleb128(ds->ds_data, off), &end,
+			    error)) != DW_DLE_NONE)
+				return (ret);
+			break;
+		case DW_LLE_offset_pair:
+			start = base + _dwarf_read_uleb128(ds->ds_data, off);
+			end = base + _dwarf_read_uleb128(ds->ds_data, off);
+			break;
+		case DW_LLE_default_location:
+			start = 0;
+			end = cu->cu_pointer_size == 4 ? ~0U : ~0ULL;
+			break;
+		case DW_LLE_start_end:
+		case DW_LLE_start_length:
+			if (*off + cu->cu_pointer_size > ds->ds_size)
+				goto short_section;
+			start = dbg->read(ds->ds_data, off,
+			    cu->cu_pointer_size);
+			if (kind == DW_LLE_start_length)
+				end = start + _dwarf_read_uleb128(ds->ds_data,
+				    off);
+			else {
+				if (*off + cu->cu_pointer_size > ds->ds_size)
+					goto short_section;
+				end = dbg->read(ds->ds_data, off,
+				    cu->cu_pointer_size);
+			}
+			break;
+		default:
+			goto short_section;
+		}
+
+		len = _dwarf_read_uleb128(ds->ds_data, off);
+		if (*off > ds->ds_size || len > ds->ds_size - *off)
+			goto short_section;
+
+		if (ld != NULL) {
+			ld[i]->ld_lopc = start;
+			ld[i]->ld_hipc = end;
+			ret = _dwarf_loc_fill_locdesc(dbg, ld[i],
+			    ds->ds_data + *off, len, cu->cu_pointer_size,
+			    cu->cu_length_size == 4 ? 4 : 8, cu->cu_version,
+			    error);
+			if (ret != DW_DLE_NONE)
+				return (ret);
+		}
+		i++;
+
+		*off += len;
+	}
+
+	/* The end-of-list entry is all zero. */
+	i++;
+
+	if (ldlen != NULL)
+		*ldlen = i;
+	if (total_len != NULL)
+		*total_len = *off - lloff;
+
+	return (DW_DLE_NONE);
+
+short_section:
+	DWARF_SET_ERROR(dbg, error, DW_DLE_DEBUG_LOC_SECTION_SHORT);
+	return (DW_DLE_DEBUG_LOC_SECTION_SHORT);
+}
+
+/*
+ * Decode the location list at offset lloff once and remember the result,
+ * so that later queries for the same list only copy it.
+ */
+static int
+_dwarf_loclist_add(Dwarf_Debug dbg, Dwarf_CU cu, uint64_t lloff,
+    struct _Dwarf_Loclist **ret_ll, Dwarf_Error *error)
+{
+	struct _Dwarf_Loclist *ll;
 	Dwarf_Locdesc **llbuf;
 	Dwarf_Section *ds;
 	Dwarf_Signed ldlen;
 	Dwarf_Unsigned off;
 	int i, ret;
 
-	if ((ds = _dwarf_find_section(dbg, ".debug_loc")) == NULL) {
+	ret = _dwarf_find_section(dbg, cu->cu_version >= 5 ?
+	    ".debug_loclists" : ".debug_loc", &ds, error);
+	if (ret != DW_DLE_NONE)
+		return (ret);
+	if (ds == NULL) {
 		DWARF_SET_ERROR(dbg, error, DW_DLE_NO_ENTRY);
 		return (DW_DLE_NO_ENTRY);
 	}
@@ -113,53 +246,258 @@ _dwarf_loclist_find(Dwarf_Debug dbg, Dwarf_CU cu, uint64_t lloff,
 
 	/* Get the number of locdesc the first round. */
 	off = lloff;
-	ret = _dwarf_loclist_add_locdesc(dbg, cu, ds, &off, NULL, &ldlen,
-	    NULL, error);
+	if (cu->cu_version >= 5)
+		ret = _dwarf_loclists_add_locdesc(dbg, cu, ds, &off, NULL,
+		    &ldlen, NULL, error);
+	else
+		ret = _dwarf_loclist_add_locdesc(dbg, cu, ds, &off, NULL,
+		    &ldlen, NULL, error);
 	if (ret != DW_DLE_NONE)
 		return (ret);
 
-	if (ldlen == 0)
+	if ((ll = calloc(1, sizeof(struct _Dwarf_Loclist))) == NULL) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
+		return (DW_DLE_MEMORY);
+	}
+	ll->ll_key.lk_offset = lloff;
+	ll->ll_key.lk_cu = cu->cu_version >= 5 ? cu : NULL;
+	ll->ll_ldlen = ldlen;
+	ll->ll_cu = cu;
+
+	if (ldlen > 0) {
+		if ((llbuf = calloc(ldlen, sizeof(Dwarf_Locdesc *))) == NULL) {
+			free(ll);
+			DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
+			return (DW_DLE_MEMORY);
+		}
+		ll->ll_ldlist = llbuf;
+		for (i = 0; i < ldlen; i++) {
+			if ((llbuf[i] = calloc(1, sizeof(Dwarf_Locdesc))) ==
+			    NULL) {
+				DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
+				ret = DW_DLE_MEMORY;
+				goto fail_cleanup;
+			}
+		}
+
+		off = lloff;
+
+		/* Fill in locdesc. */
+		if (cu->cu_version >= 5)
+			ret = _dwarf_loclists_add_locdesc(dbg, cu, ds, &off,
+			    llbuf, NULL, &ll->ll_length, error);
+		else
+			ret = _dwarf_loclist_add_locdesc(dbg, cu, ds, &off,
+			    llbuf, NULL, &ll->ll_length, error);
+		if (ret != DW_DLE_NONE)
+			goto fail_cleanup;
+	}
+
+	HASH_ADD(ll_hh, dbg->dbg_llhash, ll_key, sizeof(ll->ll_key), ll);
+	*ret_ll = ll;
+
+	return (DW_DLE_NONE);
+
+fail_cleanup:
+
+	for (i = 0; i < ldlen && llbuf[i] != NULL; i++) {
+		if (llbuf[i]->ld_s)
+			free(llbuf[i]->ld_s);
+		free(llbuf[i]);
+	}
+	free(llbuf);
+	free(ll);
+
+	return (ret);
+}
+
+/*
+ * Look up the cached decode of the location list at offset lloff,
+ * decoding the list if this is its first use.
+ */
+static int
+_dwarf_loclist_get(Dwarf_Debug dbg, Dwarf_CU cu, uint64_t lloff,
+    struct _Dwarf_Loclist **ret_ll, Dwarf_Error *error)
+{
+	struct _Dwarf_ListKey key;
+	struct _Dwarf_Loclist *ll;
+	int ret;
+
+	memset(&key, 0, sizeof(key));
+	key.lk_offset = lloff;
+	key.lk_cu = cu->cu_version >= 5 ? cu : NULL;
+
+	DWARF_LOCK(dbg);
+	HASH_FIND(ll_hh, dbg->dbg_llhash, &key, sizeof(key), ll);
+	ret = DW_DLE_NONE;
+	if (ll == NULL)
+		ret = _dwarf_loclist_add(dbg, cu, lloff, &ll, error);
+	DWARF_UNLOCK(dbg);
+	if (ret != DW_DLE_NONE)
+		return (ret);
+
+	*ret_ll = ll;
+
+	return (DW_DLE_NONE);
+}
+
+int
+_dwarf_loclist_find(Dwarf_Debug dbg, Dwarf_CU cu, uint64_t lloff,
+    Dwarf_Locdesc ***ret_llbuf, Dwarf_Signed *listlen,
+    Dwarf_Unsigned *entry_len, Dwarf_Error *error)
+{
+	struct _Dwarf_Loclist *ll;
+	Dwarf_Locdesc **llbuf, *ld;
+	int i, ret;
+
+	if ((ret = _dwarf_loclist_get(dbg, cu, lloff, &ll, error)) !=
+	    DW_DLE_NONE)
+		return (ret);
+
+	if (ll->ll_ldlen == 0)
 		return (DW_DLE_NO_ENTRY);
 
 	/*
+	 * The caller owns the returned list, so hand out a copy of the
+	 * cached one.
+	 *
 	 * Dwarf_Locdesc list memory is allocated in this way (one more level
 	 * of indirect) to make the loclist API be compatible with SGI libdwarf.
 	 */
-	if ((llbuf = calloc(ldlen, sizeof(Dwarf_Locdesc *))) == NULL) {
+	if ((llbuf = calloc(ll->ll_ldlen, sizeof(Dwarf_Locdesc *))) == NULL) {
 		DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
 		return (DW_DLE_MEMORY);
 	}
-	for (i = 0; i < ldlen; i++) {
-		if ((llbuf[i] = calloc(1, sizeof(Dwarf_Locdesc))) == NULL) {
-			DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
-			ret = DW_DLE_MEMORY;
+	for (i = 0; i < ll->ll_ldlen; i++) {
+		if ((ld = malloc(sizeof(Dwarf_Locdesc))) == NULL)
 			goto fail_cleanup;
+		*ld = *ll->ll_ldlist[i];
+		ld->ld_s = NULL;
+		llbuf[i] = ld;
+		if (ld->ld_cents > 0) {
+			ld->ld_s = malloc(ld->ld_cents * sizeof(Dwarf_Loc));
+			if (ld->ld_s == NULL)
+				goto fail_cleanup;
+			memcpy(ld->ld_s, ll->ll_ldlist[i]->ld_s,
+			    ld->ld_cents * sizeof(Dwarf_Loc));
 		}
 	}
 
-	off = lloff;
-
-	/* Fill in locdesc. */
-	ret = _dwarf_loclist_add_locdesc(dbg, cu, ds, &off, llbuf, NULL,
-	    entry_len, error);
-	if (ret != DW_DLE_NONE)
-		goto fail_cleanup;
-
 	*ret_llbuf = llbuf;
-	*listlen = ldlen;
+	*listlen = ll->ll_ldlen;
+	if (entry_len != NULL)
+		*entry_len = ll->ll_length;
 
 	return (DW_DLE_NONE);
 
 fail_cleanup:
 
-	if (llbuf != NULL) {
-		for (i = 0; i < ldlen; i++) {
-			if (llbuf[i]->ld_s)
-				free(llbuf[i]->ld_s);
-			free(llbuf[i]);
+	for (i = 0; i < ll->ll_ldlen && llbuf[i] != NULL; i++) {
+		free(llbuf[i]->ld_s);
+		free(llbuf[i]);
+	}
+	free(llbuf);
+	DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
+
+	return (DW_DLE_MEMORY);
+}
+
+/*
+ * Find the entry of the location list at offset lloff that covers
+ * address pc.  The entry is returned from the cached decode, so the
+ * lookup does not allocate once the list has been decoded.
+ */
+int
+_dwarf_loclist_find_pc(Dwarf_Debug dbg, Dwarf_CU cu, uint64_t lloff,
+    Dwarf_Addr pc, Dwarf_Locdesc **ret_ld, Dwarf_Error *error)
+{
+	struct _Dwarf_Loclist *ll;
+	Dwarf_Locdesc *ld, *dflt;
+	Dwarf_Addr base, max;
+	int i, ret;
+
+	if ((ret = _dwarf_loclist_get(dbg, cu, lloff, &ll, error)) !=
+	    DW_DLE_NONE)
+		return (ret);
+
+	/* Entries of a .debug_loc list are relative to the CU base. */
+	if ((ret = _dwarf_cu_bases_init(cu, NULL, error)) != DW_DLE_NONE)
+		return (ret);
+	base = cu->cu_version >= 5 ? 0 : cu->cu_lowpc;
+	max = cu->cu_pointer_size == 4 ? ~0U : ~0ULL;
+
+	dflt = NULL;
+	for (i = 0; i < ll->ll_ldlen; i++) {
+		ld = ll->ll_ldlist[i];
+
+		/* Base address selection entry. */
+		if (ld->ld_lopc == max) {
+			base = ld->ld_hipc;
+			continue;
+		}
+
+		/*
+		 * A DWARF 5 default location entry applies only when no
+		 * other entry covers the address.
+		 */
+		if (cu->cu_version >= 5 && ld->ld_lopc == 0 &&
+		    ld->ld_hipc == max) {
+			if (dflt == NULL)
+				dflt = ld;
+			continue;
+		}
+
+		/* The end-of-list entry covers no address. */
+		if (pc >= base + ld->ld_lopc && pc < base + ld->ld_hipc) {
+			*ret_ld = ld;
+			return (DW_DLE_NONE);
 		}
-		free(llbuf);
 	}
 
-	return (ret);
+	if (dflt == NULL) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_NO_ENTRY);
+		return (DW_DLE_NO_ENTRY);
+	}
+
+	*ret_ld = dflt;
+
+	return (DW_DLE_NONE);
+}
+
+static void
+_dwarf_loclist_free(Dwarf_Debug dbg, struct _Dwarf_Loclist *ll)
+{
+	int i;
+
+	HASH_DELETE(ll_hh, dbg->dbg_llhash, ll);
+	for (i = 0; i < ll->ll_ldlen; i++) {
+		free(ll->ll_ldlist[i]->ld_s);
+		free(ll->ll_ldlist[i]);
+	}
+	free(ll->ll_ldlist);
+	free(ll);
+}
+
+/*
+ * Drop the cached location lists decoded by units that have not been
+ * used since trim epoch `keep'.  They are decoded again when needed.
+ */
+void
+_dwarf_loclist_trim(Dwarf_Debug dbg, uint64_t keep)
+{
+	struct _Dwarf_Loclist *ll, *tll;
+
+	HASH_ITER(ll_hh, dbg->dbg_llhash, ll, tll) {
+		if (ll->ll_cu->cu_lastuse < keep)
+			_dwarf_loclist_free(dbg, ll);
+	}
+}
+
+void
+_dwarf_loclist_cleanup(Dwarf_Debug dbg)
+{
+	struct _Dwarf_Loclist *ll, *tll;
+
+	HASH_ITER(ll_hh, dbg->dbg_llhash, ll, tll)
+		_dwarf_loclist_free(dbg, ll);
 }
@@ -130,7 +130,10 @@ _dwarf_macinfo_init(Dwarf_Debug dbg, Dwarf_Error *error)
 	uint64_t offset, entry_off;
 	int ret;
 
-	if ((ds = _dwarf_find_section(dbg, ".debug_macinfo")) == NULL)
+	if ((ret = _dwarf_find_section(dbg, ".debug_macinfo", &ds, error)) !=
+	    DW_DLE_NONE)
+		return (ret);
+	if (ds == NULL)
 		return (DW_DLE_NONE);
 
 	offset = 0;
@@ -0,0 +1,258 @@
+/*-
+ * Copyright (c) 2026 The Elftoolchain Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "_libdwarf.h"
+
+ELFTC_VCSID("$Id$");
+
+/* Size of the bookkeeping of a uthash table, excluding its items. */
+#define	_HASH_SIZE(hh, head)						\
+	((head) != NULL ? sizeof(UT_hash_table) +			\
+	    (head)->hh.tbl->num_buckets * sizeof(UT_hash_bucket) : 0)
+
+static Dwarf_Unsigned
+_dwarf_memory_abbrev(Dwarf_CU cu)
+{
+	Dwarf_Abbrev ab;
+	Dwarf_Unsigned size;
+
+	size = _HASH_SIZE(ab_hh, cu->cu_abbrev_hash);
+	for (ab = cu->cu_abbrev_hash; ab != NULL; ab = ab->ab_hh.next)
+		size += sizeof(*ab) + ab->ab_atnum *
+		    sizeof(struct _Dwarf_AttrDef);
+
+	return (size);
+}
+
+static Dwarf_Unsigned
+_dwarf_memory_lineno(Dwarf_LineInfo li)
+{
+	Dwarf_LineFile lf;
+	Dwarf_Unsigned size;
+
+	if (li == NULL)
+		return (0);
+
+	size = sizeof(*li) + li->li_opbase + li->li_inclen * sizeof(char *) +
+	    li->li_lnlen * sizeof(struct _Dwarf_Line);
+	STAILQ_FOREACH(lf, &li->li_lflist, lf_next) {
+		size += sizeof(*lf);
+		if (lf->lf_fullpath != NULL)
+			size += strlen(lf->lf_fullpath) + 1;
+	}
+	if (li->li_lnarray != NULL)
+		size += li->li_lnlen * sizeof(Dwarf_Line);
+	if (li->li_lfnarray != NULL)
+		size += li->li_lflen * sizeof(char *);
+
+	return (size);
+}
+
+static void
+_dwarf_memory_units(Dwarf_Debug dbg, Dwarf_Memory_Usage *mu, int is_info)
+{
+	Dwarf_CU cu;
+
+	cu = is_info ? STAILQ_FIRST(&dbg->dbg_cu) : STAILQ_FIRST(&dbg->dbg_tu);
+	for (; cu != NULL; cu = STAILQ_NEXT(cu, cu_next)) {
+		mu->dmu_units += sizeof(*cu);
+		mu->dmu_abbrevs += _dwarf_memory_abbrev(cu);
+		mu->dmu_lines += _dwarf_memory_lineno(cu->cu_lineinfo);
+	}
+}
+
+static Dwarf_Unsigned
+_dwarf_memory_frame(Dwarf_FrameSec fs)
+{
+	Dwarf_Cie cie;
+	Dwarf_Fde fde;
+	Dwarf_Unsigned size;
+
+	if (fs == NULL)
+		return (0);
+
+	size = sizeof(*fs) + _HASH_SIZE(cie_hh, fs->fs_ciehash) +
+	    fs->fs_fdeidxcap * sizeof(struct _Dwarf_FdeIndex);
+	STAILQ_FOREACH(cie, &fs->fs_cielist, cie_next)
+		size += sizeof(*cie);
+	STAILQ_FOREACH(fde, &fs->fs_fdelist, fde_next)
+		size += sizeof(*fde);
+	if (fs->fs_ciearray != NULL)
+		size += fs->fs_cielen * sizeof(Dwarf_Cie);
+	if (fs->fs_fdearray != NULL)
+		size += fs->fs_fdelen * sizeof(Dwarf_Fde);
+
+	return (size);
+}
+
+static Dwarf_Unsigned
+_dwarf_memory_nametbl(Dwarf_NameSec ns)
+{
+	Dwarf_NameTbl nt;
+	Dwarf_Unsigned size;
+
+	if (ns == NULL)
+		return (0);
+
+	size = sizeof(*ns) + ns->ns_len * sizeof(struct _Dwarf_NamePair) +
+	    ns->ns_hashsize * sizeof(struct _Dwarf_NameSlot);
+	STAILQ_FOREACH(nt, &ns->ns_ntlist, nt_next)
+		size += sizeof(*nt);
+	if (ns->ns_array != NULL)
+		size += ns->ns_len * sizeof(Dwarf_NamePair);
+	if (ns->ns_byname != NULL)
+		size += ns->ns_len * sizeof(Dwarf_NamePair);
+
+	return (size);
+}
+
+/*
+ * Add up the memory held by the lazily built tables of a consumer.
+ * The figures count the payload of each allocation and do not include
+ * the overhead of the memory allocator.
+ */
+void
+_dwarf_memory_usage(Dwarf_Debug dbg, Dwarf_Memory_Usage *mu)
+{
+	struct _Dwarf_Loclist *ll;
+	Dwarf_ArangeSet as;
+	Dwarf_Arange ar;
+	Dwarf_MacroSet ms;
+	Dwarf_NameIdx ni;
+	Dwarf_Rangelist rl;
+	Dwarf_Section *ds;
+	Dwarf_Signed i;
+	Dwarf_Unsigned j;
+
+	memset(mu, 0, sizeof(*mu));
+
+	_dwarf_memory_units(dbg, mu, 1);
+	_dwarf_memory_units(dbg, mu, 0);
+
+	mu->dmu_ranges = _HASH_SIZE(rl_hh, dbg->dbg_rlhash);
+	STAILQ_FOREACH(rl, &dbg->dbg_rllist, rl_next)
+		mu->dmu_ranges += sizeof(*rl) +
+		    rl->rl_rglen * sizeof(Dwarf_Ranges);
+
+	mu->dmu_loclists = _HASH_SIZE(ll_hh, dbg->dbg_llhash);
+	for (ll = dbg->dbg_llhash; ll != NULL; ll = ll->ll_hh.next) {
+		mu->dmu_loclists += sizeof(*ll);
+		for (i = 0; i < ll->ll_ldlen; i++)
+			mu->dmu_loclists += sizeof(Dwarf_Locdesc *) +
+			    sizeof(Dwarf_Locdesc) +
+			    ll->ll_ldlist[i]->ld_cents * sizeof(Dwarf_Loc);
+	}
+
+	STAILQ_FOREACH(as, &dbg->dbg_aslist, as_next) {
+		mu->dmu_aranges += sizeof(*as);
+		STAILQ_FOREACH(ar, &as->as_arlist, ar_next)
+			mu->dmu_aranges += sizeof(*ar);
+	}
+	if (dbg->dbg_arange_array != NULL)
+		mu->dmu_aranges += dbg->dbg_arange_cnt * sizeof(Dwarf_Arange);
+	if (dbg->dbg_arange_sorted != NULL)
+		mu->dmu_aranges += dbg->dbg_arange_cnt * sizeof(Dwarf_Arange);
+
+	mu->dmu_frames = _dwarf_memory_frame(dbg->dbg_frame) +
+	    _dwarf_memory_frame(dbg->dbg_eh_frame);
+	if (dbg->dbg_internal_reg_table != NULL)
+		mu->dmu_frames += sizeof(Dwarf_Regtable3) +
+		    dbg->dbg_internal_reg_table->rt3_reg_table_size *
+		    sizeof(Dwarf_Regtable_Entry3);
+
+	mu->dmu_names = _dwarf_memory_nametbl(dbg->dbg_globals) +
+	    _dwarf_memory_nametbl(dbg->dbg_pubtypes) +
+	    _dwarf_memory_nametbl(dbg->dbg_weaks) +
+	    _dwarf_memory_nametbl(dbg->dbg_funcs) +
+	    _dwarf_memory_nametbl(dbg->dbg_vars) +
+	    _dwarf_memory_nametbl(dbg->dbg_types);
+	STAILQ_FOREACH(ni, &dbg->dbg_nilist, ni_next)
+		mu->dmu_names += sizeof(*ni) + ni->ni_abbrev_cnt *
+		    sizeof(struct _Dwarf_NameIdxAbbrev);
+
+	STAILQ_FOREACH(ms, &dbg->dbg_mslist, ms_next)
+		mu->dmu_macros += sizeof(*ms) +
+		    ms->ms_cnt * sizeof(Dwarf_Macro_Details);
+
+	mu->dmu_sections = _dwarf_elf_memory_usage(dbg);
+	for (j = 0; j < dbg->dbg_seccnt; j++) {
+		ds = &dbg->dbg_section[j];
+		if (ds->ds_zdata != NULL)
+			mu->dmu_sections += ds->ds_size;
+	}
+
+	mu->dmu_total = mu->dmu_units + mu->dmu_abbrevs + mu->dmu_lines +
+	    mu->dmu_ranges + mu->dmu_loclists + mu->dmu_aranges +
+	    mu->dmu_frames + mu->dmu_names + mu->dmu_macros +
+	    mu->dmu_sections;
+}
+
+static void
+_dwarf_memory_trim_units(Dwarf_Debug dbg, uint64_t keep, int is_info)
+{
+	Dwarf_CU cu;
+
+	cu = is_info ? STAILQ_FIRST(&dbg->dbg_cu) : STAILQ_FIRST(&dbg->dbg_tu);
+	for (; cu != NULL; cu = STAILQ_NEXT(cu, cu_next)) {
+		if (cu->cu_lastuse >= keep)
+			continue;
+		if (cu->cu_lineinfo != NULL) {
+			_dwarf_lineno_cleanup(cu->cu_lineinfo);
+			cu->cu_lineinfo = NULL;
+		}
+
+		/*
+		 * A consumer shared by several threads looks up abbrevs
+		 * without the lock, relying on the tables being complete.
+		 */
+		if (dbg->dbg_thread_safe)
+			continue;
+		_dwarf_abbrev_cleanup(cu);
+		cu->cu_abbrev_loaded = 0;
+		cu->cu_abbrev_offset_cur = cu->cu_abbrev_offset;
+	}
+}
+
+/*
+ * Release the per-unit tables of the units which have not been used
+ * during the last `idle' trim epochs, then start a new epoch.  The
+ * unit descriptors themselves are kept, and the tables are built again
+ * on their next use.
+ */
+void
+_dwarf_memory_trim(Dwarf_Debug dbg, Dwarf_Unsigned idle)
+{
+	uint64_t keep;
+
+	keep = idle > dbg->dbg_epoch ? 0 : dbg->dbg_epoch - idle + 1;
+
+	_dwarf_memory_trim_units(dbg, keep, 1);
+	_dwarf_memory_trim_units(dbg, keep, 0);
+	_dwarf_ranges_trim(dbg, keep);
+	_dwarf_loclist_trim(dbg, keep);
+
+	dbg->dbg_epoch++;
+}
@@ -33,27 +33,59 @@ _dwarf_nametbl_cleanup(Dwarf_NameSec *nsp)
 {
 	Dwarf_NameSec ns;
 	Dwarf_NameTbl nt, tnt;
-	Dwarf_NamePair np, tnp;
 
 	assert(nsp != NULL);
 	if ((ns = *nsp) == NULL)
 		return;
 
 	STAILQ_FOREACH_SAFE(nt, &ns->ns_ntlist, nt_next, tnt) {
-		STAILQ_FOREACH_SAFE(np, &nt->nt_nplist, np_next, tnp) {
-			STAILQ_REMOVE(&nt->nt_nplist, np, _Dwarf_NamePair,
-			    np_next);
-			free(np);
-		}
 		STAILQ_REMOVE(&ns->ns_ntlist, nt, _Dwarf_NameTbl, nt_next);
 		free(nt);
 	}
-	if (ns->ns_array)
-		free(ns->ns_array);
+	free(ns->ns_pairs);
+	free(ns->ns_array);
+	free(ns->ns_hash);
+	free(ns->ns_byname);
 	free(ns);
 	*nsp = NULL;
 }
 
+/*
+ * Count the name pairs of all tables in a name lookup section, so that
+ * they can be allocated at once.
+ */
+static Dwarf_Unsigned
+_dwarf_nametbl_count(Dwarf_Debug dbg, Dwarf_Section *ds)
+{
+	uint64_t offset, dwarf_size, cuoff;
+	Dwarf_Unsigned cnt;
+	char *p;
+
+	p = (char *) ds->ds_data;
+	cnt = 0;
+	offset = 0;
+	while (offset < ds->ds_size) {
+		/* Skip the table header. */
+		if (dbg->read(ds->ds_data, &offset, 4) == 0xffffffff) {
+			dwarf_size = 8;
+			offset += 8;
+		} else
+			dwarf_size = 4;
+		offset += 2 + 2 * dwarf_size;
+
+		while (offset < ds->ds_size) {
+			cuoff = dbg->read(ds->ds_data, &offset, dwarf_size);
+			if (cuoff == 0)
+				break;
+			while (p[offset++] != '\0')
+				;
+			cnt++;
+		}
+	}
+
+	return (cnt);
+}
+
 int
 _dwarf_nametbl_init(Dwarf_Debug dbg, Dwarf_NameSec *namesec, Dwarf_Section *ds,
     Dwarf_Error *error)
@@ -62,19 +94,27 @@ _dwarf_nametbl_init(Dwarf_Debug dbg, Dwarf_NameSec *namesec, Dwarf_Section *ds,
 	Dwarf_NameSec ns;
 	Dwarf_NameTbl nt;
 	Dwarf_NamePair np;
+	Dwarf_Unsigned cnt;
 	uint64_t offset, dwarf_size, length, cuoff;
 	char *p;
 	int i, ret;
 
 	assert(*namesec == NULL);
 
-	if ((ns = malloc(sizeof(struct _Dwarf_NameSec))) == NULL) {
+	if ((ns = calloc(1, sizeof(struct _Dwarf_NameSec))) == NULL) {
 		DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
 		return (DW_DLE_MEMORY);
 	}
 	STAILQ_INIT(&ns->ns_ntlist);
-	ns->ns_array = NULL;
-	ns->ns_len = 0;
+
+	/* The name pairs of all tables share one allocation. */
+	if ((cnt = _dwarf_nametbl_count(dbg, ds)) > 0 &&
+	    (ns->ns_pairs = calloc(cnt, sizeof(struct _Dwarf_NamePair))) ==
+	    NULL) {
+		ret = DW_DLE_MEMORY;
+		DWARF_SET_ERROR(dbg, error, ret);
+		goto fail_cleanup;
+	}
 
 	offset = 0;
 	while (offset < ds->ds_size) {
@@ -115,17 +155,15 @@ _dwarf_nametbl_init(Dwarf_Debug dbg, Dwarf_NameSec *namesec, Dwarf_Section *ds,
 		}
 		nt->nt_cu = cu;	/* FIXME: Check if NULL here */
 
-		/* Add name pairs. */
+		/*
+		 * Add name pairs.  The names point into the section data.
+		 */
 		while (offset < ds->ds_size) {
 			cuoff = dbg->read(ds->ds_data, &offset, dwarf_size);
 			if (cuoff == 0)
 				break;
-			if ((np = malloc(sizeof(struct _Dwarf_NamePair))) ==
-			    NULL) {
-				ret = DW_DLE_MEMORY;
-				DWARF_SET_ERROR(dbg, error, ret);
-				goto fail_cleanup;
-			}
+			assert(ns->ns_len < cnt);
+			np = &ns->ns_pairs[ns->ns_len];
 			np->np_nt = nt;
 			np->np_offset = cuoff;
 			p = (char *) ds->ds_data;
@@ -165,6 +203,128 @@ fail_cleanup:
 	return (ret);
 }
 
+static uint32_t
+_dwarf_nametbl_hash(const char *name)
+{
+	uint32_t h;
+
+	for (h = 5381; *name != '\0'; name++)
+		h = h * 33 + (unsigned char) *name;
+
+	return (h);
+}
+
+/*
+ * Find the slot of a name in the open addressing hash of a name lookup
+ * section, or the free slot where the name would be inserted.
+ */
+static struct _Dwarf_NameSlot *
+_dwarf_nametbl_slot(Dwarf_NameSec ns, const char *name, uint32_t hash)
+{
+	struct _Dwarf_NameSlot *nh;
+	Dwarf_Unsigned i;
+
+	for (i = hash & (ns->ns_hashsize - 1);;
+	     i = (i + 1) & (ns->ns_hashsize - 1)) {
+		nh = &ns->ns_hash[i];
+		if (nh->nh_name == NULL)
+			return (nh);
+		if (nh->nh_hash == hash && !strcmp(nh->nh_name, name))
+			return (nh);
+	}
+}
+
+/*
+ * Build the name hash of a name lookup section.  Pairs sharing a name
+ * are grouped in ns_byname, in the order they appear in ns_array, and
+ * the hash slot of the name records where the group starts.
+ */
+int
+_dwarf_nametbl_hash_init(Dwarf_Debug dbg, Dwarf_NameSec ns,
+    Dwarf_Error *error)
+{
+	struct _Dwarf_NameSlot *nh;
+	Dwarf_NamePair np;
+	Dwarf_Unsigned i, first;
+	uint32_t hash;
+
+	assert(ns->ns_hash == NULL);
+
+	/* Keep the load factor at or below one half. */
+	for (ns->ns_hashsize = 8; ns->ns_hashsize < 2 * ns->ns_len;
+	     ns->ns_hashsize <<= 1)
+		;
+
+	if ((ns->ns_hash = calloc(ns->ns_hashsize,
+	    sizeof(struct _Dwarf_NameSlot))) == NULL) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
+		return (DW_DLE_MEMORY);
+	}
+
+	if (ns->ns_len == 0)
+		return (DW_DLE_NONE);
+
+	if ((ns->ns_byname = malloc(ns->ns_len * sizeof(Dwarf_NamePair))) ==
+	    NULL) {
+		free(ns->ns_hash);
+		ns->ns_hash = NULL;
+		DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
+		return (DW_DLE_MEMORY);
+	}
+
+	/* Count the pairs of each name. */
+	for (i = 0; i < ns->ns_len; i++) {
+		np = ns->ns_array[i];
+		hash = _dwarf_nametbl_hash(np->np_name);
+		nh = _dwarf_nametbl_slot(ns, np->np_name, hash);
+		if (nh->nh_name == NULL) {
+			nh->nh_name = np->np_name;
+			nh->nh_hash = hash;
+		}
+		nh->nh_cnt++;
+	}
+
+	/* Assign each name its range in ns_byname. */
+	first = 0;
+	for (i = 0; i < ns->ns_hashsize; i++) {
+		nh = &ns->ns_hash[i];
+		if (nh->nh_name == NULL)
+			continue;
+		nh->nh_first = first;
+		first += nh->nh_cnt;
+		nh->nh_cnt = 0;
+	}
+	assert(first == ns->ns_len);
+
+	/* Fill in the groups. */
+	for (i = 0; i < ns->ns_len; i++) {
+		np = ns->ns_array[i];
+		nh = _dwarf_nametbl_slot(ns, np->np_name,
+		    _dwarf_nametbl_hash(np->np_name));
+		ns->ns_byname[nh->nh_first + nh->nh_cnt++] = np;
+	}
+
+	return (DW_DLE_NONE);
+}
+
+int
+_dwarf_nametbl_lookup(Dwarf_NameSec ns, const char *name,
+    Dwarf_NamePair **ret_array, Dwarf_Signed *ret_count)
+{
+	struct _Dwarf_NameSlot *nh;
+
+	assert(ns->ns_hash != NULL);
+
+	nh = _dwarf_nametbl_slot(ns, name, _dwarf_nametbl_hash(name));
+	if (nh->nh_name == NULL)
+		return (DW_DLE_NO_ENTRY);
+
+	*ret_array = &ns->ns_byname[nh->nh_first];
+	*ret_count = nh->nh_cnt;
+
+	return (DW_DLE_NONE);
+}
+
 int
 _dwarf_nametbl_gen(Dwarf_P_Debug dbg, const char *name, Dwarf_NameTbl nt,
     Dwarf_Error *error)
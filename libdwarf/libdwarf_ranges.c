@@ -65,14 +65,132 @@ _dwarf_ranges_parse(Dwarf_Debug dbg, Dwarf_CU cu, Dwarf_Section *ds,
 	return (DW_DLE_NONE);
 }
 
+/*
+ * Parse a DWARF 5 range list in .debug_rnglists.  The entries are
+ * translated to the .debug_ranges representation: a leading base
+ * address selection entry with base 0 is followed by entries holding
+ * absolute addresses and a terminating end-of-list entry.
+ */
+static int
+_dwarf_rnglists_parse(Dwarf_Debug dbg, Dwarf_CU cu, Dwarf_Section *ds,
+    uint64_t off, Dwarf_Ranges *rg, Dwarf_Unsigned *cnt, Dwarf_Error *error)
+{
+	Dwarf_Unsigned base, start, end;
+	uint8_t kind;
+	int i, ret;
+
+	if ((ret = _dwarf_cu_bases_init(cu, NULL, error)) != DW_DLE_NONE)
+		return (ret);
+
+	base = cu->cu_lowpc;
+
+	if (rg != NULL) {
+		rg[0].dwr_type = DW_RANGES_ADDRESS_SELECTION;
+		rg[0].dwr_addr1 = cu->cu_pointer_size == 4 ? ~0U : ~0ULL;
+		rg[0].dwr_addr2 = 0;
+	}
+	i = 1;
+
+	for (;;) {
+		if (off >= ds->ds_size)
+			goto short_section;
+		kind = dbg->read(ds->ds_data, &off, 1);
+		if (kind == DW_RLE_end_of_list)
+			break;
+
+		switch (kind) {
+		case DW_RLE_base_addressx:
+			ret = _dwarf_addrx_lookup(cu,
+			    _dwarf_read_uleb128(ds->ds_data, &off), &base,
+			    error);
+			if (ret != DW_DLE_NONE)
+				return (ret);
+			continue;
+		case DW_RLE_base_address:
+			if (off + cu->cu_pointer_size > ds->ds_size)
+				goto short_section;
+			base = dbg->read(ds->ds_data, &off,
+			    cu->cu_pointer_size);
+			continue;
+		case DW_RLE_startx_endx:
+		case DW_RLE_startx_length:
+			ret = _dwarf_addrx_lookup(cu,
+			    _dwarf_read_uleb128(ds->ds_data, &off), &start,
+			    error);
+			if (ret != DW_DLE_NONE)
+				return (ret);
+			if (kind == DW_RLE_startx_length)
+				end = start + _dwarf_read_uleb128(ds->ds_data,
+				    &off);
+			else if ((ret = _dwarf_addrx_lookup(cu,
+			    _dwarf_read_uleb128(ds->ds_data, &off), &end,
+			    error)) != DW_DLE_NONE)
+				return (ret);
+			break;
+		case DW_RLE_offset_pair:
+			start = base + _dwarf_read_uleb128(ds->ds_data, &off);
+			end = base + _dwarf_read_uleb128(ds->ds_data, &off);
+			break;
+		case DW_RLE_start_end:
+		case DW_RLE_start_length:
+			if (off + cu->cu_pointer_size > ds->ds_size)
+				goto short_section;
+			start = dbg->read(ds->ds_data, &off,
+			    cu->cu_pointer_size);
+			if (kind == DW_RLE_start_length)
+				end = start + _dwarf_read_uleb128(ds->ds_data,
+				    &off);
+			else {
+				if (off + cu->cu_pointer_size > ds->ds_size)
+					goto short_section;
+				end = dbg->read(ds->ds_data, &off,
+				    cu->cu_pointer_size);
+			}
+			break;
+		default:
+			goto short_section;
+		}
+
+		if (rg != NULL) {
+			rg[i].dwr_type = DW_RANGES_ENTRY;
+			rg[i].dwr_addr1 = start;
+			rg[i].dwr_addr2 = end;
+		}
+		i++;
+	}
+
+	if (rg != NULL) {
+		rg[i].dwr_type = DW_RANGES_END;
+		rg[i].dwr_addr1 = 0;
+		rg[i].dwr_addr2 = 0;
+	}
+	i++;
+
+	if (cnt != NULL)
+		*cnt = i;
+
+	return (DW_DLE_NONE);
+
+short_section:
+	DWARF_SET_ERROR(dbg, error, DW_DLE_ARANGE_OFFSET_BAD);
+	return (DW_DLE_ARANGE_OFFSET_BAD);
+}
+
 int
-_dwarf_ranges_find(Dwarf_Debug dbg, uint64_t off, Dwarf_Rangelist *ret_rl)
+_dwarf_ranges_find(Dwarf_Debug dbg, Dwarf_CU cu, uint64_t off,
+    Dwarf_Rangelist *ret_rl)
 {
+	struct _Dwarf_ListKey key;
 	Dwarf_Rangelist rl;
 
-	STAILQ_FOREACH(rl, &dbg->dbg_rllist, rl_next)
-		if (rl->rl_offset == off)
-			break;
+	/*
+	 * DWARF 5 range lists live in a different section and are
+	 * resolved against the base address of their CU.
+	 */
+	memset(&key, 0, sizeof(key));
+	key.lk_offset = off;
+	key.lk_cu = cu->cu_version >= 5 ? cu : NULL;
+	HASH_FIND(rl_hh, dbg->dbg_rlhash, &key, sizeof(key), rl);
 
 	if (rl == NULL)
 		return (DW_DLE_NO_ENTRY);
@@ -91,6 +209,7 @@ _dwarf_ranges_cleanup(Dwarf_Debug dbg)
 	if (STAILQ_EMPTY(&dbg->dbg_rllist))
 		return;
 
+	HASH_CLEAR(rl_hh, dbg->dbg_rlhash);
 	STAILQ_FOREACH_SAFE(rl, &dbg->dbg_rllist, rl_next, trl) {
 		STAILQ_REMOVE(&dbg->dbg_rllist, rl, _Dwarf_Rangelist, rl_next);
 		if (rl->rl_rgarray)
@@ -99,6 +218,31 @@ _dwarf_ranges_cleanup(Dwarf_Debug dbg)
 	}
 }
 
+/*
+ * Drop the cached range lists decoded by units that have not been used
+ * since trim epoch `keep'.  They are decoded again when needed.
+ */
+void
+_dwarf_ranges_trim(Dwarf_Debug dbg, uint64_t keep)
+{
+	STAILQ_HEAD(, _Dwarf_Rangelist) rllist;
+	Dwarf_Rangelist rl;
+
+	/* Rebuild the list rather than unlinking from its middle. */
+	STAILQ_INIT(&rllist);
+	STAILQ_CONCAT(&rllist, &dbg->dbg_rllist);
+	while ((rl = STAILQ_FIRST(&rllist)) != NULL) {
+		STAILQ_REMOVE_HEAD(&rllist, rl_next);
+		if (rl->rl_cu->cu_lastuse >= keep) {
+			STAILQ_INSERT_TAIL(&dbg->dbg_rllist, rl, rl_next);
+			continue;
+		}
+		HASH_DELETE(rl_hh, dbg->dbg_rlhash, rl);
+		free(rl->rl_rgarray);
+		free(rl);
+	}
+}
+
 int
 _dwarf_ranges_add(Dwarf_Debug dbg, Dwarf_CU cu, uint64_t off,
     Dwarf_Rangelist *ret_rl, Dwarf_Error *error)
@@ -108,19 +252,30 @@ _dwarf_ranges_add(Dwarf_Debug dbg, Dwarf_CU cu, uint64_t off,
 	Dwarf_Unsigned cnt;
 	int ret;
 
-	if ((ds = _dwarf_find_section(dbg, ".debug_ranges")) == NULL) {
+	ret = _dwarf_find_section(dbg, cu->cu_version >= 5 ?
+	    ".debug_rnglists" : ".debug_ranges", &ds, error);
+	if (ret != DW_DLE_NONE)
+		return (ret);
+	if (ds == NULL) {
 		DWARF_SET_ERROR(dbg, error, DW_DLE_NO_ENTRY);
 		return (DW_DLE_NO_ENTRY);
 	}
 
-	if ((rl = malloc(sizeof(struct _Dwarf_Rangelist))) == NULL) {
+	if ((rl = calloc(1, sizeof(struct _Dwarf_Rangelist))) == NULL) {
 		DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
 		return (DW_DLE_MEMORY);
 	}
 
+	rl->rl_cu = cu;
 	rl->rl_offset = off;
+	rl->rl_key.lk_offset = off;
+	rl->rl_key.lk_cu = cu->cu_version >= 5 ? cu : NULL;
 
-	ret = _dwarf_ranges_parse(dbg, cu, ds, off, NULL, &cnt);
+	if (cu->cu_version >= 5)
+		ret = _dwarf_rnglists_parse(dbg, cu, ds, off, NULL, &cnt,
+		    error);
+	else
+		ret = _dwarf_ranges_parse(dbg, cu, ds, off, NULL, &cnt);
 	if (ret != DW_DLE_NONE) {
 		free(rl);
 		return (ret);
@@ -135,8 +290,12 @@ _dwarf_ranges_add(Dwarf_Debug dbg, Dwarf_CU cu, uint64_t off,
 			return (DW_DLE_MEMORY);
 		}
 
-		ret = _dwarf_ranges_parse(dbg, cu, ds, off, rl->rl_rgarray,
-		    NULL);
+		if (cu->cu_version >= 5)
+			ret = _dwarf_rnglists_parse(dbg, cu, ds, off,
+			    rl->rl_rgarray, NULL, error);
+		else
+			ret = _dwarf_ranges_parse(dbg, cu, ds, off,
+			    rl->rl_rgarray, NULL);
 		if (ret != DW_DLE_NONE) {
 			free(rl->rl_rgarray);
 			free(rl);
@@ -146,6 +305,7 @@ _dwarf_ranges_add(Dwarf_Debug dbg, Dwarf_CU cu, uint64_t off,
 		rl->rl_rgarray = NULL;
 
 	STAILQ_INSERT_TAIL(&dbg->dbg_rllist, rl, rl_next);
+	HASH_ADD(rl_hh, dbg->dbg_rlhash, rl_key, sizeof(rl->rl_key), rl);
 	*ret_rl = rl;
 
 	return (DW_DLE_NONE);
@@ -146,7 +146,7 @@ _dwarf_reloc_section_init(Dwarf_P_Debug dbg, Dwarf_Rel_Section *drsp,
 		return (DW_DLE_MEMORY);
 	}
 
-	STAILQ_INIT(&drs->drs_dre);
+	drs->drs_sorted = 1;
 	STAILQ_INSERT_TAIL(&dbg->dbgp_drslist, drs, drs_next);
 	dbg->dbgp_drscnt++;
 	*drsp = drs;
@@ -158,7 +158,6 @@ void
 _dwarf_reloc_section_free(Dwarf_P_Debug dbg, Dwarf_Rel_Section *drsp)
 {
 	Dwarf_Rel_Section drs, tdrs;
-	Dwarf_Rel_Entry dre, tdre;
 
 	assert(dbg != NULL && drsp != NULL);
 
@@ -170,11 +169,7 @@ _dwarf_reloc_section_free(Dwarf_P_Debug dbg, Dwarf_Rel_Section *drsp)
 			continue;
 		STAILQ_REMOVE(&dbg->dbgp_drslist, drs, _Dwarf_Rel_Section,
 		    drs_next);
-		STAILQ_FOREACH_SAFE(dre, &drs->drs_dre, dre_next, tdre) {
-			STAILQ_REMOVE(&drs->drs_dre, dre, _Dwarf_Rel_Entry,
-			    dre_next);
-			free(dre);
-		}
+		free(drs->drs_dre);
 		if ((dbg->dbgp_flags & DW_DLC_SYMBOLIC_RELOCATIONS) == 0)
 			_dwarf_section_free(dbg, &drs->drs_ds);
 		else {
@@ -189,6 +184,39 @@ _dwarf_reloc_section_free(Dwarf_P_Debug dbg, Dwarf_Rel_Section *drsp)
 	}
 }
 
+/*
+ * Reserve room for 'cnt' more entries in the entry array of a
+ * relocation section and return the first of them.
+ */
+static Dwarf_Rel_Entry
+_dwarf_reloc_entry_alloc(Dwarf_P_Debug dbg, Dwarf_Rel_Section drs,
+    Dwarf_Unsigned offset, int cnt, Dwarf_Error *error)
+{
+	Dwarf_Rel_Entry dre;
+	Dwarf_Unsigned cap;
+
+	if (drs->drs_drecnt + cnt > drs->drs_drecap) {
+		cap = drs->drs_drecap > 0 ? drs->drs_drecap * 2 : 64;
+		dre = realloc(drs->drs_dre, cap * sizeof(*dre));
+		if (dre == NULL) {
+			DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
+			return (NULL);
+		}
+		drs->drs_dre = dre;
+		drs->drs_drecap = cap;
+	}
+
+	/* Entries are normally added as the section is written. */
+	if (drs->drs_drecnt > 0 &&
+	    offset < drs->drs_dre[drs->drs_drecnt - 1].dre_offset)
+		drs->drs_sorted = 0;
+
+	dre = &drs->drs_dre[drs->drs_drecnt];
+	drs->drs_drecnt += cnt;
+
+	return (dre);
+}
+
 int
 _dwarf_reloc_entry_add(Dwarf_P_Debug dbg, Dwarf_Rel_Section drs,
     Dwarf_P_Section ds, unsigned char type, unsigned char length,
@@ -209,9 +237,13 @@ _dwarf_reloc_entry_add(Dwarf_P_Debug dbg, Dwarf_Rel_Section drs,
 	 * in the storage unit to be relocated. Otherwise write 0 in the
 	 * storage unit and the addend will be written into relocation
 	 * section later.
+	 *
+	 * Under DW_DLC_NO_SECTION_RELOCATIONS an offset into a debug
+	 * section is final: write it and generate no relocation entry.
 	 */
 	if ((dbg->dbgp_flags & DW_DLC_SYMBOLIC_RELOCATIONS) ||
-	    drs->drs_addend == 0)
+	    drs->drs_addend == 0 || (secname != NULL &&
+	    (dbg->dbgp_flags & DW_DLC_NO_SECTION_RELOCATIONS)))
 		ret = dbg->write_alloc(&ds->ds_data, &ds->ds_cap, &offset,
 		    addend, length, error);
 	else
@@ -222,18 +254,19 @@ _dwarf_reloc_entry_add(Dwarf_P_Debug dbg, Dwarf_Rel_Section drs,
 	if (offset > ds->ds_size)
 		ds->ds_size = offset;
 
-	if ((dre = calloc(1, sizeof(struct _Dwarf_Rel_Entry))) == NULL) {
-		DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
+	if (secname != NULL &&
+	    (dbg->dbgp_flags & DW_DLC_NO_SECTION_RELOCATIONS))
+		return (DW_DLE_NONE);
+
+	if ((dre = _dwarf_reloc_entry_alloc(dbg, drs, reloff, 1, error)) ==
+	    NULL)
 		return (DW_DLE_MEMORY);
-	}
-	STAILQ_INSERT_TAIL(&drs->drs_dre, dre, dre_next);
 	dre->dre_type = type;
 	dre->dre_length = length;
 	dre->dre_offset = reloff;
 	dre->dre_symndx = symndx;
 	dre->dre_addend = addend;
 	dre->dre_secname = secname;
-	drs->drs_drecnt++;
 
 	return (DW_DLE_NONE);
 }
@@ -261,12 +294,9 @@ _dwarf_reloc_entry_add_pair(Dwarf_P_Debug dbg, Dwarf_Rel_Section drs,
 	if (offset > ds->ds_size)
 		ds->ds_size = offset;
 
-	if ((dre = calloc(2, sizeof(struct _Dwarf_Rel_Entry))) == NULL) {
-		DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
+	if ((dre = _dwarf_reloc_entry_alloc(dbg, drs, reloff, 2, error)) ==
+	    NULL)
 		return (DW_DLE_MEMORY);
-	}
-	STAILQ_INSERT_TAIL(&drs->drs_dre, &dre[0], dre_next);
-	STAILQ_INSERT_TAIL(&drs->drs_dre, &dre[1], dre_next);
 	dre[0].dre_type = dwarf_drt_first_of_length_pair;
 	dre[0].dre_length = length;
 	dre[0].dre_offset = reloff;
@@ -279,11 +309,28 @@ _dwarf_reloc_entry_add_pair(Dwarf_P_Debug dbg, Dwarf_Rel_Section drs,
 	dre[1].dre_symndx = esymndx;
 	dre[1].dre_addend = 0;
 	dre[1].dre_secname = NULL;
-	drs->drs_drecnt += 2;
 
 	return (DW_DLE_NONE);
 }
 
+static int
+_dwarf_reloc_entry_cmp(const void *a, const void *b)
+{
+	const struct _Dwarf_Rel_Entry *dre1, *dre2;
+
+	dre1 = a;
+	dre2 = b;
+
+	if (dre1->dre_offset != dre2->dre_offset)
+		return (dre1->dre_offset < dre2->dre_offset ? -1 : 1);
+
+	/* Keep the two halves of a length pair in order. */
+	if (dre1->dre_type != dre2->dre_type)
+		return (dre1->dre_type < dre2->dre_type ? -1 : 1);
+
+	return (0);
+}
+
 int
 _dwarf_reloc_section_finalize(Dwarf_P_Debug dbg, Dwarf_Rel_Section drs,
     Dwarf_Error *error)
@@ -315,6 +362,13 @@ _dwarf_reloc_section_finalize(Dwarf_P_Debug dbg, Dwarf_Rel_Section drs,
 		return (DW_DLE_NONE);
 	}
 
+	/* Hand out the entries in the order of the storage units. */
+	if (!drs->drs_sorted) {
+		qsort(drs->drs_dre, drs->drs_drecnt, sizeof(*drs->drs_dre),
+		    _dwarf_reloc_entry_cmp);
+		drs->drs_sorted = 1;
+	}
+
 	/*
 	 * If we are under stream mode, realloc the section data block to
 	 * this size.
@@ -347,64 +401,48 @@ _dwarf_reloc_section_finalize(Dwarf_P_Debug dbg, Dwarf_Rel_Section drs,
 }
 
 int
-_dwarf_reloc_section_gen(Dwarf_P_Debug dbg, Dwarf_Rel_Section drs,
-    Dwarf_Error *error)
+_dwarf_reloc_section_gen(Dwarf_P_Debug dbg, Dwarf_Rel_Section drs)
 {
-	Dwarf_Rel_Entry dre;
+	Dwarf_Rel_Entry dre, end;
 	Dwarf_P_Section ds;
-	Dwarf_Unsigned type;
-	int ret;
+	Dwarf_Unsigned type[2];
+	uint64_t offset;
+	int unit;
 
 	assert((dbg->dbgp_flags & DW_DLC_SYMBOLIC_RELOCATIONS) == 0);
 	assert(drs->drs_ds != NULL && drs->drs_ds->ds_size == 0);
-	assert(!STAILQ_EMPTY(&drs->drs_dre));
+	assert(drs->drs_drecnt > 0);
 	ds = drs->drs_ds;
 
-	STAILQ_FOREACH(dre, &drs->drs_dre, dre_next) {
+	/*
+	 * The section data was sized by _dwarf_reloc_section_finalize(),
+	 * so the entries are translated straight into it.
+	 */
+	unit = (dbg->dbgp_flags & DW_DLC_SIZE_64) ? 8 : 4;
+	type[0] = _dwarf_get_reloc_type(dbg, 0);
+	type[1] = _dwarf_get_reloc_type(dbg, 1);
+	offset = 0;
+	end = drs->drs_dre + drs->drs_drecnt;
+	for (dre = drs->drs_dre; dre < end; dre++) {
 		assert(dre->dre_length == 4 || dre->dre_length == 8);
-		type = _dwarf_get_reloc_type(dbg, dre->dre_length == 8);
-		if (dbg->dbgp_flags & DW_DLC_SIZE_64) {
-			/* Write r_offset (8 bytes) */
-			ret = dbg->write_alloc(&ds->ds_data, &ds->ds_cap,
-			    &ds->ds_size, dre->dre_offset, 8, error);
-			if (ret != DW_DLE_NONE)
-				return (ret);
-			/* Write r_info (8 bytes) */
-			ret = dbg->write_alloc(&ds->ds_data, &ds->ds_cap,
-			    &ds->ds_size, ELF64_R_INFO(dre->dre_symndx, type),
-			    8, error);
-			if (ret != DW_DLE_NONE)
-				return (ret);
-			/* Write r_addend (8 bytes) */
-			if (drs->drs_addend) {
-				ret = dbg->write_alloc(&ds->ds_data,
-				    &ds->ds_cap, &ds->ds_size, dre->dre_addend,
-				    8, error);
-				if (ret != DW_DLE_NONE)
-					return (ret);
-			}
-		} else {
-			/* Write r_offset (4 bytes) */
-			ret = dbg->write_alloc(&ds->ds_data, &ds->ds_cap,
-			    &ds->ds_size, dre->dre_offset, 4, error);
-			if (ret != DW_DLE_NONE)
-				return (ret);
-			/* Write r_info (4 bytes) */
-			ret = dbg->write_alloc(&ds->ds_data, &ds->ds_cap,
-			    &ds->ds_size, ELF32_R_INFO(dre->dre_symndx, type),
-			    4, error);
-			if (ret != DW_DLE_NONE)
-				return (ret);
-			/* Write r_addend (4 bytes) */
-			if (drs->drs_addend) {
-				ret = dbg->write_alloc(&ds->ds_data,
-				    &ds->ds_cap, &ds->ds_size, dre->dre_addend,
-				    4, error);
-				if (ret != DW_DLE_NONE)
-					return (ret);
-			}
-		}
+		assert(offset + unit * (drs->drs_addend ? 3 : 2) <=
+		    ds->ds_cap);
+		/* Write r_offset. */
+		dbg->write(ds->ds_data, &offset, dre->dre_offset, unit);
+		/* Write r_info. */
+		if (unit == 8)
+			dbg->write(ds->ds_data, &offset,
+			    ELF64_R_INFO(dre->dre_symndx,
+			    type[dre->dre_length == 8]), 8);
+		else
+			dbg->write(ds->ds_data, &offset,
+			    ELF32_R_INFO(dre->dre_symndx,
+			    type[dre->dre_length == 8]), 4);
+		/* Write r_addend. */
+		if (drs->drs_addend)
+			dbg->write(ds->ds_data, &offset, dre->dre_addend, unit);
 	}
+	ds->ds_size = offset;
 	assert(ds->ds_size == ds->ds_cap);
 
 	return (DW_DLE_NONE);
@@ -414,7 +452,7 @@ int
 _dwarf_reloc_gen(Dwarf_P_Debug dbg, Dwarf_Error *error)
 {
 	Dwarf_Rel_Section drs;
-	Dwarf_Rel_Entry dre;
+	Dwarf_Rel_Entry dre, end;
 	Dwarf_P_Section ds;
 	int ret;
 
@@ -423,7 +461,8 @@ _dwarf_reloc_gen(Dwarf_P_Debug dbg, Dwarf_Error *error)
 		 * Update relocation entries: translate any section name
 		 * reference to section symbol index.
 		 */
-		STAILQ_FOREACH(dre, &drs->drs_dre, dre_next) {
+		end = drs->drs_dre + drs->drs_drecnt;
+		for (dre = drs->drs_dre; dre < end; dre++) {
 			if (dre->dre_secname == NULL)
 				continue;
 			ds = _dwarf_pro_find_section(dbg, dre->dre_secname);
@@ -436,7 +475,7 @@ _dwarf_reloc_gen(Dwarf_P_Debug dbg, Dwarf_Error *error)
 		 * mode.
 		 */
 		if ((dbg->dbgp_flags & DW_DLC_SYMBOLIC_RELOCATIONS) == 0) {
-			ret = _dwarf_reloc_section_gen(dbg, drs, error);
+			ret = _dwarf_reloc_section_gen(dbg, drs);
 			if (ret != DW_DLE_NONE)
 				return (ret);
 		}
@@ -449,7 +488,6 @@ void
 _dwarf_reloc_cleanup(Dwarf_P_Debug dbg)
 {
 	Dwarf_Rel_Section drs, tdrs;
-	Dwarf_Rel_Entry dre, tdre;
 
 	assert(dbg != NULL && dbg->dbg_mode == DW_DLC_WRITE);
 
@@ -457,11 +495,7 @@ _dwarf_reloc_cleanup(Dwarf_P_Debug dbg)
 		STAILQ_REMOVE(&dbg->dbgp_drslist, drs, _Dwarf_Rel_Section,
 		    drs_next);
 		free(drs->drs_drd);
-		STAILQ_FOREACH_SAFE(dre, &drs->drs_dre, dre_next, tdre) {
-			STAILQ_REMOVE(&drs->drs_dre, dre, _Dwarf_Rel_Entry,
-			    dre_next);
-			free(dre);
-		}
+		free(drs->drs_dre);
 		if (dbg->dbgp_flags & DW_DLC_SYMBOLIC_RELOCATIONS) {
 			if (drs->drs_ds) {
 				if (drs->drs_ds->ds_name)
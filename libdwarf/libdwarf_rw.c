@@ -43,7 +43,9 @@ _dwarf_read_lsb(uint8_t *data, uint64_t *offsetp, int bytes_to_read)
 		ret |= ((uint64_t) src[4]) << 32 | ((uint64_t) src[5]) << 40;
 		ret |= ((uint64_t) src[6]) << 48 | ((uint64_t) src[7]) << 56;
 	case 4:
-		ret |= ((uint64_t) src[2]) << 16 | ((uint64_t) src[3]) << 24;
+		ret |= ((uint64_t) src[3]) << 24;
+	case 3:
+		ret |= ((uint64_t) src[2]) << 16;
 	case 2:
 		ret |= ((uint64_t) src[1]) << 8;
 	case 1:
@@ -72,7 +74,9 @@ _dwarf_decode_lsb(uint8_t **data, int bytes_to_read)
 		ret |= ((uint64_t) src[4]) << 32 | ((uint64_t) src[5]) << 40;
 		ret |= ((uint64_t) src[6]) << 48 | ((uint64_t) src[7]) << 56;
 	case 4:
-		ret |= ((uint64_t) src[2]) << 16 | ((uint64_t) src[3]) << 24;
+		ret |= ((uint64_t) src[3]) << 24;
+	case 3:
+		ret |= ((uint64_t) src[2]) << 16;
 	case 2:
 		ret |= ((uint64_t) src[1]) << 8;
 	case 1:
@@ -102,6 +106,10 @@ _dwarf_read_msb(uint8_t *data, uint64_t *offsetp, int bytes_to_read)
 	case 2:
 		ret = src[1] | ((uint64_t) src[0]) << 8;
 		break;
+	case 3:
+		ret = src[2] | ((uint64_t) src[1]) << 8;
+		ret |= ((uint64_t) src[0]) << 16;
+		break;
 	case 4:
 		ret = src[3] | ((uint64_t) src[2]) << 8;
 		ret |= ((uint64_t) src[1]) << 16 | ((uint64_t) src[0]) << 24;
@@ -137,6 +145,10 @@ _dwarf_decode_msb(uint8_t **data, int bytes_to_read)
 	case 2:
 		ret = src[1] | ((uint64_t) src[0]) << 8;
 		break;
+	case 3:
+		ret = src[2] | ((uint64_t) src[1]) << 8;
+		ret |= ((uint64_t) src[0]) << 16;
+		break;
 	case 4:
 		ret = src[3] | ((uint64_t) src[2]) << 8;
 		ret |= ((uint64_t) src[1]) << 16 | ((uint64_t) src[0]) << 24;
@@ -260,27 +272,132 @@ _dwarf_write_msb_alloc(uint8_t **block, uint64_t *size, uint64_t *offsetp,
 	return (DW_DLE_NONE);
 }
 
-int64_t
-_dwarf_read_sleb128(uint8_t *data, uint64_t *offsetp)
+/*
+ * Decode the LEB128 value at '*dp' and advance '*dp' past it.  If
+ * 'offsetp' is not NULL, it is set to the offset of the new '*dp' from
+ * 'data'.  If 'end' is not NULL, a value running up to 'end' is truncated
+ * and '*offsetp' is set past 'end'.
+ *
+ * Values of one or two bytes, such as abbreviation codes, attribute
+ * names, forms and most constants, take the unrolled paths.  Bits beyond
+ * the 64th are dropped.
+ */
+static uint64_t
+_dwarf_decode_uleb128_end(uint8_t **dp, uint8_t *data, uint64_t *offsetp,
+    uint8_t *end)
 {
-	int64_t ret = 0;
+	uint64_t ret;
+	uint8_t *src;
 	uint8_t b;
-	int shift = 0;
+	int shift;
+
+	src = *dp;
+
+	if (end == NULL || end - src >= 2) {
+		if ((src[0] & 0x80) == 0) {
+			ret = src[0];
+			src += 1;
+			goto done;
+		}
+		if ((src[1] & 0x80) == 0) {
+			ret = (src[0] & 0x7f) | ((uint64_t) src[1] << 7);
+			src += 2;
+			goto done;
+		}
+	}
+
+	ret = 0;
+	shift = 0;
+	do {
+		if (end != NULL && src >= end) {
+			*dp = src;
+			if (offsetp != NULL)
+				*offsetp = (end - data) + 1;
+			return (ret);
+		}
+		b = *src++;
+		if (shift < 64)
+			ret |= (uint64_t) (b & 0x7f) << shift;
+		shift += 7;
+	} while ((b & 0x80) != 0);
+
+done:
+	*dp = src;
+	if (offsetp != NULL)
+		*offsetp = src - data;
+
+	return (ret);
+}
+
+static int64_t
+_dwarf_decode_sleb128_end(uint8_t **dp, uint8_t *data, uint64_t *offsetp,
+    uint8_t *end)
+{
+	uint64_t ret;
 	uint8_t *src;
+	uint8_t b;
+	int shift;
 
-	src = data + *offsetp;
+	src = *dp;
+
+	if ((end == NULL || end - src >= 1) && (src[0] & 0x80) == 0) {
+		/* Sign-extend from bit 6. */
+		ret = src[0];
+		if ((ret & 0x40) != 0)
+			ret |= ~(uint64_t) 0x7f;
+		src += 1;
+		goto done;
+	}
 
+	ret = 0;
+	shift = 0;
 	do {
+		if (end != NULL && src >= end) {
+			*dp = src;
+			if (offsetp != NULL)
+				*offsetp = (end - data) + 1;
+			return ((int64_t) ret);
+		}
 		b = *src++;
-		ret |= ((b & 0x7f) << shift);
-		(*offsetp)++;
+		if (shift < 64)
+			ret |= (uint64_t) (b & 0x7f) << shift;
 		shift += 7;
 	} while ((b & 0x80) != 0);
 
 	if (shift < 64 && (b & 0x40) != 0)
-		ret |= (-1 << shift);
+		ret |= ~(uint64_t) 0 << shift;
 
-	return (ret);
+done:
+	*dp = src;
+	if (offsetp != NULL)
+		*offsetp = src - data;
+
+	return ((int64_t) ret);
+}
+
+int64_t
+_dwarf_read_sleb128(uint8_t *data, uint64_t *offsetp)
+{
+	uint8_t *src;
+
+	src = data + *offsetp;
+
+	return (_dwarf_decode_sleb128_end(&src, data, offsetp, NULL));
+}
+
+int64_t
+_dwarf_read_sleb128_bounded(uint8_t *data, uint64_t *offsetp, uint64_t size)
+{
+	uint8_t *src;
+
+	if (*offsetp >= size) {
+		*offsetp = size + 1;
+		return (0);
+	}
+
+	src = data + *offsetp;
+
+	return (_dwarf_decode_sleb128_end(&src, data, offsetp, data + size));
 }
 
 int
@@ -332,21 +449,26 @@ _dwarf_write_sleb128_alloc(uint8_t **block, uint64_t *size, uint64_t *offsetp,
 uint64_t
 _dwarf_read_uleb128(uint8_t *data, uint64_t *offsetp)
 {
-	uint64_t ret = 0;
-	uint8_t b;
-	int shift = 0;
 	uint8_t *src;
 
 	src = data + *offsetp;
 
-	do {
-		b = *src++;
-		ret |= ((b & 0x7f) << shift);
-		(*offsetp)++;
-		shift += 7;
-	} while ((b & 0x80) != 0);
+	return (_dwarf_decode_uleb128_end(&src, data, offsetp, NULL));
+}
 
-	return (ret);
+uint64_t
+_dwarf_read_uleb128_bounded(uint8_t *data, uint64_t *offsetp, uint64_t size)
+{
+	uint8_t *src;
+
+	if (*offsetp >= size) {
+		*offsetp = size + 1;
+		return (0);
+	}
+
+	src = data + *offsetp;
+
+	return (_dwarf_decode_uleb128_end(&src, data, offsetp, data + size));
 }
 
 int
@@ -395,44 +517,15 @@ _dwarf_write_uleb128_alloc(uint8_t **block, uint64_t *size, uint64_t *offsetp,
 int64_t
 _dwarf_decode_sleb128(uint8_t **dp)
 {
-	int64_t ret = 0;
-	uint8_t b;
-	int shift = 0;
-
-	uint8_t *src = *dp;
-
-	do {
-		b = *src++;
-		ret |= ((b & 0x7f) << shift);
-		shift += 7;
-	} while ((b & 0x80) != 0);
-
-	if (shift < 64 && (b & 0x40) != 0)
-		ret |= (-1 << shift);
-
-	*dp = src;
 
-	return (ret);
+	return (_dwarf_decode_sleb128_end(dp, *dp, NULL, NULL));
 }
 
 uint64_t
 _dwarf_decode_uleb128(uint8_t **dp)
 {
-	uint64_t ret = 0;
-	uint8_t b;
-	int shift = 0;
-
-	uint8_t *src = *dp;
-
-	do {
-		b = *src++;
-		ret |= ((b & 0x7f) << shift);
-		shift += 7;
-	} while ((b & 0x80) != 0);
 
-	*dp = src;
-
-	return (ret);
+	return (_dwarf_decode_uleb128_end(dp, *dp, NULL, NULL));
 }
 
 char *
@@ -191,6 +191,10 @@ _dwarf_generate_sections(Dwarf_P_Debug dbg, Dwarf_Error *error)
 	    error)) != DW_DLE_NONE)
 		return (ret);
 
+	/* Produce .debug_names section. */
+	if ((ret = _dwarf_debugnames_gen(dbg, error)) != DW_DLE_NONE)
+		return (ret);
+
 	/* Produce .debug_str section. */
 	if ((ret = _dwarf_strtab_gen(dbg, error)) != DW_DLE_NONE)
 		return (ret);
@@ -206,21 +210,121 @@ _dwarf_generate_sections(Dwarf_P_Debug dbg, Dwarf_Error *error)
 	return (DW_DLE_NONE);
 }
 
+static int
+_dwarf_section_decompress(Dwarf_Debug dbg, Dwarf_Section *ds,
+    Dwarf_Error *error)
+{
+	Dwarf_Unsigned hdrsize, size;
+	int ret;
+
+	hdrsize = _dwarf_decompress_zdebug_header(ds->ds_data, ds->ds_size,
+	    &size);
+	if (hdrsize == 0) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_COMPRESSION);
+		return (DW_DLE_COMPRESSION);
+	}
+
+	if ((ds->ds_zdata = malloc(size > 0 ? size : 1)) == NULL) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
+		return (DW_DLE_MEMORY);
+	}
+
+	ret = _dwarf_decompress(DWARF_COMPRESS_ZLIB, ds->ds_data + hdrsize,
+	    ds->ds_size - hdrsize, ds->ds_zdata, size);
+	if (ret != DW_DLE_NONE) {
+		free(ds->ds_zdata);
+		ds->ds_zdata = NULL;
+		DWARF_SET_ERROR(dbg, error, ret);
+		return (ret);
+	}
+
+	ds->ds_data = ds->ds_zdata;
+	ds->ds_size = size;
+
+	return (DW_DLE_NONE);
+}
+
+int
+_dwarf_section_load(Dwarf_Debug dbg, Dwarf_Section *ds, Dwarf_Error *error)
+{
+	Dwarf_Obj_Access_Interface *iface;
+	int ret;
+
+	assert(dbg != NULL && ds != NULL);
+
+	if (ds->ds_loaded)
+		return (DW_DLE_NONE);
+
+	/*
+	 * dwarf_set_thread_safe() loads every section before the debug
+	 * context is shared, so that the flag above can be tested
+	 * without a lock.  A section that could not be loaded then is
+	 * not loaded again; its error is reported instead.
+	 */
+	if (dbg->dbg_thread_safe) {
+		assert(ds->ds_loaderr != DW_DLE_NONE);
+		_DWARF_SET_ERROR(dbg, error, ds->ds_loaderr, ds->ds_elferr);
+		return (ds->ds_loaderr);
+	}
+
+	iface = dbg->dbg_iface;
+	ret = DW_DLE_NONE;
+	if (iface->methods->load_section(iface->object,
+	    (Dwarf_Half) (ds - dbg->dbg_section), &ds->ds_data, &ret) !=
+	    DW_DLV_OK) {
+		if (ret == DW_DLE_NONE)
+			ret = DW_DLE_NO_ENTRY;
+		if (ret == DW_DLE_ELF)
+			ds->ds_elferr = _dwarf_elf_load_error(dbg);
+		_DWARF_SET_ERROR(dbg, error, ret, ds->ds_elferr);
+	} else if (ds->ds_zname != NULL)
+		ret = _dwarf_section_decompress(dbg, ds, error);
+
+	if (ret == DW_DLE_NONE)
+		ds->ds_loaded = 1;
+	else
+		ds->ds_loaderr = ret;
+
+	return (ret);
+}
+
 Dwarf_Section *
-_dwarf_find_section(Dwarf_Debug dbg, const char *name)
+_dwarf_locate_section(Dwarf_Debug dbg, const char *name)
 {
 	Dwarf_Section *ds;
-	Dwarf_Half i;
 
 	assert(dbg != NULL && name != NULL);
 
-	for (i = 0; i < dbg->dbg_seccnt; i++) {
-		ds = &dbg->dbg_section[i];
-		if (ds->ds_name != NULL && !strcmp(ds->ds_name, name))
-			return (ds);
-	}
+	HASH_FIND(ds_hh, dbg->dbg_sechash, (void *) (uintptr_t) name,
+	    strlen(name), ds);
 
-	return (NULL);
+	return (ds);
+}
+
+/*
+ * Find the section with the given name and load its data on first use.
+ * A section that is not present is returned as NULL; an error is only
+ * returned if the section exists but can not be loaded.
+ */
+int
+_dwarf_find_section(Dwarf_Debug dbg, const char *name,
+    Dwarf_Section **ret_ds, Dwarf_Error *error)
+{
+	Dwarf_Section *ds;
+	int ret;
+
+	assert(ret_ds != NULL);
+
+	*ret_ds = NULL;
+	if ((ds = _dwarf_locate_section(dbg, name)) == NULL)
+		return (DW_DLE_NONE);
+
+	if ((ret = _dwarf_section_load(dbg, ds, error)) != DW_DLE_NONE)
+		return (ret);
+
+	*ret_ds = ds;
+
+	return (DW_DLE_NONE);
 }
 
 Dwarf_Section *
@@ -230,7 +334,7 @@ _dwarf_find_next_types_section(Dwarf_Debug dbg, Dwarf_Section *ds)
 	assert(dbg != NULL);
 
 	if (ds == NULL)
-		return (_dwarf_find_section(dbg, ".debug_types"));
+		return (_dwarf_locate_section(dbg, ".debug_types"));
 
 	assert(ds->ds_name != NULL);
 
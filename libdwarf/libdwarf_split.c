@@ -0,0 +1,503 @@
+/*-
+ * Copyright (c) 2026 The Elftoolchain Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "_libdwarf.h"
+
+ELFTC_VCSID("$Id$");
+
+/*
+ * Split DWARF support.  The units of a split DWARF object (.dwo) are
+ * paired with the skeleton units of the object they were split from
+ * (the "tied" object) through their 64-bit DWO id.  A DWARF package
+ * (.dwp) combines many .dwo objects; its .debug_cu_index and
+ * .debug_tu_index sections are hash tables mapping a signature to the
+ * contributions of a unit in each of the package's sections.
+ *
+ * Type units, split or not, are found by their type signature the same
+ * way, which resolves DW_FORM_ref_sig8 references.
+ */
+
+static int
+_dwarf_unit_index_ent_cmp(const void *a, const void *b)
+{
+	const struct _Dwarf_UnitIndexEnt *ea, *eb;
+
+	ea = a;
+	eb = b;
+
+	if (ea->ue_off < eb->ue_off)
+		return (-1);
+	if (ea->ue_off > eb->ue_off)
+		return (1);
+	return (0);
+}
+
+static void
+_dwarf_unit_index_free(struct _Dwarf_UnitIndex *ui)
+{
+
+	if (ui == NULL)
+		return;
+
+	free(ui->ui_sect);
+	free(ui->ui_ent);
+	free(ui->ui_cu);
+	free(ui);
+}
+
+static int
+_dwarf_unit_index_parse(Dwarf_Debug dbg, const char *name, int is_tu,
+    struct _Dwarf_UnitIndex **ret_ui, Dwarf_Error *error)
+{
+	struct _Dwarf_UnitIndex *ui;
+	Dwarf_Section *ds;
+	uint64_t offset, size;
+	uint32_t i, j, key, sect;
+	int ret;
+
+	*ret_ui = NULL;
+
+	if ((ret = _dwarf_find_section(dbg, name, &ds, error)) != DW_DLE_NONE)
+		return (ret);
+	if (ds == NULL)
+		return (DW_DLE_NONE);
+
+	if (ds->ds_size < 16)
+		goto bad_index;
+
+	if ((ui = calloc(1, sizeof(struct _Dwarf_UnitIndex))) == NULL) {
+		DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
+		return (DW_DLE_MEMORY);
+	}
+	ui->ui_ds = ds;
+
+	/*
+	 * The GNU extension to DWARF 4 starts the header with a 4-byte
+	 * version 2, DWARF 5 with a 2-byte version 5 and 2 bytes of
+	 * padding.
+	 */
+	offset = 0;
+	ui->ui_version = dbg->read(ds->ds_data, &offset, 4);
+	if (ui->ui_version != 2) {
+		offset = 0;
+		ui->ui_version = dbg->read(ds->ds_data, &offset, 2);
+		offset += 2;
+	}
+	ui->ui_col_cnt = dbg->read(ds->ds_data, &offset, 4);
+	ui->ui_unit_cnt = dbg->read(ds->ds_data, &offset, 4);
+	ui->ui_slot_cnt = dbg->read(ds->ds_data, &offset, 4);
+
+	if ((ui->ui_version != 2 && ui->ui_version != 5) ||
+	    ui->ui_col_cnt > DW_SECT_RNGLISTS ||
+	    ui->ui_unit_cnt > ui->ui_slot_cnt ||
+	    (ui->ui_slot_cnt & (ui->ui_slot_cnt - 1)) != 0)
+		goto bad_index_free;
+
+	/*
+	 * The hash table and the parallel row table are followed by the
+	 * section offset table and the section size table.
+	 */
+	size = 16 + (uint64_t) ui->ui_slot_cnt * 12 +
+	    (uint64_t) ui->ui_col_cnt * 4 +
+	    (uint64_t) ui->ui_unit_cnt * ui->ui_col_cnt * 8;
+	if (size > ds->ds_size)
+		goto bad_index_free;
+
+	ui->ui_hash_off = 16;
+	ui->ui_row_off = ui->ui_hash_off + (uint64_t) ui->ui_slot_cnt * 8;
+	ui->ui_off_off = ui->ui_row_off + (uint64_t) ui->ui_slot_cnt * 4 +
+	    (uint64_t) ui->ui_col_cnt * 4;
+
+	/* An empty index may omit the section columns. */
+	if (ui->ui_unit_cnt == 0) {
+		*ret_ui = ui;
+		return (DW_DLE_NONE);
+	}
+
+	if ((ui->ui_sect = calloc(ui->ui_col_cnt, sizeof(int))) == NULL)
+		goto nomem;
+
+	/* Units are located by their .debug_info (or .debug_types) column. */
+	key = is_tu && ui->ui_version == 2 ? DW_SECT_TYPES : DW_SECT_INFO;
+	ui->ui_key_col = ui->ui_col_cnt;
+	offset = ui->ui_off_off - (uint64_t) ui->ui_col_cnt * 4;
+	for (i = 0; i < ui->ui_col_cnt; i++) {
+		sect = dbg->read(ds->ds_data, &offset, 4);
+		if (sect == 0 || sect > DW_SECT_RNGLISTS)
+			goto bad_index_free;
+		for (j = 0; j < i; j++)
+			if ((uint32_t) ui->ui_sect[j] == sect)
+				goto bad_index_free;
+		ui->ui_sect[i] = sect;
+		if (sect == key)
+			ui->ui_key_col = i;
+	}
+	if (ui->ui_key_col == ui->ui_col_cnt)
+		goto bad_index_free;
+
+	if ((ui->ui_ent = calloc(ui->ui_unit_cnt,
+	    sizeof(struct _Dwarf_UnitIndexEnt))) == NULL ||
+	    (ui->ui_cu = calloc(ui->ui_unit_cnt, sizeof(Dwarf_CU))) == NULL)
+		goto nomem;
+	for (i = 0; i < ui->ui_unit_cnt; i++) {
+		offset = ui->ui_off_off + ((uint64_t) i * ui->ui_col_cnt +
+		    ui->ui_key_col) * 4;
+		ui->ui_ent[i].ue_off = dbg->read(ds->ds_data, &offset, 4);
+		ui->ui_ent[i].ue_row = i + 1;
+	}
+	qsort(ui->ui_ent, ui->ui_unit_cnt, sizeof(struct _Dwarf_UnitIndexEnt),
+	    _dwarf_unit_index_ent_cmp);
+
+	*ret_ui = ui;
+
+	return (DW_DLE_NONE);
+
+nomem:
+	_dwarf_unit_index_free(ui);
+	DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
+	return (DW_DLE_MEMORY);
+
+bad_index_free:
+	_dwarf_unit_index_free(ui);
+
+bad_index:
+	DWARF_SET_ERROR(dbg, error, DW_DLE_UNIT_INDEX_BAD);
+	return (DW_DLE_UNIT_INDEX_BAD);
+}
+
+/*
+ * Parse the unit indexes of a .dwp package.  A damaged index is reported
+ * once; the units are then read without it.
+ */
+int
+_dwarf_unit_index_init(Dwarf_Debug dbg, Dwarf_Error *error)
+{
+	int ret;
+
+	if (dbg->dbg_unit_index_loaded)
+		return (DW_DLE_NONE);
+
+	dbg->dbg_unit_index_loaded = 1;
+
+	ret = _dwarf_unit_index_parse(dbg, ".debug_cu_index", 0,
+	    &dbg->dbg_cu_index, error);
+	if (ret != DW_DLE_NONE)
+		return (ret);
+
+	ret = _dwarf_unit_index_parse(dbg, ".debug_tu_index", 1,
+	    &dbg->dbg_tu_index, error);
+	if (ret != DW_DLE_NONE) {
+		_dwarf_unit_index_free(dbg->dbg_cu_index);
+		dbg->dbg_cu_index = NULL;
+		return (ret);
+	}
+
+	return (DW_DLE_NONE);
+}
+
+void
+_dwarf_unit_index_cleanup(Dwarf_Debug dbg)
+{
+
+	_dwarf_unit_index_free(dbg->dbg_cu_index);
+	_dwarf_unit_index_free(dbg->dbg_tu_index);
+	dbg->dbg_cu_index = NULL;
+	dbg->dbg_tu_index = NULL;
+	dbg->dbg_unit_index_loaded = 0;
+}
+
+/*
+ * Record the section contributions of a newly read unit of a .dwp
+ * package.  Offsets read from the unit are relative to them.
+ */
+void
+_dwarf_unit_index_apply(Dwarf_Debug dbg, Dwarf_CU cu)
+{
+	struct _Dwarf_UnitIndex *ui;
+	struct _Dwarf_UnitIndexEnt key, *ue;
+	uint64_t offset;
+	uint32_t i;
+
+	if (cu->cu_is_info && cu->cu_unit_type != DW_UT_type &&
+	    cu->cu_unit_type != DW_UT_split_type)
+		ui = dbg->dbg_cu_index;
+	else
+		ui = dbg->dbg_tu_index;
+
+	if (ui == NULL || ui->ui_unit_cnt == 0)
+		return;
+
+	key.ue_off = cu->cu_offset;
+	ue = bsearch(&key, ui->ui_ent, ui->ui_unit_cnt,
+	    sizeof(struct _Dwarf_UnitIndexEnt), _dwarf_unit_index_ent_cmp);
+	if (ue == NULL)
+		return;
+
+	offset = ui->ui_off_off + (uint64_t) (ue->ue_row - 1) *
+	    ui->ui_col_cnt * 4;
+	for (i = 0; i < ui->ui_col_cnt; i++)
+		cu->cu_dwp_off[ui->ui_sect[i]] = dbg->read(ui->ui_ds->ds_data,
+		    &offset, 4);
+
+	cu->cu_abbrev_offset += cu->cu_dwp_off[DW_SECT_ABBREV];
+	cu->cu_abbrev_offset_cur = cu->cu_abbrev_offset;
+	cu->cu_dwp_index = ui;
+	ui->ui_cu[ue->ue_row - 1] = cu;
+}
+
+/*
+ * Look up a signature in the hash table of a unit index and return the
+ * (1-based) row of the unit.
+ */
+static int
+_dwarf_unit_index_find(Dwarf_Debug dbg, struct _Dwarf_UnitIndex *ui,
+    uint64_t sig, uint32_t *ret_row)
+{
+	Dwarf_Section *ds;
+	uint64_t h, h2, mask, offset, s;
+	uint32_t i, row;
+
+	if (ui->ui_slot_cnt == 0)
+		return (DW_DLE_NO_ENTRY);
+
+	ds = ui->ui_ds;
+	mask = ui->ui_slot_cnt - 1;
+	h = sig & mask;
+	h2 = ((sig >> 32) & mask) | 1;
+
+	for (i = 0; i < ui->ui_slot_cnt; i++) {
+		offset = ui->ui_row_off + h * 4;
+		if ((row = dbg->read(ds->ds_data, &offset, 4)) == 0)
+			break;
+		offset = ui->ui_hash_off + h * 8;
+		s = dbg->read(ds->ds_data, &offset, 8);
+		if (s == sig) {
+			if (row > ui->ui_unit_cnt)
+				break;
+			*ret_row = row;
+			return (DW_DLE_NONE);
+		}
+		h = (h + h2) & mask;
+	}
+
+	return (DW_DLE_NO_ENTRY);
+}
+
+static void
+_dwarf_split_sighash_add(Dwarf_CU *head, Dwarf_CU cu, uint64_t sig)
+{
+	Dwarf_CU tcu;
+
+	HASH_FIND(cu_hh, *head, &sig, sizeof(sig), tcu);
+	if (tcu != NULL)
+		return;
+
+	cu->cu_sig = sig;
+	HASH_ADD(cu_hh, *head, cu_sig, sizeof(cu->cu_sig), cu);
+}
+
+static uint64_t
+_dwarf_split_type_sig(Dwarf_Debug dbg, Dwarf_CU cu)
+{
+	uint64_t offset;
+
+	offset = 0;
+
+	return (dbg->read((uint8_t *) cu->cu_type_sig.signature, &offset, 8));
+}
+
+/*
+ * Hash the units of an object without a unit index by signature on
+ * first use: the compilation units by DWO id, or the type units by type
+ * signature.
+ */
+static int
+_dwarf_split_sighash_init(Dwarf_Debug dbg, int is_tu, Dwarf_Error *error)
+{
+	Dwarf_CU cu;
+	int ret;
+
+	if (is_tu ? dbg->dbg_tu_sighash_init : dbg->dbg_cu_sighash_init)
+		return (DW_DLE_NONE);
+
+	if ((ret = _dwarf_info_load(dbg, 1, 1, error)) != DW_DLE_NONE)
+		return (ret);
+
+	if (is_tu && dbg->dbg_types_sec != NULL &&
+	    (ret = _dwarf_info_load(dbg, 1, 0, error)) != DW_DLE_NONE)
+		return (ret);
+
+	STAILQ_FOREACH(cu, &dbg->dbg_cu, cu_next) {
+		if (cu->cu_unit_type == DW_UT_type ||
+		    cu->cu_unit_type == DW_UT_split_type) {
+			if (is_tu)
+				_dwarf_split_sighash_add(&dbg->dbg_tu_sighash,
+				    cu, _dwarf_split_type_sig(dbg, cu));
+			continue;
+		}
+
+		if (is_tu)
+			continue;
+
+		/* DWARF 4 units keep the DWO id in the CU DIE. */
+		if (cu->cu_version < 5 &&
+		    (ret = _dwarf_cu_bases_init(cu, NULL, error)) !=
+		    DW_DLE_NONE)
+			return (ret);
+
+		if (cu->cu_dwo_id != 0)
+			_dwarf_split_sighash_add(&dbg->dbg_cu_sighash, cu,
+			    cu->cu_dwo_id);
+	}
+
+	if (is_tu) {
+		STAILQ_FOREACH(cu, &dbg->dbg_tu, cu_next)
+			_dwarf_split_sighash_add(&dbg->dbg_tu_sighash, cu,
+			    _dwarf_split_type_sig(dbg, cu));
+		dbg->dbg_tu_sighash_init = 1;
+	} else
+		dbg->dbg_cu_sighash_init = 1;
+
+	return (DW_DLE_NONE);
+}
+
+void
+_dwarf_split_sighash_cleanup(Dwarf_Debug dbg, int is_tu)
+{
+
+	if (is_tu) {
+		HASH_CLEAR(cu_hh, dbg->dbg_tu_sighash);
+		dbg->dbg_tu_sighash_init = 0;
+	} else {
+		HASH_CLEAR(cu_hh, dbg->dbg_cu_sighash);
+		dbg->dbg_cu_sighash_init = 0;
+	}
+}
+
+static int
+_dwarf_split_lookup(Dwarf_Debug dbg, uint64_t sig, int is_tu,
+    Dwarf_CU *ret_cu, Dwarf_Error *error)
+{
+	struct _Dwarf_UnitIndex *ui;
+	Dwarf_CU cu;
+	uint32_t row;
+	int ret;
+
+	if ((ret = _dwarf_unit_index_init(dbg, error)) != DW_DLE_NONE)
+		return (ret);
+
+	ui = is_tu ? dbg->dbg_tu_index : dbg->dbg_cu_index;
+	if (ui != NULL) {
+		if (_dwarf_unit_index_find(dbg, ui, sig, &row) != DW_DLE_NONE)
+			return (DW_DLE_NO_ENTRY);
+		if (ui->ui_cu[row - 1] == NULL) {
+			ret = _dwarf_info_load(dbg, 1, !is_tu ||
+			    ui->ui_version != 2, error);
+			if (ret != DW_DLE_NONE)
+				return (ret);
+		}
+		cu = ui->ui_cu[row - 1];
+	} else {
+		if ((ret = _dwarf_split_sighash_init(dbg, is_tu, error)) !=
+		    DW_DLE_NONE)
+			return (ret);
+		if (is_tu)
+			HASH_FIND(cu_hh, dbg->dbg_tu_sighash, &sig,
+			    sizeof(sig), cu);
+		else
+			HASH_FIND(cu_hh, dbg->dbg_cu_sighash, &sig,
+			    sizeof(sig), cu);
+	}
+
+	if (cu == NULL)
+		return (DW_DLE_NO_ENTRY);
+
+	*ret_cu = cu;
+
+	return (DW_DLE_NONE);
+}
+
+/*
+ * Find the compilation unit with the given DWO id, or the type unit
+ * with the given type signature.  A missing unit is not reported
+ * through 'error', since callers may look for it in several objects.
+ * The signature hash is built on first use, under the lock.
+ */
+int
+_dwarf_split_find_unit(Dwarf_Debug dbg, uint64_t sig, int is_tu,
+    Dwarf_CU *ret_cu, Dwarf_Error *error)
+{
+	int ret;
+
+	DWARF_LOCK(dbg);
+	ret = _dwarf_split_lookup(dbg, sig, is_tu, ret_cu, error);
+	DWARF_UNLOCK(dbg);
+
+	return (ret);
+}
+
+/*
+ * Complete the table bases of a unit once the attributes of its CU DIE
+ * are known.  Offsets within a .dwp package are relative to the unit's
+ * contributions.  A split compilation unit takes its address table base
+ * and its base address from its skeleton unit in the tied object.
+ */
+int
+_dwarf_split_bases_init(Dwarf_CU cu, Dwarf_Error *error)
+{
+	Dwarf_Debug tied;
+	Dwarf_CU skel;
+	int ret;
+
+	if (cu->cu_dwp_index != NULL) {
+		cu->cu_str_offsets_base += cu->cu_dwp_off[DW_SECT_STR_OFFSETS];
+		if (cu->cu_dwp_index->ui_version == 5) {
+			cu->cu_loclists_base +=
+			    cu->cu_dwp_off[DW_SECT_LOCLISTS];
+			cu->cu_rnglists_base +=
+			    cu->cu_dwp_off[DW_SECT_RNGLISTS];
+		}
+	}
+
+	if (!cu->cu_is_split || cu->cu_unit_type == DW_UT_split_type ||
+	    (tied = cu->cu_dbg->dbg_tied) == NULL)
+		return (DW_DLE_NONE);
+
+	ret = _dwarf_split_find_unit(tied, cu->cu_dwo_id, 0, &skel, error);
+	if (ret == DW_DLE_NO_ENTRY)
+		return (DW_DLE_NONE);
+	else if (ret != DW_DLE_NONE)
+		return (ret);
+
+	if ((ret = _dwarf_cu_bases_init(skel, NULL, error)) != DW_DLE_NONE)
+		return (ret);
+
+	cu->cu_skel = skel;
+	cu->cu_addr_base = skel->cu_addr_base;
+	cu->cu_lowpc = skel->cu_lowpc;
+
+	return (DW_DLE_NONE);
+}
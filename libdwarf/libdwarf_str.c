@@ -29,16 +29,127 @@
 ELFTC_VCSID("$Id$");
 
 #define	_INIT_DWARF_STRTAB_SIZE 1024
+#define	_INIT_DWARF_STRHASH_SIZE 256
+
+/*
+ * Strings added to the string table are interned in an open addressing
+ * hash, so that each distinct string is stored once.  The hash value
+ * is computed from the last character backwards: this gives the hash
+ * values of all the suffixes of a string in one pass, which is used to
+ * also intern the suffixes when tail merging is enabled.
+ */
+static uint32_t
+_dwarf_strtab_hash(const char *string, size_t len)
+{
+	uint32_t h;
+
+	for (h = 5381; len > 0; len--)
+		h = h * 33 + (unsigned char) string[len - 1];
+
+	return (h);
+}
+
+static struct _Dwarf_StrSlot *
+_dwarf_strtab_slot(Dwarf_Debug dbg, const char *string, uint32_t hash)
+{
+	struct _Dwarf_StrSlot *ss;
+	Dwarf_Unsigned i, mask;
+
+	mask = dbg->dbg_strhash_size - 1;
+	for (i = hash & mask;; i = (i + 1) & mask) {
+		ss = &dbg->dbg_strhash[i];
+		if (ss->ss_off == 0)
+			return (ss);
+		if (ss->ss_hash == hash &&
+		    !strcmp(&dbg->dbg_strtab[ss->ss_off - 1], string))
+			return (ss);
+	}
+}
+
+static int
+_dwarf_strtab_hash_grow(Dwarf_Debug dbg, Dwarf_Error *error)
+{
+	struct _Dwarf_StrSlot *oss, *ss;
+	Dwarf_Unsigned i, j, osize, mask;
+
+	oss = dbg->dbg_strhash;
+	osize = dbg->dbg_strhash_size;
+	dbg->dbg_strhash_size = osize > 0 ? osize * 2 :
+	    _INIT_DWARF_STRHASH_SIZE;
+	if ((dbg->dbg_strhash = calloc(dbg->dbg_strhash_size,
+	    sizeof(struct _Dwarf_StrSlot))) == NULL) {
+		dbg->dbg_strhash = oss;
+		dbg->dbg_strhash_size = osize;
+		DWARF_SET_ERROR(dbg, error, DW_DLE_MEMORY);
+		return (DW_DLE_MEMORY);
+	}
+
+	/* The strings are distinct, only free slots need to be found. */
+	mask = dbg->dbg_strhash_size - 1;
+	for (i = 0; i < osize; i++) {
+		if (oss[i].ss_off == 0)
+			continue;
+		for (j = oss[i].ss_hash & mask;; j = (j + 1) & mask) {
+			ss = &dbg->dbg_strhash[j];
+			if (ss->ss_off == 0) {
+				*ss = oss[i];
+				break;
+			}
+		}
+	}
+	free(oss);
+
+	return (DW_DLE_NONE);
+}
+
+static int
+_dwarf_strtab_intern(Dwarf_Debug dbg, uint64_t off, uint32_t hash,
+    Dwarf_Error *error)
+{
+	struct _Dwarf_StrSlot *ss;
+	int ret;
+
+	/* Keep the load factor at or below one half. */
+	if ((dbg->dbg_strhash_cnt + 1) * 2 > dbg->dbg_strhash_size &&
+	    (ret = _dwarf_strtab_hash_grow(dbg, error)) != DW_DLE_NONE)
+		return (ret);
+
+	ss = _dwarf_strtab_slot(dbg, &dbg->dbg_strtab[off], hash);
+	if (ss->ss_off == 0) {
+		ss->ss_off = off + 1;
+		ss->ss_hash = hash;
+		dbg->dbg_strhash_cnt++;
+	}
+
+	return (DW_DLE_NONE);
+}
 
 int
 _dwarf_strtab_add(Dwarf_Debug dbg, char *string, uint64_t *off,
     Dwarf_Error *error)
 {
-	size_t len;
+	struct _Dwarf_StrSlot *ss;
+	uint64_t soff;
+	uint32_t hash;
+	size_t len, i;
+	int ret;
 
 	assert(dbg != NULL && string != NULL);
 
-	len = strlen(string) + 1;
+	len = strlen(string);
+	hash = _dwarf_strtab_hash(string, len);
+
+	/* Reuse an identical string, or a string it is the tail of. */
+	if (dbg->dbg_strhash != NULL) {
+		ss = _dwarf_strtab_slot(dbg, string, hash);
+		if (ss->ss_off != 0) {
+			if (off != NULL)
+				*off = ss->ss_off - 1;
+			return (DW_DLE_NONE);
+		}
+	}
+
+	len++;
 	while (dbg->dbg_strtab_size + len > dbg->dbg_strtab_cap) {
 		dbg->dbg_strtab_cap *= 2;
 		dbg->dbg_strtab = realloc(dbg->dbg_strtab,
@@ -49,13 +160,28 @@ _dwarf_strtab_add(Dwarf_Debug dbg, char *string, uint64_t *off,
 		}
 	}
 
+	soff = dbg->dbg_strtab_size;
 	if (off != NULL)
-		*off = dbg->dbg_strtab_size;
+		*off = soff;
 
 	strncpy(&dbg->dbg_strtab[dbg->dbg_strtab_size], string, len - 1);
 	dbg->dbg_strtab_size += len;
 	dbg->dbg_strtab[dbg->dbg_strtab_size - 1] = '\0';
 
+	if ((dbg->dbgp_flags & DW_DLC_STRING_TAIL_MERGE) == 0)
+		return (_dwarf_strtab_intern(dbg, soff, hash, error));
+
+	/* Intern every suffix of the string, the string itself last. */
+	hash = 5381;
+	for (i = len - 1;; i--) {
+		ret = _dwarf_strtab_intern(dbg, soff + i, hash, error);
+		if (ret != DW_DLE_NONE)
+			return (ret);
+		if (i == 0)
+			break;
+		hash = hash * 33 + (unsigned char) string[i - 1];
+	}
+
 	return (DW_DLE_NONE);
 }
 
@@ -72,11 +198,14 @@ int
 _dwarf_strtab_init(Dwarf_Debug dbg, Dwarf_Error *error)
 {
 	Dwarf_Section *ds;
+	int ret;
 
 	assert(dbg != NULL);
 
 	if (dbg->dbg_mode == DW_DLC_READ || dbg->dbg_mode == DW_DLC_RDWR) {
-		ds = _dwarf_find_section(dbg, ".debug_str");
+		ret = _dwarf_find_section(dbg, ".debug_str", &ds, error);
+		if (ret != DW_DLE_NONE)
+			return (ret);
 		if (ds == NULL) {
 			dbg->dbg_strtab = NULL;
 			dbg->dbg_strtab_cap = dbg->dbg_strtab_size = 0;
@@ -120,6 +249,7 @@ _dwarf_strtab_cleanup(Dwarf_Debug dbg)
 
 	if (dbg->dbg_mode == DW_DLC_RDWR || dbg->dbg_mode == DW_DLC_WRITE)
 		free(dbg->dbg_strtab);
+	free(dbg->dbg_strhash);
 }
 
 int
@@ -23,6 +23,13 @@ _LDADD_LIBDWARF=${LDADD:M-ldwarf}
 .if !empty(_LDADD_LIBDWARF)
 CFLAGS+= -I${TOP}/libdwarf
 LDFLAGS+= -L${TOP}/libdwarf
+# libdwarf decompresses compressed debug sections.
+LDADD+= -lz
+# libdwarf serializes access to a debug context shared by threads.
+LDADD+= -lpthread
+.if defined(LIBDWARF_ZSTD)
+LDADD+= -lzstd
+.endif
 .endif
 
 _LDADD_LIBELF=${LDADD:M-lelf}
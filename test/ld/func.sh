@@ -0,0 +1,179 @@
+# $Id$
+#
+# `init' initializes test engine global data.
+#
+# The input objects of the tests are assembled from x86-64 assembly
+# sources with the host C compiler and archived with the host ar(1),
+# which can be overridden with the CC and AR environment variables.
+#
+init() {
+    THISDIR=`/bin/pwd`
+    TOPDIR=${THISDIR}/../..
+    LD=${TOPDIR}/ld/ld
+    NM=${TOPDIR}/nm/nm
+    BUILDID=${THISDIR}/plugin/buildid
+    GNUHASH=${THISDIR}/plugin/gnuhash
+    GDBINDEX=${THISDIR}/plugin/gdbindex
+    AR=${AR:-ar}
+    CC=${CC:-cc}
+
+    # keep a record of total tests and number of tests passed.
+    TOTALCT=/tmp/ld-test-total
+    PASSEDCT=/tmp/ld-test-passed
+    echo 0 > ${TOTALCT}
+    echo 0 > ${PASSEDCT}
+}
+
+# `inittest' initializes individual test process. (set up temp dirs,
+# make copies of files used in the test if necessary, etc.)
+#
+inittest() {
+    if [ $# -ne 2 ]; then
+	echo "usage: inittest tcname tcdir"
+	exit 1
+    fi
+
+    TC=$1
+    TCDIR=$2
+    TESTDIR=/tmp/${TC}
+    OUTDIR=/tmp/${TC}-out
+    RLTDIR=/tmp/${TC}-rlt
+    rm -rf ${TESTDIR}
+    rm -rf ${OUTDIR}
+    rm -rf ${RLTDIR}
+    mkdir -p ${TESTDIR} || exit 1
+    mkdir -p ${OUTDIR} || exit 1
+    mkdir -p ${RLTDIR} || exit 1
+
+    if [ -d "${TCDIR}/in" ]; then
+	cp -R ${TCDIR}/in/* ${TESTDIR} || exit 1
+    fi
+
+    if [ -d "${TCDIR}/out" ]; then
+	cp -R ${TCDIR}/out/* ${RLTDIR} || exit 1
+    fi
+}
+
+# `assemble' assembles every assembly source in the work dir.
+#
+assemble() {
+    cd ${TESTDIR} || exit 1
+    for f in *.s; do
+	${CC} -c $f -o `basename $f .s`.o || exit 1
+    done
+    cd ${THISDIR}
+}
+
+# `runcmd' runs the shell command `cmd' in the work dir.
+#
+# cmd: command to execute
+# rec: true (keep a record of the stdout, stderr and exit value)
+#      false (do not record)
+#
+runcmd() {
+    if [ $# -ne 2 ]; then
+	echo "usage: runcmd cmd rec"
+	exit 1
+    fi
+
+    cd ${TESTDIR} || exit 1
+
+    if [ "$2" = true ]; then
+	/bin/sh -c "$1" > ${OUTDIR}/${TC}.out 2> ${OUTDIR}/${TC}.err
+	echo $? > ${OUTDIR}/${TC}.eval
+    elif [ "$2" = false ]; then
+	/bin/sh -c "$1"
+    else
+	echo "rec must be true or false."
+	exit 1
+    fi
+
+    cd ${THISDIR}
+}
+
+# `rundiff' performs standard diff to compare exit value,
+# stdout output, stderr output and resulting files with
+# "standard answers".
+#
+rundiff() {
+    # $1 indicates whether we should compare resulting files.
+    if [ $# -ne 1 ]; then
+	echo "usage: rundiff [true|false]"
+	exit 1
+    fi
+    cd ${THISDIR} || exit 1
+    if [ -f ${TCDIR}/${TC}.eval ]; then
+	incct ${TOTALCT}
+	diff -urN ${TCDIR}/${TC}.eval ${OUTDIR}/${TC}.eval
+	if [ $? -eq 0 ]; then
+	    echo "${TC} exit value - ok"
+	    incct ${PASSEDCT}
+	else
+	    echo "${TC} exit value - not ok"
+	fi
+    fi
+
+    if [ -f ${TCDIR}/${TC}.out ]; then
+	incct ${TOTALCT}
+	diff -urN ${TCDIR}/${TC}.out ${OUTDIR}/${TC}.out
+	if [ $? -eq 0 ]; then
+	    echo "${TC} stdout - ok"
+	    incct ${PASSEDCT}
+	else
+	    echo "${TC} stdout - not ok"
+	fi
+    fi
+
+    if [ -f ${TCDIR}/${TC}.err ]; then
+	incct ${TOTALCT}
+	diff -urN ${TCDIR}/${TC}.err ${OUTDIR}/${TC}.err
+	if [ $? -eq 0 ]; then
+	    echo "${TC} stderr - ok"
+	    incct ${PASSEDCT}
+	else
+	    echo "${TC} stderr - not ok"
+	fi
+    fi
+
+    if [ "$1" = true ]; then
+	incct ${TOTALCT}
+	diff -urN ${RLTDIR} ${TESTDIR}
+	if [ $? -eq 0 ]; then
+	    echo "${TC} resulting files - ok"
+	    incct ${PASSEDCT}
+	else
+	    echo "${TC} resulting files - not ok"
+	fi
+    fi
+}
+
+# `innct' increase specified counter by 1.
+incct() {
+    if [ $# -ne 1 ]; then
+	echo "usage: incct counterfile"
+	exit 1
+    fi
+    if [ -f $1 ]; then
+	exec 3< $1
+	read val <&3
+	exec 3<&-
+	newval=`expr ${val} + 1`
+	echo ${newval} > $1
+    else
+	echo "$1 not exist"
+	exit 1
+    fi
+}
+
+# `statistic' shows number of test passed.
+#
+statistic() {
+    exec 3< ${TOTALCT}
+    read tval <&3
+    exec 3<&-
+    exec 3< ${PASSEDCT}
+    read pval <&3
+    exec 3<&-
+
+    echo "${pval} out of ${tval} passed."
+}
@@ -0,0 +1,118 @@
+/*
+ * Print the GNU build ID note of an object.
+ *
+ * Usage:
+ *	buildid [-n] file
+ *
+ * The section holding the note, the size of the build ID and, unless
+ * -n is given, the build ID itself are printed. Every SHT_NOTE section
+ * is searched, so the note is found regardless of its section name.
+ *
+ * $Id$
+ */
+
+#include <err.h>
+#include <fcntl.h>
+#include <gelf.h>
+#include <libelf.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define	NOTE_ALIGN(n)	(((n) + 3) & ~(size_t) 3)
+
+static void	usage(void);
+
+int
+main(int argc, char **argv)
+{
+	Elf *e;
+	Elf_Scn *scn;
+	Elf_Data *d;
+	Elf_Note note;
+	GElf_Ehdr eh;
+	GElf_Shdr sh;
+	const unsigned char *p, *desc;
+	const char *name;
+	size_t off, i;
+	int fd, nflag, ch, found;
+
+	nflag = 0;
+	while ((ch = getopt(argc, argv, "n")) != -1) {
+		switch (ch) {
+		case 'n':
+			nflag = 1;
+			break;
+		default:
+			usage();
+		}
+	}
+	argc -= optind;
+	argv += optind;
+	if (argc != 1)
+		usage();
+
+	if (elf_version(EV_CURRENT) == EV_NONE)
+		errx(EXIT_FAILURE, "elf_version: %s", elf_errmsg(-1));
+	if ((fd = open(argv[0], O_RDONLY)) < 0)
+		err(EXIT_FAILURE, "open %s", argv[0]);
+	if ((e = elf_begin(fd, ELF_C_READ, NULL)) == NULL)
+		errx(EXIT_FAILURE, "elf_begin: %s", elf_errmsg(-1));
+	if (gelf_getehdr(e, &eh) == NULL)
+		errx(EXIT_FAILURE, "gelf_getehdr: %s", elf_errmsg(-1));
+
+	found = 0;
+	scn = NULL;
+	while ((scn = elf_nextscn(e, scn)) != NULL) {
+		if (gelf_getshdr(scn, &sh) == NULL)
+			errx(EXIT_FAILURE, "gelf_getshdr: %s", elf_errmsg(-1));
+		if (sh.sh_type != SHT_NOTE)
+			continue;
+		if ((d = elf_getdata(scn, NULL)) == NULL)
+			errx(EXIT_FAILURE, "elf_getdata: %s", elf_errmsg(-1));
+		p = d->d_buf;
+		off = 0;
+		while (off + sizeof(note) <= d->d_size) {
+			memcpy(&note, p + off, sizeof(note));
+			off += sizeof(note);
+			if (off + NOTE_ALIGN(note.n_namesz) +
+			    NOTE_ALIGN(note.n_descsz) > d->d_size)
+				errx(EXIT_FAILURE, "truncated note");
+			name = (const char *) p + off;
+			desc = p + off + NOTE_ALIGN(note.n_namesz);
+			off += NOTE_ALIGN(note.n_namesz) +
+			    NOTE_ALIGN(note.n_descsz);
+			if (note.n_type != NT_GNU_BUILD_ID ||
+			    note.n_namesz != 4 || strcmp(name, "GNU") != 0)
+				continue;
+			printf("section: %s\n", elf_strptr(e, eh.e_shstrndx,
+			    sh.sh_name));
+			printf("size: %u\n", note.n_descsz);
+			if (!nflag) {
+				printf("id: ");
+				for (i = 0; i < note.n_descsz; i++)
+					printf("%02x", desc[i]);
+				printf("\n");
+			}
+			found++;
+		}
+	}
+
+	if (!found)
+		printf("no build ID note\n");
+
+	(void) elf_end(e);
+	(void) close(fd);
+
+	exit(EXIT_SUCCESS);
+}
+
+static void
+usage(void)
+{
+
+	fprintf(stderr, "usage: buildid [-n] file\n");
+	exit(EXIT_FAILURE);
+}
@@ -0,0 +1,373 @@
+/*
+ * Check the .gdb_index section of a linked object.
+ *
+ * Usage:
+ *	gdbindex file
+ *
+ * The CU list, the address area and every symbol of the index are
+ * printed, the symbols sorted by name. The CU list is checked against
+ * the unit headers in .debug_info, each address range must lie in an
+ * allocated section, and each symbol is looked up through the symbol
+ * hash table the same way a debugger does. The exit status is 0 if no
+ * error was found.
+ *
+ * $Id$
+ */
+
+#include <err.h>
+#include <fcntl.h>
+#include <gelf.h>
+#include <libelf.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define	INDEX_VERSION	7
+#define	INDEX_HDR_SIZE	24
+
+struct sym {
+	const char	*name;
+	const unsigned char *vec;
+	uint32_t	veclen;
+};
+
+static int	nerr;
+
+static void	check_cus(Elf_Scn *info, const unsigned char *p,
+    uint32_t ncu, int msb);
+static void	check_addrs(Elf *e, const unsigned char *p, uint32_t naddr,
+    uint32_t ncu);
+static void	check_syms(const unsigned char *p, uint32_t nslot,
+    const unsigned char *pool, uint32_t poolsize, uint32_t ncu);
+static int	cmp_sym(const void *a, const void *b);
+static void	error(const char *fmt, ...)
+    __attribute__((__format__(__printf__, 1, 2)));
+static uint32_t	index_hash(const char *name);
+static uint64_t	rd(const unsigned char *p, int sz, int msb);
+
+int
+main(int argc, char **argv)
+{
+	Elf *e;
+	Elf_Scn *scn, *index, *info;
+	Elf_Data *d;
+	GElf_Ehdr eh;
+	GElf_Shdr sh;
+	const unsigned char *p;
+	const char *name;
+	size_t shstrndx;
+	uint32_t version, cu_off, tu_off, addr_off, sym_off, pool_off;
+	int fd;
+
+	if (argc != 2) {
+		fprintf(stderr, "usage: gdbindex file\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (elf_version(EV_CURRENT) == EV_NONE)
+		errx(EXIT_FAILURE, "elf_version: %s", elf_errmsg(-1));
+	if ((fd = open(argv[1], O_RDONLY)) < 0)
+		err(EXIT_FAILURE, "open %s", argv[1]);
+	if ((e = elf_begin(fd, ELF_C_READ, NULL)) == NULL)
+		errx(EXIT_FAILURE, "elf_begin: %s", elf_errmsg(-1));
+	if (gelf_getehdr(e, &eh) == NULL)
+		errx(EXIT_FAILURE, "gelf_getehdr: %s", elf_errmsg(-1));
+	if (elf_getshdrstrndx(e, &shstrndx) != 0)
+		errx(EXIT_FAILURE, "elf_getshdrstrndx: %s", elf_errmsg(-1));
+
+	index = info = NULL;
+	scn = NULL;
+	while ((scn = elf_nextscn(e, scn)) != NULL) {
+		if (gelf_getshdr(scn, &sh) == NULL)
+			errx(EXIT_FAILURE, "gelf_getshdr: %s", elf_errmsg(-1));
+		if ((name = elf_strptr(e, shstrndx, sh.sh_name)) == NULL)
+			continue;
+		if (strcmp(name, ".gdb_index") == 0)
+			index = scn;
+		else if (strcmp(name, ".debug_info") == 0)
+			info = scn;
+	}
+
+	if (index == NULL) {
+		printf("no .gdb_index section\n");
+		goto done;
+	}
+	if (info == NULL)
+		error("no .debug_info section");
+
+	if ((d = elf_rawdata(index, NULL)) == NULL)
+		errx(EXIT_FAILURE, "elf_rawdata: %s", elf_errmsg(-1));
+	if (d->d_size < INDEX_HDR_SIZE) {
+		error(".gdb_index is too small");
+		goto done;
+	}
+
+	/* All fields of the index are little-endian. */
+	p = d->d_buf;
+	version = rd(p, 4, 0);
+	cu_off = rd(p + 4, 4, 0);
+	tu_off = rd(p + 8, 4, 0);
+	addr_off = rd(p + 12, 4, 0);
+	sym_off = rd(p + 16, 4, 0);
+	pool_off = rd(p + 20, 4, 0);
+	printf("version: %u\n", version);
+	if (version != INDEX_VERSION || cu_off != INDEX_HDR_SIZE ||
+	    tu_off < cu_off || addr_off < tu_off || sym_off < addr_off ||
+	    pool_off < sym_off || pool_off > d->d_size ||
+	    (tu_off - cu_off) % 16 != 0 || (addr_off - tu_off) % 24 != 0 ||
+	    (sym_off - addr_off) % 20 != 0 || (pool_off - sym_off) % 8 != 0) {
+		error("bad .gdb_index header");
+		goto done;
+	}
+	printf("type units: %u\n", (addr_off - tu_off) / 24);
+
+	if (info != NULL)
+		check_cus(info, p + cu_off, (tu_off - cu_off) / 16,
+		    eh.e_ident[EI_DATA] == ELFDATA2MSB);
+	check_addrs(e, p + addr_off, (sym_off - addr_off) / 20,
+	    (tu_off - cu_off) / 16);
+	check_syms(p + sym_off, (pool_off - sym_off) / 8, p + pool_off,
+	    d->d_size - pool_off, (tu_off - cu_off) / 16);
+
+done:
+	printf("%d error(s)\n", nerr);
+
+	(void) elf_end(e);
+	(void) close(fd);
+
+	exit(nerr == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+static void
+check_cus(Elf_Scn *info, const unsigned char *p, uint32_t ncu, int msb)
+{
+	Elf_Data *d;
+	uint64_t off, len, unit_off, unit_len;
+	uint32_t i;
+	int hdr;
+
+	if ((d = elf_rawdata(info, NULL)) == NULL)
+		errx(EXIT_FAILURE, "elf_rawdata: %s", elf_errmsg(-1));
+
+	/* The CU list must name every unit of .debug_info, in order. */
+	unit_off = 0;
+	for (i = 0; i < ncu; i++, p += 16) {
+		off = rd(p, 8, 0);
+		len = rd(p + 8, 8, 0);
+		printf("cu %u: offset %#jx length %#jx\n", i, (uintmax_t) off,
+		    (uintmax_t) len);
+		if (unit_off + 4 > d->d_size) {
+			error("cu %u is beyond .debug_info", i);
+			return;
+		}
+		unit_len = rd((unsigned char *) d->d_buf + unit_off, 4, msb);
+		hdr = 4;
+		if (unit_len == 0xffffffff) {
+			if (unit_off + 12 > d->d_size) {
+				error("cu %u is beyond .debug_info", i);
+				return;
+			}
+			unit_len = rd((unsigned char *) d->d_buf + unit_off + 4,
+			    8, msb);
+			hdr = 12;
+		}
+		if (off != unit_off || len != unit_len + hdr)
+			error("cu %u does not match the unit at %#jx", i,
+			    (uintmax_t) unit_off);
+		unit_off += unit_len + hdr;
+	}
+	if (unit_off != d->d_size)
+		error("units of .debug_info are missing from the CU list");
+}
+
+static void
+check_addrs(Elf *e, const unsigned char *p, uint32_t naddr, uint32_t ncu)
+{
+	Elf_Scn *scn;
+	GElf_Shdr sh;
+	uint64_t lo, hi;
+	uint32_t i, cu;
+	int found;
+
+	for (i = 0; i < naddr; i++, p += 20) {
+		lo = rd(p, 8, 0);
+		hi = rd(p + 8, 8, 0);
+		cu = rd(p + 16, 4, 0);
+		printf("address %#jx-%#jx: cu %u\n", (uintmax_t) lo,
+		    (uintmax_t) hi, cu);
+		if (lo >= hi)
+			error("empty address range %#jx-%#jx",
+			    (uintmax_t) lo, (uintmax_t) hi);
+		if (cu >= ncu)
+			error("address range of cu %u out of the CU list", cu);
+
+		/* The range must be the address of allocated code or data. */
+		found = 0;
+		scn = NULL;
+		while (!found && (scn = elf_nextscn(e, scn)) != NULL) {
+			if (gelf_getshdr(scn, &sh) == NULL)
+				errx(EXIT_FAILURE, "gelf_getshdr: %s",
+				    elf_errmsg(-1));
+			found = (sh.sh_flags & SHF_ALLOC) != 0 &&
+			    lo >= sh.sh_addr && hi <= sh.sh_addr + sh.sh_size;
+		}
+		if (!found)
+			error("address range %#jx-%#jx is not in a section",
+			    (uintmax_t) lo, (uintmax_t) hi);
+	}
+}
+
+static void
+check_syms(const unsigned char *p, uint32_t nslot, const unsigned char *pool,
+    uint32_t poolsize, uint32_t ncu)
+{
+	struct sym *syms;
+	const unsigned char *s;
+	uint32_t nameoff, vecoff, h, i, j, k, step, nsym, v;
+
+	if (nslot == 0 || (nslot & (nslot - 1)) != 0) {
+		error("symbol table size %u is not a power of 2", nslot);
+		return;
+	}
+	if ((syms = calloc(nslot, sizeof(*syms))) == NULL)
+		err(EXIT_FAILURE, "calloc");
+
+	nsym = 0;
+	for (i = 0; i < nslot; i++) {
+		s = p + i * 8;
+		nameoff = rd(s, 4, 0);
+		vecoff = rd(s + 4, 4, 0);
+		if (nameoff == 0 && vecoff == 0)
+			continue;
+		if (nameoff >= poolsize || vecoff + 4 > poolsize ||
+		    strnlen((const char *) pool + nameoff,
+		    poolsize - nameoff) == poolsize - nameoff) {
+			error("slot %u is out of the constant pool", i);
+			continue;
+		}
+		syms[nsym].name = (const char *) pool + nameoff;
+		syms[nsym].veclen = rd(pool + vecoff, 4, 0);
+		syms[nsym].vec = pool + vecoff + 4;
+		if (vecoff + 4 + (uint64_t) syms[nsym].veclen * 4 > poolsize) {
+			error("CU vector of %s is out of the constant pool",
+			    syms[nsym].name);
+			continue;
+		}
+
+		/* Probe for the name the same way a debugger does. */
+		h = index_hash(syms[nsym].name);
+		j = h & (nslot - 1);
+		step = ((h * 17) & (nslot - 1)) | 1;
+		for (k = 0; k < nslot; k++) {
+			s = p + j * 8;
+			nameoff = rd(s, 4, 0);
+			if ((nameoff == 0 && rd(s + 4, 4, 0) == 0) ||
+			    (nameoff < poolsize && strncmp((const char *) pool +
+			    nameoff, syms[nsym].name, poolsize - nameoff) == 0))
+				break;
+			j = (j + step) & (nslot - 1);
+		}
+		if (j != i)
+			error("symbol %s is not found through the hash table",
+			    syms[nsym].name);
+		nsym++;
+	}
+
+	qsort(syms, nsym, sizeof(*syms), cmp_sym);
+	for (i = 0; i < nsym; i++) {
+		if (i > 0 && strcmp(syms[i - 1].name, syms[i].name) == 0)
+			error("symbol %s is in the index twice", syms[i].name);
+		if (syms[i].veclen == 0)
+			error("symbol %s has no CU", syms[i].name);
+		printf("%s:", syms[i].name);
+		for (j = 0; j < syms[i].veclen; j++) {
+			v = rd(syms[i].vec + j * 4, 4, 0);
+			printf("%s cu %u", j > 0 ? "," : "", v & 0xffffff);
+			switch ((v >> 28) & 7) {
+			case 1:
+				printf(" type");
+				break;
+			case 2:
+				printf(" variable");
+				break;
+			case 3:
+				printf(" function");
+				break;
+			default:
+				printf(" kind %u", (v >> 28) & 7);
+				break;
+			}
+			printf("%s", (v >> 31) ? " static" : " global");
+			if ((v & 0xffffff) >= ncu)
+				error("CU of %s out of the CU list",
+				    syms[i].name);
+		}
+		printf("\n");
+	}
+
+	free(syms);
+}
+
+static int
+cmp_sym(const void *a, const void *b)
+{
+	const struct sym *s1, *s2;
+
+	s1 = a;
+	s2 = b;
+
+	return (strcmp(s1->name, s2->name));
+}
+
+static void
+error(const char *fmt, ...)
+{
+	va_list ap;
+
+	printf("error: ");
+	va_start(ap, fmt);
+	vprintf(fmt, ap);
+	va_end(ap);
+	printf("\n");
+	nerr++;
+}
+
+/*
+ * The symbol hash function of index version 5 and later.
+ */
+static uint32_t
+index_hash(const char *name)
+{
+	const unsigned char *p;
+	uint32_t c, h;
+
+	h = 0;
+	for (p = (const unsigned char *) name; *p != '\0'; p++) {
+		c = *p;
+		if (c >= 'A' && c <= 'Z')
+			c = c - 'A' + 'a';
+		h = h * 67 + c - 113;
+	}
+
+	return (h);
+}
+
+static uint64_t
+rd(const unsigned char *p, int sz, int msb)
+{
+	uint64_t v;
+	int i;
+
+	v = 0;
+	for (i = 0; i < sz; i++) {
+		if (msb)
+			v = (v << 8) | p[i];
+		else
+			v |= (uint64_t) p[i] << (8 * i);
+	}
+
+	return (v);
+}
@@ -0,0 +1,331 @@
+/*
+ * Check the .gnu.hash (and .hash, if present) section of a dynamically
+ * linked object.
+ *
+ * Usage:
+ *	gnuhash file
+ *
+ * The section header fields and every symbol covered by the hash table
+ * are printed. Each covered symbol is looked up through the Bloom
+ * filter, the hash buckets and the hash chains the same way a runtime
+ * linker does, and the structure of the buckets and chains is checked.
+ * The exit status is 0 if no error was found.
+ *
+ * $Id$
+ */
+
+#include <err.h>
+#include <fcntl.h>
+#include <gelf.h>
+#include <libelf.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static int	nerr;
+
+static uint32_t	gnu_hash(const char *name);
+static uint64_t	rd(const unsigned char *p, int sz, int msb);
+static void	check_gnu_hash(Elf *e, Elf_Scn *scn, GElf_Shdr *sh, int msb,
+    int ec);
+static void	check_sysv_hash(Elf *e, Elf_Scn *scn, GElf_Shdr *sh, int msb);
+static void	error(const char *fmt, ...)
+    __attribute__((__format__(__printf__, 1, 2)));
+
+int
+main(int argc, char **argv)
+{
+	Elf *e;
+	Elf_Scn *scn, *gnu, *sysv;
+	GElf_Ehdr eh;
+	GElf_Shdr sh, gnush, sysvsh;
+	int fd;
+
+	if (argc != 2) {
+		fprintf(stderr, "usage: gnuhash file\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (elf_version(EV_CURRENT) == EV_NONE)
+		errx(EXIT_FAILURE, "elf_version: %s", elf_errmsg(-1));
+	if ((fd = open(argv[1], O_RDONLY)) < 0)
+		err(EXIT_FAILURE, "open %s", argv[1]);
+	if ((e = elf_begin(fd, ELF_C_READ, NULL)) == NULL)
+		errx(EXIT_FAILURE, "elf_begin: %s", elf_errmsg(-1));
+	if (gelf_getehdr(e, &eh) == NULL)
+		errx(EXIT_FAILURE, "gelf_getehdr: %s", elf_errmsg(-1));
+
+	gnu = sysv = NULL;
+	scn = NULL;
+	while ((scn = elf_nextscn(e, scn)) != NULL) {
+		if (gelf_getshdr(scn, &sh) == NULL)
+			errx(EXIT_FAILURE, "gelf_getshdr: %s", elf_errmsg(-1));
+		if (sh.sh_type == SHT_GNU_HASH) {
+			gnu = scn;
+			gnush = sh;
+		} else if (sh.sh_type == SHT_HASH) {
+			sysv = scn;
+			sysvsh = sh;
+		}
+	}
+
+	if (gnu == NULL)
+		printf("no .gnu.hash section\n");
+	else
+		check_gnu_hash(e, gnu, &gnush,
+		    eh.e_ident[EI_DATA] == ELFDATA2MSB,
+		    eh.e_ident[EI_CLASS]);
+
+	if (sysv == NULL)
+		printf("no .hash section\n");
+	else
+		check_sysv_hash(e, sysv, &sysvsh,
+		    eh.e_ident[EI_DATA] == ELFDATA2MSB);
+
+	printf("%d error(s)\n", nerr);
+
+	(void) elf_end(e);
+	(void) close(fd);
+
+	exit(nerr == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+static void
+check_gnu_hash(Elf *e, Elf_Scn *scn, GElf_Shdr *sh, int msb, int ec)
+{
+	Elf_Scn *symscn;
+	Elf_Data *d, *symd;
+	GElf_Shdr symsh;
+	GElf_Sym sym;
+	const unsigned char *p, *bloom, *buckets, *chains;
+	const char *name;
+	uint32_t nbuckets, symoffset, maskwords, shift2, h, b, prevb, idx;
+	uint32_t nsyms, i, c;
+	uint64_t word, wbits;
+	int wsz, found;
+
+	if ((d = elf_rawdata(scn, NULL)) == NULL)
+		errx(EXIT_FAILURE, "elf_rawdata: %s", elf_errmsg(-1));
+	if ((symscn = elf_getscn(e, sh->sh_link)) == NULL ||
+	    gelf_getshdr(symscn, &symsh) == NULL ||
+	    (symd = elf_getdata(symscn, NULL)) == NULL)
+		errx(EXIT_FAILURE, "can not read .dynsym: %s", elf_errmsg(-1));
+	if (symsh.sh_type != SHT_DYNSYM)
+		error("sh_link of .gnu.hash is not .dynsym");
+	nsyms = symsh.sh_size / symsh.sh_entsize;
+
+	if (d->d_size < 16) {
+		error(".gnu.hash is too small");
+		return;
+	}
+	p = d->d_buf;
+	nbuckets = rd(p, 4, msb);
+	symoffset = rd(p + 4, 4, msb);
+	maskwords = rd(p + 8, 4, msb);
+	shift2 = rd(p + 12, 4, msb);
+	printf("nbuckets: %u\n", nbuckets);
+	printf("symoffset: %u\n", symoffset);
+	printf("maskwords: %u\n", maskwords);
+	printf("shift2: %u\n", shift2);
+
+	wsz = ec == ELFCLASS32 ? 4 : 8;
+	wbits = wsz * 8;
+	if (nbuckets == 0 || maskwords == 0 ||
+	    (maskwords & (maskwords - 1)) != 0 || symoffset == 0 ||
+	    symoffset > nsyms) {
+		error("bad .gnu.hash header");
+		return;
+	}
+	if (d->d_size != 16 + (size_t) maskwords * wsz +
+	    ((size_t) nbuckets + nsyms - symoffset) * 4) {
+		error(".gnu.hash size does not match the header");
+		return;
+	}
+	bloom = p + 16;
+	buckets = bloom + (size_t) maskwords * wsz;
+	chains = buckets + (size_t) nbuckets * 4;
+
+	/* Symbols below symoffset must not be looked up. */
+	for (i = 1; i < symoffset; i++) {
+		if (gelf_getsym(symd, i, &sym) == NULL)
+			errx(EXIT_FAILURE, "gelf_getsym: %s", elf_errmsg(-1));
+		name = elf_strptr(e, symsh.sh_link, sym.st_name);
+		if (sym.st_shndx != SHN_UNDEF &&
+		    GELF_ST_BIND(sym.st_info) != STB_LOCAL)
+			error("defined symbol %s is not hashed", name);
+	}
+
+	/* Bucket values must point into the hashed part of .dynsym. */
+	for (b = 0; b < nbuckets; b++) {
+		idx = rd(buckets + b * 4, 4, msb);
+		if (idx != 0 && (idx < symoffset || idx >= nsyms))
+			error("bucket out of range in .gnu.hash");
+	}
+
+	prevb = 0;
+	for (i = symoffset; i < nsyms; i++) {
+		if (gelf_getsym(symd, i, &sym) == NULL)
+			errx(EXIT_FAILURE, "gelf_getsym: %s", elf_errmsg(-1));
+		name = elf_strptr(e, symsh.sh_link, sym.st_name);
+		if (name == NULL || *name == '\0') {
+			error("unnamed symbol in .gnu.hash");
+			continue;
+		}
+		if (sym.st_shndx == SHN_UNDEF)
+			error("undefined symbol %s is hashed", name);
+		h = gnu_hash(name);
+		b = h % nbuckets;
+		printf("%s: bucket %u\n", name, b);
+
+		/* Symbols in the same bucket must be contiguous. */
+		if (i > symoffset && b < prevb)
+			error("symbol %s is out of bucket order", name);
+		c = rd(chains + (i - symoffset) * 4, 4, msb);
+		if ((c & ~1U) != (h & ~1U))
+			error("bad chain value for %s", name);
+		if (i == nsyms - 1 && (c & 1) == 0)
+			error("chain of %s is not terminated", name);
+		prevb = b;
+
+		/* Bloom filter. */
+		word = rd(bloom + ((h / wbits) & (maskwords - 1)) * wsz, wsz,
+		    msb);
+		if ((word & (1ULL << (h % wbits))) == 0 ||
+		    (word & (1ULL << ((h >> shift2) % wbits))) == 0)
+			error("symbol %s is rejected by the Bloom filter",
+			    name);
+
+		/* Runtime linker lookup. */
+		found = 0;
+		idx = rd(buckets + b * 4, 4, msb);
+		if (idx != 0) {
+			for (;; idx++) {
+				c = rd(chains + (idx - symoffset) * 4, 4, msb);
+				if (idx == i && ((c ^ h) >> 1) == 0) {
+					found = 1;
+					break;
+				}
+				if ((c & 1) || idx == nsyms - 1)
+					break;
+			}
+		}
+		if (!found)
+			error("symbol %s is not found through the hash chain",
+			    name);
+	}
+
+	/* The last symbol of each bucket chain must be marked. */
+	for (i = symoffset; i + 1 < nsyms; i++) {
+		if (gelf_getsym(symd, i, &sym) == NULL ||
+		    (name = elf_strptr(e, symsh.sh_link, sym.st_name)) ==
+		    NULL)
+			continue;
+		b = gnu_hash(name) % nbuckets;
+		if (gelf_getsym(symd, i + 1, &sym) == NULL ||
+		    (name = elf_strptr(e, symsh.sh_link, sym.st_name)) ==
+		    NULL)
+			continue;
+		c = rd(chains + (i - symoffset) * 4, 4, msb);
+		if ((gnu_hash(name) % nbuckets != b) != ((c & 1) != 0))
+			error("bad end of chain marker before %s", name);
+	}
+}
+
+static void
+check_sysv_hash(Elf *e, Elf_Scn *scn, GElf_Shdr *sh, int msb)
+{
+	Elf_Scn *symscn;
+	Elf_Data *d, *symd;
+	GElf_Shdr symsh;
+	GElf_Sym sym, s;
+	const unsigned char *p;
+	const char *name, *n;
+	uint32_t nbuckets, nchains, i, idx, cnt;
+	int found;
+
+	if ((d = elf_rawdata(scn, NULL)) == NULL)
+		errx(EXIT_FAILURE, "elf_rawdata: %s", elf_errmsg(-1));
+	if ((symscn = elf_getscn(e, sh->sh_link)) == NULL ||
+	    gelf_getshdr(symscn, &symsh) == NULL ||
+	    (symd = elf_getdata(symscn, NULL)) == NULL)
+		errx(EXIT_FAILURE, "can not read .dynsym: %s", elf_errmsg(-1));
+
+	p = d->d_buf;
+	nbuckets = rd(p, 4, msb);
+	nchains = rd(p + 4, 4, msb);
+	if (nchains != symsh.sh_size / symsh.sh_entsize ||
+	    d->d_size != (2 + (size_t) nbuckets + nchains) * 4) {
+		error("bad .hash header");
+		return;
+	}
+
+	cnt = 0;
+	for (i = 1; i < nchains; i++) {
+		if (gelf_getsym(symd, i, &sym) == NULL)
+			errx(EXIT_FAILURE, "gelf_getsym: %s", elf_errmsg(-1));
+		name = elf_strptr(e, symsh.sh_link, sym.st_name);
+		if (name == NULL || *name == '\0')
+			continue;
+		found = 0;
+		idx = rd(p + (2 + elf_hash(name) % nbuckets) * 4, 4, msb);
+		while (idx != 0 && idx < nchains) {
+			if (gelf_getsym(symd, idx, &s) != NULL &&
+			    (n = elf_strptr(e, symsh.sh_link, s.st_name)) !=
+			    NULL && strcmp(n, name) == 0) {
+				found = idx == i;
+				break;
+			}
+			idx = rd(p + (2 + nbuckets + idx) * 4, 4, msb);
+		}
+		if (!found)
+			error("symbol %s is not found through .hash", name);
+		cnt++;
+	}
+	printf(".hash: %u symbols\n", cnt);
+}
+
+static void
+error(const char *fmt, ...)
+{
+	va_list ap;
+
+	printf("error: ");
+	va_start(ap, fmt);
+	vprintf(fmt, ap);
+	va_end(ap);
+	printf("\n");
+	nerr++;
+}
+
+static uint32_t
+gnu_hash(const char *name)
+{
+	const unsigned char *p;
+	uint32_t h;
+
+	h = 5381;
+	for (p = (const unsigned char *) name; *p != '\0'; p++)
+		h = h * 33 + *p;
+
+	return (h);
+}
+
+static uint64_t
+rd(const unsigned char *p, int sz, int msb)
+{
+	uint64_t v;
+	int i;
+
+	v = 0;
+	for (i = 0; i < sz; i++) {
+		if (msb)
+			v = (v << 8) | p[i];
+		else
+			v |= (uint64_t) p[i] << (8 * i);
+	}
+
+	return (v);
+}
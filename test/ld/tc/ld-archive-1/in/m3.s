@@ -0,0 +1,8 @@
+# $Id$
+
+	.text
+	.globl	z
+	.type	z, @function
+z:
+	ret
+	.size	z, .-z
@@ -0,0 +1,8 @@
+# $Id$
+
+	.text
+	.globl	c
+	.type	c, @function
+c:
+	ret
+	.size	c, .-c
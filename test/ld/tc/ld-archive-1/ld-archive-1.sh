@@ -0,0 +1,6 @@
+# $Id$
+inittest ld-archive-1 tc/ld-archive-1
+assemble
+runcmd "${AR} rc liba.a m4.o m3.o m2.o m1.o" false
+runcmd "${LD} -o t main.o liba.a && ${NM} -g -P t | awk '{print \$1, \$2}'" true
+rundiff false
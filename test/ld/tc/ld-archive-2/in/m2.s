@@ -0,0 +1,9 @@
+# $Id$
+
+	.text
+	.globl	y
+	.type	y, @function
+y:
+	call	z
+	ret
+	.size	y, .-y
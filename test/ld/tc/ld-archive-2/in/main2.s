@@ -0,0 +1,15 @@
+# $Id$
+
+	.text
+	.globl	_start
+	.type	_start, @function
+_start:
+	call	x
+	ret
+	.size	_start, .-_start
+
+	.globl	y
+	.type	y, @function
+y:
+	ret
+	.size	y, .-y
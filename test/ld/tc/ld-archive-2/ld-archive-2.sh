@@ -0,0 +1,6 @@
+# $Id$
+inittest ld-archive-2 tc/ld-archive-2
+assemble
+runcmd "${AR} rc liba.a m3.o m2.o m1.o" false
+runcmd "${LD} -o t main2.o liba.a && ${NM} -g -P t | awk '{print \$1, \$2}'" true
+rundiff false
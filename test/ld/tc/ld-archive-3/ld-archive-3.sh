@@ -0,0 +1,6 @@
+# $Id$
+inittest ld-archive-3 tc/ld-archive-3
+assemble
+runcmd "${AR} rc libx.a m1.o m3.o && ${AR} rc liby.a m2.o" false
+runcmd "${LD} -o t main.o --start-group libx.a liby.a --end-group && ${NM} -g -P t | awk '{print \$1, \$2}'" true
+rundiff false
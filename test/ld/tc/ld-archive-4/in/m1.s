@@ -0,0 +1,9 @@
+# $Id$
+
+	.text
+	.globl	x
+	.type	x, @function
+x:
+	call	y
+	ret
+	.size	x, .-x
@@ -0,0 +1,6 @@
+# $Id$
+inittest ld-archive-4 tc/ld-archive-4
+assemble
+runcmd "${AR} rc libx.a m1.o m3.o && ${AR} rc liby.a m2.o" false
+runcmd "${LD} -o t main.o libx.a liby.a && ${NM} -g -P t | awk '{print \$1, \$2}'" true
+rundiff false
@@ -0,0 +1,9 @@
+# $Id$
+
+	.text
+	.globl	_start
+	.type	_start, @function
+_start:
+	call	x
+	ret
+	.size	_start, .-_start
@@ -0,0 +1,5 @@
+# $Id$
+inittest ld-build-id-1 tc/ld-build-id-1
+assemble
+runcmd "${LD} --build-id=0x0123456789ABCDEF -o t t.o && ${BUILDID} t" true
+rundiff false
@@ -0,0 +1,5 @@
+# $Id$
+inittest ld-build-id-2 tc/ld-build-id-2
+assemble
+runcmd "${LD} --build-id -o a t.o && ${LD} --build-id=sha1 -o b t.o && cmp a b && ${BUILDID} -n a" true
+rundiff false
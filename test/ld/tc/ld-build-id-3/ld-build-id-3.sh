@@ -0,0 +1,5 @@
+# $Id$
+inittest ld-build-id-3 tc/ld-build-id-3
+assemble
+runcmd "${LD} --build-id=md5 -o a t.o && ${LD} --build-id=md5 -o b u.o && ${BUILDID} -n a && test \"\`${BUILDID} a\`\" != \"\`${BUILDID} b\`\"" true
+rundiff false
@@ -0,0 +1,16 @@
+# $Id$
+
+	.text
+	.globl	_start
+	.type	_start, @function
+_start:
+	movl	value(%rip), %edi
+	movl	$60, %eax
+	syscall
+	.size	_start, .-_start
+
+	.data
+	.type	value, @object
+	.size	value, 4
+value:
+	.long	1
@@ -0,0 +1,5 @@
+# $Id$
+inittest ld-build-id-4 tc/ld-build-id-4
+assemble
+runcmd "${LD} --build-id --build-id=none -o t t.o && ${BUILDID} t" true
+rundiff false
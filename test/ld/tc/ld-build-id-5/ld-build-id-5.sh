@@ -0,0 +1,5 @@
+# $Id$
+inittest ld-build-id-5 tc/ld-build-id-5
+assemble
+runcmd "${LD} --build-id=0x123 -o t t.o" true
+rundiff false
@@ -0,0 +1,5 @@
+# $Id$
+inittest ld-build-id-6 tc/ld-build-id-6
+assemble
+runcmd "${LD} --build-id=uuid -o a t.o && ${LD} --build-id=uuid -o b t.o && ${BUILDID} -n a && test \"\`${BUILDID} a\`\" != \"\`${BUILDID} b\`\"" true
+rundiff false
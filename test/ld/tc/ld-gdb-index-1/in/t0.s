@@ -0,0 +1,85 @@
+# $Id$
+#
+# A C unit with debugging information written out by hand: a function,
+# a file scope variable and the base type of the variable.
+
+	.text
+	.globl	_start
+	.type	_start, @function
+_start:
+	call	f
+	movl	counter(%rip), %edi
+	movl	$60, %eax
+	syscall
+.Ltext_end:
+	.size	_start, .-_start
+
+	.data
+	.type	counter, @object
+	.size	counter, 4
+counter:
+	.long	1
+
+	.section	.debug_abbrev,"",@progbits
+.Labbrev:
+	.uleb128 1			# DW_TAG_compile_unit, children
+	.uleb128 0x11
+	.byte	1
+	.uleb128 0x03, 0x08		# DW_AT_name, DW_FORM_string
+	.uleb128 0x13, 0x0b		# DW_AT_language, DW_FORM_data1
+	.uleb128 0x11, 0x01		# DW_AT_low_pc, DW_FORM_addr
+	.uleb128 0x12, 0x06		# DW_AT_high_pc, DW_FORM_data4
+	.uleb128 0, 0
+	.uleb128 2			# DW_TAG_base_type
+	.uleb128 0x24
+	.byte	0
+	.uleb128 0x03, 0x08		# DW_AT_name, DW_FORM_string
+	.uleb128 0x0b, 0x0b		# DW_AT_byte_size, DW_FORM_data1
+	.uleb128 0x3e, 0x0b		# DW_AT_encoding, DW_FORM_data1
+	.uleb128 0, 0
+	.uleb128 3			# DW_TAG_subprogram
+	.uleb128 0x2e
+	.byte	0
+	.uleb128 0x03, 0x08		# DW_AT_name, DW_FORM_string
+	.uleb128 0x3f, 0x19		# DW_AT_external, DW_FORM_flag_present
+	.uleb128 0x11, 0x01		# DW_AT_low_pc, DW_FORM_addr
+	.uleb128 0x12, 0x06		# DW_AT_high_pc, DW_FORM_data4
+	.uleb128 0, 0
+	.uleb128 4			# DW_TAG_variable
+	.uleb128 0x34
+	.byte	0
+	.uleb128 0x03, 0x08		# DW_AT_name, DW_FORM_string
+	.uleb128 0x49, 0x13		# DW_AT_type, DW_FORM_ref4
+	.uleb128 0x02, 0x18		# DW_AT_location, DW_FORM_exprloc
+	.uleb128 0, 0
+	.byte	0
+
+	.section	.debug_info,"",@progbits
+.Lcu:
+	.long	.Lcu_end - .Lcu_start	# unit_length
+.Lcu_start:
+	.value	4			# version
+	.long	.Labbrev		# debug_abbrev_offset
+	.byte	8			# address_size
+	.uleb128 1
+	.string	"t0.c"
+	.byte	0x0c			# DW_LANG_C99
+	.quad	_start
+	.long	.Ltext_end - _start
+.Lint:
+	.uleb128 2
+	.string	"int"
+	.byte	4
+	.byte	0x05			# DW_ATE_signed
+	.uleb128 3
+	.string	"_start"
+	.quad	_start
+	.long	.Ltext_end - _start
+	.uleb128 4
+	.string	"counter"
+	.long	.Lint - .Lcu
+	.uleb128 9
+	.byte	0x03			# DW_OP_addr
+	.quad	counter
+	.byte	0
+.Lcu_end:
@@ -0,0 +1,149 @@
+# $Id$
+#
+# A C unit with debugging information written out by hand, its names
+# in .debug_str: a function, a declaration, and a typedef, a structure
+# and an enumeration type.  "int" is a base type of both units.
+
+	.text
+	.globl	f
+	.type	f, @function
+f:
+	ret
+.Ltext_end:
+	.size	f, .-f
+
+	.section	.debug_abbrev,"",@progbits
+.Labbrev:
+	.uleb128 1			# DW_TAG_compile_unit, children
+	.uleb128 0x11
+	.byte	1
+	.uleb128 0x03, 0x0e		# DW_AT_name, DW_FORM_strp
+	.uleb128 0x13, 0x0b		# DW_AT_language, DW_FORM_data1
+	.uleb128 0x11, 0x01		# DW_AT_low_pc, DW_FORM_addr
+	.uleb128 0x12, 0x06		# DW_AT_high_pc, DW_FORM_data4
+	.uleb128 0, 0
+	.uleb128 2			# DW_TAG_base_type
+	.uleb128 0x24
+	.byte	0
+	.uleb128 0x03, 0x0e		# DW_AT_name, DW_FORM_strp
+	.uleb128 0x0b, 0x0b		# DW_AT_byte_size, DW_FORM_data1
+	.uleb128 0x3e, 0x0b		# DW_AT_encoding, DW_FORM_data1
+	.uleb128 0, 0
+	.uleb128 3			# DW_TAG_typedef
+	.uleb128 0x16
+	.byte	0
+	.uleb128 0x03, 0x0e		# DW_AT_name, DW_FORM_strp
+	.uleb128 0x49, 0x13		# DW_AT_type, DW_FORM_ref4
+	.uleb128 0, 0
+	.uleb128 4			# DW_TAG_structure_type, children
+	.uleb128 0x13
+	.byte	1
+	.uleb128 0x03, 0x0e		# DW_AT_name, DW_FORM_strp
+	.uleb128 0x0b, 0x0b		# DW_AT_byte_size, DW_FORM_data1
+	.uleb128 0, 0
+	.uleb128 5			# DW_TAG_member
+	.uleb128 0x0d
+	.byte	0
+	.uleb128 0x03, 0x0e		# DW_AT_name, DW_FORM_strp
+	.uleb128 0x49, 0x13		# DW_AT_type, DW_FORM_ref4
+	.uleb128 0x38, 0x0b		# DW_AT_data_member_location, DW_FORM_data1
+	.uleb128 0, 0
+	.uleb128 6			# DW_TAG_enumeration_type, children
+	.uleb128 0x04
+	.byte	1
+	.uleb128 0x03, 0x0e		# DW_AT_name, DW_FORM_strp
+	.uleb128 0x0b, 0x0b		# DW_AT_byte_size, DW_FORM_data1
+	.uleb128 0, 0
+	.uleb128 7			# DW_TAG_enumerator
+	.uleb128 0x28
+	.byte	0
+	.uleb128 0x03, 0x0e		# DW_AT_name, DW_FORM_strp
+	.uleb128 0x1c, 0x0b		# DW_AT_const_value, DW_FORM_data1
+	.uleb128 0, 0
+	.uleb128 8			# DW_TAG_subprogram
+	.uleb128 0x2e
+	.byte	0
+	.uleb128 0x03, 0x0e		# DW_AT_name, DW_FORM_strp
+	.uleb128 0x3f, 0x19		# DW_AT_external, DW_FORM_flag_present
+	.uleb128 0x11, 0x01		# DW_AT_low_pc, DW_FORM_addr
+	.uleb128 0x12, 0x06		# DW_AT_high_pc, DW_FORM_data4
+	.uleb128 0, 0
+	.uleb128 9			# DW_TAG_variable
+	.uleb128 0x34
+	.byte	0
+	.uleb128 0x03, 0x0e		# DW_AT_name, DW_FORM_strp
+	.uleb128 0x49, 0x13		# DW_AT_type, DW_FORM_ref4
+	.uleb128 0x3f, 0x19		# DW_AT_external, DW_FORM_flag_present
+	.uleb128 0x3c, 0x19		# DW_AT_declaration, DW_FORM_flag_present
+	.uleb128 0, 0
+	.byte	0
+
+	.section	.debug_str,"MS",@progbits,1
+.Ls_t1:
+	.string	"t1.c"
+.Ls_int:
+	.string	"int"
+.Ls_count_t:
+	.string	"count_t"
+.Ls_point:
+	.string	"point"
+.Ls_x:
+	.string	"x"
+.Ls_color:
+	.string	"color"
+.Ls_RED:
+	.string	"RED"
+.Ls_GREEN:
+	.string	"GREEN"
+.Ls_f:
+	.string	"f"
+.Ls_limit:
+	.string	"limit"
+
+	.section	.debug_info,"",@progbits
+.Lcu:
+	.long	.Lcu_end - .Lcu_start	# unit_length
+.Lcu_start:
+	.value	4			# version
+	.long	.Labbrev		# debug_abbrev_offset
+	.byte	8			# address_size
+	.uleb128 1
+	.long	.Ls_t1
+	.byte	0x0c			# DW_LANG_C99
+	.quad	f
+	.long	.Ltext_end - f
+.Lint:
+	.uleb128 2
+	.long	.Ls_int
+	.byte	4
+	.byte	0x05			# DW_ATE_signed
+	.uleb128 3
+	.long	.Ls_count_t
+	.long	.Lint - .Lcu
+	.uleb128 4
+	.long	.Ls_point
+	.byte	4
+	.uleb128 5
+	.long	.Ls_x
+	.long	.Lint - .Lcu
+	.byte	0
+	.byte	0
+	.uleb128 6
+	.long	.Ls_color
+	.byte	4
+	.uleb128 7
+	.long	.Ls_RED
+	.byte	0
+	.uleb128 7
+	.long	.Ls_GREEN
+	.byte	1
+	.byte	0
+	.uleb128 8
+	.long	.Ls_f
+	.quad	f
+	.long	.Ltext_end - f
+	.uleb128 9
+	.long	.Ls_limit
+	.long	.Lint - .Lcu
+	.byte	0
+.Lcu_end:
@@ -0,0 +1,5 @@
+# $Id$
+inittest ld-gdb-index-1 tc/ld-gdb-index-1
+assemble
+runcmd "${LD} --gdb-index -o t t0.o t1.o && ${GDBINDEX} t" true
+rundiff false
@@ -0,0 +1,5 @@
+# $Id$
+inittest ld-gdb-index-2 tc/ld-gdb-index-2
+assemble
+runcmd "${LD} --gdb-index -o t t.o && ${GDBINDEX} t" true
+rundiff false
@@ -0,0 +1,8 @@
+# $Id$
+
+	.text
+	.globl	d
+	.type	d, @function
+d:
+	ret
+	.size	d, .-d
@@ -0,0 +1,110 @@
+# $Id$
+
+	.text
+	.globl	alpha
+	.type	alpha, @function
+alpha:
+	jmp	d@PLT
+	.size	alpha, .-alpha
+	.globl	beta
+	.type	beta, @function
+beta:
+	jmp	d@PLT
+	.size	beta, .-beta
+	.globl	gamma
+	.type	gamma, @function
+gamma:
+	jmp	d@PLT
+	.size	gamma, .-gamma
+	.globl	delta
+	.type	delta, @function
+delta:
+	jmp	d@PLT
+	.size	delta, .-delta
+	.globl	epsilon
+	.type	epsilon, @function
+epsilon:
+	jmp	d@PLT
+	.size	epsilon, .-epsilon
+	.globl	zeta
+	.type	zeta, @function
+zeta:
+	jmp	d@PLT
+	.size	zeta, .-zeta
+	.globl	eta
+	.type	eta, @function
+eta:
+	jmp	d@PLT
+	.size	eta, .-eta
+	.globl	theta
+	.type	theta, @function
+theta:
+	jmp	d@PLT
+	.size	theta, .-theta
+	.globl	iota
+	.type	iota, @function
+iota:
+	jmp	d@PLT
+	.size	iota, .-iota
+	.globl	kappa
+	.type	kappa, @function
+kappa:
+	jmp	d@PLT
+	.size	kappa, .-kappa
+	.globl	lambda
+	.type	lambda, @function
+lambda:
+	jmp	d@PLT
+	.size	lambda, .-lambda
+	.globl	mu
+	.type	mu, @function
+mu:
+	jmp	d@PLT
+	.size	mu, .-mu
+	.globl	nu
+	.type	nu, @function
+nu:
+	jmp	d@PLT
+	.size	nu, .-nu
+	.globl	xi
+	.type	xi, @function
+xi:
+	jmp	d@PLT
+	.size	xi, .-xi
+	.globl	omicron
+	.type	omicron, @function
+omicron:
+	jmp	d@PLT
+	.size	omicron, .-omicron
+	.globl	pi
+	.type	pi, @function
+pi:
+	jmp	d@PLT
+	.size	pi, .-pi
+	.globl	rho
+	.type	rho, @function
+rho:
+	jmp	d@PLT
+	.size	rho, .-rho
+	.globl	sigma
+	.type	sigma, @function
+sigma:
+	jmp	d@PLT
+	.size	sigma, .-sigma
+	.globl	tau
+	.type	tau, @function
+tau:
+	jmp	d@PLT
+	.size	tau, .-tau
+	.globl	upsilon
+	.type	upsilon, @function
+upsilon:
+	jmp	d@PLT
+	.size	upsilon, .-upsilon
+
+	.data
+	.globl	counter
+	.type	counter, @object
+	.size	counter, 8
+counter:
+	.quad	0
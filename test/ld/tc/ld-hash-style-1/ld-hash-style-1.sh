@@ -0,0 +1,6 @@
+# $Id$
+inittest ld-hash-style-1 tc/ld-hash-style-1
+assemble
+runcmd "${CC} -shared -nostdlib -o libd.so d.s" false
+runcmd "${LD} -shared --hash-style=gnu -o t.so t.o libd.so && ${GNUHASH} t.so" true
+rundiff false
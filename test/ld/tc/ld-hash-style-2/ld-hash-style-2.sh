@@ -0,0 +1,6 @@
+# $Id$
+inittest ld-hash-style-2 tc/ld-hash-style-2
+assemble
+runcmd "${CC} -shared -nostdlib -o libd.so d.s" false
+runcmd "${LD} -shared --hash-style=both -o t.so t.o libd.so && ${GNUHASH} t.so" true
+rundiff false
@@ -0,0 +1,6 @@
+# $Id$
+inittest ld-hash-style-4 tc/ld-hash-style-4
+assemble
+runcmd "${CC} -shared -nostdlib -o libd.so d.s" false
+runcmd "${LD} -shared --hash-style=elf -o t.so t.o libd.so" true
+rundiff false
@@ -0,0 +1,207 @@
+# $Id$
+
+	.text
+	.globl	_start
+	.type	_start, @function
+_start:
+	call	f0_0
+	ret
+	.size	_start, .-_start
+
+	.section	.text.f0_0,"ax",@progbits
+	.globl	f0_0
+	.type	f0_0, @function
+f0_0:
+	.cfi_startproc
+	leaq	p0+0(%rip), %rdx
+	call	f1_1
+	ret
+	.cfi_endproc
+	.size	f0_0, .-f0_0
+
+	.section	.text.f0_1,"ax",@progbits
+	.globl	f0_1
+	.type	f0_1, @function
+f0_1:
+	.cfi_startproc
+	leaq	p0+8(%rip), %rdx
+	call	f1_2
+	ret
+	.cfi_endproc
+	.size	f0_1, .-f0_1
+
+	.section	.text.f0_2,"ax",@progbits
+	.globl	f0_2
+	.type	f0_2, @function
+f0_2:
+	.cfi_startproc
+	leaq	p0+16(%rip), %rdx
+	call	f1_3
+	ret
+	.cfi_endproc
+	.size	f0_2, .-f0_2
+
+	.section	.text.f0_3,"ax",@progbits
+	.globl	f0_3
+	.type	f0_3, @function
+f0_3:
+	.cfi_startproc
+	leaq	p0+24(%rip), %rdx
+	call	f1_4
+	ret
+	.cfi_endproc
+	.size	f0_3, .-f0_3
+
+	.section	.text.f0_4,"ax",@progbits
+	.globl	f0_4
+	.type	f0_4, @function
+f0_4:
+	.cfi_startproc
+	leaq	p0+32(%rip), %rdx
+	call	f1_5
+	ret
+	.cfi_endproc
+	.size	f0_4, .-f0_4
+
+	.section	.text.f0_5,"ax",@progbits
+	.globl	f0_5
+	.type	f0_5, @function
+f0_5:
+	.cfi_startproc
+	leaq	p0+40(%rip), %rdx
+	call	f1_6
+	ret
+	.cfi_endproc
+	.size	f0_5, .-f0_5
+
+	.section	.text.f0_6,"ax",@progbits
+	.globl	f0_6
+	.type	f0_6, @function
+f0_6:
+	.cfi_startproc
+	leaq	p0+48(%rip), %rdx
+	call	f1_7
+	ret
+	.cfi_endproc
+	.size	f0_6, .-f0_6
+
+	.section	.text.f0_7,"ax",@progbits
+	.globl	f0_7
+	.type	f0_7, @function
+f0_7:
+	.cfi_startproc
+	leaq	p0+56(%rip), %rdx
+	call	f1_8
+	ret
+	.cfi_endproc
+	.size	f0_7, .-f0_7
+
+	.section	.text.f0_8,"ax",@progbits
+	.globl	f0_8
+	.type	f0_8, @function
+f0_8:
+	.cfi_startproc
+	leaq	p0+64(%rip), %rdx
+	call	f1_9
+	ret
+	.cfi_endproc
+	.size	f0_8, .-f0_8
+
+	.section	.text.f0_9,"ax",@progbits
+	.globl	f0_9
+	.type	f0_9, @function
+f0_9:
+	.cfi_startproc
+	leaq	p0+72(%rip), %rdx
+	call	f1_10
+	ret
+	.cfi_endproc
+	.size	f0_9, .-f0_9
+
+	.section	.text.f0_10,"ax",@progbits
+	.globl	f0_10
+	.type	f0_10, @function
+f0_10:
+	.cfi_startproc
+	leaq	p0+80(%rip), %rdx
+	call	f1_11
+	ret
+	.cfi_endproc
+	.size	f0_10, .-f0_10
+
+	.section	.text.f0_11,"ax",@progbits
+	.globl	f0_11
+	.type	f0_11, @function
+f0_11:
+	.cfi_startproc
+	leaq	p0+88(%rip), %rdx
+	call	f1_12
+	ret
+	.cfi_endproc
+	.size	f0_11, .-f0_11
+
+	.section	.text.f0_12,"ax",@progbits
+	.globl	f0_12
+	.type	f0_12, @function
+f0_12:
+	.cfi_startproc
+	leaq	p0+96(%rip), %rdx
+	call	f1_13
+	ret
+	.cfi_endproc
+	.size	f0_12, .-f0_12
+
+	.section	.text.f0_13,"ax",@progbits
+	.globl	f0_13
+	.type	f0_13, @function
+f0_13:
+	.cfi_startproc
+	leaq	p0+104(%rip), %rdx
+	call	f1_14
+	ret
+	.cfi_endproc
+	.size	f0_13, .-f0_13
+
+	.section	.text.f0_14,"ax",@progbits
+	.globl	f0_14
+	.type	f0_14, @function
+f0_14:
+	.cfi_startproc
+	leaq	p0+112(%rip), %rdx
+	call	f1_15
+	ret
+	.cfi_endproc
+	.size	f0_14, .-f0_14
+
+	.section	.text.f0_15,"ax",@progbits
+	.globl	f0_15
+	.type	f0_15, @function
+f0_15:
+	.cfi_startproc
+	leaq	p0+120(%rip), %rdx
+	call	f1_0
+	ret
+	.cfi_endproc
+	.size	f0_15, .-f0_15
+
+	.section	.data.p0,"aw",@progbits
+	.align	8
+	.type	p0, @object
+	.size	p0, 128
+p0:
+	.quad	f0_0
+	.quad	f0_1
+	.quad	f0_2
+	.quad	f0_3
+	.quad	f0_4
+	.quad	f0_5
+	.quad	f0_6
+	.quad	f0_7
+	.quad	f0_8
+	.quad	f0_9
+	.quad	f0_10
+	.quad	f0_11
+	.quad	f0_12
+	.quad	f0_13
+	.quad	f0_14
+	.quad	f0_15
@@ -0,0 +1,199 @@
+# $Id$
+
+	.section	.text.f1_0,"ax",@progbits
+	.globl	f1_0
+	.type	f1_0, @function
+f1_0:
+	.cfi_startproc
+	leaq	p1+0(%rip), %rdx
+	call	f2_1
+	ret
+	.cfi_endproc
+	.size	f1_0, .-f1_0
+
+	.section	.text.f1_1,"ax",@progbits
+	.globl	f1_1
+	.type	f1_1, @function
+f1_1:
+	.cfi_startproc
+	leaq	p1+8(%rip), %rdx
+	call	f2_2
+	ret
+	.cfi_endproc
+	.size	f1_1, .-f1_1
+
+	.section	.text.f1_2,"ax",@progbits
+	.globl	f1_2
+	.type	f1_2, @function
+f1_2:
+	.cfi_startproc
+	leaq	p1+16(%rip), %rdx
+	call	f2_3
+	ret
+	.cfi_endproc
+	.size	f1_2, .-f1_2
+
+	.section	.text.f1_3,"ax",@progbits
+	.globl	f1_3
+	.type	f1_3, @function
+f1_3:
+	.cfi_startproc
+	leaq	p1+24(%rip), %rdx
+	call	f2_4
+	ret
+	.cfi_endproc
+	.size	f1_3, .-f1_3
+
+	.section	.text.f1_4,"ax",@progbits
+	.globl	f1_4
+	.type	f1_4, @function
+f1_4:
+	.cfi_startproc
+	leaq	p1+32(%rip), %rdx
+	call	f2_5
+	ret
+	.cfi_endproc
+	.size	f1_4, .-f1_4
+
+	.section	.text.f1_5,"ax",@progbits
+	.globl	f1_5
+	.type	f1_5, @function
+f1_5:
+	.cfi_startproc
+	leaq	p1+40(%rip), %rdx
+	call	f2_6
+	ret
+	.cfi_endproc
+	.size	f1_5, .-f1_5
+
+	.section	.text.f1_6,"ax",@progbits
+	.globl	f1_6
+	.type	f1_6, @function
+f1_6:
+	.cfi_startproc
+	leaq	p1+48(%rip), %rdx
+	call	f2_7
+	ret
+	.cfi_endproc
+	.size	f1_6, .-f1_6
+
+	.section	.text.f1_7,"ax",@progbits
+	.globl	f1_7
+	.type	f1_7, @function
+f1_7:
+	.cfi_startproc
+	leaq	p1+56(%rip), %rdx
+	call	f2_8
+	ret
+	.cfi_endproc
+	.size	f1_7, .-f1_7
+
+	.section	.text.f1_8,"ax",@progbits
+	.globl	f1_8
+	.type	f1_8, @function
+f1_8:
+	.cfi_startproc
+	leaq	p1+64(%rip), %rdx
+	call	f2_9
+	ret
+	.cfi_endproc
+	.size	f1_8, .-f1_8
+
+	.section	.text.f1_9,"ax",@progbits
+	.globl	f1_9
+	.type	f1_9, @function
+f1_9:
+	.cfi_startproc
+	leaq	p1+72(%rip), %rdx
+	call	f2_10
+	ret
+	.cfi_endproc
+	.size	f1_9, .-f1_9
+
+	.section	.text.f1_10,"ax",@progbits
+	.globl	f1_10
+	.type	f1_10, @function
+f1_10:
+	.cfi_startproc
+	leaq	p1+80(%rip), %rdx
+	call	f2_11
+	ret
+	.cfi_endproc
+	.size	f1_10, .-f1_10
+
+	.section	.text.f1_11,"ax",@progbits
+	.globl	f1_11
+	.type	f1_11, @function
+f1_11:
+	.cfi_startproc
+	leaq	p1+88(%rip), %rdx
+	call	f2_12
+	ret
+	.cfi_endproc
+	.size	f1_11, .-f1_11
+
+	.section	.text.f1_12,"ax",@progbits
+	.globl	f1_12
+	.type	f1_12, @function
+f1_12:
+	.cfi_startproc
+	leaq	p1+96(%rip), %rdx
+	call	f2_13
+	ret
+	.cfi_endproc
+	.size	f1_12, .-f1_12
+
+	.section	.text.f1_13,"ax",@progbits
+	.globl	f1_13
+	.type	f1_13, @function
+f1_13:
+	.cfi_startproc
+	leaq	p1+104(%rip), %rdx
+	call	f2_14
+	ret
+	.cfi_endproc
+	.size	f1_13, .-f1_13
+
+	.section	.text.f1_14,"ax",@progbits
+	.globl	f1_14
+	.type	f1_14, @function
+f1_14:
+	.cfi_startproc
+	leaq	p1+112(%rip), %rdx
+	call	f2_15
+	ret
+	.cfi_endproc
+	.size	f1_14, .-f1_14
+
+	.section	.text.f1_15,"ax",@progbits
+	.globl	f1_15
+	.type	f1_15, @function
+f1_15:
+	.cfi_startproc
+	leaq	p1+120(%rip), %rdx
+	call	f2_0
+	ret
+	.cfi_endproc
+	.size	f1_15, .-f1_15
+
+	.section	.data.p1,"aw",@progbits
+	.align	8
+	.type	p1, @object
+	.size	p1, 128
+p1:
+	.quad	f1_0
+	.quad	f1_1
+	.quad	f1_2
+	.quad	f1_3
+	.quad	f1_4
+	.quad	f1_5
+	.quad	f1_6
+	.quad	f1_7
+	.quad	f1_8
+	.quad	f1_9
+	.quad	f1_10
+	.quad	f1_11
+	.quad	f1_12
+	.quad	f1_13
+	.quad	f1_14
+	.quad	f1_15
@@ -0,0 +1,199 @@
+# $Id$
+
+	.section	.text.f2_0,"ax",@progbits
+	.globl	f2_0
+	.type	f2_0, @function
+f2_0:
+	.cfi_startproc
+	leaq	p2+0(%rip), %rdx
+	call	f0_1
+	ret
+	.cfi_endproc
+	.size	f2_0, .-f2_0
+
+	.section	.text.f2_1,"ax",@progbits
+	.globl	f2_1
+	.type	f2_1, @function
+f2_1:
+	.cfi_startproc
+	leaq	p2+8(%rip), %rdx
+	call	f0_2
+	ret
+	.cfi_endproc
+	.size	f2_1, .-f2_1
+
+	.section	.text.f2_2,"ax",@progbits
+	.globl	f2_2
+	.type	f2_2, @function
+f2_2:
+	.cfi_startproc
+	leaq	p2+16(%rip), %rdx
+	call	f0_3
+	ret
+	.cfi_endproc
+	.size	f2_2, .-f2_2
+
+	.section	.text.f2_3,"ax",@progbits
+	.globl	f2_3
+	.type	f2_3, @function
+f2_3:
+	.cfi_startproc
+	leaq	p2+24(%rip), %rdx
+	call	f0_4
+	ret
+	.cfi_endproc
+	.size	f2_3, .-f2_3
+
+	.section	.text.f2_4,"ax",@progbits
+	.globl	f2_4
+	.type	f2_4, @function
+f2_4:
+	.cfi_startproc
+	leaq	p2+32(%rip), %rdx
+	call	f0_5
+	ret
+	.cfi_endproc
+	.size	f2_4, .-f2_4
+
+	.section	.text.f2_5,"ax",@progbits
+	.globl	f2_5
+	.type	f2_5, @function
+f2_5:
+	.cfi_startproc
+	leaq	p2+40(%rip), %rdx
+	call	f0_6
+	ret
+	.cfi_endproc
+	.size	f2_5, .-f2_5
+
+	.section	.text.f2_6,"ax",@progbits
+	.globl	f2_6
+	.type	f2_6, @function
+f2_6:
+	.cfi_startproc
+	leaq	p2+48(%rip), %rdx
+	call	f0_7
+	ret
+	.cfi_endproc
+	.size	f2_6, .-f2_6
+
+	.section	.text.f2_7,"ax",@progbits
+	.globl	f2_7
+	.type	f2_7, @function
+f2_7:
+	.cfi_startproc
+	leaq	p2+56(%rip), %rdx
+	call	f0_8
+	ret
+	.cfi_endproc
+	.size	f2_7, .-f2_7
+
+	.section	.text.f2_8,"ax",@progbits
+	.globl	f2_8
+	.type	f2_8, @function
+f2_8:
+	.cfi_startproc
+	leaq	p2+64(%rip), %rdx
+	call	f0_9
+	ret
+	.cfi_endproc
+	.size	f2_8, .-f2_8
+
+	.section	.text.f2_9,"ax",@progbits
+	.globl	f2_9
+	.type	f2_9, @function
+f2_9:
+	.cfi_startproc
+	leaq	p2+72(%rip), %rdx
+	call	f0_10
+	ret
+	.cfi_endproc
+	.size	f2_9, .-f2_9
+
+	.section	.text.f2_10,"ax",@progbits
+	.globl	f2_10
+	.type	f2_10, @function
+f2_10:
+	.cfi_startproc
+	leaq	p2+80(%rip), %rdx
+	call	f0_11
+	ret
+	.cfi_endproc
+	.size	f2_10, .-f2_10
+
+	.section	.text.f2_11,"ax",@progbits
+	.globl	f2_11
+	.type	f2_11, @function
+f2_11:
+	.cfi_startproc
+	leaq	p2+88(%rip), %rdx
+	call	f0_12
+	ret
+	.cfi_endproc
+	.size	f2_11, .-f2_11
+
+	.section	.text.f2_12,"ax",@progbits
+	.globl	f2_12
+	.type	f2_12, @function
+f2_12:
+	.cfi_startproc
+	leaq	p2+96(%rip), %rdx
+	call	f0_13
+	ret
+	.cfi_endproc
+	.size	f2_12, .-f2_12
+
+	.section	.text.f2_13,"ax",@progbits
+	.globl	f2_13
+	.type	f2_13, @function
+f2_13:
+	.cfi_startproc
+	leaq	p2+104(%rip), %rdx
+	call	f0_14
+	ret
+	.cfi_endproc
+	.size	f2_13, .-f2_13
+
+	.section	.text.f2_14,"ax",@progbits
+	.globl	f2_14
+	.type	f2_14, @function
+f2_14:
+	.cfi_startproc
+	leaq	p2+112(%rip), %rdx
+	call	f0_15
+	ret
+	.cfi_endproc
+	.size	f2_14, .-f2_14
+
+	.section	.text.f2_15,"ax",@progbits
+	.globl	f2_15
+	.type	f2_15, @function
+f2_15:
+	.cfi_startproc
+	leaq	p2+120(%rip), %rdx
+	call	f0_0
+	ret
+	.cfi_endproc
+	.size	f2_15, .-f2_15
+
+	.section	.data.p2,"aw",@progbits
+	.align	8
+	.type	p2, @object
+	.size	p2, 128
+p2:
+	.quad	f2_0
+	.quad	f2_1
+	.quad	f2_2
+	.quad	f2_3
+	.quad	f2_4
+	.quad	f2_5
+	.quad	f2_6
+	.quad	f2_7
+	.quad	f2_8
+	.quad	f2_9
+	.quad	f2_10
+	.quad	f2_11
+	.quad	f2_12
+	.quad	f2_13
+	.quad	f2_14
+	.quad	f2_15
@@ -0,0 +1,9 @@
+# $Id$
+inittest ld-threads-1 tc/ld-threads-1
+assemble
+runcmd "${LD} --build-id --threads=1 -o a1 t0.o t1.o t2.o" false
+runcmd "${LD} --build-id --threads=2 -o a2 t0.o t1.o t2.o" false
+runcmd "${LD} --build-id --threads=8 -o a8 t0.o t1.o t2.o" false
+runcmd "${LD} --build-id -o a t0.o t1.o t2.o" false
+runcmd "cmp a1 a2 && cmp a1 a8 && cmp a1 a && ${NM} -g -P a1 | awk '{print \$1, \$2}'" true
+rundiff false
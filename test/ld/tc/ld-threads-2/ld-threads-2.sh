@@ -0,0 +1,5 @@
+# $Id$
+inittest ld-threads-2 tc/ld-threads-2
+assemble
+runcmd "${LD} --threads=0 -o a t.o" true
+rundiff false
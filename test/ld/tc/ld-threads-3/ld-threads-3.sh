@@ -0,0 +1,5 @@
+# $Id$
+inittest ld-threads-3 tc/ld-threads-3
+assemble
+runcmd "${LD} --threads=abc -o a t.o" true
+rundiff false
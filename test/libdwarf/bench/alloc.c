@@ -0,0 +1,155 @@
+/*-
+ * Copyright (c) 2026 The Elftoolchain Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/*
+ * Count the heap allocations made by the benchmarked code.
+ *
+ * The allocator entry points are interposed and forwarded to the next
+ * definition found by the dynamic linker.  The counters see every
+ * allocation made in the process, whether libdwarf is linked statically
+ * or as a shared library.  The dynamic linker may itself allocate
+ * while the real entry points are being looked up; such requests are
+ * served from a small static buffer.
+ */
+
+#include <dlfcn.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "_elftc.h"
+#include "dwarfbench.h"
+
+ELFTC_VCSID("$Id$");
+
+uint64_t	bench_nalloc;		/* Number of allocation requests. */
+
+static void	*(*real_calloc)(size_t, size_t);
+static void	(*real_free)(void *);
+static void	*(*real_malloc)(size_t);
+static void	*(*real_realloc)(void *, size_t);
+
+static union {
+	max_align_t	align;
+	char		buf[4096];
+} early;
+static size_t	early_used;
+static int	resolving;
+
+#define	EARLY(p)	((char *) (p) >= early.buf &&			\
+    (char *) (p) < early.buf + sizeof(early.buf))
+
+static void *
+early_alloc(size_t size)
+{
+	void *p;
+
+	size = (size + sizeof(max_align_t) - 1) &
+	    ~(sizeof(max_align_t) - 1);
+	if (size > sizeof(early.buf) - early_used)
+		return (NULL);
+	p = early.buf + early_used;
+	early_used += size;
+
+	/* The buffer is zero-filled and never reused. */
+	return (p);
+}
+
+static int
+resolve(void)
+{
+
+	if (real_malloc != NULL)
+		return (1);
+	if (resolving)
+		return (0);
+
+	resolving = 1;
+	real_calloc = dlsym(RTLD_NEXT, "calloc");
+	real_free = dlsym(RTLD_NEXT, "free");
+	real_malloc = dlsym(RTLD_NEXT, "malloc");
+	real_realloc = dlsym(RTLD_NEXT, "realloc");
+	resolving = 0;
+
+	return (real_malloc != NULL);
+}
+
+void *
+malloc(size_t size)
+{
+
+	if (!resolve())
+		return (early_alloc(size));
+	bench_nalloc++;
+
+	return (real_malloc(size));
+}
+
+void *
+calloc(size_t nmemb, size_t size)
+{
+
+	if (!resolve()) {
+		if (size != 0 && nmemb > SIZE_MAX / size)
+			return (NULL);
+		return (early_alloc(nmemb * size));
+	}
+	bench_nalloc++;
+
+	return (real_calloc(nmemb, size));
+}
+
+void *
+realloc(void *ptr, size_t size)
+{
+	size_t avail;
+	void *p;
+
+	if (ptr != NULL && EARLY(ptr)) {
+		/* The old size is unknown; copy up to the end of the buffer. */
+		avail = early.buf + sizeof(early.buf) - (char *) ptr;
+		if ((p = malloc(size)) == NULL)
+			return (NULL);
+		(void) memcpy(p, ptr, size < avail ? size : avail);
+		return (p);
+	}
+
+	if (!resolve())
+		return (ptr == NULL ? early_alloc(size) : NULL);
+	bench_nalloc++;
+
+	return (real_realloc(ptr, size));
+}
+
+void
+free(void *ptr)
+{
+
+	if (ptr == NULL || EARLY(ptr))
+		return;
+	if (resolve())
+		real_free(ptr);
+}
@@ -0,0 +1,585 @@
+/*-
+ * Copyright (c) 2026 The Elftoolchain Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/*
+ * Benchmarks for the libdwarf consumer.
+ *
+ * Each benchmark runs in a child process of its own, so that the peak
+ * resident set size and the allocation count it reports are its own.
+ * Work needed to choose the inputs of a benchmark, such as picking the
+ * addresses to look up, is done with a separate debug context before
+ * the clock starts.
+ */
+
+#include <sys/types.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#include <err.h>
+#include <fcntl.h>
+#include <libelf.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "dwarf.h"
+#include "libdwarf.h"
+
+#include "_elftc.h"
+#include "dwarfbench.h"
+
+ELFTC_VCSID("$Id$");
+
+struct bench {
+	const char	*b_path;	/* Object being benchmarked. */
+	unsigned	b_nlookup;	/* Lookups per lookup benchmark. */
+	unsigned	b_nstartup;	/* Iterations of the startup test. */
+	struct bench_corpus b_corpus;	/* Parameters of a generated corpus. */
+};
+
+struct bench_phase {
+	const char	*bp_name;
+	uint64_t	(*bp_run)(struct bench *);
+};
+
+static struct timespec	bench_t0;	/* Start of the timed section. */
+static double		bench_secs;	/* Length of the timed section. */
+static uint64_t		bench_allocs;	/* Allocations in the timed section. */
+static uint64_t		bench_seed = 0x9e3779b97f4a7c15ULL;
+
+static void
+bench_start(void)
+{
+
+	bench_nalloc = 0;
+	(void) clock_gettime(CLOCK_MONOTONIC, &bench_t0);
+}
+
+static void
+bench_stop(void)
+{
+	struct timespec t1;
+
+	(void) clock_gettime(CLOCK_MONOTONIC, &t1);
+	bench_allocs = bench_nalloc;
+	bench_secs = (t1.tv_sec - bench_t0.tv_sec) +
+	    (t1.tv_nsec - bench_t0.tv_nsec) / 1e9;
+}
+
+/* A fixed xorshift64* sequence, so that runs are comparable. */
+static uint64_t
+bench_random(void)
+{
+
+	bench_seed ^= bench_seed >> 12;
+	bench_seed ^= bench_seed << 25;
+	bench_seed ^= bench_seed >> 27;
+
+	return (bench_seed * 0x2545f4914f6cdd1dULL);
+}
+
+static Dwarf_Debug
+bench_open(struct bench *b, int *fd)
+{
+	Dwarf_Debug dbg;
+	Dwarf_Error de;
+
+	if ((*fd = open(b->b_path, O_RDONLY)) < 0)
+		err(EXIT_FAILURE, "%s", b->b_path);
+	if (dwarf_init(*fd, DW_DLC_READ, NULL, NULL, &dbg, &de) != DW_DLV_OK)
+		errx(EXIT_FAILURE, "dwarf_init: %s", dwarf_errmsg(de));
+
+	return (dbg);
+}
+
+static void
+bench_close(Dwarf_Debug dbg, int fd)
+{
+	Dwarf_Error de;
+
+	(void) dwarf_finish(dbg, &de);
+	(void) close(fd);
+}
+
+/* Pick addresses covered by the address ranges of the object. */
+static Dwarf_Addr *
+bench_sample_pcs(struct bench *b)
+{
+	Dwarf_Arange *aranges;
+	Dwarf_Debug dbg;
+	Dwarf_Error de;
+	Dwarf_Addr *pcs, start;
+	Dwarf_Unsigned len;
+	Dwarf_Off off;
+	Dwarf_Signed cnt;
+	unsigned i;
+	int fd;
+
+	dbg = bench_open(b, &fd);
+	if (dwarf_get_aranges(dbg, &aranges, &cnt, &de) != DW_DLV_OK)
+		errx(EXIT_FAILURE, "dwarf_get_aranges: %s", dwarf_errmsg(de));
+	if ((pcs = malloc(b->b_nlookup * sizeof(*pcs))) == NULL)
+		err(EXIT_FAILURE, "malloc");
+
+	for (i = 0; i < b->b_nlookup; ) {
+		if (dwarf_get_arange_info(aranges[bench_random() % cnt],
+		    &start, &len, &off, &de) != DW_DLV_OK)
+			errx(EXIT_FAILURE, "dwarf_get_arange_info: %s",
+			    dwarf_errmsg(de));
+		if (len > 0)
+			pcs[i++] = start + bench_random() % len;
+	}
+
+	bench_close(dbg, fd);
+
+	return (pcs);
+}
+
+static uint64_t
+bench_startup(struct bench *b)
+{
+	Dwarf_Debug dbg;
+	Dwarf_Error de;
+	Elf *e;
+	unsigned i;
+	int fd;
+
+	if ((fd = open(b->b_path, O_RDONLY)) < 0)
+		err(EXIT_FAILURE, "%s", b->b_path);
+
+	bench_start();
+	for (i = 0; i < b->b_nstartup; i++) {
+		if ((e = elf_begin(fd, ELF_C_READ, NULL)) == NULL)
+			errx(EXIT_FAILURE, "elf_begin: %s", elf_errmsg(-1));
+		if (dwarf_elf_init(e, DW_DLC_READ, NULL, NULL, &dbg, &de) !=
+		    DW_DLV_OK)
+			errx(EXIT_FAILURE, "dwarf_elf_init: %s",
+			    dwarf_errmsg(de));
+		(void) dwarf_finish(dbg, &de);
+		(void) elf_end(e);
+	}
+	bench_stop();
+
+	(void) close(fd);
+
+	return (b->b_nstartup);
+}
+
+/* Visit every DIE and attribute; returns the number of DIEs. */
+static uint64_t
+bench_die_walk(struct bench *b)
+{
+	Dwarf_Attribute *atlist;
+	Dwarf_Debug dbg;
+	Dwarf_Die cu, die, kid, sib, *stack, *ns;
+	Dwarf_Error de;
+	Dwarf_Half form, ver, addrsz, offsz, extsz;
+	Dwarf_Off abbroff;
+	Dwarf_Sig8 sig;
+	Dwarf_Signed i, atcnt;
+	Dwarf_Unsigned culen, typeoff, next;
+	uint64_t ndies;
+	size_t cap, sp;
+	int fd;
+
+	dbg = bench_open(b, &fd);
+	cap = 64;
+	if ((stack = malloc(cap * sizeof(*stack))) == NULL)
+		err(EXIT_FAILURE, "malloc");
+	ndies = 0;
+
+	bench_start();
+	while (dwarf_next_cu_header_c(dbg, 1, &culen, &ver, &abbroff, &addrsz,
+	    &offsz, &extsz, &sig, &typeoff, &next, &de) == DW_DLV_OK) {
+		if (dwarf_siblingof(dbg, NULL, &cu, &de) != DW_DLV_OK)
+			errx(EXIT_FAILURE, "dwarf_siblingof: %s",
+			    dwarf_errmsg(de));
+		/*
+		 * The CU DIE itself is counted here and never pushed, as
+		 * it has no siblings to follow.
+		 */
+		ndies++;
+		sp = 0;
+		if (dwarf_child(cu, &kid, &de) == DW_DLV_OK)
+			stack[sp++] = kid;
+		dwarf_dealloc(dbg, cu, DW_DLA_DIE);
+		while (sp > 0) {
+			die = stack[--sp];
+			ndies++;
+			if (dwarf_attrlist(die, &atlist, &atcnt, &de) ==
+			    DW_DLV_OK) {
+				for (i = 0; i < atcnt; i++)
+					(void) dwarf_whatform(atlist[i], &form,
+					    &de);
+			}
+			if (sp + 2 > cap) {
+				cap *= 2;
+				if ((ns = realloc(stack, cap *
+				    sizeof(*stack))) == NULL)
+					err(EXIT_FAILURE, "realloc");
+				stack = ns;
+			}
+			if (dwarf_siblingof(dbg, die, &sib, &de) == DW_DLV_OK)
+				stack[sp++] = sib;
+			if (dwarf_child(die, &kid, &de) == DW_DLV_OK)
+				stack[sp++] = kid;
+			dwarf_dealloc(dbg, die, DW_DLA_DIE);
+		}
+	}
+	bench_stop();
+
+	free(stack);
+	bench_close(dbg, fd);
+
+	return (ndies);
+}
+
+/* Map addresses to line numbers through the aranges and line tables. */
+static uint64_t
+bench_addr2line(struct bench *b)
+{
+	Dwarf_Arange *aranges, ar;
+	Dwarf_Debug dbg;
+	Dwarf_Die die;
+	Dwarf_Error de;
+	Dwarf_Line *lines;
+	Dwarf_Addr *pcs, addr;
+	Dwarf_Off off;
+	Dwarf_Signed cnt, lcnt, lo, hi, mid;
+	Dwarf_Unsigned lineno;
+	uint64_t found;
+	unsigned i;
+	int fd;
+
+	pcs = bench_sample_pcs(b);
+	dbg = bench_open(b, &fd);
+	found = 0;
+
+	bench_start();
+	if (dwarf_get_aranges(dbg, &aranges, &cnt, &de) != DW_DLV_OK)
+		errx(EXIT_FAILURE, "dwarf_get_aranges: %s", dwarf_errmsg(de));
+	for (i = 0; i < b->b_nlookup; i++) {
+		if (dwarf_get_arange(aranges, cnt, pcs[i], &ar, &de) !=
+		    DW_DLV_OK ||
+		    dwarf_get_cu_die_offset(ar, &off, &de) != DW_DLV_OK ||
+		    dwarf_offdie(dbg, off, &die, &de) != DW_DLV_OK)
+			continue;
+		if (dwarf_srclines(die, &lines, &lcnt, &de) == DW_DLV_OK &&
+		    lcnt > 0) {
+			/* Find the last row at or below the address. */
+			lo = 0;
+			hi = lcnt;
+			while (lo < hi) {
+				mid = lo + (hi - lo) / 2;
+				(void) dwarf_lineaddr(lines[mid], &addr, &de);
+				if (addr <= pcs[i])
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+			if (lo > 0 && dwarf_lineno(lines[lo - 1], &lineno,
+			    &de) == DW_DLV_OK)
+				found++;
+		}
+		dwarf_dealloc(dbg, die, DW_DLA_DIE);
+	}
+	bench_stop();
+
+	if (found != b->b_nlookup)
+		warnx("addr2line: %ju of %u addresses not found",
+		    (uintmax_t) (b->b_nlookup - found), b->b_nlookup);
+
+	free(pcs);
+	bench_close(dbg, fd);
+
+	return (b->b_nlookup);
+}
+
+/* Find the FDE covering each address. */
+static uint64_t
+bench_fde_at_pc(struct bench *b)
+{
+	Dwarf_Debug dbg;
+	Dwarf_Error de;
+	Dwarf_Fde fde;
+	Dwarf_Addr *pcs, lopc, hipc;
+	uint64_t found;
+	unsigned i;
+	int fd;
+	int (*lookup)(Dwarf_Debug, Dwarf_Addr, Dwarf_Fde *, Dwarf_Addr *,
+	    Dwarf_Addr *, Dwarf_Error *);
+
+	pcs = bench_sample_pcs(b);
+
+	/* Use .eh_frame if the object has no .debug_frame. */
+	dbg = bench_open(b, &fd);
+	lookup = dwarf_get_fde_for_pc;
+	if (b->b_nlookup > 0 && dwarf_get_fde_for_pc(dbg, pcs[0], &fde,
+	    &lopc, &hipc, &de) != DW_DLV_OK && dwarf_get_fde_for_pc_eh(dbg,
+	    pcs[0], &fde, &lopc, &hipc, &de) == DW_DLV_OK)
+		lookup = dwarf_get_fde_for_pc_eh;
+	bench_close(dbg, fd);
+
+	dbg = bench_open(b, &fd);
+	found = 0;
+
+	bench_start();
+	for (i = 0; i < b->b_nlookup; i++) {
+		if (lookup(dbg, pcs[i], &fde, &lopc, &hipc, &de) == DW_DLV_OK)
+			found++;
+	}
+	bench_stop();
+
+	if (found != b->b_nlookup)
+		warnx("fde-at-pc: %ju of %u addresses not found",
+		    (uintmax_t) (b->b_nlookup - found), b->b_nlookup);
+
+	free(pcs);
+	bench_close(dbg, fd);
+
+	return (b->b_nlookup);
+}
+
+/* Look up global names through the .debug_pubnames table. */
+static uint64_t
+bench_name_lookup(struct bench *b)
+{
+	Dwarf_Debug dbg;
+	Dwarf_Error de;
+	Dwarf_Global *globs;
+	Dwarf_Signed cnt;
+	char **names, *name;
+	uint64_t found;
+	unsigned i;
+	int fd;
+
+	dbg = bench_open(b, &fd);
+	if (dwarf_get_globals(dbg, &globs, &cnt, &de) != DW_DLV_OK ||
+	    cnt == 0)
+		errx(EXIT_FAILURE, "dwarf_get_globals: no global names");
+	if ((names = malloc(b->b_nlookup * sizeof(*names))) == NULL)
+		err(EXIT_FAILURE, "malloc");
+	for (i = 0; i < b->b_nlookup; i++) {
+		if (dwarf_globname(globs[bench_random() % cnt], &name, &de) !=
+		    DW_DLV_OK)
+			errx(EXIT_FAILURE, "dwarf_globname: %s",
+			    dwarf_errmsg(de));
+		if ((names[i] = strdup(name)) == NULL)
+			err(EXIT_FAILURE, "strdup");
+	}
+	bench_close(dbg, fd);
+
+	dbg = bench_open(b, &fd);
+	found = 0;
+
+	bench_start();
+	for (i = 0; i < b->b_nlookup; i++) {
+		if (dwarf_globals_lookup(dbg, names[i], &globs, &cnt, &de) ==
+		    DW_DLV_OK)
+			found++;
+	}
+	bench_stop();
+
+	if (found != b->b_nlookup)
+		warnx("name-lookup: %ju of %u names not found",
+		    (uintmax_t) (b->b_nlookup - found), b->b_nlookup);
+
+	for (i = 0; i < b->b_nlookup; i++)
+		free(names[i]);
+	free(names);
+	bench_close(dbg, fd);
+
+	return (b->b_nlookup);
+}
+
+static uint64_t
+bench_generate_corpus(struct bench *b)
+{
+	uint64_t n;
+
+	bench_start();
+	n = bench_generate(b->b_path, &b->b_corpus);
+	bench_stop();
+
+	return (n);
+}
+
+static struct bench_phase bench_gen_phase = {
+	"generate", bench_generate_corpus
+};
+
+static struct bench_phase bench_phases[] = {
+	{ "startup", bench_startup },
+	{ "die-walk", bench_die_walk },
+	{ "addr2line", bench_addr2line },
+	{ "fde-at-pc", bench_fde_at_pc },
+	{ "name-lookup", bench_name_lookup },
+	{ NULL, NULL }
+};
+
+static int
+bench_run(struct bench *b, struct bench_phase *bp)
+{
+	struct rusage ru;
+	uint64_t ops;
+	pid_t pid;
+	int status;
+
+	(void) fflush(stdout);
+	if ((pid = fork()) < 0)
+		err(EXIT_FAILURE, "fork");
+
+	if (pid == 0) {
+		ops = bp->bp_run(b);
+		if (getrusage(RUSAGE_SELF, &ru) < 0)
+			err(EXIT_FAILURE, "getrusage");
+		(void) printf("%-12s %12ju %9.3f %12.0f %12ju %10ld\n",
+		    bp->bp_name, (uintmax_t) ops, bench_secs,
+		    bench_secs > 0 ? ops / bench_secs : 0,
+		    (uintmax_t) bench_allocs, ru.ru_maxrss);
+		(void) fflush(stdout);
+		_exit(EXIT_SUCCESS);
+	}
+
+	if (waitpid(pid, &status, 0) < 0)
+		err(EXIT_FAILURE, "waitpid");
+	if (!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS) {
+		warnx("%s: benchmark failed", bp->bp_name);
+		return (-1);
+	}
+
+	return (0);
+}
+
+static unsigned
+bench_number(const char *s, int c)
+{
+	char *end;
+	unsigned long v;
+
+	v = strtoul(s, &end, 0);
+	if (*s == '\0' || *end != '\0' || v > UINT32_MAX)
+		errx(EXIT_FAILURE, "-%c: invalid number \"%s\"", c, s);
+
+	return ((unsigned) v);
+}
+
+static void
+usage(void)
+{
+
+	(void) fprintf(stderr, "usage: %s [-d depth] [-f funcs] "
+	    "[-l lines] [-n lookups] [-o file]\n"
+	    "       [-r repeat] [-u units] [file]\n", ELFTC_GETPROGNAME());
+	exit(EXIT_FAILURE);
+}
+
+int
+main(int argc, char **argv)
+{
+	struct bench b;
+	struct bench_phase *bp;
+	char tmpl[] = "/tmp/dwarfbench.XXXXXX";
+	int c, fd, keep, status;
+
+	memset(&b, 0, sizeof(b));
+	b.b_nlookup = 200000;
+	b.b_nstartup = 100;
+	b.b_corpus.bc_units = 100000;
+	b.b_corpus.bc_funcs = 4;
+	b.b_corpus.bc_depth = 1000;
+	b.b_corpus.bc_lines = 1000000;
+	keep = 0;
+
+	while ((c = getopt(argc, argv, "d:f:l:n:o:r:u:")) != -1) {
+		switch (c) {
+		case 'd':
+			b.b_corpus.bc_depth = bench_number(optarg, c);
+			break;
+		case 'f':
+			b.b_corpus.bc_funcs = bench_number(optarg, c);
+			break;
+		case 'l':
+			b.b_corpus.bc_lines = bench_number(optarg, c);
+			break;
+		case 'n':
+			b.b_nlookup = bench_number(optarg, c);
+			break;
+		case 'o':
+			b.b_path = optarg;
+			keep = 1;
+			break;
+		case 'r':
+			b.b_nstartup = bench_number(optarg, c);
+			break;
+		case 'u':
+			b.b_corpus.bc_units = bench_number(optarg, c);
+			break;
+		default:
+			usage();
+		}
+	}
+	argc -= optind;
+	argv += optind;
+
+	if (argc > 1 || (argc == 1 && b.b_path != NULL))
+		usage();
+	if (b.b_corpus.bc_units < 2 || b.b_corpus.bc_funcs == 0)
+		errx(EXIT_FAILURE, "at least 2 units of 1 function needed");
+
+	if (elf_version(EV_CURRENT) == EV_NONE)
+		errx(EXIT_FAILURE, "elf_version: %s", elf_errmsg(-1));
+
+	(void) printf("%-12s %12s %9s %12s %12s %10s\n", "benchmark", "ops",
+	    "seconds", "ops/sec", "allocs", "maxrss(KB)");
+
+	if (argc == 1) {
+		b.b_path = argv[0];
+		keep = 1;
+	} else if (b.b_path == NULL) {
+		if ((fd = mkstemp(tmpl)) < 0)
+			err(EXIT_FAILURE, "mkstemp");
+		(void) close(fd);
+		b.b_path = tmpl;
+	}
+
+	status = EXIT_SUCCESS;
+	if (argc == 0 && bench_run(&b, &bench_gen_phase) < 0)
+		status = EXIT_FAILURE;
+	for (bp = bench_phases; status == EXIT_SUCCESS && bp->bp_name != NULL;
+	     bp++) {
+		if (bench_run(&b, bp) < 0)
+			status = EXIT_FAILURE;
+	}
+
+	if (!keep)
+		(void) unlink(b.b_path);
+
+	exit(status);
+}
@@ -0,0 +1,50 @@
+/*-
+ * Copyright (c) 2026 The Elftoolchain Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * $Id$
+ */
+
+#ifndef	_DWARFBENCH_H_
+#define	_DWARFBENCH_H_
+
+/* Parameters of the generated corpus. */
+struct bench_corpus {
+	unsigned	bc_units;	/* Number of compilation units. */
+	unsigned	bc_funcs;	/* Functions per unit. */
+	unsigned	bc_depth;	/* Depth of the nested type tree. */
+	unsigned	bc_lines;	/* Rows of the large line program. */
+};
+
+#define	BENCH_TEXT_BASE		0x400000 /* Address of the first function. */
+#define	BENCH_FUNC_SIZE		64	/* Size of a generated function. */
+#define	BENCH_LINE_STEP		4	/* Address step of line rows. */
+#define	BENCH_DEEP_UNIT		0	/* Unit holding the type tree. */
+#define	BENCH_LINES_UNIT	1	/* Unit holding the large line table. */
+
+extern uint64_t	bench_nalloc;
+
+uint64_t	bench_generate(const char *, struct bench_corpus *);
+
+#endif	/* _DWARFBENCH_H_ */
@@ -0,0 +1,505 @@
+/*-
+ * Copyright (c) 2026 The Elftoolchain Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/*
+ * Generate a synthetic corpus for the benchmarks.
+ *
+ * The producer emits a single compilation unit per Dwarf_P_Debug, so
+ * each unit is produced by its own producer instance.  The sections of
+ * successive units are concatenated, and the symbolic relocations that
+ * reference debug sections are resolved against the offset at which
+ * the referenced section of the unit was placed, much as a linker
+ * would.  Target addresses are absolute and need no relocation.
+ */
+
+#include <sys/types.h>
+
+#include <err.h>
+#include <fcntl.h>
+#include <gelf.h>
+#include <libelf.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "dwarf.h"
+#include "libdwarf.h"
+
+#include "_elftc.h"
+#include "dwarfbench.h"
+
+ELFTC_VCSID("$Id$");
+
+/* Id given to relocation sections and to sections that are not kept. */
+#define	GEN_OTHER	63
+
+/* Symbol index used for code addresses, which are left as they are. */
+#define	GEN_TEXT	62
+
+struct gen_sec {
+	const char	*gs_name;	/* Section name. */
+	unsigned char	*gs_buf;	/* Concatenated contents. */
+	size_t		gs_size;	/* Size of the contents. */
+	size_t		gs_cap;		/* Capacity of the buffer. */
+	size_t		gs_base;	/* Offset of the current unit. */
+};
+
+static struct gen_sec gen_secs[] = {
+	{ ".debug_info", NULL, 0, 0, 0 },
+	{ ".debug_abbrev", NULL, 0, 0, 0 },
+	{ ".debug_line", NULL, 0, 0, 0 },
+	{ ".debug_str", NULL, 0, 0, 0 },
+	{ ".debug_frame", NULL, 0, 0, 0 },
+	{ ".debug_aranges", NULL, 0, 0, 0 },
+	{ ".debug_pubnames", NULL, 0, 0, 0 },
+};
+
+#define	GEN_NSECS	(sizeof(gen_secs) / sizeof(gen_secs[0]))
+
+/* Initial instructions shared by all CIEs: DW_CFA_def_cfa rsp+8. */
+static unsigned char gen_cie_inst[] = { DW_CFA_def_cfa, 7, 8 };
+
+static int
+gen_callback(char *name, int size, Dwarf_Unsigned type, Dwarf_Unsigned flags,
+    Dwarf_Unsigned link, Dwarf_Unsigned info, Dwarf_Unsigned *index,
+    int *error)
+{
+	size_t i;
+
+	(void) size;
+	(void) type;
+	(void) flags;
+	(void) link;
+	(void) info;
+	(void) error;
+
+	/*
+	 * Section ids double as the symbol index of each section, which
+	 * is what the relocation entries refer to.
+	 */
+	for (i = 0; i < GEN_NSECS; i++) {
+		if (strcmp(name, gen_secs[i].gs_name) == 0) {
+			*index = i + 1;
+			return (i + 1);
+		}
+	}
+
+	*index = GEN_OTHER;
+	return (GEN_OTHER);
+}
+
+static struct gen_sec *
+gen_sec_find(Dwarf_Signed id)
+{
+
+	if (id < 1 || (size_t) id > GEN_NSECS)
+		return (NULL);
+
+	return (&gen_secs[id - 1]);
+}
+
+static void
+gen_sec_append(struct gen_sec *gs, const void *buf, size_t len)
+{
+	unsigned char *p;
+	size_t cap;
+
+	if (gs->gs_size + len > gs->gs_cap) {
+		cap = gs->gs_cap > 0 ? gs->gs_cap : 4096;
+		while (cap < gs->gs_size + len)
+			cap *= 2;
+		if ((p = realloc(gs->gs_buf, cap)) == NULL)
+			err(EXIT_FAILURE, "realloc");
+		gs->gs_buf = p;
+		gs->gs_cap = cap;
+	}
+
+	memcpy(gs->gs_buf + gs->gs_size, buf, len);
+	gs->gs_size += len;
+}
+
+/*
+ * Add the offset of the referenced section of the current unit to a
+ * little-endian value in the relocated section.
+ */
+static void
+gen_reloc_apply(struct gen_sec *gs, Dwarf_Relocation_Data drd,
+    size_t base)
+{
+	unsigned char *p;
+	uint64_t v;
+	int i;
+
+	if (drd->drd_type != dwarf_drt_data_reloc)
+		errx(EXIT_FAILURE, "unexpected relocation type %d",
+		    drd->drd_type);
+
+	p = gs->gs_buf + gs->gs_base + drd->drd_offset;
+	v = 0;
+	for (i = drd->drd_length - 1; i >= 0; i--)
+		v = (v << 8) | p[i];
+	v += base;
+	for (i = 0; i < drd->drd_length; i++, v >>= 8)
+		p[i] = v & 0xff;
+}
+
+static void
+gen_unit_collect(Dwarf_P_Debug dbg)
+{
+	Dwarf_Error de;
+	Dwarf_Relocation_Data drd;
+	Dwarf_Ptr buf;
+	Dwarf_Signed cnt, i, id, link;
+	Dwarf_Unsigned j, len, nrel;
+	struct gen_sec *gs, *ref;
+	size_t k;
+	int version;
+
+	if ((cnt = dwarf_transform_to_disk_form(dbg, &de)) == DW_DLV_NOCOUNT)
+		errx(EXIT_FAILURE, "dwarf_transform_to_disk_form: %s",
+		    dwarf_errmsg(de));
+
+	for (k = 0; k < GEN_NSECS; k++)
+		gen_secs[k].gs_base = gen_secs[k].gs_size;
+
+	for (i = 0; i < cnt; i++) {
+		buf = dwarf_get_section_bytes(dbg, i, &id, &len, &de);
+		if (buf == NULL)
+			errx(EXIT_FAILURE, "dwarf_get_section_bytes: %s",
+			    dwarf_errmsg(de));
+		if ((gs = gen_sec_find(id)) != NULL)
+			gen_sec_append(gs, buf, len);
+	}
+
+	if (dwarf_get_relocation_info_count(dbg, &nrel, &version, &de) !=
+	    DW_DLV_OK)
+		errx(EXIT_FAILURE, "dwarf_get_relocation_info_count: %s",
+		    dwarf_errmsg(de));
+
+	while (nrel-- > 0) {
+		if (dwarf_get_relocation_info(dbg, &id, &link, &len, &drd,
+		    &de) != DW_DLV_OK)
+			errx(EXIT_FAILURE, "dwarf_get_relocation_info: %s",
+			    dwarf_errmsg(de));
+		if ((gs = gen_sec_find(link)) == NULL)
+			continue;
+		for (j = 0; j < len; j++) {
+			if ((ref = gen_sec_find(drd[j].drd_symbol_index)) !=
+			    NULL)
+				gen_reloc_apply(gs, &drd[j], ref->gs_base);
+		}
+	}
+}
+
+static Dwarf_P_Die
+gen_die(Dwarf_P_Debug dbg, Dwarf_Tag tag, Dwarf_P_Die parent,
+    const char *name)
+{
+	Dwarf_Error de;
+	Dwarf_P_Die die;
+	char buf[64];
+
+	die = dwarf_new_die(dbg, tag, parent, NULL, NULL, NULL, &de);
+	if (die == DW_DLV_BADADDR)
+		errx(EXIT_FAILURE, "dwarf_new_die: %s", dwarf_errmsg(de));
+
+	if (name != NULL) {
+		(void) snprintf(buf, sizeof(buf), "%s", name);
+		if (dwarf_add_AT_name(die, buf, &de) == DW_DLV_BADADDR)
+			errx(EXIT_FAILURE, "dwarf_add_AT_name: %s",
+			    dwarf_errmsg(de));
+	}
+
+	return (die);
+}
+
+#define	GEN_CHECK(e, f) do {						\
+	if ((e) == DW_DLV_BADADDR)					\
+		errx(EXIT_FAILURE, "%s: %s", (f), dwarf_errmsg(de));	\
+} while (0)
+
+#define	GEN_CHECKN(e, f) do {						\
+	if ((Dwarf_Signed) (e) == DW_DLV_NOCOUNT)			\
+		errx(EXIT_FAILURE, "%s: %s", (f), dwarf_errmsg(de));	\
+} while (0)
+
+/*
+ * A chain of nested structure types, each with a member whose type
+ * is the next structure in the chain.
+ */
+static void
+gen_type_tree(Dwarf_P_Debug dbg, Dwarf_P_Die parent, Dwarf_P_Die base,
+    unsigned depth)
+{
+	Dwarf_Error de;
+	Dwarf_P_Die m, s;
+	char name[32];
+	unsigned d;
+
+	m = NULL;
+	for (d = 0; d < depth; d++) {
+		(void) snprintf(name, sizeof(name), "s%u", d);
+		s = gen_die(dbg, DW_TAG_structure_type, parent, name);
+		GEN_CHECK(dwarf_add_AT_unsigned_const(dbg, s, DW_AT_byte_size,
+		    8 * (depth - d), &de), "dwarf_add_AT_unsigned_const");
+		if (m != NULL)
+			GEN_CHECK(dwarf_add_AT_reference(dbg, m, DW_AT_type, s,
+			    &de), "dwarf_add_AT_reference");
+		m = gen_die(dbg, DW_TAG_member, s, "m");
+		parent = s;
+	}
+	if (m != NULL)
+		GEN_CHECK(dwarf_add_AT_reference(dbg, m, DW_AT_type, base,
+		    &de), "dwarf_add_AT_reference");
+}
+
+static void
+gen_lines(Dwarf_P_Debug dbg, Dwarf_Unsigned file, Dwarf_Addr pc,
+    Dwarf_Unsigned size, Dwarf_Unsigned *line)
+{
+	Dwarf_Error de;
+	Dwarf_Unsigned off;
+
+	for (off = 0; off < size; off += BENCH_LINE_STEP)
+		GEN_CHECKN(dwarf_add_line_entry(dbg, file, pc + off,
+		    (*line)++, 0, 1, 0, &de), "dwarf_add_line_entry");
+}
+
+static void
+gen_func(Dwarf_P_Debug dbg, Dwarf_P_Die cu, Dwarf_P_Die base,
+    Dwarf_Unsigned cie, const char *name, Dwarf_Addr pc, Dwarf_Unsigned size)
+{
+	Dwarf_Error de;
+	Dwarf_P_Die sp;
+	Dwarf_P_Fde fde;
+
+	sp = gen_die(dbg, DW_TAG_subprogram, cu, name);
+	GEN_CHECK(dwarf_add_AT_flag(dbg, sp, DW_AT_external, 1, &de),
+	    "dwarf_add_AT_flag");
+	GEN_CHECK(dwarf_add_AT_reference(dbg, sp, DW_AT_type, base, &de),
+	    "dwarf_add_AT_reference");
+	GEN_CHECK(dwarf_add_AT_targ_address(dbg, sp, DW_AT_low_pc, pc,
+	    GEN_TEXT, &de), "dwarf_add_AT_targ_address");
+	GEN_CHECK(dwarf_add_AT_targ_address(dbg, sp, DW_AT_high_pc,
+	    pc + size, GEN_TEXT, &de), "dwarf_add_AT_targ_address");
+	(void) gen_die(dbg, DW_TAG_variable, sp, "v");
+	GEN_CHECKN(dwarf_add_pubname(dbg, sp, (char *) (uintptr_t) name,
+	    &de), "dwarf_add_pubname");
+
+	if ((fde = dwarf_new_fde(dbg, &de)) == DW_DLV_BADADDR)
+		errx(EXIT_FAILURE, "dwarf_new_fde: %s", dwarf_errmsg(de));
+	GEN_CHECK(dwarf_add_fde_inst(fde, DW_CFA_advance_loc, 1, 0, &de),
+	    "dwarf_add_fde_inst");
+	GEN_CHECK(dwarf_add_fde_inst(fde, DW_CFA_def_cfa_offset, 16, 0, &de),
+	    "dwarf_add_fde_inst");
+	GEN_CHECKN(dwarf_add_frame_fde(dbg, fde, sp, cie, pc, size, GEN_TEXT,
+	    &de), "dwarf_add_frame_fde");
+}
+
+static Dwarf_Addr
+gen_unit(struct bench_corpus *bc, unsigned u, Dwarf_Addr pc)
+{
+	Dwarf_Error de;
+	Dwarf_P_Debug dbg;
+	Dwarf_P_Die base, cu;
+	Dwarf_Unsigned cie, file, line;
+	Dwarf_Addr lowpc;
+	char name[64];
+	unsigned f;
+
+	dbg = dwarf_producer_init_b(DW_DLC_WRITE | DW_DLC_SIZE_64 |
+	    DW_DLC_SYMBOLIC_RELOCATIONS | DW_DLC_TARGET_LITTLEENDIAN,
+	    gen_callback, NULL, NULL, &de);
+	if (dbg == DW_DLV_BADADDR)
+		errx(EXIT_FAILURE, "dwarf_producer_init_b: %s",
+		    dwarf_errmsg(de));
+
+	(void) snprintf(name, sizeof(name), "unit%u.c", u);
+	cu = gen_die(dbg, DW_TAG_compile_unit, NULL, name);
+	GEN_CHECK(dwarf_add_AT_unsigned_const(dbg, cu, DW_AT_language,
+	    DW_LANG_C99, &de), "dwarf_add_AT_unsigned_const");
+	GEN_CHECKN(file = dwarf_add_file_decl(dbg, name, 0, 0, 0, &de),
+	    "dwarf_add_file_decl");
+
+	base = gen_die(dbg, DW_TAG_base_type, cu, "int");
+	GEN_CHECK(dwarf_add_AT_unsigned_const(dbg, base, DW_AT_byte_size, 4,
+	    &de), "dwarf_add_AT_unsigned_const");
+	GEN_CHECK(dwarf_add_AT_unsigned_const(dbg, base, DW_AT_encoding,
+	    DW_ATE_signed, &de), "dwarf_add_AT_unsigned_const");
+
+	if (u == BENCH_DEEP_UNIT)
+		gen_type_tree(dbg, cu, base, bc->bc_depth);
+
+	GEN_CHECKN(cie = dwarf_add_frame_cie(dbg, "", 1, -8, 16,
+	    gen_cie_inst, sizeof(gen_cie_inst), &de), "dwarf_add_frame_cie");
+	GEN_CHECKN(dwarf_lne_set_address(dbg, pc, GEN_TEXT, &de),
+	    "dwarf_lne_set_address");
+
+	/*
+	 * The line program generator drops a row that matches the state
+	 * registers, so the first row must not sit on the initial line 1.
+	 */
+	lowpc = pc;
+	line = 2;
+	for (f = 0; f < bc->bc_funcs; f++) {
+		(void) snprintf(name, sizeof(name), "f%u_%u", u, f);
+		gen_func(dbg, cu, base, cie, name, pc, BENCH_FUNC_SIZE);
+		gen_lines(dbg, file, pc, BENCH_FUNC_SIZE, &line);
+		pc += BENCH_FUNC_SIZE;
+	}
+	if (u == BENCH_LINES_UNIT && bc->bc_lines > 0) {
+		(void) snprintf(name, sizeof(name), "big%u", u);
+		gen_func(dbg, cu, base, cie, name, pc,
+		    (Dwarf_Unsigned) bc->bc_lines * BENCH_LINE_STEP);
+		gen_lines(dbg, file, pc,
+		    (Dwarf_Unsigned) bc->bc_lines * BENCH_LINE_STEP, &line);
+		pc += (Dwarf_Addr) bc->bc_lines * BENCH_LINE_STEP;
+	}
+	GEN_CHECKN(dwarf_lne_end_sequence(dbg, pc, &de),
+	    "dwarf_lne_end_sequence");
+
+	GEN_CHECK(dwarf_add_AT_targ_address(dbg, cu, DW_AT_low_pc, lowpc,
+	    GEN_TEXT, &de), "dwarf_add_AT_targ_address");
+	GEN_CHECK(dwarf_add_AT_targ_address(dbg, cu, DW_AT_high_pc, pc,
+	    GEN_TEXT, &de), "dwarf_add_AT_targ_address");
+	GEN_CHECKN(dwarf_add_arange(dbg, lowpc, pc - lowpc, GEN_TEXT, &de),
+	    "dwarf_add_arange");
+	GEN_CHECKN(dwarf_add_die_to_debug(dbg, cu, &de),
+	    "dwarf_add_die_to_debug");
+
+	gen_unit_collect(dbg);
+
+	GEN_CHECKN(dwarf_producer_finish(dbg, &de), "dwarf_producer_finish");
+
+	return (pc);
+}
+
+static void
+gen_write(const char *path)
+{
+	Elf *e;
+	Elf_Data *d;
+	Elf_Scn *scn;
+	GElf_Ehdr eh;
+	GElf_Shdr sh;
+	char *shstr;
+	size_t i, len, shstrsz;
+	int fd;
+
+	if ((fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644)) < 0)
+		err(EXIT_FAILURE, "%s", path);
+	if ((e = elf_begin(fd, ELF_C_WRITE, NULL)) == NULL)
+		errx(EXIT_FAILURE, "elf_begin: %s", elf_errmsg(-1));
+	if (gelf_newehdr(e, ELFCLASS64) == NULL)
+		errx(EXIT_FAILURE, "gelf_newehdr: %s", elf_errmsg(-1));
+	if (gelf_getehdr(e, &eh) == NULL)
+		errx(EXIT_FAILURE, "gelf_getehdr: %s", elf_errmsg(-1));
+	eh.e_ident[EI_DATA] = ELFDATA2LSB;
+	eh.e_type = ET_REL;
+	eh.e_machine = EM_X86_64;
+	eh.e_version = EV_CURRENT;
+
+	/* Section name string table: "\0.shstrtab\0" and the names. */
+	shstrsz = sizeof(".shstrtab") + 1;
+	for (i = 0; i < GEN_NSECS; i++)
+		shstrsz += strlen(gen_secs[i].gs_name) + 1;
+	if ((shstr = calloc(1, shstrsz)) == NULL)
+		err(EXIT_FAILURE, "calloc");
+	len = 1;
+
+	for (i = 0; i < GEN_NSECS; i++) {
+		if (gen_secs[i].gs_size == 0)
+			continue;
+		if ((scn = elf_newscn(e)) == NULL ||
+		    (d = elf_newdata(scn)) == NULL)
+			errx(EXIT_FAILURE, "elf_newscn: %s", elf_errmsg(-1));
+		d->d_align = 1;
+		d->d_buf = gen_secs[i].gs_buf;
+		d->d_size = gen_secs[i].gs_size;
+		d->d_type = ELF_T_BYTE;
+		d->d_version = EV_CURRENT;
+		if (gelf_getshdr(scn, &sh) == NULL)
+			errx(EXIT_FAILURE, "gelf_getshdr: %s", elf_errmsg(-1));
+		sh.sh_name = len;
+		sh.sh_type = SHT_PROGBITS;
+		sh.sh_addralign = 1;
+		if (gelf_update_shdr(scn, &sh) == 0)
+			errx(EXIT_FAILURE, "gelf_update_shdr: %s",
+			    elf_errmsg(-1));
+		(void) strcpy(shstr + len, gen_secs[i].gs_name);
+		len += strlen(gen_secs[i].gs_name) + 1;
+	}
+
+	if ((scn = elf_newscn(e)) == NULL || (d = elf_newdata(scn)) == NULL)
+		errx(EXIT_FAILURE, "elf_newscn: %s", elf_errmsg(-1));
+	(void) strcpy(shstr + len, ".shstrtab");
+	d->d_align = 1;
+	d->d_buf = shstr;
+	d->d_size = len + sizeof(".shstrtab");
+	d->d_type = ELF_T_BYTE;
+	d->d_version = EV_CURRENT;
+	if (gelf_getshdr(scn, &sh) == NULL)
+		errx(EXIT_FAILURE, "gelf_getshdr: %s", elf_errmsg(-1));
+	sh.sh_name = len;
+	sh.sh_type = SHT_STRTAB;
+	sh.sh_addralign = 1;
+	if (gelf_update_shdr(scn, &sh) == 0)
+		errx(EXIT_FAILURE, "gelf_update_shdr: %s", elf_errmsg(-1));
+	eh.e_shstrndx = elf_ndxscn(scn);
+
+	if (gelf_update_ehdr(e, &eh) == 0)
+		errx(EXIT_FAILURE, "gelf_update_ehdr: %s", elf_errmsg(-1));
+	if (elf_update(e, ELF_C_WRITE) < 0)
+		errx(EXIT_FAILURE, "elf_update: %s", elf_errmsg(-1));
+
+	(void) elf_end(e);
+	(void) close(fd);
+	free(shstr);
+}
+
+uint64_t
+bench_generate(const char *path, struct bench_corpus *bc)
+{
+	Dwarf_Addr pc;
+	size_t i;
+	unsigned u;
+
+	pc = BENCH_TEXT_BASE;
+	for (u = 0; u < bc->bc_units; u++)
+		pc = gen_unit(bc, u, pc);
+
+	gen_write(path);
+
+	for (i = 0; i < GEN_NSECS; i++) {
+		free(gen_secs[i].gs_buf);
+		gen_secs[i].gs_buf = NULL;
+		gen_secs[i].gs_size = gen_secs[i].gs_cap = 0;
+	}
+
+	return (bc->bc_units);
+}
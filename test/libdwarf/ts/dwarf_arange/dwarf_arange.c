@@ -31,6 +31,7 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <libdwarf.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "driver.h"
@@ -40,8 +41,12 @@
  * Test case for dwarf address range API.
  */
 static void tp_dwarf_arange(void);
+static void tp_dwarf_arange_lookup(void);
+static void tp_dwarf_arange_synth(void);
 static struct dwarf_tp dwarf_tp_array[] = {
 	{"tp_dwarf_arange", tp_dwarf_arange},
+	{"tp_dwarf_arange_lookup", tp_dwarf_arange_lookup},
+	{"tp_dwarf_arange_synth", tp_dwarf_arange_synth},
 	{NULL, NULL},
 };
 static int result = TET_UNRESOLVED;
@@ -118,6 +123,180 @@ tp_dwarf_arange(void)
 	}
 
 
+	if (result == TET_UNRESOLVED)
+		result = TET_PASS;
+
+done:
+	TS_DWARF_FINISH(dbg, de);
+	TS_RESULT(result);
+}
+
+/*
+ * Look up `addr' in the array returned by dwarf_get_aranges(), which is
+ * searched through the library's sorted index, and in a copy of it,
+ * which is searched linearly.  Both must agree on whether `addr' is
+ * covered, and the descriptor found must cover it.
+ */
+static void
+_dwarf_arange_lookup(Dwarf_Arange *aranges, Dwarf_Arange *copy,
+    Dwarf_Signed arange_cnt, Dwarf_Addr addr)
+{
+	Dwarf_Arange arange, arange2;
+	Dwarf_Addr start;
+	Dwarf_Unsigned length;
+	Dwarf_Off cu_die_offset;
+	Dwarf_Error de;
+	int r_arange, r_arange2, agree, covered;
+
+	r_arange = dwarf_get_arange(aranges, arange_cnt, addr, &arange, &de);
+	TS_CHECK_INT(r_arange);
+	r_arange2 = dwarf_get_arange(copy, arange_cnt, addr, &arange2, &de);
+	agree = r_arange == r_arange2;
+	TS_CHECK_INT(agree);
+	if (r_arange != DW_DLV_OK)
+		return;
+
+	if (dwarf_get_arange_info(arange, &start, &length, &cu_die_offset,
+	    &de) != DW_DLV_OK) {
+		tet_printf("dwarf_get_arange_info failed: %s\n",
+		    dwarf_errmsg(de));
+		result = TET_FAIL;
+		return;
+	}
+	covered = addr >= start && addr - start < length;
+	TS_CHECK_INT(covered);
+	TS_CHECK_UINT(start);
+	TS_CHECK_UINT(length);
+	TS_CHECK_UINT(cu_die_offset);
+}
+
+static void
+tp_dwarf_arange_lookup(void)
+{
+	Dwarf_Debug dbg;
+	Dwarf_Arange *aranges, *copy;
+	Dwarf_Signed arange_cnt;
+	Dwarf_Addr start;
+	Dwarf_Unsigned length;
+	Dwarf_Off cu_die_offset;
+	Dwarf_Error de;
+	int fd, i, r_aranges;
+
+	result = TET_UNRESOLVED;
+	copy = NULL;
+
+	TS_DWARF_INIT(dbg, fd, de);
+
+	r_aranges = dwarf_get_aranges(dbg, &aranges, &arange_cnt, &de);
+	TS_CHECK_INT(r_aranges);
+	if (r_aranges == DW_DLV_ERROR) {
+		tet_printf("dwarf_get_aranges failed: %s\n", dwarf_errmsg(de));
+		result = TET_FAIL;
+		goto done;
+	}
+	if (r_aranges == DW_DLV_NO_ENTRY) {
+		result = TET_PASS;
+		goto done;
+	}
+
+	if ((copy = malloc(arange_cnt * sizeof(Dwarf_Arange))) == NULL) {
+		tet_infoline("malloc failed");
+		result = TET_FAIL;
+		goto done;
+	}
+	memcpy(copy, aranges, arange_cnt * sizeof(Dwarf_Arange));
+
+	/* Probe both ends of every range and the addresses next to them. */
+	for (i = 0; i < arange_cnt; i++) {
+		if (dwarf_get_arange_info(aranges[i], &start, &length,
+		    &cu_die_offset, &de) != DW_DLV_OK) {
+			tet_printf("dwarf_get_arange_info failed: %s\n",
+			    dwarf_errmsg(de));
+			result = TET_FAIL;
+			continue;
+		}
+		if (start > 0)
+			_dwarf_arange_lookup(aranges, copy, arange_cnt,
+			    start - 1);
+		_dwarf_arange_lookup(aranges, copy, arange_cnt, start);
+		if (length == 0)
+			continue;
+		_dwarf_arange_lookup(aranges, copy, arange_cnt,
+		    start + length - 1);
+		_dwarf_arange_lookup(aranges, copy, arange_cnt,
+		    start + length);
+	}
+
+	if (result == TET_UNRESOLVED)
+		result = TET_PASS;
+
+done:
+	free(copy);
+	TS_DWARF_FINISH(dbg, de);
+	TS_RESULT(result);
+}
+
+static void
+tp_dwarf_arange_synth(void)
+{
+	Dwarf_Debug dbg;
+	Dwarf_Arange *aranges, *aranges2;
+	Dwarf_Signed arange_cnt, arange_cnt2;
+	Dwarf_Addr start;
+	Dwarf_Unsigned length;
+	Dwarf_Off cu_die_offset;
+	Dwarf_Error de;
+	int fd, i, r_aranges, oldsynth, same_table;
+
+	result = TET_UNRESOLVED;
+
+	TS_DWARF_INIT(dbg, fd, de);
+
+	/*
+	 * Address ranges are synthesized from the CU DIEs only if the
+	 * object has no .debug_aranges section.
+	 */
+	oldsynth = dwarf_set_aranges_synthesis(dbg, 1);
+	TS_CHECK_INT(oldsynth);
+	r_aranges = dwarf_get_aranges(dbg, &aranges, &arange_cnt, &de);
+	TS_CHECK_INT(r_aranges);
+	if (r_aranges == DW_DLV_ERROR) {
+		tet_printf("dwarf_get_aranges failed: %s\n", dwarf_errmsg(de));
+		result = TET_FAIL;
+		goto done;
+	}
+	if (r_aranges == DW_DLV_NO_ENTRY) {
+		result = TET_PASS;
+		goto done;
+	}
+
+	TS_CHECK_INT(arange_cnt);
+	for (i = 0; i < arange_cnt; i++) {
+		if (dwarf_get_arange_info(aranges[i], &start, &length,
+		    &cu_die_offset, &de) != DW_DLV_OK) {
+			tet_printf("dwarf_get_arange_info failed: %s\n",
+			    dwarf_errmsg(de));
+			result = TET_FAIL;
+			continue;
+		}
+		TS_CHECK_UINT(start);
+		TS_CHECK_UINT(length);
+		TS_CHECK_UINT(cu_die_offset);
+	}
+
+	/*
+	 * The table is built once: turning synthesis off afterwards does
+	 * not change it.
+	 */
+	oldsynth = dwarf_set_aranges_synthesis(dbg, 0);
+	TS_CHECK_INT(oldsynth);
+	r_aranges = dwarf_get_aranges(dbg, &aranges2, &arange_cnt2, &de);
+	TS_CHECK_INT(r_aranges);
+	if (r_aranges == DW_DLV_OK) {
+		same_table = aranges2 == aranges && arange_cnt2 == arange_cnt;
+		TS_CHECK_INT(same_table);
+	}
+
 	if (result == TET_UNRESOLVED)
 		result = TET_PASS;
 
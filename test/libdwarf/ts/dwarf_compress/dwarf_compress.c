@@ -0,0 +1,193 @@
+/*-
+ * Copyright (c) 2026 The Elftoolchain Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * $Id$
+ */
+
+#include <assert.h>
+#include <dwarf.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <libdwarf.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "driver.h"
+#include "tet_api.h"
+
+/*
+ * Test case for reading compressed debug sections.
+ *
+ * The DIE and line information of the compressed objects is checked
+ * against that of their uncompressed originals by the dwarf_form,
+ * dwarf_lineno and dwarf_loclist test cases.  The first test purpose
+ * here checks that an object whose compression header, compressed data
+ * or section data is damaged is rejected with an error, either by
+ * dwarf_init() or when the section is first used.  The second one
+ * checks that section data is only decompressed or relocated when it
+ * is first used.
+ */
+static void tp_dwarf_compress(void);
+static void tp_dwarf_compress_lazy(void);
+static struct dwarf_tp dwarf_tp_array[] = {
+	{"tp_dwarf_compress", tp_dwarf_compress},
+	{"tp_dwarf_compress_lazy", tp_dwarf_compress_lazy},
+	{NULL, NULL},
+};
+static int result = TET_UNRESOLVED;
+#include "driver.c"
+
+static void
+_dwarf_compress_units(Dwarf_Debug dbg)
+{
+	Dwarf_Die die;
+	Dwarf_Error de;
+	Dwarf_Line *linebuf;
+	Dwarf_Signed linecount;
+	Dwarf_Unsigned next_offset;
+	int r_next, r_srclines, cu_count, errnum, elferrnum;
+
+	cu_count = 0;
+	while ((r_next = dwarf_next_cu_header(dbg, NULL, NULL, NULL, NULL,
+	    &next_offset, &de)) == DW_DLV_OK) {
+		cu_count++;
+		if (dwarf_siblingof(dbg, NULL, &die, &de) != DW_DLV_OK) {
+			tet_printf("dwarf_siblingof failed: %s",
+			    dwarf_errmsg(de));
+			result = TET_FAIL;
+			return;
+		}
+		r_srclines = dwarf_srclines(die, &linebuf, &linecount, &de);
+		TS_CHECK_INT(r_srclines);
+		if (r_srclines == DW_DLV_OK)
+			TS_CHECK_INT(linecount);
+		else if (r_srclines == DW_DLV_ERROR) {
+			errnum = dwarf_errno(de);
+			TS_CHECK_INT(errnum);
+			if (errnum == DW_DLE_ELF) {
+				elferrnum = de.err_elferror;
+				TS_CHECK_INT(elferrnum);
+			}
+		}
+	}
+	TS_CHECK_INT(cu_count);
+	TS_CHECK_INT(r_next);
+	if (r_next == DW_DLV_ERROR) {
+		errnum = dwarf_errno(de);
+		TS_CHECK_INT(errnum);
+	}
+}
+
+static void
+tp_dwarf_compress(void)
+{
+	Dwarf_Debug dbg;
+	Dwarf_Error de;
+	int fd, r_init, errnum;
+
+	result = TET_UNRESOLVED;
+
+	assert(_cur_file != NULL);
+	dbg = NULL;
+	if ((fd = open(_cur_file, O_RDONLY)) < 0) {
+		tet_printf("open %s failed: %s", _cur_file, strerror(errno));
+		result = TET_FAIL;
+		goto done;
+	}
+
+	r_init = dwarf_init(fd, DW_DLC_READ, NULL, NULL, &dbg, &de);
+	TS_CHECK_INT(r_init);
+	if (r_init == DW_DLV_ERROR) {
+		errnum = dwarf_errno(de);
+		TS_CHECK_INT(errnum);
+	} else if (r_init == DW_DLV_OK)
+		_dwarf_compress_units(dbg);
+
+	if (result == TET_UNRESOLVED)
+		result = TET_PASS;
+
+done:
+	if (dbg != NULL)
+		TS_DWARF_FINISH(dbg, de);
+	if (fd >= 0)
+		(void) close(fd);
+	TS_RESULT(result);
+}
+
+static void
+tp_dwarf_compress_lazy(void)
+{
+	Dwarf_Debug dbg;
+	Dwarf_Error de;
+	Dwarf_Memory_Usage mu0, mu;
+	int fd, r_init, sections_loaded;
+
+	result = TET_UNRESOLVED;
+
+	assert(_cur_file != NULL);
+	dbg = NULL;
+	if ((fd = open(_cur_file, O_RDONLY)) < 0) {
+		tet_printf("open %s failed: %s", _cur_file, strerror(errno));
+		result = TET_FAIL;
+		goto done;
+	}
+
+	/* Damaged objects are covered by tp_dwarf_compress. */
+	r_init = dwarf_init(fd, DW_DLC_READ, NULL, NULL, &dbg, &de);
+	if (r_init != DW_DLV_OK) {
+		result = TET_PASS;
+		goto done;
+	}
+
+	/*
+	 * Private copies of section data are made for decompressed and
+	 * relocated sections only, and only when the sections are used.
+	 */
+	if (dwarf_get_memory_usage(dbg, &mu0, &de) != DW_DLV_OK) {
+		tet_printf("dwarf_get_memory_usage failed: %s",
+		    dwarf_errmsg(de));
+		result = TET_FAIL;
+		goto done;
+	}
+	_dwarf_compress_units(dbg);
+	if (dwarf_get_memory_usage(dbg, &mu, &de) != DW_DLV_OK) {
+		tet_printf("dwarf_get_memory_usage failed: %s",
+		    dwarf_errmsg(de));
+		result = TET_FAIL;
+		goto done;
+	}
+	sections_loaded = mu.dmu_sections > mu0.dmu_sections;
+	TS_CHECK_INT(sections_loaded);
+
+	if (result == TET_UNRESOLVED)
+		result = TET_PASS;
+
+done:
+	if (dbg != NULL)
+		TS_DWARF_FINISH(dbg, de);
+	if (fd >= 0)
+		(void) close(fd);
+	TS_RESULT(result);
+}
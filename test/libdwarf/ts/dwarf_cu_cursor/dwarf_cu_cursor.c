@@ -0,0 +1,337 @@
+/*-
+ * Copyright (c) 2026 The Elftoolchain Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * $Id$
+ */
+
+#include <assert.h>
+#include <dwarf.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <libdwarf.h>
+#include <pthread.h>
+#include <string.h>
+
+#include "driver.h"
+#include "tet_api.h"
+
+/*
+ * Test case for the explicit unit cursors, used by a single thread and
+ * shared by several threads of a thread-safe debug context.
+ */
+static void tp_dwarf_cu_cursor(void);
+static void tp_dwarf_cu_cursor_threads(void);
+static struct dwarf_tp dwarf_tp_array[] = {
+	{"tp_dwarf_cu_cursor", tp_dwarf_cu_cursor},
+	{"tp_dwarf_cu_cursor_threads", tp_dwarf_cu_cursor_threads},
+	{NULL, NULL},
+};
+static int result = TET_UNRESOLVED;
+#include "driver.c"
+
+#define	_MAX_UNITS	256
+#define	_NTHREADS	4
+#define	_NROUNDS	8
+
+struct _unit {
+	Dwarf_Off	u_off;		/* Offset of the unit DIE. */
+	Dwarf_Unsigned	u_dies;		/* Number of DIEs in the unit. */
+	Dwarf_Signed	u_lines;	/* Number of line table rows. */
+	int		u_seen;		/* Times handed out. */
+};
+
+struct _walk {
+	Dwarf_Debug	w_dbg;
+	Dwarf_CU_Cursor	w_cc;
+	pthread_mutex_t	w_mtx;
+	struct _unit	w_units[_MAX_UNITS];
+	int		w_cnt;
+	int		w_error;
+};
+
+/*
+ * Count the DIEs of the tree rooted at "die", which is released.
+ */
+static int
+_dwarf_die_count(Dwarf_Debug dbg, Dwarf_Die die, Dwarf_Unsigned *cnt)
+{
+	Dwarf_Die child, sib;
+	Dwarf_Error de;
+	int r;
+
+	while (die != NULL) {
+		(*cnt)++;
+		r = dwarf_child(die, &child, &de);
+		if (r == DW_DLV_ERROR)
+			goto fail;
+		if (r == DW_DLV_OK && _dwarf_die_count(dbg, child, cnt) < 0)
+			goto fail;
+		r = dwarf_siblingof_b(dbg, die, &sib,
+		    dwarf_get_die_infotypes_flag(die), &de);
+		if (r == DW_DLV_ERROR)
+			goto fail;
+		dwarf_dealloc(dbg, die, DW_DLA_DIE);
+		die = r == DW_DLV_OK ? sib : NULL;
+	}
+
+	return (0);
+
+fail:
+	dwarf_dealloc(dbg, die, DW_DLA_DIE);
+	return (-1);
+}
+
+/*
+ * Take units from the cursor until it is exhausted and record what
+ * was found in each of them.
+ */
+static void *
+_dwarf_cu_walk(void *arg)
+{
+	struct _walk *w;
+	struct _unit u;
+	Dwarf_Die die;
+	Dwarf_Line *linebuf;
+	Dwarf_Error de;
+	int r;
+
+	w = arg;
+	while ((r = dwarf_cu_cursor_next(w->w_cc, &die, &de)) == DW_DLV_OK) {
+		memset(&u, 0, sizeof(u));
+		u.u_lines = -1;
+		if (dwarf_dieoffset(die, &u.u_off, &de) != DW_DLV_OK)
+			goto fail;
+		r = dwarf_srclines(die, &linebuf, &u.u_lines, &de);
+		if (r == DW_DLV_ERROR)
+			goto fail;
+		if (r == DW_DLV_OK)
+			dwarf_srclines_dealloc(w->w_dbg, linebuf, u.u_lines);
+		if (_dwarf_die_count(w->w_dbg, die, &u.u_dies) < 0)
+			goto fail_walk;
+		pthread_mutex_lock(&w->w_mtx);
+		if (w->w_cnt < _MAX_UNITS)
+			w->w_units[w->w_cnt++] = u;
+		else
+			w->w_error = 1;
+		pthread_mutex_unlock(&w->w_mtx);
+	}
+	if (r == DW_DLV_NO_ENTRY)
+		return (NULL);
+	goto fail_walk;
+
+fail:
+	dwarf_dealloc(w->w_dbg, die, DW_DLA_DIE);
+fail_walk:
+	pthread_mutex_lock(&w->w_mtx);
+	w->w_error = 1;
+	pthread_mutex_unlock(&w->w_mtx);
+	return (NULL);
+}
+
+static int
+_dwarf_cu_walk_init(Dwarf_Debug dbg, Dwarf_Bool is_info, struct _walk *w)
+{
+	Dwarf_Error de;
+	int r;
+
+	memset(w, 0, sizeof(*w));
+	w->w_dbg = dbg;
+	r = dwarf_cu_cursor_init(dbg, is_info, &w->w_cc, &de);
+	if (r == DW_DLV_ERROR) {
+		tet_printf("dwarf_cu_cursor_init failed: %s\n",
+		    dwarf_errmsg(de));
+		result = TET_FAIL;
+	}
+	if (r == DW_DLV_OK)
+		pthread_mutex_init(&w->w_mtx, NULL);
+
+	return (r);
+}
+
+static void
+_dwarf_cu_walk_fini(struct _walk *w)
+{
+
+	dwarf_cu_cursor_dealloc(w->w_cc);
+	pthread_mutex_destroy(&w->w_mtx);
+}
+
+static void
+tp_dwarf_cu_cursor(void)
+{
+	Dwarf_Debug dbg;
+	Dwarf_Error de;
+	Dwarf_Die die;
+	Dwarf_Off die_off;
+	Dwarf_Unsigned cu_next_offset;
+	struct _walk w;
+	int fd, i, is_info, r;
+
+	result = TET_UNRESOLVED;
+
+	TS_DWARF_INIT(dbg, fd, de);
+
+	for (is_info = 1; is_info >= 0; is_info--) {
+		r = _dwarf_cu_walk_init(dbg, is_info, &w);
+		TS_CHECK_INT(r);
+		if (r != DW_DLV_OK)
+			continue;
+		_dwarf_cu_walk(&w);
+		_dwarf_cu_walk_fini(&w);
+		TS_CHECK_INT(w.w_error);
+		TS_CHECK_INT(w.w_cnt);
+
+		/* The cursor visits the units in section order. */
+		i = 0;
+		TS_DWARF_CU_FOREACH2(dbg, is_info, cu_next_offset, de) {
+			if (dwarf_siblingof_b(dbg, NULL, &die, is_info,
+			    &de) != DW_DLV_OK) {
+				tet_printf("dwarf_siblingof_b failed: %s\n",
+				    dwarf_errmsg(de));
+				result = TET_FAIL;
+				goto done;
+			}
+			if (dwarf_dieoffset(die, &die_off, &de) != DW_DLV_OK) {
+				tet_printf("dwarf_dieoffset failed: %s\n",
+				    dwarf_errmsg(de));
+				result = TET_FAIL;
+				goto done;
+			}
+			dwarf_dealloc(dbg, die, DW_DLA_DIE);
+			if (i >= w.w_cnt || w.w_units[i].u_off != die_off) {
+				tet_printf("unit at offset %ju not visited in "
+				    "order\n", (uintmax_t) die_off);
+				result = TET_FAIL;
+				goto done;
+			}
+			TS_CHECK_UINT(w.w_units[i].u_off);
+			TS_CHECK_UINT(w.w_units[i].u_dies);
+			TS_CHECK_INT(w.w_units[i].u_lines);
+			i++;
+		}
+		if (i != w.w_cnt) {
+			tet_printf("cursor returned %d units, expected %d\n",
+			    w.w_cnt, i);
+			result = TET_FAIL;
+			goto done;
+		}
+	}
+
+	if (result == TET_UNRESOLVED)
+		result = TET_PASS;
+
+done:
+	TS_DWARF_FINISH(dbg, de);
+	TS_RESULT(result);
+}
+
+static void
+tp_dwarf_cu_cursor_threads(void)
+{
+	Dwarf_Debug dbg;
+	Dwarf_Error de;
+	pthread_t tid[_NTHREADS];
+	struct _walk ref, w;
+	struct _unit *u, *v;
+	int fd, i, j, n, is_info, r, round;
+
+	result = TET_UNRESOLVED;
+
+	TS_DWARF_INIT(dbg, fd, de);
+
+	if (dwarf_set_thread_safe(dbg, &de) != DW_DLV_OK) {
+		tet_printf("dwarf_set_thread_safe failed: %s\n",
+		    dwarf_errmsg(de));
+		result = TET_FAIL;
+		goto done;
+	}
+
+	for (is_info = 1; is_info >= 0; is_info--) {
+		/* A walk by a single thread gives the expected results. */
+		r = _dwarf_cu_walk_init(dbg, is_info, &ref);
+		TS_CHECK_INT(r);
+		if (r != DW_DLV_OK)
+			continue;
+		_dwarf_cu_walk(&ref);
+		_dwarf_cu_walk_fini(&ref);
+		TS_CHECK_INT(ref.w_error);
+		TS_CHECK_INT(ref.w_cnt);
+
+		for (round = 0; round < _NROUNDS; round++) {
+			if (_dwarf_cu_walk_init(dbg, is_info, &w) !=
+			    DW_DLV_OK)
+				goto done;
+			for (n = 0; n < _NTHREADS; n++)
+				if (pthread_create(&tid[n], NULL,
+				    _dwarf_cu_walk, &w) != 0)
+					break;
+			for (i = 0; i < n; i++)
+				pthread_join(tid[i], NULL);
+			_dwarf_cu_walk_fini(&w);
+			if (n != _NTHREADS) {
+				tet_printf("pthread_create failed\n");
+				result = TET_UNRESOLVED;
+				goto done;
+			}
+			if (w.w_error || w.w_cnt != ref.w_cnt) {
+				tet_printf("threads walked %d units, expected "
+				    "%d\n", w.w_cnt, ref.w_cnt);
+				result = TET_FAIL;
+				goto done;
+			}
+
+			/*
+			 * Each unit is handed to exactly one thread and
+			 * reads the same as in the single-threaded walk.
+			 */
+			for (i = 0; i < w.w_cnt; i++) {
+				u = &w.w_units[i];
+				for (j = 0; j < ref.w_cnt; j++) {
+					v = &ref.w_units[j];
+					if (v->u_off == u->u_off)
+						break;
+				}
+				if (j == ref.w_cnt || v->u_seen++ > 0 ||
+				    v->u_dies != u->u_dies ||
+				    v->u_lines != u->u_lines) {
+					tet_printf("unit at offset %ju "
+					    "mismatched\n",
+					    (uintmax_t) u->u_off);
+					result = TET_FAIL;
+					goto done;
+				}
+			}
+			for (j = 0; j < ref.w_cnt; j++)
+				ref.w_units[j].u_seen = 0;
+		}
+	}
+
+	if (result == TET_UNRESOLVED)
+		result = TET_PASS;
+
+done:
+	TS_DWARF_FINISH(dbg, de);
+	TS_RESULT(result);
+}
@@ -0,0 +1,203 @@
+/*-
+ * Copyright (c) 2026 The Elftoolchain Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * $Id$
+ */
+
+#include <assert.h>
+#include <dwarf.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <libdwarf.h>
+#include <string.h>
+
+#include "driver.h"
+#include "tet_api.h"
+
+/*
+ * Test case for the .debug_names lookup function dwarf_debugnames_lookup.
+ */
+static void tp_dwarf_debugnames_lookup(void);
+static void tp_dwarf_debugnames_sanity(void);
+static struct dwarf_tp dwarf_tp_array[] = {
+	{"tp_dwarf_debugnames_lookup", tp_dwarf_debugnames_lookup},
+	{"tp_dwarf_debugnames_sanity", tp_dwarf_debugnames_sanity},
+	{NULL, NULL},
+};
+static int result = TET_UNRESOLVED;
+static Dwarf_Debug _dbg;
+#include "driver.c"
+#include "die_traverse.c"
+
+static void
+_dwarf_debugnames_lookup(Dwarf_Die die)
+{
+	Dwarf_Die die0;
+	Dwarf_Off die_offset, *offsets;
+	Dwarf_Signed cnt, i;
+	Dwarf_Half tag, tag0;
+	Dwarf_Error de;
+	char *name;
+	int r_lookup, r_lookup_tag, found;
+
+	if (dwarf_diename(die, &name, &de) != DW_DLV_OK)
+		return;
+	if (dwarf_dieoffset(die, &die_offset, &de) != DW_DLV_OK) {
+		tet_printf("dwarf_dieoffset failed: %s\n", dwarf_errmsg(de));
+		result = TET_FAIL;
+		return;
+	}
+	if (dwarf_tag(die, &tag, &de) != DW_DLV_OK) {
+		tet_printf("dwarf_tag failed: %s\n", dwarf_errmsg(de));
+		result = TET_FAIL;
+		return;
+	}
+	TS_CHECK_STRING(name);
+
+	/* Look up the name with any tag. */
+	r_lookup = dwarf_debugnames_lookup(_dbg, name, 0, &offsets, &cnt,
+	    &de);
+	TS_CHECK_INT(r_lookup);
+	if (r_lookup == DW_DLV_ERROR) {
+		tet_printf("dwarf_debugnames_lookup failed: %s\n",
+		    dwarf_errmsg(de));
+		result = TET_FAIL;
+		return;
+	}
+	if (r_lookup != DW_DLV_OK)
+		return;
+	TS_CHECK_INT(cnt);
+	for (i = 0; i < cnt; i++)
+		TS_CHECK_UINT(offsets[i]);
+	dwarf_dealloc(_dbg, offsets, DW_DLA_LIST);
+
+	/*
+	 * Look up the name with the tag of the DIE.  Every DIE returned
+	 * should have this tag, and the DIE itself should be found.
+	 */
+	r_lookup_tag = dwarf_debugnames_lookup(_dbg, name, tag, &offsets,
+	    &cnt, &de);
+	TS_CHECK_INT(r_lookup_tag);
+	if (r_lookup_tag != DW_DLV_OK)
+		return;
+	TS_CHECK_INT(cnt);
+	found = 0;
+	for (i = 0; i < cnt; i++) {
+		if (offsets[i] == die_offset)
+			found = 1;
+		if (dwarf_offdie(_dbg, offsets[i], &die0, &de) != DW_DLV_OK) {
+			tet_printf("dwarf_offdie failed: %s\n",
+			    dwarf_errmsg(de));
+			result = TET_FAIL;
+			continue;
+		}
+		if (dwarf_tag(die0, &tag0, &de) != DW_DLV_OK) {
+			tet_printf("dwarf_tag failed: %s\n", dwarf_errmsg(de));
+			result = TET_FAIL;
+		} else if (tag0 != tag) {
+			tet_printf("DIE at offset %ju has tag %#x instead of"
+			    " %#x\n", (uintmax_t) offsets[i], tag0, tag);
+			result = TET_FAIL;
+		}
+		dwarf_dealloc(_dbg, die0, DW_DLA_DIE);
+	}
+	TS_CHECK_INT(found);
+	dwarf_dealloc(_dbg, offsets, DW_DLA_LIST);
+}
+
+static void
+tp_dwarf_debugnames_lookup(void)
+{
+	Dwarf_Debug dbg;
+	Dwarf_Error de;
+	int fd;
+
+	result = TET_UNRESOLVED;
+
+	TS_DWARF_INIT(dbg, fd, de);
+
+	_dbg = dbg;
+	TS_DWARF_DIE_TRAVERSE(dbg, _dwarf_debugnames_lookup);
+
+	if (result == TET_UNRESOLVED)
+		result = TET_PASS;
+
+done:
+	TS_DWARF_FINISH(dbg, de);
+	TS_RESULT(result);
+}
+
+static void
+tp_dwarf_debugnames_sanity(void)
+{
+	Dwarf_Debug dbg;
+	Dwarf_Error de;
+	Dwarf_Off *offsets;
+	Dwarf_Signed cnt;
+	int fd;
+
+	result = TET_UNRESOLVED;
+
+	TS_DWARF_INIT(dbg, fd, de);
+
+	if (dwarf_debugnames_lookup(NULL, "main", 0, &offsets, &cnt, &de) !=
+	    DW_DLV_ERROR) {
+		tet_infoline("dwarf_debugnames_lookup didn't return"
+		    " DW_DLV_ERROR when called with NULL arguments");
+		result = TET_FAIL;
+		goto done;
+	}
+
+	if (dwarf_debugnames_lookup(dbg, NULL, 0, &offsets, &cnt, &de) !=
+	    DW_DLV_ERROR) {
+		tet_infoline("dwarf_debugnames_lookup didn't return"
+		    " DW_DLV_ERROR when called with NULL arguments");
+		result = TET_FAIL;
+		goto done;
+	}
+
+	if (dwarf_debugnames_lookup(dbg, "main", 0, NULL, &cnt, &de) !=
+	    DW_DLV_ERROR) {
+		tet_infoline("dwarf_debugnames_lookup didn't return"
+		    " DW_DLV_ERROR when called with NULL arguments");
+		result = TET_FAIL;
+		goto done;
+	}
+
+	if (dwarf_debugnames_lookup(dbg, "no such name", 0, &offsets, &cnt,
+	    &de) != DW_DLV_NO_ENTRY) {
+		tet_infoline("dwarf_debugnames_lookup didn't return"
+		    " DW_DLV_NO_ENTRY for a name not in the index");
+		result = TET_FAIL;
+		goto done;
+	}
+
+	if (result == TET_UNRESOLVED)
+		result = TET_PASS;
+
+done:
+	TS_DWARF_FINISH(dbg, de);
+	TS_RESULT(result);
+}
@@ -41,12 +41,15 @@
  */
 static void tp_dwarf_form(void);
 static void tp_dwarf_form_sanity(void);
+static void tp_dwarf_form_sig8(void);
 static struct dwarf_tp dwarf_tp_array[] = {
 	{"tp_dwarf_form", tp_dwarf_form},
 	{"tp_dwarf_form_sanity", tp_dwarf_form_sanity},
+	{"tp_dwarf_form_sig8", tp_dwarf_form_sig8},
 	{NULL, NULL},
 };
 static int result = TET_UNRESOLVED;
+static Dwarf_Debug _dbg;
 #include "driver.c"
 #include "die_traverse2.c"
 
@@ -282,3 +285,120 @@ done:
 	TS_DWARF_FINISH(dbg, de);
 	TS_RESULT(result);
 }
+
+/*
+ * Resolve every type signature to the DIE of the type it refers to.
+ */
+static void
+_dwarf_form_sig8(Dwarf_Die die)
+{
+	Dwarf_Attribute *attrlist;
+	Dwarf_Signed attrcount;
+	Dwarf_Half form, tag;
+	Dwarf_Sig8 sig8;
+	Dwarf_Die ret_die;
+	Dwarf_Off offset;
+	Dwarf_Bool is_info;
+	Dwarf_Error de;
+	char *name;
+	int i, r, r_find;
+
+	r = dwarf_attrlist(die, &attrlist, &attrcount, &de);
+	if (r == DW_DLV_ERROR) {
+		tet_printf("dwarf_attrlist failed: %s\n", dwarf_errmsg(de));
+		result = TET_FAIL;
+		return;
+	} else if (r == DW_DLV_NO_ENTRY)
+		return;
+
+	for (i = 0; i < attrcount; i++) {
+		if (dwarf_whatform(attrlist[i], &form, &de) != DW_DLV_OK) {
+			tet_printf("dwarf_whatform failed: %s\n",
+			    dwarf_errmsg(de));
+			result = TET_FAIL;
+			continue;
+		}
+		if (form != DW_FORM_ref_sig8)
+			continue;
+		if (dwarf_formsig8(attrlist[i], &sig8, &de) != DW_DLV_OK) {
+			tet_printf("dwarf_formsig8 failed: %s\n",
+			    dwarf_errmsg(de));
+			result = TET_FAIL;
+			continue;
+		}
+		TS_CHECK_BLOCK(sig8.signature, 8);
+
+		is_info = 2;
+		r_find = dwarf_find_die_given_sig8(_dbg, &sig8, &ret_die,
+		    &is_info, &de);
+		TS_CHECK_INT(r_find);
+		if (r_find == DW_DLV_ERROR) {
+			tet_printf("dwarf_find_die_given_sig8 failed: %s\n",
+			    dwarf_errmsg(de));
+			result = TET_FAIL;
+			continue;
+		} else if (r_find == DW_DLV_NO_ENTRY)
+			continue;
+		TS_CHECK_INT(is_info);
+		if (dwarf_dieoffset(ret_die, &offset, &de) != DW_DLV_OK) {
+			tet_printf("dwarf_dieoffset failed: %s\n",
+			    dwarf_errmsg(de));
+			result = TET_FAIL;
+		} else
+			TS_CHECK_UINT(offset);
+		if (dwarf_tag(ret_die, &tag, &de) != DW_DLV_OK) {
+			tet_printf("dwarf_tag failed: %s\n", dwarf_errmsg(de));
+			result = TET_FAIL;
+		} else
+			TS_CHECK_UINT(tag);
+		if (dwarf_diename(ret_die, &name, &de) == DW_DLV_OK)
+			TS_CHECK_STRING(name);
+		dwarf_dealloc(_dbg, ret_die, DW_DLA_DIE);
+	}
+}
+
+static void
+tp_dwarf_form_sig8(void)
+{
+	Dwarf_Debug dbg;
+	Dwarf_Error de;
+	Dwarf_Sig8 sig8;
+	Dwarf_Die ret_die;
+	int fd;
+
+	result = TET_UNRESOLVED;
+
+	TS_DWARF_INIT(dbg, fd, de);
+
+	_dbg = dbg;
+	TS_DWARF_DIE_TRAVERSE2(dbg, 1, _dwarf_form_sig8);
+	TS_DWARF_DIE_TRAVERSE2(dbg, 0, _dwarf_form_sig8);
+
+	if (dwarf_find_die_given_sig8(NULL, &sig8, &ret_die, NULL, &de) !=
+	    DW_DLV_ERROR ||
+	    dwarf_find_die_given_sig8(dbg, NULL, &ret_die, NULL, &de) !=
+	    DW_DLV_ERROR ||
+	    dwarf_find_die_given_sig8(dbg, &sig8, NULL, NULL, &de) !=
+	    DW_DLV_ERROR) {
+		tet_infoline("dwarf_find_die_given_sig8 didn't return"
+		    " DW_DLV_ERROR when called with NULL arguments");
+		result = TET_FAIL;
+		goto done;
+	}
+
+	memset(&sig8, 0xff, sizeof(sig8));
+	if (dwarf_find_die_given_sig8(dbg, &sig8, &ret_die, NULL, &de) !=
+	    DW_DLV_NO_ENTRY) {
+		tet_infoline("dwarf_find_die_given_sig8 didn't return"
+		    " DW_DLV_NO_ENTRY for an unknown signature");
+		result = TET_FAIL;
+		goto done;
+	}
+
+	if (result == TET_UNRESOLVED)
+		result = TET_PASS;
+
+done:
+	TS_DWARF_FINISH(dbg, de);
+	TS_RESULT(result);
+}
@@ -41,9 +41,11 @@
  */
 static void tp_dwarf_frame2(void);
 static void tp_dwarf_frame3(void);
+static void tp_dwarf_frame_fde_for_pc(void);
 static struct dwarf_tp dwarf_tp_array[] = {
 	{"tp_dwarf_frame2",tp_dwarf_frame2},
 	{"tp_dwarf_frame3",tp_dwarf_frame3},
+	{"tp_dwarf_frame_fde_for_pc",tp_dwarf_frame_fde_for_pc},
 	{NULL, NULL},
 };
 static int result = TET_UNRESOLVED;
@@ -496,3 +498,137 @@ done:
 	TS_DWARF_FINISH(dbg, de);
 	TS_RESULT(result);
 }
+
+static int
+_dwarf_fde_for_pc(Dwarf_Debug dbg, int eh, Dwarf_Addr pc, Dwarf_Fde *fde)
+{
+	Dwarf_Addr lopc, hipc;
+	Dwarf_Error de;
+	int r_fde_for_pc;
+
+	tet_printf("attempt to get fde for %#jx\n", (uintmax_t) pc);
+	if (eh)
+		r_fde_for_pc = dwarf_get_fde_for_pc_eh(dbg, pc, fde, &lopc,
+		    &hipc, &de);
+	else
+		r_fde_for_pc = dwarf_get_fde_for_pc(dbg, pc, fde, &lopc,
+		    &hipc, &de);
+	TS_CHECK_INT(r_fde_for_pc);
+	if (r_fde_for_pc == DW_DLV_ERROR) {
+		tet_printf("dwarf_get_fde_for_pc failed: %s\n",
+		    dwarf_errmsg(de));
+		result = TET_FAIL;
+	} else if (r_fde_for_pc == DW_DLV_OK) {
+		TS_CHECK_UINT(lopc);
+		TS_CHECK_UINT(hipc);
+	}
+
+	return (r_fde_for_pc);
+}
+
+static void
+_dwarf_fde_for_pc_test(Dwarf_Debug dbg, int eh)
+{
+	Dwarf_Cie *cielist;
+	Dwarf_Fde *fdelist, fde, fde0;
+	Dwarf_Signed ciecnt, fdecnt, cie_index;
+	Dwarf_Addr low_pc;
+	Dwarf_Unsigned func_len, fde_byte_len;
+	Dwarf_Off cie_offset, fde_offset;
+	Dwarf_Ptr fde_bytes;
+	Dwarf_Error de;
+	int i, r, same_fde;
+
+	/*
+	 * Look up the hard-coded PC values before the FDE list is
+	 * retrieved, so that only the address index is built.
+	 */
+	(void) _dwarf_fde_for_pc(dbg, eh, 0x08082a30, &fde);
+	(void) _dwarf_fde_for_pc(dbg, eh, 0x08083087, &fde);
+	(void) _dwarf_fde_for_pc(dbg, eh, 0x080481f0, &fde);
+	(void) _dwarf_fde_for_pc(dbg, eh, 0x08048564, &fde);
+	(void) _dwarf_fde_for_pc(dbg, eh, 0x00401280, &fde);
+	(void) _dwarf_fde_for_pc(dbg, eh, 0x004012b1, &fde);
+
+	if (eh)
+		r = dwarf_get_fde_list_eh(dbg, &cielist, &ciecnt, &fdelist,
+		    &fdecnt, &de);
+	else
+		r = dwarf_get_fde_list(dbg, &cielist, &ciecnt, &fdelist,
+		    &fdecnt, &de);
+	if (r != DW_DLV_OK) {
+		tet_printf("dwarf_get_fde_list failed: %s\n",
+		    dwarf_errmsg(de));
+		result = TET_FAIL;
+		return;
+	}
+
+	/*
+	 * Look up the first and the last address covered by each FDE.
+	 * The FDE found should be the one in the list, unless another
+	 * FDE starting at a higher address also covers the address.
+	 */
+	for (i = 0; i < fdecnt; i++) {
+		if (dwarf_get_fde_n(fdelist, i, &fde0, &de) != DW_DLV_OK) {
+			tet_printf("dwarf_get_fde_n(%d) failed: %s\n", i,
+			    dwarf_errmsg(de));
+			result = TET_FAIL;
+			continue;
+		}
+		if (dwarf_get_fde_range(fde0, &low_pc, &func_len, &fde_bytes,
+		    &fde_byte_len, &cie_offset, &cie_index, &fde_offset,
+		    &de) == DW_DLV_ERROR) {
+			tet_printf("dwarf_get_fde_range(%d) failed: %s\n", i,
+			    dwarf_errmsg(de));
+			result = TET_FAIL;
+			continue;
+		}
+		if (func_len == 0)
+			continue;
+		if (_dwarf_fde_for_pc(dbg, eh, low_pc, &fde) == DW_DLV_OK) {
+			same_fde = fde == fde0;
+			TS_CHECK_INT(same_fde);
+		}
+		if (_dwarf_fde_for_pc(dbg, eh, low_pc + func_len - 1, &fde) ==
+		    DW_DLV_OK) {
+			same_fde = fde == fde0;
+			TS_CHECK_INT(same_fde);
+		}
+	}
+}
+
+static void
+tp_dwarf_frame_fde_for_pc(void)
+{
+	Dwarf_Debug dbg;
+	Dwarf_Error de;
+	Dwarf_Fde fde;
+	Dwarf_Addr lopc, hipc;
+	int fd;
+
+	result = TET_UNRESOLVED;
+
+	TS_DWARF_INIT(dbg, fd, de);
+
+	_dwarf_fde_for_pc_test(dbg, 0);
+	_dwarf_fde_for_pc_test(dbg, 1);
+
+	if (dwarf_get_fde_for_pc(NULL, 0, &fde, &lopc, &hipc, &de) !=
+	    DW_DLV_ERROR ||
+	    dwarf_get_fde_for_pc(dbg, 0, NULL, &lopc, &hipc, &de) !=
+	    DW_DLV_ERROR ||
+	    dwarf_get_fde_for_pc_eh(dbg, 0, &fde, NULL, &hipc, &de) !=
+	    DW_DLV_ERROR ||
+	    dwarf_get_fde_for_pc_eh(dbg, 0, &fde, &lopc, NULL, &de) !=
+	    DW_DLV_ERROR) {
+		tet_infoline("dwarf_get_fde_for_pc didn't return"
+		    " DW_DLV_ERROR when called with NULL arguments");
+		result = TET_FAIL;
+	}
+
+	if (result == TET_UNRESOLVED)
+		result = TET_PASS;
+done:
+	TS_DWARF_FINISH(dbg, de);
+	TS_RESULT(result);
+}
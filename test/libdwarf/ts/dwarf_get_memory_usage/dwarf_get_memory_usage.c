@@ -0,0 +1,229 @@
+/*-
+ * Copyright (c) 2026 The Elftoolchain Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * $Id$
+ */
+
+#include <assert.h>
+#include <dwarf.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <libdwarf.h>
+#include <string.h>
+
+#include "driver.h"
+#include "tet_api.h"
+
+/*
+ * Test case for dwarf_get_memory_usage and dwarf_trim.  The figures
+ * depend on the host, so only their relations are checked.
+ */
+static void tp_dwarf_get_memory_usage(void);
+static void tp_dwarf_get_memory_usage_sanity(void);
+static struct dwarf_tp dwarf_tp_array[] = {
+	{"tp_dwarf_get_memory_usage", tp_dwarf_get_memory_usage},
+	{"tp_dwarf_get_memory_usage_sanity",
+	 tp_dwarf_get_memory_usage_sanity},
+	{NULL, NULL},
+};
+static int result = TET_UNRESOLVED;
+#include "driver.c"
+
+static int
+_dwarf_memory_usage(Dwarf_Debug dbg, Dwarf_Memory_Usage *mu)
+{
+	Dwarf_Error de;
+	int total_ok;
+
+	if (dwarf_get_memory_usage(dbg, mu, &de) != DW_DLV_OK) {
+		tet_printf("dwarf_get_memory_usage failed: %s\n",
+		    dwarf_errmsg(de));
+		result = TET_FAIL;
+		return (-1);
+	}
+	total_ok = mu->dmu_total == mu->dmu_units + mu->dmu_abbrevs +
+	    mu->dmu_lines + mu->dmu_ranges + mu->dmu_loclists +
+	    mu->dmu_aranges + mu->dmu_frames + mu->dmu_names +
+	    mu->dmu_macros + mu->dmu_sections;
+	TS_CHECK_INT(total_ok);
+
+	return (0);
+}
+
+/*
+ * Use every compilation unit: read its CU DIE and its line number
+ * information.
+ */
+static void
+_dwarf_memory_use(Dwarf_Debug dbg)
+{
+	Dwarf_Die die;
+	Dwarf_Line *linebuf;
+	Dwarf_Signed linecount;
+	Dwarf_Unsigned cu_next_offset;
+	Dwarf_Error de;
+	int r_srclines;
+
+	TS_DWARF_CU_FOREACH(dbg, cu_next_offset, de) {
+		if (dwarf_siblingof(dbg, NULL, &die, &de) != DW_DLV_OK) {
+			tet_printf("dwarf_siblingof failed: %s\n",
+			    dwarf_errmsg(de));
+			result = TET_FAIL;
+			continue;
+		}
+		r_srclines = dwarf_srclines(die, &linebuf, &linecount, &de);
+		TS_CHECK_INT(r_srclines);
+		if (r_srclines == DW_DLV_OK)
+			TS_CHECK_INT(linecount);
+		dwarf_dealloc(dbg, die, DW_DLA_DIE);
+	}
+}
+
+static void
+tp_dwarf_get_memory_usage(void)
+{
+	Dwarf_Debug dbg;
+	Dwarf_Error de;
+	Dwarf_Memory_Usage mu, mu0;
+	Dwarf_Unsigned freed;
+	int fd, units_used, abbrevs_used, lines_used;
+	int units_kept, abbrevs_freed, lines_freed, freed_ok;
+
+	result = TET_UNRESOLVED;
+
+	TS_DWARF_INIT(dbg, fd, de);
+
+	if (_dwarf_memory_usage(dbg, &mu0) < 0)
+		goto done;
+
+	_dwarf_memory_use(dbg);
+	if (_dwarf_memory_usage(dbg, &mu) < 0)
+		goto done;
+	units_used = mu.dmu_units > 0;
+	abbrevs_used = mu.dmu_abbrevs > 0;
+	lines_used = mu.dmu_lines > mu0.dmu_lines;
+	TS_CHECK_INT(units_used);
+	TS_CHECK_INT(abbrevs_used);
+	TS_CHECK_INT(lines_used);
+
+	/* An idle count of 0 releases the tables of every unit. */
+	mu0 = mu;
+	if (dwarf_trim(dbg, 0, &freed, &de) != DW_DLV_OK) {
+		tet_printf("dwarf_trim failed: %s\n", dwarf_errmsg(de));
+		result = TET_FAIL;
+		goto done;
+	}
+	if (_dwarf_memory_usage(dbg, &mu) < 0)
+		goto done;
+	freed_ok = freed > 0 && freed == mu0.dmu_total - mu.dmu_total;
+	units_kept = mu.dmu_units == mu0.dmu_units;
+	abbrevs_freed = mu.dmu_abbrevs == 0;
+	lines_freed = mu.dmu_lines == 0;
+	TS_CHECK_INT(freed_ok);
+	TS_CHECK_INT(units_kept);
+	TS_CHECK_INT(abbrevs_freed);
+	TS_CHECK_INT(lines_freed);
+
+	/* The released tables are built again on use. */
+	_dwarf_memory_use(dbg);
+	if (_dwarf_memory_usage(dbg, &mu) < 0)
+		goto done;
+	abbrevs_used = mu.dmu_abbrevs == mu0.dmu_abbrevs;
+	lines_used = mu.dmu_lines == mu0.dmu_lines;
+	TS_CHECK_INT(abbrevs_used);
+	TS_CHECK_INT(lines_used);
+
+	/*
+	 * An idle count of 1 keeps the tables of the units used since
+	 * the previous trim, and releases them at the next one.
+	 */
+	if (dwarf_trim(dbg, 1, &freed, &de) != DW_DLV_OK) {
+		tet_printf("dwarf_trim failed: %s\n", dwarf_errmsg(de));
+		result = TET_FAIL;
+		goto done;
+	}
+	TS_CHECK_UINT(freed);
+	if (dwarf_trim(dbg, 1, &freed, &de) != DW_DLV_OK) {
+		tet_printf("dwarf_trim failed: %s\n", dwarf_errmsg(de));
+		result = TET_FAIL;
+		goto done;
+	}
+	if (_dwarf_memory_usage(dbg, &mu) < 0)
+		goto done;
+	freed_ok = freed > 0;
+	lines_freed = mu.dmu_lines == 0;
+	TS_CHECK_INT(freed_ok);
+	TS_CHECK_INT(lines_freed);
+
+	if (result == TET_UNRESOLVED)
+		result = TET_PASS;
+
+done:
+	TS_DWARF_FINISH(dbg, de);
+	TS_RESULT(result);
+}
+
+static void
+tp_dwarf_get_memory_usage_sanity(void)
+{
+	Dwarf_Debug dbg;
+	Dwarf_Error de;
+	Dwarf_Memory_Usage mu;
+	Dwarf_Unsigned freed;
+	int fd;
+
+	result = TET_UNRESOLVED;
+
+	TS_DWARF_INIT(dbg, fd, de);
+
+	if (dwarf_get_memory_usage(NULL, &mu, &de) != DW_DLV_ERROR ||
+	    dwarf_get_memory_usage(dbg, NULL, &de) != DW_DLV_ERROR) {
+		tet_infoline("dwarf_get_memory_usage didn't return"
+		    " DW_DLV_ERROR when called with NULL arguments");
+		result = TET_FAIL;
+		goto done;
+	}
+
+	if (dwarf_trim(NULL, 0, &freed, &de) != DW_DLV_ERROR) {
+		tet_infoline("dwarf_trim didn't return DW_DLV_ERROR"
+		    " when called with NULL arguments");
+		result = TET_FAIL;
+		goto done;
+	}
+
+	if (dwarf_trim(dbg, 0, NULL, &de) != DW_DLV_OK) {
+		tet_infoline("dwarf_trim didn't return DW_DLV_OK"
+		    " when called without a location for the freed size");
+		result = TET_FAIL;
+		goto done;
+	}
+
+	if (result == TET_UNRESOLVED)
+		result = TET_PASS;
+
+done:
+	TS_DWARF_FINISH(dbg, de);
+	TS_RESULT(result);
+}
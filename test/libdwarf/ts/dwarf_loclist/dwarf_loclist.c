@@ -41,15 +41,45 @@
  */
 static void tp_dwarf_loclist(void);
 static void tp_dwarf_loclist_sanity(void);
+static void tp_dwarf_loclist_at_pc(void);
 static struct dwarf_tp dwarf_tp_array[] = {
 	{"tp_dwarf_loclist", tp_dwarf_loclist},
 	{"tp_dwarf_loclist_sanity", tp_dwarf_loclist_sanity},
+	{"tp_dwarf_loclist_at_pc", tp_dwarf_loclist_at_pc},
 	{NULL, NULL},
 };
 static int result = TET_UNRESOLVED;
 #include "driver.c"
 #include "die_traverse.c"
 
+/*
+ * The second operand of an operator taking a block is a pointer to the
+ * block, so check the content of the block instead of the pointer.
+ */
+static void
+_dwarf_loc_operand2(Dwarf_Loc *loc)
+{
+	uint8_t *lr_block;
+
+	switch (loc->lr_atom) {
+	case DW_OP_implicit_value:
+	case DW_OP_entry_value:
+	case DW_OP_GNU_entry_value:
+		lr_block = (uint8_t *) (uintptr_t) loc->lr_number2;
+		TS_CHECK_BLOCK(lr_block, loc->lr_number);
+		break;
+	case DW_OP_const_type:
+	case DW_OP_GNU_const_type:
+		/* The first byte of the block is its size. */
+		lr_block = (uint8_t *) (uintptr_t) loc->lr_number2;
+		TS_CHECK_BLOCK(lr_block, lr_block[0] + 1);
+		break;
+	default:
+		TS_CHECK_UINT(loc->lr_number2);
+		break;
+	}
+}
+
 static void
 _dwarf_loclist(Dwarf_Die die)
 {
@@ -128,7 +158,7 @@ _dwarf_loclist(Dwarf_Die die)
 					loc = &llbuf[j]->ld_s[k];
 					TS_CHECK_UINT(loc->lr_atom);
 					TS_CHECK_UINT(loc->lr_number);
-					TS_CHECK_UINT(loc->lr_number2);
+					_dwarf_loc_operand2(loc);
 #ifndef TCGEN
 					/*
 					 * XXX SGI libdwarf defined that
@@ -161,7 +191,7 @@ _dwarf_loclist(Dwarf_Die die)
 				loc = &llbuf0->ld_s[k];
 				TS_CHECK_UINT(loc->lr_atom);
 				TS_CHECK_UINT(loc->lr_number);
-				TS_CHECK_UINT(loc->lr_number2);
+				_dwarf_loc_operand2(loc);
 #ifndef TCGEN
 					/*
 					 * XXX SGI libdwarf defined that
@@ -232,3 +262,162 @@ done:
 	TS_DWARF_FINISH(dbg, de);
 	TS_RESULT(result);
 }
+
+/*
+ * Base address of the .debug_loc lists of the current CU.  The entries
+ * of DWARF 5 .debug_loclists lists are not relative to it.
+ */
+static Dwarf_Addr _cu_base;
+
+static void
+_dwarf_loclist_at_pc_check(Dwarf_Attribute at, Dwarf_Addr pc)
+{
+	Dwarf_Locdesc *ld;
+	Dwarf_Error de;
+	int r_at_pc;
+
+	tet_printf("process pc %#jx\n", (uintmax_t) pc);
+	r_at_pc = dwarf_loclist_at_pc(at, pc, &ld, &de);
+	TS_CHECK_INT(r_at_pc);
+	if (r_at_pc == DW_DLV_ERROR) {
+		tet_printf("dwarf_loclist_at_pc failed: %s\n",
+		    dwarf_errmsg(de));
+		result = TET_FAIL;
+		return;
+	} else if (r_at_pc == DW_DLV_NO_ENTRY)
+		return;
+	TS_CHECK_UINT(ld->ld_lopc);
+	TS_CHECK_UINT(ld->ld_hipc);
+	TS_CHECK_UINT(ld->ld_cents);
+	if (ld->ld_cents > 0)
+		TS_CHECK_UINT(ld->ld_s[0].lr_atom);
+}
+
+static void
+_dwarf_loclist_at_pc(Dwarf_Die die)
+{
+	Dwarf_Attribute *attrlist, at;
+	Dwarf_Signed attrcount;
+	Dwarf_Half attr, form;
+	Dwarf_Locdesc **llbuf;
+	Dwarf_Signed listlen;
+	Dwarf_Error de;
+	int r, i, j;
+
+	r = dwarf_attrlist(die, &attrlist, &attrcount, &de);
+	if (r == DW_DLV_ERROR) {
+		tet_printf("dwarf_attrlist failed: %s\n", dwarf_errmsg(de));
+		result = TET_FAIL;
+		return;
+	} else if (r == DW_DLV_NO_ENTRY)
+		return;
+
+	for (i = 0; i < attrcount; i++) {
+		at = attrlist[i];
+		if (dwarf_whatattr(at, &attr, &de) != DW_DLV_OK) {
+			tet_printf("dwarf_whatattr failed: %s\n",
+			    dwarf_errmsg(de));
+			result = TET_FAIL;
+			continue;
+		}
+		if (attr != DW_AT_location && attr != DW_AT_frame_base)
+			continue;
+		if (dwarf_whatform(at, &form, &de) != DW_DLV_OK) {
+			tet_printf("dwarf_whatform failed: %s\n",
+			    dwarf_errmsg(de));
+			result = TET_FAIL;
+			continue;
+		}
+		if (dwarf_loclist_n(at, &llbuf, &listlen, &de) != DW_DLV_OK)
+			continue;
+		TS_CHECK_UINT(attr);
+		TS_CHECK_UINT(form);
+
+		/* A single location expression applies at every address. */
+		switch (form) {
+		case DW_FORM_block:
+		case DW_FORM_block1:
+		case DW_FORM_block2:
+		case DW_FORM_block4:
+		case DW_FORM_exprloc:
+			_dwarf_loclist_at_pc_check(at, _cu_base);
+			continue;
+		default:
+			break;
+		}
+
+		/*
+		 * Look up the first, the last and the first address past
+		 * the range of each entry of a location list.
+		 */
+		for (j = 0; j < listlen; j++) {
+			if (llbuf[j]->ld_lopc >= llbuf[j]->ld_hipc)
+				continue;
+			tet_printf("process loclist[%d]\n", j);
+			_dwarf_loclist_at_pc_check(at,
+			    _cu_base + llbuf[j]->ld_lopc);
+			_dwarf_loclist_at_pc_check(at,
+			    _cu_base + llbuf[j]->ld_hipc - 1);
+			_dwarf_loclist_at_pc_check(at,
+			    _cu_base + llbuf[j]->ld_hipc);
+		}
+	}
+}
+
+static void
+_dwarf_loclist_at_pc_traverse(Dwarf_Debug dbg, Dwarf_Die die)
+{
+	Dwarf_Die die0;
+	Dwarf_Error de;
+
+	_dwarf_loclist_at_pc(die);
+
+	if (dwarf_child(die, &die0, &de) == DW_DLV_OK)
+		_dwarf_loclist_at_pc_traverse(dbg, die0);
+	if (dwarf_siblingof(dbg, die, &die0, &de) == DW_DLV_OK)
+		_dwarf_loclist_at_pc_traverse(dbg, die0);
+}
+
+static void
+tp_dwarf_loclist_at_pc(void)
+{
+	Dwarf_Debug dbg;
+	Dwarf_Error de;
+	Dwarf_Die die;
+	Dwarf_Half cu_version;
+	Dwarf_Unsigned cu_next_offset;
+	Dwarf_Locdesc *ld;
+	int fd;
+
+	result = TET_UNRESOLVED;
+
+	TS_DWARF_INIT(dbg, fd, de);
+
+	while (dwarf_next_cu_header_b(dbg, NULL, &cu_version, NULL, NULL,
+	    NULL, NULL, &cu_next_offset, &de) == DW_DLV_OK) {
+		if (dwarf_siblingof(dbg, NULL, &die, &de) != DW_DLV_OK) {
+			tet_printf("dwarf_siblingof failed: %s\n",
+			    dwarf_errmsg(de));
+			result = TET_FAIL;
+			continue;
+		}
+		if (cu_version >= 5 ||
+		    dwarf_lowpc(die, &_cu_base, &de) != DW_DLV_OK)
+			_cu_base = 0;
+		_dwarf_loclist_at_pc_traverse(dbg, die);
+	}
+
+	if (dwarf_loclist_at_pc(NULL, 0, &ld, &de) != DW_DLV_ERROR) {
+		tet_infoline("dwarf_loclist_at_pc didn't return DW_DLV_ERROR"
+		    " when called with NULL arguments");
+		result = TET_FAIL;
+		goto done;
+	}
+
+	if (result == TET_UNRESOLVED)
+		result = TET_PASS;
+
+done:
+	TS_DWARF_FINISH(dbg, de);
+	TS_RESULT(result);
+}
@@ -39,11 +39,13 @@
 static void tp_dwarf_next_cu_header(void);
 static void tp_dwarf_next_cu_header_b(void);
 static void tp_dwarf_next_cu_header_c(void);
+static void tp_dwarf_next_cu_header_c_info(void);
 static void tp_dwarf_next_cu_header_loop(void);
 static struct dwarf_tp dwarf_tp_array[] = {
 	{"tp_dwarf_next_cu_header", tp_dwarf_next_cu_header},
 	{"tp_dwarf_next_cu_header_b", tp_dwarf_next_cu_header_b},
 	{"tp_dwarf_next_cu_header_c", tp_dwarf_next_cu_header_c},
+	{"tp_dwarf_next_cu_header_c_info", tp_dwarf_next_cu_header_c_info},
 	{"tp_dwarf_next_cu_header_loop", tp_dwarf_next_cu_header_loop},
 	{NULL, NULL},
 };
@@ -179,6 +181,46 @@ done:
 	TS_RESULT(result);
 }
 
+/*
+ * DWARF 5 type units live in .debug_info, so the type signature and
+ * type offset are also returned for units of that section.
+ */
+static void
+tp_dwarf_next_cu_header_c_info(void)
+{
+	Dwarf_Debug dbg;
+	Dwarf_Error de;
+	Dwarf_Half cu_version;
+	Dwarf_Sig8 cu_type_sig;
+	Dwarf_Unsigned cu_type_offset;
+	Dwarf_Unsigned cu_next_offset;
+	int fd, result;
+
+	result = TET_UNRESOLVED;
+
+	TS_DWARF_INIT(dbg, fd, de);
+
+	for (;;) {
+		memset(&cu_type_sig, 0, sizeof(cu_type_sig));
+		cu_type_offset = 0;
+		if (dwarf_next_cu_header_c(dbg, 1, NULL, &cu_version, NULL,
+		    NULL, NULL, NULL, &cu_type_sig, &cu_type_offset,
+		    &cu_next_offset, &de) != DW_DLV_OK)
+			break;
+		TS_CHECK_UINT(cu_version);
+		TS_CHECK_BLOCK(cu_type_sig.signature, 8);
+		TS_CHECK_UINT(cu_type_offset);
+		TS_CHECK_UINT(cu_next_offset);
+	}
+
+	if (result == TET_UNRESOLVED)
+		result = TET_PASS;
+
+done:
+	TS_DWARF_FINISH(dbg, de);
+	TS_RESULT(result);
+}
+
 #define	_LOOP_COUNT	50
 
 static void
@@ -0,0 +1,1762 @@
+/*-
+ * Copyright (c) 2026 The Elftoolchain Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * $Id$
+ */
+
+#include <assert.h>
+#include <dwarf.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <libdwarf.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "driver.h"
+#include "tet_api.h"
+
+/*
+ * Test cases for the producer.  Each test purpose builds a unit out of
+ * the names of the DIEs in the test object, reads the sections made by
+ * the producer back through an object access interface and checks what
+ * the consumer finds in them.
+ */
+static void tp_dwarf_producer_sections(void);
+static void tp_dwarf_producer_pubnames(void);
+static void tp_dwarf_producer_strings(void);
+static void tp_dwarf_producer_abbrevs(void);
+static void tp_dwarf_producer_trees(void);
+static void tp_dwarf_producer_relocs(void);
+static void tp_dwarf_producer_frames(void);
+static struct dwarf_tp dwarf_tp_array[] = {
+	{"tp_dwarf_producer_sections", tp_dwarf_producer_sections},
+	{"tp_dwarf_producer_pubnames", tp_dwarf_producer_pubnames},
+	{"tp_dwarf_producer_strings", tp_dwarf_producer_strings},
+	{"tp_dwarf_producer_abbrevs", tp_dwarf_producer_abbrevs},
+	{"tp_dwarf_producer_trees", tp_dwarf_producer_trees},
+	{"tp_dwarf_producer_relocs", tp_dwarf_producer_relocs},
+	{"tp_dwarf_producer_frames", tp_dwarf_producer_frames},
+	{NULL, NULL},
+};
+static int result = TET_UNRESOLVED;
+#include "driver.c"
+#include "die_traverse.c"
+
+#define	_MAX_SECS	256
+
+/*
+ * Sections of the object being built.  Section ids handed out by the
+ * producer callback are indices into this table plus one.
+ */
+static struct _sec {
+	char		*s_name;
+	Dwarf_Small	*s_data;
+	Dwarf_Unsigned	s_size;
+} _secs[_MAX_SECS];
+static int _nsecs;
+
+/* Names of the DIEs of the test object, in DIE order. */
+static char **_names;
+static int _nnames, _names_cap;
+
+static void
+_names_cb(Dwarf_Die die)
+{
+	Dwarf_Error de;
+	char *name, **p;
+
+	if (dwarf_diename(die, &name, &de) != DW_DLV_OK)
+		return;
+	if (_nnames == _names_cap) {
+		_names_cap = _names_cap > 0 ? _names_cap * 2 : 64;
+		if ((p = realloc(_names, _names_cap * sizeof(*p))) == NULL) {
+			tet_printf("realloc failed: %s\n", strerror(errno));
+			result = TET_UNRESOLVED;
+			return;
+		}
+		_names = p;
+	}
+	if ((_names[_nnames] = strdup(name)) == NULL) {
+		tet_printf("strdup failed: %s\n", strerror(errno));
+		result = TET_UNRESOLVED;
+		return;
+	}
+	_nnames++;
+}
+
+static void
+_names_free(void)
+{
+	int i;
+
+	for (i = 0; i < _nnames; i++)
+		free(_names[i]);
+	free(_names);
+	_names = NULL;
+	_nnames = _names_cap = 0;
+}
+
+/*
+ * Collect the names of the DIEs of the test object.
+ */
+static int
+_names_load(void)
+{
+	Dwarf_Debug dbg;
+	Dwarf_Error de;
+	int fd;
+
+	_names_free();
+
+	TS_DWARF_INIT(dbg, fd, de);
+	TS_DWARF_DIE_TRAVERSE(dbg, _names_cb);
+	TS_DWARF_FINISH(dbg, de);
+
+done:
+	if (_nnames == 0) {
+		tet_infoline("no DIE names in the test object");
+		result = TET_UNRESOLVED;
+		return (-1);
+	}
+
+	return (0);
+}
+
+static int
+_sec_add(const char *name, const void *data, Dwarf_Unsigned size)
+{
+	struct _sec *s;
+
+	if (_nsecs == _MAX_SECS) {
+		tet_infoline("too many sections");
+		result = TET_UNRESOLVED;
+		return (-1);
+	}
+	s = &_secs[_nsecs];
+	if ((s->s_name = strdup(name)) == NULL ||
+	    (size > 0 && (s->s_data = malloc(size)) == NULL)) {
+		tet_printf("allocation failed: %s\n", strerror(errno));
+		result = TET_UNRESOLVED;
+		return (-1);
+	}
+	if (size > 0)
+		memcpy(s->s_data, data, size);
+	s->s_size = size;
+
+	return (++_nsecs);
+}
+
+static struct _sec *
+_sec_find(const char *name)
+{
+	int i;
+
+	for (i = 0; i < _nsecs; i++)
+		if (!strcmp(_secs[i].s_name, name))
+			return (&_secs[i]);
+
+	return (NULL);
+}
+
+static void
+_secs_free(void)
+{
+	int i;
+
+	for (i = 0; i < _nsecs; i++) {
+		free(_secs[i].s_name);
+		free(_secs[i].s_data);
+	}
+	memset(_secs, 0, sizeof(_secs));
+	_nsecs = 0;
+}
+
+static int
+_pro_callback(char *name, int size, Dwarf_Unsigned type,
+    Dwarf_Unsigned flags, Dwarf_Unsigned link, Dwarf_Unsigned info,
+    Dwarf_Unsigned *index, int *error)
+{
+	int id;
+
+	if ((id = _sec_add(name, NULL, 0)) < 0) {
+		*error = DW_DLE_MEMORY;
+		return (-1);
+	}
+
+	/* Relocations refer to a section by its own id. */
+	*index = id;
+
+	return (id);
+}
+
+static Dwarf_P_Debug
+_pro_init(Dwarf_Unsigned flags)
+{
+	Dwarf_P_Debug dbg;
+	Dwarf_Error de;
+
+	dbg = dwarf_producer_init_b(DW_DLC_WRITE | DW_DLC_SIZE_64 |
+	    DW_DLC_SYMBOLIC_RELOCATIONS | DW_DLC_TARGET_LITTLEENDIAN | flags,
+	    _pro_callback, NULL, NULL, &de);
+	if (dbg == DW_DLV_BADADDR) {
+		tet_printf("dwarf_producer_init_b failed: %s\n",
+		    dwarf_errmsg(de));
+		result = TET_FAIL;
+		return (NULL);
+	}
+
+	return (dbg);
+}
+
+/*
+ * Generate the sections of a producer and keep a copy of their
+ * contents.  A unit is placed at the start of each section, so the
+ * section offsets recorded in place by symbolic relocations are final
+ * and the relocations need not be applied.
+ */
+static int
+_pro_collect(Dwarf_P_Debug dbg)
+{
+	Dwarf_Error de;
+	Dwarf_Ptr buf;
+	Dwarf_Signed cnt, i, id;
+	Dwarf_Unsigned len;
+	struct _sec *s;
+
+	if ((cnt = dwarf_transform_to_disk_form(dbg, &de)) ==
+	    DW_DLV_NOCOUNT) {
+		tet_printf("dwarf_transform_to_disk_form failed: %s\n",
+		    dwarf_errmsg(de));
+		result = TET_FAIL;
+		return (-1);
+	}
+
+	for (i = 0; i < cnt; i++) {
+		buf = dwarf_get_section_bytes(dbg, i, &id, &len, &de);
+		if (buf == NULL) {
+			tet_printf("dwarf_get_section_bytes failed: %s\n",
+			    dwarf_errmsg(de));
+			result = TET_FAIL;
+			return (-1);
+		}
+		if (id < 1 || id > _nsecs) {
+			tet_printf("unknown section id %jd\n", (intmax_t) id);
+			result = TET_FAIL;
+			return (-1);
+		}
+		s = &_secs[id - 1];
+		if ((s->s_data = realloc(s->s_data, s->s_size + len)) ==
+		    NULL) {
+			tet_printf("realloc failed: %s\n", strerror(errno));
+			result = TET_UNRESOLVED;
+			return (-1);
+		}
+		memcpy(s->s_data + s->s_size, buf, len);
+		s->s_size += len;
+	}
+
+	return (0);
+}
+
+static int
+_obj_get_section_info(void *obj, Dwarf_Half ndx,
+    Dwarf_Obj_Access_Section *ret_section, int *error)
+{
+
+	if (ndx >= _nsecs) {
+		*error = DW_DLE_NO_ENTRY;
+		return (DW_DLV_NO_ENTRY);
+	}
+
+	ret_section->addr = 0;
+	ret_section->size = _secs[ndx].s_size;
+	ret_section->name = _secs[ndx].s_name;
+
+	return (DW_DLV_OK);
+}
+
+static Dwarf_Endianness
+_obj_get_byte_order(void *obj)
+{
+
+	return (DW_OBJECT_LSB);
+}
+
+static Dwarf_Small
+_obj_get_length_size(void *obj)
+{
+
+	return (4);
+}
+
+static Dwarf_Small
+_obj_get_pointer_size(void *obj)
+{
+
+	return (8);
+}
+
+static Dwarf_Unsigned
+_obj_get_section_count(void *obj)
+{
+
+	return (_nsecs);
+}
+
+static int
+_obj_load_section(void *obj, Dwarf_Half ndx, Dwarf_Small **ret_data,
+    int *error)
+{
+
+	if (ndx >= _nsecs) {
+		*error = DW_DLE_NO_ENTRY;
+		return (DW_DLV_NO_ENTRY);
+	}
+
+	*ret_data = _secs[ndx].s_data;
+
+	return (DW_DLV_OK);
+}
+
+static const Dwarf_Obj_Access_Methods _obj_methods = {
+	_obj_get_section_info,
+	_obj_get_byte_order,
+	_obj_get_length_size,
+	_obj_get_pointer_size,
+	_obj_get_section_count,
+	_obj_load_section
+};
+
+static Dwarf_Obj_Access_Interface _obj_iface = {
+	_secs,
+	&_obj_methods
+};
+
+/*
+ * Open the sections built so far with the consumer.
+ */
+static Dwarf_Debug
+_obj_open(void)
+{
+	Dwarf_Debug dbg;
+	Dwarf_Error de;
+
+	if (dwarf_object_init(&_obj_iface, NULL, NULL, &dbg, &de) !=
+	    DW_DLV_OK) {
+		tet_printf("dwarf_object_init failed: %s\n",
+		    dwarf_errmsg(de));
+		result = TET_FAIL;
+		return (NULL);
+	}
+
+	return (dbg);
+}
+
+/*
+ * Add a compilation unit DIE with a child of the given tag for each
+ * name of the test object.
+ */
+static Dwarf_P_Die
+_pro_unit(Dwarf_P_Debug dbg, Dwarf_Tag tag, Dwarf_P_Die **ret_dies)
+{
+	Dwarf_Error de;
+	Dwarf_P_Die cu, die, *dies;
+	int i;
+
+	dies = NULL;
+	if (ret_dies != NULL &&
+	    (dies = calloc(_nnames, sizeof(*dies))) == NULL) {
+		tet_printf("calloc failed: %s\n", strerror(errno));
+		result = TET_UNRESOLVED;
+		return (NULL);
+	}
+
+	cu = dwarf_new_die(dbg, DW_TAG_compile_unit, NULL, NULL, NULL, NULL,
+	    &de);
+	if (cu == DW_DLV_BADADDR)
+		goto fail;
+	if (dwarf_add_AT_name(cu, _names[0], &de) == DW_DLV_BADADDR)
+		goto fail;
+	for (i = 0; i < _nnames; i++) {
+		die = dwarf_new_die(dbg, tag, cu, NULL, NULL, NULL, &de);
+		if (die == DW_DLV_BADADDR)
+			goto fail;
+		if (dwarf_add_AT_name(die, _names[i], &de) == DW_DLV_BADADDR)
+			goto fail;
+		if (dies != NULL)
+			dies[i] = die;
+	}
+	if (dwarf_add_die_to_debug(dbg, cu, &de) == DW_DLV_NOCOUNT)
+		goto fail;
+
+	if (ret_dies != NULL)
+		*ret_dies = dies;
+
+	return (cu);
+
+fail:
+	tet_printf("building the unit failed: %s\n", dwarf_errmsg(de));
+	result = TET_FAIL;
+	free(dies);
+	return (NULL);
+}
+
+/*
+ * Check that the first unit of a consumer holds a child DIE for each
+ * name of the test object, in order, and optionally return their
+ * offsets.  Return the number of children found, or -1.
+ */
+static int
+_check_unit(Dwarf_Debug dbg, Dwarf_Off *offs)
+{
+	Dwarf_Die cu, die, sib;
+	Dwarf_Error de;
+	Dwarf_Unsigned cu_next_offset;
+	char *name;
+	int i, r;
+
+	if (dwarf_next_cu_header(dbg, NULL, NULL, NULL, NULL,
+	    &cu_next_offset, &de) != DW_DLV_OK ||
+	    dwarf_siblingof(dbg, NULL, &cu, &de) != DW_DLV_OK) {
+		tet_printf("reading the unit failed: %s\n", dwarf_errmsg(de));
+		result = TET_FAIL;
+		return (-1);
+	}
+
+	i = 0;
+	r = dwarf_child(cu, &die, &de);
+	dwarf_dealloc(dbg, cu, DW_DLA_DIE);
+	while (r == DW_DLV_OK) {
+		if (i >= _nnames || dwarf_diename(die, &name, &de) !=
+		    DW_DLV_OK || strcmp(name, _names[i]) != 0) {
+			tet_printf("DIE #%d does not match\n", i);
+			result = TET_FAIL;
+			dwarf_dealloc(dbg, die, DW_DLA_DIE);
+			return (-1);
+		}
+		if (offs != NULL && dwarf_dieoffset(die, &offs[i], &de) !=
+		    DW_DLV_OK) {
+			tet_printf("dwarf_dieoffset failed: %s\n",
+			    dwarf_errmsg(de));
+			result = TET_FAIL;
+			dwarf_dealloc(dbg, die, DW_DLA_DIE);
+			return (-1);
+		}
+		i++;
+		r = dwarf_siblingof(dbg, die, &sib, &de);
+		dwarf_dealloc(dbg, die, DW_DLA_DIE);
+		die = sib;
+	}
+	if (r == DW_DLV_ERROR || i != _nnames) {
+		tet_printf("found %d DIEs, expected %d\n", i, _nnames);
+		result = TET_FAIL;
+		return (-1);
+	}
+
+	return (i);
+}
+
+/*
+ * Sections are looked up by name through an index.  Place the debug
+ * sections after many unrelated ones and follow them with bogus
+ * sections of the same names: the first section of a name is used.
+ */
+static void
+tp_dwarf_producer_sections(void)
+{
+	static const char *dups[] = { ".debug_abbrev", ".debug_info",
+	    ".debug_str" };
+	Dwarf_P_Debug pdbg;
+	Dwarf_Debug dbg;
+	Dwarf_Error de;
+	Dwarf_Arange *arlist;
+	Dwarf_Signed arcnt;
+	Dwarf_Small junk[64];
+	char name[32];
+	int i, cnt, r_aranges;
+
+	result = TET_UNRESOLVED;
+	pdbg = NULL;
+	dbg = NULL;
+
+	if (_names_load() < 0)
+		goto done;
+
+	memset(junk, 0xff, sizeof(junk));
+	for (i = 0; i < 100; i++) {
+		snprintf(name, sizeof(name), ".text.f%d", i);
+		if (_sec_add(name, junk, i % sizeof(junk)) < 0)
+			goto done;
+	}
+
+	if ((pdbg = _pro_init(0)) == NULL ||
+	    _pro_unit(pdbg, DW_TAG_variable, NULL) == NULL ||
+	    _pro_collect(pdbg) < 0)
+		goto done;
+
+	for (i = 0; (size_t) i < sizeof(dups) / sizeof(dups[0]); i++)
+		if (_sec_add(dups[i], junk, sizeof(junk)) < 0)
+			goto done;
+
+	if ((dbg = _obj_open()) == NULL)
+		goto done;
+
+	cnt = _check_unit(dbg, NULL);
+	TS_CHECK_INT(cnt);
+
+	/* A section that is not present is not found. */
+	r_aranges = dwarf_get_aranges(dbg, &arlist, &arcnt, &de);
+	TS_CHECK_INT(r_aranges);
+
+	if (result == TET_UNRESOLVED)
+		result = TET_PASS;
+
+done:
+	if (dbg != NULL)
+		(void) dwarf_object_finish(dbg, &de);
+	if (pdbg != NULL)
+		(void) dwarf_producer_finish(pdbg, &de);
+	_secs_free();
+	_names_free();
+	TS_RESULT(result);
+}
+
+/*
+ * Look up every name of the test object in the global or weak name
+ * table of a consumer, where every "step"th child DIE was entered.
+ * Return the largest number of entries sharing a name, or -1.
+ */
+static int
+_check_names(Dwarf_Debug dbg, int weak, int step, Dwarf_Off *offs)
+{
+	Dwarf_Global *globals;
+	Dwarf_Weak *weaks;
+	Dwarf_Error de;
+	Dwarf_Signed cnt, k;
+	Dwarf_Off off;
+	int i, j, r, maxcnt;
+
+	maxcnt = 0;
+	for (i = 0; i < _nnames; i += step) {
+		/* Look up each name once. */
+		for (j = 0; j < i; j += step)
+			if (!strcmp(_names[j], _names[i]))
+				break;
+		if (j < i)
+			continue;
+
+		if (weak)
+			r = dwarf_weaks_lookup(dbg, _names[i], &weaks, &cnt,
+			    &de);
+		else
+			r = dwarf_globals_lookup(dbg, _names[i], &globals,
+			    &cnt, &de);
+		if (r != DW_DLV_OK) {
+			tet_printf("lookup of \"%s\" failed: %s\n", _names[i],
+			    dwarf_errmsg(de));
+			result = TET_FAIL;
+			return (-1);
+		}
+
+		/* Entries sharing a name come in section order. */
+		for (j = i, k = 0; j < _nnames; j += step) {
+			if (strcmp(_names[j], _names[i]) != 0)
+				continue;
+			if (k >= cnt)
+				break;
+			if (weak)
+				r = dwarf_weak_die_offset(weaks[k], &off, &de);
+			else
+				r = dwarf_global_die_offset(globals[k], &off,
+				    &de);
+			if (r != DW_DLV_OK || off != offs[j])
+				break;
+			k++;
+		}
+		if (j < _nnames || k != cnt) {
+			tet_printf("lookup of \"%s\" returned wrong entries\n",
+			    _names[i]);
+			result = TET_FAIL;
+			return (-1);
+		}
+		if (cnt > maxcnt)
+			maxcnt = cnt;
+	}
+
+	return (maxcnt);
+}
+
+/*
+ * Enter every child DIE in the global name table and every other one
+ * in the weak name table, then look their names up.
+ */
+static void
+tp_dwarf_producer_pubnames(void)
+{
+	Dwarf_P_Debug pdbg;
+	Dwarf_P_Die *dies;
+	Dwarf_Debug dbg;
+	Dwarf_Error de;
+	Dwarf_Global *globals;
+	Dwarf_Off *offs;
+	Dwarf_Signed cnt;
+	int i, r_missing, globals_max, weaks_max;
+
+	result = TET_UNRESOLVED;
+	pdbg = NULL;
+	dbg = NULL;
+	dies = NULL;
+	offs = NULL;
+
+	if (_names_load() < 0)
+		goto done;
+
+	if ((pdbg = _pro_init(0)) == NULL ||
+	    _pro_unit(pdbg, DW_TAG_variable, &dies) == NULL)
+		goto done;
+	for (i = 0; i < _nnames; i++) {
+		if (dwarf_add_pubname(pdbg, dies[i], _names[i], &de) == 0 ||
+		    (i % 2 == 0 && dwarf_add_weakname(pdbg, dies[i],
+		    _names[i], &de) == 0)) {
+			tet_printf("adding name \"%s\" failed: %s\n",
+			    _names[i], dwarf_errmsg(de));
+			result = TET_FAIL;
+			goto done;
+		}
+	}
+	if (_pro_collect(pdbg) < 0 || (dbg = _obj_open()) == NULL)
+		goto done;
+
+	if ((offs = calloc(_nnames, sizeof(*offs))) == NULL) {
+		tet_printf("calloc failed: %s\n", strerror(errno));
+		goto done;
+	}
+	if (_check_unit(dbg, offs) < 0)
+		goto done;
+
+	globals_max = _check_names(dbg, 0, 1, offs);
+	TS_CHECK_INT(globals_max);
+	weaks_max = _check_names(dbg, 1, 2, offs);
+	TS_CHECK_INT(weaks_max);
+
+	r_missing = dwarf_globals_lookup(dbg, "no such name", &globals, &cnt,
+	    &de);
+	TS_CHECK_INT(r_missing);
+
+	if (result == TET_UNRESOLVED)
+		result = TET_PASS;
+
+done:
+	if (dbg != NULL)
+		(void) dwarf_object_finish(dbg, &de);
+	if (pdbg != NULL)
+		(void) dwarf_producer_finish(pdbg, &de);
+	free(offs);
+	free(dies);
+	_secs_free();
+	_names_free();
+	TS_RESULT(result);
+}
+
+/*
+ * Return the size of the string table expected for the names of the
+ * test object.  Names that fit in a section offset are stored inline.
+ * Other names are stored once, unless "merge" is set and the name is
+ * the tail of a name stored before it.
+ */
+static Dwarf_Unsigned
+_strtab_size(int merge)
+{
+	Dwarf_Unsigned size;
+	size_t len, tlen;
+	int i, j;
+
+	size = 0;
+	for (i = 0; i < _nnames; i++) {
+		len = strlen(_names[i]);
+		if (len + 1 <= 4)
+			continue;
+		for (j = 0; j < i; j++) {
+			tlen = strlen(_names[j]);
+			if (tlen + 1 <= 4)
+				continue;
+			if (merge ? tlen >= len &&
+			    !strcmp(_names[j] + tlen - len, _names[i]) :
+			    !strcmp(_names[j], _names[i]))
+				break;
+		}
+		if (j == i)
+			size += len + 1;
+	}
+
+	return (size);
+}
+
+/*
+ * Check the form of the names of the children of the first unit.
+ * Return the number of names stored inline, or -1.
+ */
+static int
+_check_forms(Dwarf_Debug dbg)
+{
+	Dwarf_Attribute at;
+	Dwarf_Die cu, die, sib;
+	Dwarf_Error de;
+	Dwarf_Half form;
+	int i, inl, r;
+
+	if (dwarf_siblingof(dbg, NULL, &cu, &de) != DW_DLV_OK) {
+		tet_printf("dwarf_siblingof failed: %s\n", dwarf_errmsg(de));
+		result = TET_FAIL;
+		return (-1);
+	}
+
+	i = inl = 0;
+	r = dwarf_child(cu, &die, &de);
+	dwarf_dealloc(dbg, cu, DW_DLA_DIE);
+	for (; r == DW_DLV_OK; i++) {
+		if (dwarf_attr(die, DW_AT_name, &at, &de) != DW_DLV_OK ||
+		    dwarf_whatform(at, &form, &de) != DW_DLV_OK ||
+		    form != (strlen(_names[i]) + 1 <= 4 ? DW_FORM_string :
+		    DW_FORM_strp)) {
+			tet_printf("DIE #%d has a wrong name form\n", i);
+			result = TET_FAIL;
+			dwarf_dealloc(dbg, die, DW_DLA_DIE);
+			return (-1);
+		}
+		if (form == DW_FORM_string)
+			inl++;
+		r = dwarf_siblingof(dbg, die, &sib, &de);
+		dwarf_dealloc(dbg, die, DW_DLA_DIE);
+		die = sib;
+	}
+
+	return (inl);
+}
+
+/*
+ * Strings are stored once in .debug_str, and with tail merging a name
+ * that ends another one reuses its tail.  Short names are stored
+ * inline.
+ */
+static void
+tp_dwarf_producer_strings(void)
+{
+	Dwarf_P_Debug pdbg;
+	Dwarf_Debug dbg;
+	Dwarf_Error de;
+	Dwarf_Unsigned str_size, str_size_merged;
+	struct _sec *s;
+	int cnt, inl, merge;
+
+	result = TET_UNRESOLVED;
+	pdbg = NULL;
+	dbg = NULL;
+
+	if (_names_load() < 0)
+		goto done;
+
+	str_size = str_size_merged = 0;
+	for (merge = 0; merge <= 1; merge++) {
+		if ((pdbg = _pro_init(merge ? DW_DLC_STRING_TAIL_MERGE : 0)) ==
+		    NULL || _pro_unit(pdbg, DW_TAG_variable, NULL) == NULL ||
+		    _pro_collect(pdbg) < 0 || (dbg = _obj_open()) == NULL)
+			goto done;
+
+		cnt = _check_unit(dbg, NULL);
+		TS_CHECK_INT(cnt);
+		inl = _check_forms(dbg);
+		TS_CHECK_INT(inl);
+
+		s = _sec_find(".debug_str");
+		if (merge) {
+			str_size_merged = s != NULL ? s->s_size : 0;
+			TS_CHECK_UINT(str_size_merged);
+		} else {
+			str_size = s != NULL ? s->s_size : 0;
+			TS_CHECK_UINT(str_size);
+		}
+		if ((s != NULL ? s->s_size : 0) != _strtab_size(merge)) {
+			tet_printf("unexpected .debug_str size %ju, "
+			    "expected %ju\n", (uintmax_t) (s != NULL ?
+			    s->s_size : 0), (uintmax_t) _strtab_size(merge));
+			result = TET_FAIL;
+			goto done;
+		}
+
+		(void) dwarf_object_finish(dbg, &de);
+		dbg = NULL;
+		(void) dwarf_producer_finish(pdbg, &de);
+		pdbg = NULL;
+		_secs_free();
+	}
+
+	if (str_size_merged > str_size) {
+		tet_infoline("tail merging grew the string table");
+		result = TET_FAIL;
+	}
+
+	if (result == TET_UNRESOLVED)
+		result = TET_PASS;
+
+done:
+	if (dbg != NULL)
+		(void) dwarf_object_finish(dbg, &de);
+	if (pdbg != NULL)
+		(void) dwarf_producer_finish(pdbg, &de);
+	_secs_free();
+	_names_free();
+	TS_RESULT(result);
+}
+
+/*
+ * In a unit built by _pro_typed_unit(), every third child is a base
+ * type.  The other children are variables, whose type is the base type
+ * before them or, for every other variable, the one after them if
+ * there is one.
+ */
+#define	_IS_BASE(i)	((i) % 3 == 0)
+
+static int
+_typed_target(int i, int n)
+{
+	int b;
+
+	b = i - i % 3;
+	if (i % 3 == 2 && b + 3 < n)
+		return (b + 3);
+
+	return (b);
+}
+
+/* Abbrev shapes of the children: their tag and their name form. */
+static int
+_typed_shape(int i)
+{
+
+	return ((_IS_BASE(i) ? 2 : 0) |
+	    (strlen(_names[i % _nnames]) + 1 <= 4 ? 1 : 0));
+}
+
+/*
+ * Build a unit with "n" children, named after the names of the test
+ * object in turn.  Children after the first are linked to their left
+ * sibling, which unlike linking to the parent takes constant time.
+ */
+static int
+_pro_typed_unit(Dwarf_P_Debug dbg, int n)
+{
+	Dwarf_Error de;
+	Dwarf_P_Die cu, *dies;
+	int i;
+
+	if ((dies = calloc(n, sizeof(*dies))) == NULL) {
+		tet_printf("calloc failed: %s\n", strerror(errno));
+		result = TET_UNRESOLVED;
+		return (-1);
+	}
+
+	cu = dwarf_new_die(dbg, DW_TAG_compile_unit, NULL, NULL, NULL, NULL,
+	    &de);
+	if (cu == DW_DLV_BADADDR)
+		goto fail;
+	for (i = 0; i < n; i++) {
+		dies[i] = dwarf_new_die(dbg, _IS_BASE(i) ? DW_TAG_base_type :
+		    DW_TAG_variable, i == 0 ? cu : NULL, NULL,
+		    i == 0 ? NULL : dies[i - 1], NULL, &de);
+		if (dies[i] == DW_DLV_BADADDR)
+			goto fail;
+		if (dwarf_add_AT_name(dies[i], _names[i % _nnames], &de) ==
+		    DW_DLV_BADADDR)
+			goto fail;
+	}
+	for (i = 0; i < n; i++) {
+		if (!_IS_BASE(i) && dwarf_add_AT_reference(dbg, dies[i],
+		    DW_AT_type, dies[_typed_target(i, n)], &de) ==
+		    DW_DLV_BADADDR)
+			goto fail;
+	}
+	if (dwarf_add_die_to_debug(dbg, cu, &de) == DW_DLV_NOCOUNT)
+		goto fail;
+
+	free(dies);
+	return (0);
+
+fail:
+	tet_printf("building the unit failed: %s\n", dwarf_errmsg(de));
+	result = TET_FAIL;
+	free(dies);
+	return (-1);
+}
+
+/*
+ * Check the children of a unit built by _pro_typed_unit() and return
+ * the form of their references, or 0.  The offset of the end of the
+ * unit is returned in "cu_end".
+ */
+static Dwarf_Half
+_check_typed_unit(Dwarf_Debug dbg, int n, Dwarf_Unsigned *cu_end)
+{
+	Dwarf_Attribute at;
+	Dwarf_Die cu, die, sib;
+	Dwarf_Error de;
+	Dwarf_Half form, tag, ref_form, exp_form;
+	Dwarf_Off *offs, *refs;
+	char *name;
+	int i, r;
+
+	offs = calloc(n, sizeof(*offs));
+	refs = calloc(n, sizeof(*refs));
+	if (offs == NULL || refs == NULL) {
+		tet_printf("calloc failed: %s\n", strerror(errno));
+		result = TET_UNRESOLVED;
+		goto fail;
+	}
+
+	if (dwarf_next_cu_header(dbg, NULL, NULL, NULL, NULL,
+	    cu_end, &de) != DW_DLV_OK ||
+	    dwarf_siblingof(dbg, NULL, &cu, &de) != DW_DLV_OK) {
+		tet_printf("reading the unit failed: %s\n", dwarf_errmsg(de));
+		result = TET_FAIL;
+		goto fail;
+	}
+
+	ref_form = 0;
+	r = dwarf_child(cu, &die, &de);
+	dwarf_dealloc(dbg, cu, DW_DLA_DIE);
+	for (i = 0; r == DW_DLV_OK; i++) {
+		if (i >= n || dwarf_diename(die, &name, &de) != DW_DLV_OK ||
+		    strcmp(name, _names[i % _nnames]) != 0 ||
+		    dwarf_tag(die, &tag, &de) != DW_DLV_OK ||
+		    tag != (_IS_BASE(i) ? DW_TAG_base_type :
+		    DW_TAG_variable) ||
+		    dwarf_dieoffset(die, &offs[i], &de) != DW_DLV_OK)
+			goto fail_die;
+		if (!_IS_BASE(i)) {
+			if (dwarf_attr(die, DW_AT_type, &at, &de) !=
+			    DW_DLV_OK || dwarf_whatform(at, &form, &de) !=
+			    DW_DLV_OK || dwarf_global_formref(at, &refs[i],
+			    &de) != DW_DLV_OK)
+				goto fail_die;
+			/* All references use the same form. */
+			if (ref_form == 0)
+				ref_form = form;
+			if (form != ref_form)
+				goto fail_die;
+		}
+		r = dwarf_siblingof(dbg, die, &sib, &de);
+		dwarf_dealloc(dbg, die, DW_DLA_DIE);
+		die = sib;
+	}
+	if (r == DW_DLV_ERROR || i != n) {
+		tet_printf("found %d DIEs, expected %d\n", i, n);
+		result = TET_FAIL;
+		goto fail;
+	}
+
+	for (i = 0; i < n; i++) {
+		if (!_IS_BASE(i) && refs[i] != offs[_typed_target(i, n)]) {
+			tet_printf("DIE #%d refers to %ju\n", i,
+			    (uintmax_t) refs[i]);
+			result = TET_FAIL;
+			goto fail;
+		}
+	}
+
+	/* The form is the smallest one that holds any offset in the unit. */
+	if (*cu_end <= UCHAR_MAX)
+		exp_form = DW_FORM_ref1;
+	else if (*cu_end <= USHRT_MAX)
+		exp_form = DW_FORM_ref2;
+	else
+		exp_form = DW_FORM_ref4;
+	if (ref_form != exp_form) {
+		tet_printf("references use form %#x in a unit of %ju bytes\n",
+		    ref_form, (uintmax_t) *cu_end);
+		result = TET_FAIL;
+		goto fail;
+	}
+
+	free(offs);
+	free(refs);
+	return (ref_form);
+
+fail_die:
+	tet_printf("DIE #%d does not match\n", i);
+	result = TET_FAIL;
+	dwarf_dealloc(dbg, die, DW_DLA_DIE);
+fail:
+	free(offs);
+	free(refs);
+	return (0);
+}
+
+/*
+ * Count the abbrevs of a unit built by _pro_typed_unit() and check
+ * that a shape used by more DIEs than any other has code 1.
+ */
+static int
+_check_typed_abbrevs(Dwarf_Debug dbg, int n)
+{
+	Dwarf_Abbrev ab;
+	Dwarf_Die cu, die;
+	Dwarf_Error de;
+	Dwarf_Unsigned off, length, attr_count, code;
+	int cnt, i, shape, shapes, tied, uses[4];
+
+	cnt = 0;
+	for (off = 0; dwarf_get_abbrev(dbg, off, &ab, &length, &attr_count,
+	    &de) == DW_DLV_OK; off += length) {
+		if (dwarf_get_abbrev_code(ab, &code, &de) == DW_DLV_OK &&
+		    code != 0)
+			cnt++;
+		dwarf_dealloc(dbg, ab, DW_DLA_ABBREV);
+	}
+
+	/* One abbrev for the unit DIE and one for each child shape. */
+	memset(uses, 0, sizeof(uses));
+	for (i = 0; i < n; i++)
+		uses[_typed_shape(i)]++;
+	for (i = shapes = 0, shape = 0; i < 4; i++) {
+		if (uses[i] > 0)
+			shapes++;
+		if (uses[i] > uses[shape])
+			shape = i;
+	}
+	for (i = 0, tied = uses[shape] <= 1; i < 4; i++)
+		if (i != shape && uses[i] == uses[shape])
+			tied = 1;
+	if (cnt != shapes + 1) {
+		tet_printf("found %d abbrevs, expected %d\n", cnt, shapes + 1);
+		result = TET_FAIL;
+		return (-1);
+	}
+	if (tied)
+		return (cnt);
+
+	for (i = 0; _typed_shape(i) != shape; i++)
+		continue;
+	if (dwarf_siblingof(dbg, NULL, &cu, &de) != DW_DLV_OK ||
+	    dwarf_child(cu, &die, &de) != DW_DLV_OK) {
+		tet_printf("reading the unit failed: %s\n", dwarf_errmsg(de));
+		result = TET_FAIL;
+		return (-1);
+	}
+	dwarf_dealloc(dbg, cu, DW_DLA_DIE);
+	while (i-- > 0) {
+		cu = die;
+		if (dwarf_siblingof(dbg, cu, &die, &de) != DW_DLV_OK) {
+			tet_printf("dwarf_siblingof failed: %s\n",
+			    dwarf_errmsg(de));
+			result = TET_FAIL;
+			dwarf_dealloc(dbg, cu, DW_DLA_DIE);
+			return (-1);
+		}
+		dwarf_dealloc(dbg, cu, DW_DLA_DIE);
+	}
+	code = dwarf_die_abbrev_code(die);
+	dwarf_dealloc(dbg, die, DW_DLA_DIE);
+	if (code != 1) {
+		tet_printf("the most used abbrev has code %ju\n",
+		    (uintmax_t) code);
+		result = TET_FAIL;
+		return (-1);
+	}
+
+	return (cnt);
+}
+
+/*
+ * DIEs of the same shape share an abbrev, and references take the
+ * smallest form that holds the size of the unit: units of a few DIEs,
+ * of the names of the test object and of many thousands of DIEs use
+ * DW_FORM_ref1, DW_FORM_ref2 and DW_FORM_ref4 respectively.
+ */
+static void
+tp_dwarf_producer_abbrevs(void)
+{
+	Dwarf_P_Debug pdbg;
+	Dwarf_Debug dbg;
+	Dwarf_Error de;
+	Dwarf_Half ref_form;
+	Dwarf_Unsigned cu_end;
+	int abbrev_cnt, i, n;
+
+	result = TET_UNRESOLVED;
+	pdbg = NULL;
+	dbg = NULL;
+
+	if (_names_load() < 0)
+		goto done;
+
+	for (i = 0; i < 3; i++) {
+		n = i == 0 ? 4 : i == 1 ? _nnames : 16384;
+		if ((pdbg = _pro_init(0)) == NULL ||
+		    _pro_typed_unit(pdbg, n) < 0 || _pro_collect(pdbg) < 0 ||
+		    (dbg = _obj_open()) == NULL)
+			goto done;
+
+		ref_form = _check_typed_unit(dbg, n, &cu_end);
+		TS_CHECK_UINT(ref_form);
+		abbrev_cnt = _check_typed_abbrevs(dbg, n);
+		TS_CHECK_INT(abbrev_cnt);
+
+		(void) dwarf_object_finish(dbg, &de);
+		dbg = NULL;
+		(void) dwarf_producer_finish(pdbg, &de);
+		pdbg = NULL;
+		_secs_free();
+	}
+
+	if (result == TET_UNRESOLVED)
+		result = TET_PASS;
+
+done:
+	if (dbg != NULL)
+		(void) dwarf_object_finish(dbg, &de);
+	if (pdbg != NULL)
+		(void) dwarf_producer_finish(pdbg, &de);
+	_secs_free();
+	_names_free();
+	TS_RESULT(result);
+}
+
+#define	_TREE_DEPTH	20000
+#define	_TREE_WIDTH	100000
+#define	_TREE_LEAVES	10
+
+/*
+ * Build a unit whose DIEs nest "depth" deep.  Each nested DIE is named
+ * after the names of the test object in turn and is followed by a
+ * sibling leaf.
+ */
+static int
+_pro_deep_unit(Dwarf_P_Debug dbg, int depth)
+{
+	Dwarf_Error de;
+	Dwarf_P_Die die, parent;
+	int i;
+
+	parent = dwarf_new_die(dbg, DW_TAG_compile_unit, NULL, NULL, NULL,
+	    NULL, &de);
+	if (parent == DW_DLV_BADADDR)
+		goto fail;
+	if (dwarf_add_die_to_debug(dbg, parent, &de) == DW_DLV_NOCOUNT)
+		goto fail;
+	for (i = 0; i < depth; i++) {
+		die = dwarf_new_die(dbg, DW_TAG_lexical_block, parent, NULL,
+		    NULL, NULL, &de);
+		if (die == DW_DLV_BADADDR ||
+		    dwarf_add_AT_name(die, _names[i % _nnames], &de) ==
+		    DW_DLV_BADADDR)
+			goto fail;
+		if (dwarf_new_die(dbg, DW_TAG_variable, parent, NULL, NULL,
+		    NULL, &de) == DW_DLV_BADADDR)
+			goto fail;
+		parent = die;
+	}
+
+	return (0);
+
+fail:
+	tet_printf("building the unit failed: %s\n", dwarf_errmsg(de));
+	result = TET_FAIL;
+	return (-1);
+}
+
+/*
+ * Walk down the nested DIEs of a unit built by _pro_deep_unit() and
+ * return the depth found, or -1.  The sibling leaf of the first few
+ * nested DIEs, which follows all of their descendants, is checked as
+ * well.  The offset of the end of the unit is returned in "cu_end".
+ */
+static int
+_check_deep_unit(Dwarf_Debug dbg, int depth, Dwarf_Unsigned *cu_end)
+{
+	Dwarf_Die die, parent, sib;
+	Dwarf_Error de;
+	Dwarf_Half tag;
+	char *name;
+	int i, r;
+
+	if (dwarf_next_cu_header(dbg, NULL, NULL, NULL, NULL,
+	    cu_end, &de) != DW_DLV_OK ||
+	    dwarf_siblingof(dbg, NULL, &parent, &de) != DW_DLV_OK) {
+		tet_printf("reading the unit failed: %s\n", dwarf_errmsg(de));
+		result = TET_FAIL;
+		return (-1);
+	}
+
+	for (i = 0; (r = dwarf_child(parent, &die, &de)) == DW_DLV_OK; i++) {
+		dwarf_dealloc(dbg, parent, DW_DLA_DIE);
+		if (i >= depth || dwarf_diename(die, &name, &de) !=
+		    DW_DLV_OK || strcmp(name, _names[i % _nnames]) != 0)
+			goto fail;
+		if (i < _TREE_LEAVES) {
+			if (dwarf_siblingof(dbg, die, &sib, &de) != DW_DLV_OK)
+				goto fail;
+			r = dwarf_tag(sib, &tag, &de);
+			dwarf_dealloc(dbg, sib, DW_DLA_DIE);
+			if (r != DW_DLV_OK || tag != DW_TAG_variable)
+				goto fail;
+		}
+		parent = die;
+	}
+	dwarf_dealloc(dbg, parent, DW_DLA_DIE);
+	if (r == DW_DLV_ERROR || i != depth) {
+		tet_printf("found a depth of %d, expected %d\n", i, depth);
+		result = TET_FAIL;
+		return (-1);
+	}
+
+	return (i);
+
+fail:
+	tet_printf("nested DIE #%d does not match\n", i);
+	result = TET_FAIL;
+	dwarf_dealloc(dbg, die, DW_DLA_DIE);
+	return (-1);
+}
+
+/*
+ * The producer walks the DIE tree without recursion: a unit nested
+ * many thousands deep and one with a hundred thousand siblings are
+ * generated and read back intact, and the unit fills .debug_info
+ * exactly.
+ */
+static void
+tp_dwarf_producer_trees(void)
+{
+	Dwarf_P_Debug pdbg;
+	Dwarf_Debug dbg;
+	Dwarf_Error de;
+	Dwarf_Half ref_form;
+	Dwarf_Unsigned cu_end;
+	struct _sec *s;
+	int depth, wide;
+
+	result = TET_UNRESOLVED;
+	pdbg = NULL;
+	dbg = NULL;
+
+	if (_names_load() < 0)
+		goto done;
+
+	for (wide = 0; wide <= 1; wide++) {
+		if ((pdbg = _pro_init(0)) == NULL)
+			goto done;
+		if ((wide ? _pro_typed_unit(pdbg, _TREE_WIDTH) :
+		    _pro_deep_unit(pdbg, _TREE_DEPTH)) < 0 ||
+		    _pro_collect(pdbg) < 0 || (dbg = _obj_open()) == NULL)
+			goto done;
+
+		if (wide) {
+			ref_form = _check_typed_unit(dbg, _TREE_WIDTH,
+			    &cu_end);
+			TS_CHECK_UINT(ref_form);
+		} else {
+			depth = _check_deep_unit(dbg, _TREE_DEPTH, &cu_end);
+			TS_CHECK_INT(depth);
+		}
+
+		/* The unit is followed by nothing. */
+		s = _sec_find(".debug_info");
+		if (s == NULL || cu_end != s->s_size) {
+			tet_printf("the unit ends at %ju in .debug_info\n",
+			    (uintmax_t) cu_end);
+			result = TET_FAIL;
+		}
+		TS_CHECK_UINT(cu_end);
+
+		(void) dwarf_object_finish(dbg, &de);
+		dbg = NULL;
+		(void) dwarf_producer_finish(pdbg, &de);
+		pdbg = NULL;
+		_secs_free();
+	}
+
+	if (result == TET_UNRESOLVED)
+		result = TET_PASS;
+
+done:
+	if (dbg != NULL)
+		(void) dwarf_object_finish(dbg, &de);
+	if (pdbg != NULL)
+		(void) dwarf_producer_finish(pdbg, &de);
+	_secs_free();
+	_names_free();
+	TS_RESULT(result);
+}
+
+/*
+ * Application symbols referred to by relocations.  They are numbered
+ * above the section ids so that the two kinds of relocations can be
+ * told apart.
+ */
+#define	_SYM_TEXT	(_MAX_SECS + 1)
+#define	_SYM_ETEXT	(_MAX_SECS + 2)
+#define	_SYM_DATA	(_MAX_SECS + 3)
+#define	_RELOC_SECS	3
+
+static const char *_reloc_secs[_RELOC_SECS] = { ".debug_info",
+    ".debug_line", ".debug_aranges" };
+
+/*
+ * Add a unit whose children are located by DW_OP_addr expressions
+ * against an application symbol, together with a line program and an
+ * address range covering the text of the unit.
+ */
+static int
+_pro_reloc_unit(Dwarf_P_Debug dbg)
+{
+	Dwarf_Error de;
+	Dwarf_P_Die cu, *dies;
+	Dwarf_P_Expr expr;
+	int i;
+
+	if ((cu = _pro_unit(dbg, DW_TAG_variable, &dies)) == NULL)
+		return (-1);
+
+	if (dwarf_add_AT_targ_address_b(dbg, cu, DW_AT_low_pc, 0, _SYM_TEXT,
+	    &de) == DW_DLV_BADADDR)
+		goto fail;
+	for (i = 0; i < _nnames; i++) {
+		if ((expr = dwarf_new_expr(dbg, &de)) == DW_DLV_BADADDR ||
+		    dwarf_add_expr_addr_b(expr, i * 8, _SYM_DATA, &de) ==
+		    DW_DLV_NOCOUNT ||
+		    dwarf_add_AT_location_expr(dbg, dies[i], DW_AT_location,
+		    expr, &de) == DW_DLV_BADADDR)
+			goto fail;
+	}
+
+	if (dwarf_add_file_decl(dbg, _names[0], 0, 0, 0, &de) ==
+	    DW_DLV_NOCOUNT ||
+	    dwarf_lne_set_address(dbg, 0, _SYM_TEXT, &de) == DW_DLV_NOCOUNT)
+		goto fail;
+	for (i = 0; i < _nnames; i++)
+		if (dwarf_add_line_entry(dbg, 1, i * 4, i + 1, 0, 1, 0,
+		    &de) == DW_DLV_NOCOUNT)
+			goto fail;
+	if (dwarf_lne_end_sequence(dbg, _nnames * 4, &de) == DW_DLV_NOCOUNT)
+		goto fail;
+
+	/* The length of the range is given by a pair of symbols. */
+	if (dwarf_add_arange_b(dbg, 0, 0, _SYM_TEXT, _SYM_ETEXT, 0, &de) ==
+	    0)
+		goto fail;
+
+	free(dies);
+
+	return (0);
+
+fail:
+	tet_printf("building the unit failed: %s\n", dwarf_errmsg(de));
+	result = TET_FAIL;
+	free(dies);
+	return (-1);
+}
+
+/*
+ * Walk the relocations of a producer and count those against debug
+ * sections and those against application symbols.  The entries of
+ * each relocation section must come in the order of the storage units
+ * they apply to, with the halves of a length pair kept together.
+ */
+static int
+_check_relocs(Dwarf_P_Debug dbg, Dwarf_Unsigned *nsec, Dwarf_Unsigned *napp)
+{
+	Dwarf_Error de;
+	Dwarf_Relocation_Data drd;
+	Dwarf_Signed id, link;
+	Dwarf_Unsigned cnt, i, nrel;
+	struct _sec *s;
+	int ok, version;
+
+	*nsec = *napp = 0;
+
+	if (dwarf_get_relocation_info_count(dbg, &nrel, &version, &de) !=
+	    DW_DLV_OK) {
+		tet_printf("dwarf_get_relocation_info_count failed: %s\n",
+		    dwarf_errmsg(de));
+		result = TET_FAIL;
+		return (-1);
+	}
+
+	for (; nrel > 0; nrel--) {
+		if (dwarf_get_relocation_info(dbg, &id, &link, &cnt, &drd,
+		    &de) != DW_DLV_OK) {
+			tet_printf("dwarf_get_relocation_info failed: %s\n",
+			    dwarf_errmsg(de));
+			result = TET_FAIL;
+			return (-1);
+		}
+		if (link < 1 || link > _nsecs) {
+			tet_printf("unknown section id %jd\n", (intmax_t) link);
+			result = TET_FAIL;
+			return (-1);
+		}
+		s = &_secs[link - 1];
+		for (i = 0; i < cnt; i++) {
+			if (drd[i].drd_offset + drd[i].drd_length >
+			    s->s_size) {
+				tet_printf("%s: relocation #%ju is out of "
+				    "the section\n", s->s_name, (uintmax_t) i);
+				result = TET_FAIL;
+				return (-1);
+			}
+			if (drd[i].drd_type == dwarf_drt_second_of_length_pair)
+				ok = i > 0 && drd[i - 1].drd_type ==
+				    dwarf_drt_first_of_length_pair &&
+				    drd[i - 1].drd_offset == drd[i].drd_offset;
+			else
+				ok = i == 0 ||
+				    drd[i - 1].drd_offset < drd[i].drd_offset;
+			if (!ok) {
+				tet_printf("%s: relocation #%ju is out of "
+				    "order\n", s->s_name, (uintmax_t) i);
+				result = TET_FAIL;
+				return (-1);
+			}
+			if (drd[i].drd_symbol_index >= 1 &&
+			    drd[i].drd_symbol_index <= (Dwarf_Unsigned) _nsecs)
+				(*nsec)++;
+			else
+				(*napp)++;
+		}
+	}
+
+	return (0);
+}
+
+/*
+ * Check that the children of the first unit of a consumer are located
+ * at the addresses they were given.
+ */
+static int
+_check_locations(Dwarf_Debug dbg, Dwarf_Off *offs)
+{
+	Dwarf_Attribute at;
+	Dwarf_Die die;
+	Dwarf_Error de;
+	Dwarf_Locdesc *llbuf;
+	Dwarf_Signed lcnt;
+	int i, ok;
+
+	for (i = 0; i < _nnames; i++) {
+		if (dwarf_offdie(dbg, offs[i], &die, &de) != DW_DLV_OK) {
+			tet_printf("dwarf_offdie failed: %s\n",
+			    dwarf_errmsg(de));
+			result = TET_FAIL;
+			return (-1);
+		}
+		ok = dwarf_attr(die, DW_AT_location, &at, &de) == DW_DLV_OK &&
+		    dwarf_loclist(at, &llbuf, &lcnt, &de) == DW_DLV_OK;
+		dwarf_dealloc(dbg, die, DW_DLA_DIE);
+		if (!ok) {
+			tet_printf("DIE #%d has no location: %s\n", i,
+			    dwarf_errmsg(de));
+			result = TET_FAIL;
+			return (-1);
+		}
+		ok = lcnt == 1 && llbuf->ld_cents == 1 &&
+		    llbuf->ld_s[0].lr_atom == DW_OP_addr &&
+		    llbuf->ld_s[0].lr_number == (Dwarf_Unsigned) i * 8;
+		dwarf_dealloc(dbg, llbuf->ld_s, DW_DLA_LOC_BLOCK);
+		dwarf_dealloc(dbg, llbuf, DW_DLA_LOCDESC);
+		if (!ok) {
+			tet_printf("DIE #%d has a wrong location\n", i);
+			result = TET_FAIL;
+			return (-1);
+		}
+	}
+
+	return (0);
+}
+
+/*
+ * Build the same object with and without DW_DLC_NO_SECTION_RELOCATIONS.
+ * The flag drops the relocations against the debug sections but keeps
+ * those against application symbols, and the sections are written the
+ * same way.  Either way the object reads back without applying any
+ * relocation.
+ */
+static void
+tp_dwarf_producer_relocs(void)
+{
+	Dwarf_P_Debug pdbg;
+	Dwarf_Debug dbg;
+	Dwarf_Error de;
+	Dwarf_Off *offs;
+	Dwarf_Unsigned nsec[2], napp[2];
+	Dwarf_Small *saved[_RELOC_SECS];
+	Dwarf_Unsigned saved_size[_RELOC_SECS];
+	struct _sec *s;
+	int cnt, flag, i;
+
+	result = TET_UNRESOLVED;
+	pdbg = NULL;
+	dbg = NULL;
+	offs = NULL;
+	memset(saved, 0, sizeof(saved));
+
+	if (_names_load() < 0)
+		goto done;
+
+	if ((offs = calloc(_nnames, sizeof(*offs))) == NULL) {
+		tet_printf("calloc failed: %s\n", strerror(errno));
+		goto done;
+	}
+
+	for (flag = 0; flag <= 1; flag++) {
+		if ((pdbg = _pro_init(flag ? DW_DLC_NO_SECTION_RELOCATIONS :
+		    0)) == NULL || _pro_reloc_unit(pdbg) < 0 ||
+		    _pro_collect(pdbg) < 0 ||
+		    _check_relocs(pdbg, &nsec[flag], &napp[flag]) < 0 ||
+		    (dbg = _obj_open()) == NULL)
+			goto done;
+
+		cnt = _check_unit(dbg, offs);
+		TS_CHECK_INT(cnt);
+		if (cnt < 0 || _check_locations(dbg, offs) < 0)
+			goto done;
+
+		for (i = 0; i < _RELOC_SECS; i++) {
+			if ((s = _sec_find(_reloc_secs[i])) == NULL) {
+				tet_printf("%s is missing\n", _reloc_secs[i]);
+				result = TET_FAIL;
+				goto done;
+			}
+			if (flag == 0) {
+				/* Keep the contents for the second round. */
+				saved[i] = s->s_data;
+				saved_size[i] = s->s_size;
+				s->s_data = NULL;
+			} else if (s->s_size != saved_size[i] ||
+			    memcmp(s->s_data, saved[i], s->s_size)) {
+				tet_printf("%s differs\n", _reloc_secs[i]);
+				result = TET_FAIL;
+			}
+		}
+
+		(void) dwarf_object_finish(dbg, &de);
+		dbg = NULL;
+		(void) dwarf_producer_finish(pdbg, &de);
+		pdbg = NULL;
+		_secs_free();
+	}
+
+	TS_CHECK_UINT(nsec[0]);
+	TS_CHECK_UINT(napp[0]);
+
+	/*
+	 * Besides the location of each child, the low pc of the unit and
+	 * the start of the line program refer to an application symbol.
+	 * So does the start of the address range, whose length takes a
+	 * pair of relocations.
+	 */
+	if (napp[0] != (Dwarf_Unsigned) _nnames + 5 || nsec[0] == 0) {
+		tet_printf("%ju application and %ju section relocations\n",
+		    (uintmax_t) napp[0], (uintmax_t) nsec[0]);
+		result = TET_FAIL;
+	}
+	if (nsec[1] != 0 || napp[1] != napp[0]) {
+		tet_printf("%ju application and %ju section relocations "
+		    "under DW_DLC_NO_SECTION_RELOCATIONS\n",
+		    (uintmax_t) napp[1], (uintmax_t) nsec[1]);
+		result = TET_FAIL;
+	}
+
+	if (result == TET_UNRESOLVED)
+		result = TET_PASS;
+
+done:
+	if (dbg != NULL)
+		(void) dwarf_object_finish(dbg, &de);
+	if (pdbg != NULL)
+		(void) dwarf_producer_finish(pdbg, &de);
+	for (i = 0; i < _RELOC_SECS; i++)
+		free(saved[i]);
+	free(offs);
+	_secs_free();
+	_names_free();
+	TS_RESULT(result);
+}
+
+#define	_FRAME_CIES	10000
+
+/* The CIE an FDE is added with; spreads the FDEs over all the CIEs. */
+#define	_FDE_CIE(i)	(((i) * 7919) % _FRAME_CIES)
+
+/*
+ * Add a CIE with its own code alignment factor and return address
+ * register for each FDE, and describe a function with each FDE.
+ */
+static int
+_pro_frames(Dwarf_P_Debug dbg)
+{
+	Dwarf_Error de;
+	Dwarf_P_Fde fde;
+	Dwarf_Small initinst[] = { DW_CFA_def_cfa, 7, 8 };
+	int i;
+
+	for (i = 0; i < _FRAME_CIES; i++)
+		if (dwarf_add_frame_cie(dbg, "", i % 127 + 1,
+		    (Dwarf_Small) -8, i % 32, initinst, sizeof(initinst),
+		    &de) != (Dwarf_Unsigned) i)
+			goto fail;
+	for (i = 0; i < _FRAME_CIES; i++) {
+		if ((fde = dwarf_new_fde(dbg, &de)) == DW_DLV_BADADDR ||
+		    dwarf_add_fde_inst(fde, DW_CFA_def_cfa_offset, 16, 0,
+		    &de) == DW_DLV_BADADDR ||
+		    dwarf_add_frame_fde(dbg, fde, NULL, _FDE_CIE(i), i * 16,
+		    16, _SYM_TEXT, &de) == DW_DLV_NOCOUNT)
+			goto fail;
+	}
+
+	return (0);
+
+fail:
+	tet_printf("building the frames failed: %s\n", dwarf_errmsg(de));
+	result = TET_FAIL;
+	return (-1);
+}
+
+/*
+ * Check that every FDE of a consumer refers to the CIE it was added
+ * with and covers its function.  Return the number of FDEs, or -1.
+ */
+static int
+_check_frames(Dwarf_Debug dbg, Dwarf_Signed *ret_cie_count)
+{
+	Dwarf_Cie *cie_list, cie;
+	Dwarf_Fde *fde_list;
+	Dwarf_Error de;
+	Dwarf_Signed cie_count, fde_count, i, cie_index, index;
+	Dwarf_Addr low_pc;
+	Dwarf_Unsigned func_len, caf, daf, fde_bytelen, cie_bytelen, instlen;
+	Dwarf_Ptr fde_bytes, initinst;
+	Dwarf_Off cie_off, fde_off;
+	Dwarf_Small version;
+	Dwarf_Half ra;
+	char *augmenter;
+	int j;
+
+	if (dwarf_get_fde_list(dbg, &cie_list, &cie_count, &fde_list,
+	    &fde_count, &de) != DW_DLV_OK) {
+		tet_printf("dwarf_get_fde_list failed: %s\n",
+		    dwarf_errmsg(de));
+		result = TET_FAIL;
+		return (-1);
+	}
+	*ret_cie_count = cie_count;
+
+	for (i = 0; i < fde_count; i++) {
+		j = _FDE_CIE(i);
+		if (dwarf_get_fde_range(fde_list[i], &low_pc, &func_len,
+		    &fde_bytes, &fde_bytelen, &cie_off, &cie_index, &fde_off,
+		    &de) != DW_DLV_OK ||
+		    dwarf_get_cie_of_fde(fde_list[i], &cie, &de) !=
+		    DW_DLV_OK ||
+		    dwarf_get_cie_index(cie, &index, &de) != DW_DLV_OK ||
+		    dwarf_get_cie_info(cie, &cie_bytelen, &version, &augmenter,
+		    &caf, &daf, &ra, &initinst, &instlen, &de) !=
+		    DW_DLV_OK) {
+			tet_printf("reading FDE #%jd failed: %s\n",
+			    (intmax_t) i, dwarf_errmsg(de));
+			result = TET_FAIL;
+			return (-1);
+		}
+		if (cie_index != j || index != j || caf !=
+		    (Dwarf_Unsigned) j % 127 + 1 || ra != j % 32 ||
+		    (Dwarf_Signed) daf != -8) {
+			tet_printf("FDE #%jd refers to a wrong CIE\n",
+			    (intmax_t) i);
+			result = TET_FAIL;
+			return (-1);
+		}
+		if (low_pc != (Dwarf_Addr) i * 16 || func_len != 16) {
+			tet_printf("FDE #%jd covers a wrong range\n",
+			    (intmax_t) i);
+			result = TET_FAIL;
+			return (-1);
+		}
+	}
+
+	return (fde_count);
+}
+
+/*
+ * Many CIEs, each FDE referring to one of them out of order.  The
+ * CIE pointers of the FDEs are section offsets written in place, so
+ * the frames read back without applying any relocation.
+ */
+static void
+tp_dwarf_producer_frames(void)
+{
+	Dwarf_P_Debug pdbg;
+	Dwarf_Debug dbg;
+	Dwarf_Error de;
+	Dwarf_Signed cie_count;
+	int cnt, fde_count;
+
+	result = TET_UNRESOLVED;
+	pdbg = NULL;
+	dbg = NULL;
+
+	if (_names_load() < 0)
+		goto done;
+
+	if ((pdbg = _pro_init(0)) == NULL ||
+	    _pro_unit(pdbg, DW_TAG_subprogram, NULL) == NULL ||
+	    _pro_frames(pdbg) < 0 || _pro_collect(pdbg) < 0 ||
+	    (dbg = _obj_open()) == NULL)
+		goto done;
+
+	cnt = _check_unit(dbg, NULL);
+	TS_CHECK_INT(cnt);
+
+	cie_count = 0;
+	fde_count = _check_frames(dbg, &cie_count);
+	TS_CHECK_INT(fde_count);
+	TS_CHECK_INT(cie_count);
+	if (fde_count != _FRAME_CIES || cie_count != _FRAME_CIES) {
+		tet_printf("found %jd CIEs and %d FDEs, expected %d\n",
+		    (intmax_t) cie_count, fde_count, _FRAME_CIES);
+		result = TET_FAIL;
+	}
+
+	if (result == TET_UNRESOLVED)
+		result = TET_PASS;
+
+done:
+	if (dbg != NULL)
+		(void) dwarf_object_finish(dbg, &de);
+	if (pdbg != NULL)
+		(void) dwarf_producer_finish(pdbg, &de);
+	_secs_free();
+	_names_free();
+	TS_RESULT(result);
+}
@@ -40,12 +40,16 @@
  * Test case for dwarf address range API.
  */
 static void tp_dwarf_ranges(void);
+static void tp_dwarf_ranges_die(void);
 static struct dwarf_tp dwarf_tp_array[] = {
 	{"tp_dwarf_ranges", tp_dwarf_ranges},
+	{"tp_dwarf_ranges_die", tp_dwarf_ranges_die},
 	{NULL, NULL},
 };
 static int result = TET_UNRESOLVED;
+static Dwarf_Debug _dbg;
 #include "driver.c"
+#include "die_traverse.c"
 
 static void
 tp_dwarf_ranges(void)
@@ -100,3 +104,83 @@ done:
 	TS_DWARF_FINISH(dbg, de);
 	TS_RESULT(result);
 }
+
+/*
+ * Check the range lists referenced by DW_AT_ranges attributes.  The DIE
+ * is passed to dwarf_get_ranges_a(), so that the range lists of DWARF 5
+ * compilation units are read from the .debug_rnglists section.
+ */
+static void
+_dwarf_ranges_die(Dwarf_Die die)
+{
+	Dwarf_Attribute at;
+	Dwarf_Ranges *ranges;
+	Dwarf_Signed range_cnt;
+	Dwarf_Unsigned byte_cnt, ranges_off;
+	Dwarf_Off off;
+	Dwarf_Half form;
+	Dwarf_Error de;
+	int r, r_ranges, i;
+
+	if (dwarf_attr(die, DW_AT_ranges, &at, &de) != DW_DLV_OK)
+		return;
+
+	if (dwarf_whatform(at, &form, &de) != DW_DLV_OK) {
+		tet_printf("dwarf_whatform failed: %s\n", dwarf_errmsg(de));
+		result = TET_FAIL;
+		return;
+	}
+	if (form == DW_FORM_data4 || form == DW_FORM_data8)
+		r = dwarf_formudata(at, &ranges_off, &de);
+	else {
+		r = dwarf_global_formref(at, &off, &de);
+		ranges_off = off;
+	}
+	if (r != DW_DLV_OK) {
+		tet_printf("reading DW_AT_ranges failed: %s\n",
+		    dwarf_errmsg(de));
+		result = TET_FAIL;
+		return;
+	}
+	TS_CHECK_UINT(ranges_off);
+
+	r_ranges = dwarf_get_ranges_a(_dbg, ranges_off, die, &ranges,
+	    &range_cnt, &byte_cnt, &de);
+	TS_CHECK_INT(r_ranges);
+	if (r_ranges != DW_DLV_OK) {
+		tet_printf("dwarf_get_ranges_a failed: %s\n",
+		    dwarf_errmsg(de));
+		result = TET_FAIL;
+		return;
+	}
+	TS_CHECK_INT(range_cnt);
+	TS_CHECK_UINT(byte_cnt);
+	for (i = 0; i < range_cnt; i++) {
+		tet_printf("check range %d:\n", i);
+		TS_CHECK_INT(ranges[i].dwr_type);
+		TS_CHECK_UINT(ranges[i].dwr_addr1);
+		TS_CHECK_UINT(ranges[i].dwr_addr2);
+	}
+}
+
+static void
+tp_dwarf_ranges_die(void)
+{
+	Dwarf_Debug dbg;
+	Dwarf_Error de;
+	int fd;
+
+	result = TET_UNRESOLVED;
+
+	TS_DWARF_INIT(dbg, fd, de);
+
+	_dbg = dbg;
+	TS_DWARF_DIE_TRAVERSE(dbg, _dwarf_ranges_die);
+
+	if (result == TET_UNRESOLVED)
+		result = TET_PASS;
+
+done:
+	TS_DWARF_FINISH(dbg, de);
+	TS_RESULT(result);
+}
@@ -0,0 +1,351 @@
+/*-
+ * Copyright (c) 2026 The Elftoolchain Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * $Id$
+ */
+
+#include <assert.h>
+#include <dwarf.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <libdwarf.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "driver.h"
+#include "tet_api.h"
+
+/*
+ * Test case for split DWARF functions: dwarf_set_tied_dbg,
+ * dwarf_get_tied_dbg and dwarf_die_from_hash_signature.
+ *
+ * Each test object holds skeleton units.  The split units are read from
+ * the companion objects named after it with a ".dwo" (a split DWARF
+ * object) or a ".dwp" (a DWARF package) suffix, when present.
+ */
+static void tp_dwarf_split_dwo(void);
+static void tp_dwarf_split_dwp(void);
+static void tp_dwarf_split_sanity(void);
+static struct dwarf_tp dwarf_tp_array[] = {
+	{"tp_dwarf_split_dwo", tp_dwarf_split_dwo},
+	{"tp_dwarf_split_dwp", tp_dwarf_split_dwp},
+	{"tp_dwarf_split_sanity", tp_dwarf_split_sanity},
+	{NULL, NULL},
+};
+static int result = TET_UNRESOLVED;
+#include "driver.c"
+
+static void
+_dwarf_split_die(Dwarf_Debug split, Dwarf_Die die, int depth)
+{
+	Dwarf_Attribute *attrlist;
+	Dwarf_Signed attrcount;
+	Dwarf_Sig8 sig;
+	Dwarf_Die die0, ret_die;
+	Dwarf_Addr lowpc;
+	Dwarf_Half tag, form;
+	Dwarf_Error de;
+	char *name;
+	int i, r, r_child, r_sibling, r_tu;
+
+	if (dwarf_tag(die, &tag, &de) != DW_DLV_OK) {
+		tet_printf("dwarf_tag failed: %s\n", dwarf_errmsg(de));
+		result = TET_FAIL;
+		return;
+	}
+	TS_CHECK_UINT(tag);
+	if (dwarf_diename(die, &name, &de) == DW_DLV_OK)
+		TS_CHECK_STRING(name);
+
+	/* Addresses are read from the .debug_addr of the tied object. */
+	if (dwarf_lowpc(die, &lowpc, &de) == DW_DLV_OK)
+		TS_CHECK_UINT(lowpc);
+
+	/* Follow type signatures to the type units. */
+	r = dwarf_attrlist(die, &attrlist, &attrcount, &de);
+	if (r == DW_DLV_ERROR) {
+		tet_printf("dwarf_attrlist failed: %s\n", dwarf_errmsg(de));
+		result = TET_FAIL;
+		return;
+	}
+	for (i = 0; r == DW_DLV_OK && i < attrcount; i++) {
+		if (dwarf_whatform(attrlist[i], &form, &de) != DW_DLV_OK) {
+			tet_printf("dwarf_whatform failed: %s\n",
+			    dwarf_errmsg(de));
+			result = TET_FAIL;
+			continue;
+		}
+		if (form != DW_FORM_ref_sig8)
+			continue;
+		if (dwarf_formsig8(attrlist[i], &sig, &de) != DW_DLV_OK) {
+			tet_printf("dwarf_formsig8 failed: %s\n",
+			    dwarf_errmsg(de));
+			result = TET_FAIL;
+			continue;
+		}
+		TS_CHECK_BLOCK(sig.signature, 8);
+		r_tu = dwarf_die_from_hash_signature(split, &sig, "tu",
+		    &ret_die, &de);
+		TS_CHECK_INT(r_tu);
+		if (r_tu == DW_DLV_ERROR) {
+			tet_printf("dwarf_die_from_hash_signature failed:"
+			    " %s\n", dwarf_errmsg(de));
+			result = TET_FAIL;
+			continue;
+		}
+		if (r_tu != DW_DLV_OK)
+			continue;
+		if (dwarf_tag(ret_die, &tag, &de) != DW_DLV_OK) {
+			tet_printf("dwarf_tag failed: %s\n", dwarf_errmsg(de));
+			result = TET_FAIL;
+		} else
+			TS_CHECK_UINT(tag);
+		if (dwarf_diename(ret_die, &name, &de) == DW_DLV_OK)
+			TS_CHECK_STRING(name);
+		dwarf_dealloc(split, ret_die, DW_DLA_DIE);
+	}
+
+	r_child = dwarf_child(die, &die0, &de);
+	TS_CHECK_INT(r_child);
+	if (r_child == DW_DLV_ERROR) {
+		tet_printf("dwarf_child failed: %s\n", dwarf_errmsg(de));
+		result = TET_FAIL;
+	} else if (r_child == DW_DLV_OK)
+		_dwarf_split_die(split, die0, depth + 1);
+
+	if (depth == 0)
+		return;
+
+	r_sibling = dwarf_siblingof_b(split, die, &die0, 1, &de);
+	TS_CHECK_INT(r_sibling);
+	if (r_sibling == DW_DLV_ERROR) {
+		tet_printf("dwarf_siblingof_b failed: %s\n", dwarf_errmsg(de));
+		result = TET_FAIL;
+	} else if (r_sibling == DW_DLV_OK)
+		_dwarf_split_die(split, die0, depth);
+}
+
+static void
+_dwarf_split(const char *suffix)
+{
+	Dwarf_Debug dbg, split, tied;
+	Dwarf_Error de;
+	Dwarf_Sig8 cu_sig;
+	Dwarf_Unsigned cu_next_offset;
+	Dwarf_Die die;
+	Dwarf_Half tag;
+	char path[256];
+	int fd, split_fd, is_tied, r_lookup, r_tied;
+
+	result = TET_UNRESOLVED;
+	split = NULL;
+	split_fd = -1;
+
+	TS_DWARF_INIT(dbg, fd, de);
+
+	(void) snprintf(path, sizeof(path), "%s%s", _cur_file, suffix);
+	if ((split_fd = open(path, O_RDONLY)) < 0) {
+		/* Not every test object comes with every companion. */
+		if (errno == ENOENT)
+			result = TET_PASS;
+		else {
+			tet_printf("open %s failed: %s\n", path,
+			    strerror(errno));
+			result = TET_FAIL;
+		}
+		goto done;
+	}
+	if (dwarf_init(split_fd, DW_DLC_READ, NULL, NULL, &split, &de) !=
+	    DW_DLV_OK) {
+		tet_printf("dwarf_init failed: %s\n", dwarf_errmsg(de));
+		result = TET_FAIL;
+		goto done;
+	}
+
+	r_tied = dwarf_get_tied_dbg(split, &tied, &de);
+	TS_CHECK_INT(r_tied);
+	if (dwarf_set_tied_dbg(split, dbg, &de) != DW_DLV_OK) {
+		tet_printf("dwarf_set_tied_dbg failed: %s\n",
+		    dwarf_errmsg(de));
+		result = TET_FAIL;
+		goto done;
+	}
+	r_tied = dwarf_get_tied_dbg(split, &tied, &de);
+	TS_CHECK_INT(r_tied);
+	is_tied = r_tied == DW_DLV_OK && tied == dbg;
+	TS_CHECK_INT(is_tied);
+
+	/* Find the split unit of each skeleton unit by its DWO id. */
+	for (;;) {
+		memset(&cu_sig, 0, sizeof(cu_sig));
+		if (dwarf_next_cu_header_c(dbg, 1, NULL, NULL, NULL, NULL,
+		    NULL, NULL, &cu_sig, NULL, &cu_next_offset, &de) !=
+		    DW_DLV_OK)
+			break;
+		TS_CHECK_UINT(cu_next_offset);
+		TS_CHECK_BLOCK(cu_sig.signature, 8);
+		if (dwarf_siblingof(dbg, NULL, &die, &de) != DW_DLV_OK) {
+			tet_printf("dwarf_siblingof failed: %s\n",
+			    dwarf_errmsg(de));
+			result = TET_FAIL;
+			continue;
+		}
+		if (dwarf_tag(die, &tag, &de) != DW_DLV_OK) {
+			tet_printf("dwarf_tag failed: %s\n", dwarf_errmsg(de));
+			result = TET_FAIL;
+		} else
+			TS_CHECK_UINT(tag);
+		dwarf_dealloc(dbg, die, DW_DLA_DIE);
+
+		r_lookup = dwarf_die_from_hash_signature(split, &cu_sig, "cu",
+		    &die, &de);
+		TS_CHECK_INT(r_lookup);
+		if (r_lookup == DW_DLV_ERROR) {
+			tet_printf("dwarf_die_from_hash_signature failed:"
+			    " %s\n", dwarf_errmsg(de));
+			result = TET_FAIL;
+		} else if (r_lookup == DW_DLV_OK) {
+			_dwarf_split_die(split, die, 0);
+			dwarf_dealloc(split, die, DW_DLA_DIE);
+		}
+	}
+
+	/* Split units report their DWO id too. */
+	for (;;) {
+		memset(&cu_sig, 0, sizeof(cu_sig));
+		if (dwarf_next_cu_header_c(split, 1, NULL, NULL, NULL, NULL,
+		    NULL, NULL, &cu_sig, NULL, &cu_next_offset, &de) !=
+		    DW_DLV_OK)
+			break;
+		TS_CHECK_UINT(cu_next_offset);
+		TS_CHECK_BLOCK(cu_sig.signature, 8);
+	}
+
+	if (result == TET_UNRESOLVED)
+		result = TET_PASS;
+
+done:
+	/* The tied object must outlive the split object. */
+	if (split != NULL)
+		TS_DWARF_FINISH(split, de);
+	if (split_fd >= 0)
+		(void) close(split_fd);
+	if (dbg != NULL)
+		TS_DWARF_FINISH(dbg, de);
+	TS_RESULT(result);
+}
+
+static void
+tp_dwarf_split_dwo(void)
+{
+
+	_dwarf_split(".dwo");
+}
+
+static void
+tp_dwarf_split_dwp(void)
+{
+
+	_dwarf_split(".dwp");
+}
+
+static void
+tp_dwarf_split_sanity(void)
+{
+	Dwarf_Debug dbg, tied;
+	Dwarf_Error de;
+	Dwarf_Sig8 sig;
+	Dwarf_Die die;
+	int fd;
+
+	result = TET_UNRESOLVED;
+
+	TS_DWARF_INIT(dbg, fd, de);
+
+	memset(&sig, 0xff, sizeof(sig));
+
+	if (dwarf_set_tied_dbg(NULL, dbg, &de) != DW_DLV_ERROR ||
+	    dwarf_set_tied_dbg(dbg, dbg, &de) != DW_DLV_ERROR) {
+		tet_infoline("dwarf_set_tied_dbg didn't return DW_DLV_ERROR"
+		    " when called with invalid arguments");
+		result = TET_FAIL;
+		goto done;
+	}
+
+	if (dwarf_get_tied_dbg(NULL, &tied, &de) != DW_DLV_ERROR ||
+	    dwarf_get_tied_dbg(dbg, NULL, &de) != DW_DLV_ERROR) {
+		tet_infoline("dwarf_get_tied_dbg didn't return DW_DLV_ERROR"
+		    " when called with NULL arguments");
+		result = TET_FAIL;
+		goto done;
+	}
+
+	if (dwarf_get_tied_dbg(dbg, &tied, &de) != DW_DLV_NO_ENTRY) {
+		tet_infoline("dwarf_get_tied_dbg didn't return"
+		    " DW_DLV_NO_ENTRY for an object without a tie");
+		result = TET_FAIL;
+		goto done;
+	}
+
+	if (dwarf_die_from_hash_signature(NULL, &sig, "cu", &die, &de) !=
+	    DW_DLV_ERROR ||
+	    dwarf_die_from_hash_signature(dbg, NULL, "cu", &die, &de) !=
+	    DW_DLV_ERROR ||
+	    dwarf_die_from_hash_signature(dbg, &sig, NULL, &die, &de) !=
+	    DW_DLV_ERROR ||
+	    dwarf_die_from_hash_signature(dbg, &sig, "cu", NULL, &de) !=
+	    DW_DLV_ERROR) {
+		tet_infoline("dwarf_die_from_hash_signature didn't return"
+		    " DW_DLV_ERROR when called with NULL arguments");
+		result = TET_FAIL;
+		goto done;
+	}
+
+	if (dwarf_die_from_hash_signature(dbg, &sig, "xu", &die, &de) !=
+	    DW_DLV_ERROR) {
+		tet_infoline("dwarf_die_from_hash_signature didn't return"
+		    " DW_DLV_ERROR for an unknown signature type");
+		result = TET_FAIL;
+		goto done;
+	}
+
+	if (dwarf_die_from_hash_signature(dbg, &sig, "cu", &die, &de) !=
+	    DW_DLV_NO_ENTRY ||
+	    dwarf_die_from_hash_signature(dbg, &sig, "tu", &die, &de) !=
+	    DW_DLV_NO_ENTRY) {
+		tet_infoline("dwarf_die_from_hash_signature didn't return"
+		    " DW_DLV_NO_ENTRY for an unknown signature");
+		result = TET_FAIL;
+		goto done;
+	}
+
+	if (result == TET_UNRESOLVED)
+		result = TET_PASS;
+
+done:
+	TS_DWARF_FINISH(dbg, de);
+	TS_RESULT(result);
+}